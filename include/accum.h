@@ -0,0 +1,132 @@
+/**
+ * @file accum.h
+ * @brief Sharded accumulators for concurrent reductions into a vector
+ * @date 18/10/26
+ */
+
+#ifndef __ACCUM_H
+#define __ACCUM_H
+
+#include "vector.h"
+
+/**
+ * @brief Accumulation target shared by many threads
+ *
+ * Dense contributions go to private, cache-line-aligned replicas (shards)
+ * that are summed by numen_accum_merge(). Sparse contributions can instead
+ * use atomic adds into a shared base array.
+ */
+typedef struct NumenAccumulator NumenAccumulator;
+
+/**
+ * @brief Replica claimed by one thread
+ */
+typedef struct NumenAccumShard NumenAccumShard;
+
+// Section: Accumulator
+
+/**
+ * @brief Create zeroed accumulator
+ * @param size Number of elements
+ * @param shards Number of replicas, 0 for one per pool thread
+ * @param[out] out_accum Pointer to store created accumulator
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_accum_create(size_t size,
+                       size_t shards,
+                       NumenAccumulator **out_accum);
+
+/**
+ * @brief Free accumulator
+ * @param accum Accumulator to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_accum_free(NumenAccumulator *accum);
+
+/**
+ * @brief Sum base array and all replicas into result
+ * @param accum Accumulator to read
+ * @param[out] result Vector of accum size to store totals
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Must not run concurrently with adds. Large accumulators are merged
+ *       on the worker pool.
+ */
+int numen_accum_merge(const NumenAccumulator *accum, Vector *result);
+
+/**
+ * @brief Zero base array and all replicas
+ * @param accum Accumulator to reset
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Must not run concurrently with adds
+ */
+int numen_accum_reset(NumenAccumulator *accum);
+
+/**
+ * @brief Atomically add to one element of the shared base array
+ * @param accum Accumulator to update
+ * @param index Element index
+ * @param value Value to add
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Safe from any thread without a shard, best for sparse updates
+ */
+int numen_accum_atomic_add(NumenAccumulator *accum,
+                           size_t index,
+                           double_t value);
+
+// Section: Shards
+
+/**
+ * @brief Claim a free replica for the calling thread
+ * @param accum Accumulator to update
+ * @param[out] out_shard Pointer to store claimed shard
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_SIZE if every replica is claimed, callers can
+ *       fall back to numen_accum_atomic_add()
+ */
+int numen_accum_shard_acquire(NumenAccumulator *accum,
+                              NumenAccumShard **out_shard);
+
+/**
+ * @brief Return a replica, its contents stay in the accumulator
+ * @param shard Shard to release
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_accum_shard_release(NumenAccumShard *shard);
+
+/**
+ * @brief Add a whole vector into a replica
+ * @param shard Claimed shard
+ * @param values Vector of accum size
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_accum_shard_add(NumenAccumShard *shard, const Vector *values);
+
+/**
+ * @brief Add one value into a replica
+ * @param shard Claimed shard
+ * @param index Element index
+ * @param value Value to add
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_accum_shard_add_at(NumenAccumShard *shard,
+                             size_t index,
+                             double_t value);
+
+/**
+ * @brief Add values at indices into a replica (histogram style)
+ * @param shard Claimed shard
+ * @param indices Array of values->size element indices
+ * @param values Values to add
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_INDEX before writing if any index is out of range
+ */
+int numen_accum_shard_add_indexed(NumenAccumShard *shard,
+                                  const size_t *indices,
+                                  const Vector *values);
+
+#endif // !__ACCUM_H
@@ -0,0 +1,131 @@
+/**
+ * @file append.h
+ * @brief Concurrent multi-producer append buffer
+ * @date 18/10/26
+ */
+
+#ifndef __APPEND_H
+#define __APPEND_H
+
+#include "vector.h"
+
+/**
+ * @brief Append-only buffer shared by producer threads
+ *
+ * Storage grows in doubling segments that are never moved. Producers
+ * reserve fixed-size chunks with a single atomic add and fill them without
+ * further synchronization.
+ */
+typedef struct NumenAppendBuffer NumenAppendBuffer;
+
+/**
+ * @brief Per-producer handle onto an append buffer
+ *
+ * An appender must only be used by one thread at a time.
+ */
+typedef struct NumenAppender NumenAppender;
+
+// Section: Buffer
+
+/**
+ * @brief Create empty append buffer
+ * @param[out] out_buffer Pointer to store created buffer
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_append_buffer_create(NumenAppendBuffer **out_buffer);
+
+/**
+ * @brief Free append buffer
+ * @param buffer Buffer to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note All appenders must be freed first
+ */
+int numen_append_buffer_free(NumenAppendBuffer *buffer);
+
+/**
+ * @brief Number of published elements
+ * @param buffer Buffer to query
+ * @param[out] out_size Pointer to store element count
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Elements become visible when their appender is flushed or freed
+ */
+int numen_append_size(const NumenAppendBuffer *buffer, size_t *out_size);
+
+/**
+ * @brief Copy published elements into a new contiguous vector
+ * @param buffer Buffer to read
+ * @param[out] out_vector Pointer to store created vector
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Elements from one appender keep their order, chunks of different
+ *       appenders are ordered by reservation
+ */
+int numen_append_finalize(const NumenAppendBuffer *buffer,
+                          Vector **out_vector);
+
+/**
+ * @brief Describe published elements as views into the buffer, no copy
+ * @param buffer Buffer to read
+ * @param[out] views Array to store views (can be NULL to count only)
+ * @param capacity Number of entries in views
+ * @param[out] out_count Pointer to store number of views needed
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_SIZE if capacity is too small, out_count is
+ *       still set
+ * @note Views stay valid until the buffer is freed
+ */
+int numen_append_views(const NumenAppendBuffer *buffer,
+                       VectorView *views,
+                       size_t capacity,
+                       size_t *out_count);
+
+// Section: Producers
+
+/**
+ * @brief Create producer handle
+ * @param buffer Buffer to append to
+ * @param[out] out_appender Pointer to store created appender
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_appender_create(NumenAppendBuffer *buffer,
+                          NumenAppender **out_appender);
+
+/**
+ * @brief Publish elements appended so far and free producer handle
+ * @param appender Appender to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_appender_free(NumenAppender *appender);
+
+/**
+ * @brief Append one element
+ * @param appender Producer handle
+ * @param value Element to append
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Only touches shared state when the current chunk is full
+ */
+int numen_append(NumenAppender *appender, double_t value);
+
+/**
+ * @brief Append several elements
+ * @param appender Producer handle
+ * @param values Elements to append
+ * @param count Number of elements
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_append_many(NumenAppender *appender,
+                      const double_t *values,
+                      size_t count);
+
+/**
+ * @brief Make elements appended so far visible to readers
+ * @param appender Producer handle
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_appender_flush(NumenAppender *appender);
+
+#endif // !__APPEND_H
@@ -0,0 +1,203 @@
+/**
+ * @file async.h
+ * @brief Asynchronous vector operations with completion futures
+ * @date 18/10/26
+ */
+
+#ifndef __ASYNC_H
+#define __ASYNC_H
+
+#include "vector.h"
+
+/**
+ * @brief Handle to an operation running on the library's worker pool
+ *
+ * Futures are reference counted internally, releasing the handle with
+ * numen_future_free() while the operation is still pending is safe.
+ */
+typedef struct NumenFuture NumenFuture;
+
+/**
+ * @brief Operation body for numen_submit()
+ * @param arg User argument
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+typedef int (*NumenTaskFn)(void *arg);
+
+/**
+ * @brief Completion callback
+ * @param status Result of the operation
+ * @param user_data Pointer given at registration
+ */
+typedef void (*NumenCallback)(int status, void *user_data);
+
+// Section: Futures
+
+/**
+ * @brief Run a function on the worker pool once its dependencies finish
+ * @param fn Function to run
+ * @param arg Argument passed to fn, owned by the caller
+ * @param deps Futures that must complete first (may be NULL if dep_count is 0)
+ * @param dep_count Number of dependencies
+ * @param[out] out_future Pointer to receive future, or NULL to fire and forget
+ * @return VECTOR_SUCCESS if submitted, error code otherwise
+ *
+ * @note If a dependency fails, fn is skipped and the future completes with
+ *       the dependency's error code
+ * @note The caller owns the returned future and must free it with numen_future_free()
+ */
+int numen_submit(NumenTaskFn fn,
+                 void *arg,
+                 NumenFuture *const *deps,
+                 size_t dep_count,
+                 NumenFuture **out_future);
+
+/**
+ * @brief Block until a future completes
+ * @param future Future to wait for
+ * @return Result of the operation, or VECTOR_ERROR_NULL
+ *
+ * @note The waiting thread runs queued pool work while it waits
+ */
+int numen_wait(NumenFuture *future);
+
+/**
+ * @brief Check whether a future has completed without blocking
+ * @param future Future to query
+ * @param[out] done Pointer to store completion state
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_poll(NumenFuture *future, bool *done);
+
+/**
+ * @brief Register a callback to run when a future completes
+ * @param future Future to observe
+ * @param callback Function to call with the result
+ * @param user_data Pointer passed to callback
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Runs on the completing worker thread, or immediately on the calling
+ *       thread if the future is already complete. Callbacks must not block.
+ */
+int numen_on_complete(NumenFuture *future,
+                      NumenCallback callback,
+                      void *user_data);
+
+/**
+ * @brief Release a future handle
+ * @param future Future to release
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note A pending operation still runs to completion
+ */
+int numen_future_free(NumenFuture *future);
+
+// Section: Asynchronous Vector Operations
+
+/**
+ * @brief Asynchronous vector_add()
+ * @param a First operand
+ * @param b Second operand
+ * @param[out] result Vector to store result
+ * @param deps Futures that must complete first
+ * @param dep_count Number of dependencies
+ * @param[out] out_future Pointer to receive future, or NULL
+ * @return VECTOR_SUCCESS if submitted, error code otherwise
+ *
+ * @note Operands must stay alive and unmodified until the future completes,
+ *       argument errors are reported through the future
+ */
+int vector_add_async(const Vector *a,
+                     const Vector *b,
+                     Vector *result,
+                     NumenFuture *const *deps,
+                     size_t dep_count,
+                     NumenFuture **out_future);
+
+/**
+ * @brief Asynchronous vector_sub()
+ * @see vector_add_async() for parameters and lifetime rules
+ */
+int vector_sub_async(const Vector *a,
+                     const Vector *b,
+                     Vector *result,
+                     NumenFuture *const *deps,
+                     size_t dep_count,
+                     NumenFuture **out_future);
+
+/**
+ * @brief Asynchronous vector_mult()
+ * @see vector_add_async() for parameters and lifetime rules
+ */
+int vector_mult_async(const Vector *a,
+                      const Vector *b,
+                      Vector *result,
+                      NumenFuture *const *deps,
+                      size_t dep_count,
+                      NumenFuture **out_future);
+
+/**
+ * @brief Asynchronous vector_div()
+ * @see vector_add_async() for parameters and lifetime rules
+ */
+int vector_div_async(const Vector *a,
+                     const Vector *b,
+                     Vector *result,
+                     NumenFuture *const *deps,
+                     size_t dep_count,
+                     NumenFuture **out_future);
+
+/**
+ * @brief Asynchronous vector_scale()
+ * @see vector_add_async() for parameters and lifetime rules
+ */
+int vector_scale_async(const Vector *a,
+                       double_t scaler,
+                       Vector *result,
+                       NumenFuture *const *deps,
+                       size_t dep_count,
+                       NumenFuture **out_future);
+
+/**
+ * @brief Asynchronous vector_copy()
+ * @see vector_add_async() for parameters and lifetime rules
+ */
+int vector_copy_async(const Vector *src,
+                      Vector *dest,
+                      NumenFuture *const *deps,
+                      size_t dep_count,
+                      NumenFuture **out_future);
+
+/**
+ * @brief Asynchronous vector_dot()
+ * @note result must stay valid until the future completes
+ * @see vector_add_async() for parameters and lifetime rules
+ */
+int vector_dot_async(const Vector *a,
+                     const Vector *b,
+                     double_t *result,
+                     NumenFuture *const *deps,
+                     size_t dep_count,
+                     NumenFuture **out_future);
+
+/**
+ * @brief Asynchronous vector_sum()
+ * @note sum must stay valid until the future completes
+ * @see vector_add_async() for parameters and lifetime rules
+ */
+int vector_sum_async(const Vector *vector,
+                     double_t *sum,
+                     NumenFuture *const *deps,
+                     size_t dep_count,
+                     NumenFuture **out_future);
+
+/**
+ * @brief Asynchronous vector_normalize()
+ * @see vector_add_async() for parameters and lifetime rules
+ */
+int vector_normalize_async(Vector *vector,
+                           NumenFuture *const *deps,
+                           size_t dep_count,
+                           NumenFuture **out_future);
+
+#endif // !__ASYNC_H
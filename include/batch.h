@@ -0,0 +1,142 @@
+/**
+ * @file batch.h
+ * @brief Structure-of-arrays batches of small fixed-size vectors
+ * @date 18/10/26
+ */
+
+#ifndef __BATCH_H
+#define __BATCH_H
+
+#include "vector.h"
+#include <stddef.h>
+#include <math.h>
+
+/**
+ * @brief Batch of 3D vectors stored as separate component arrays (SoA)
+ *
+ * Component arrays are laid out back to back in a single allocation so that
+ * kernels can process one component of many points per SIMD lane.
+ */
+typedef struct {
+    double_t *x; ///< X components
+    double_t *y; ///< Y components
+    double_t *z; ///< Z components
+    size_t count; ///< Number of vectors in batch
+} Vec3Batch;
+
+/**
+ * @brief Batch of 4D vectors stored as separate component arrays (SoA)
+ */
+typedef struct {
+    double_t *x; ///< X components
+    double_t *y; ///< Y components
+    double_t *z; ///< Z components
+    double_t *w; ///< W components
+    size_t count; ///< Number of vectors in batch
+} Vec4Batch;
+
+// Section: Initialization
+
+/**
+ * @brief Create a zero-initialized batch of 3D vectors
+ * @param count Number of vectors in batch
+ * @param[out] out_batch Pointer to receive newly created batch
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned batch and must free it with vec3_batch_free()
+ */
+int vec3_batch_create(size_t count, Vec3Batch **out_batch);
+
+/**
+ * @brief Free memory allocated by a 3D vector batch
+ * @param batch Batch to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vec3_batch_free(Vec3Batch *batch);
+
+/**
+ * @brief Create a zero-initialized batch of 4D vectors
+ * @param count Number of vectors in batch
+ * @param[out] out_batch Pointer to receive newly created batch
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned batch and must free it with vec4_batch_free()
+ */
+int vec4_batch_create(size_t count, Vec4Batch **out_batch);
+
+/**
+ * @brief Free memory allocated by a 4D vector batch
+ * @param batch Batch to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vec4_batch_free(Vec4Batch *batch);
+
+// Section: Layout Conversion
+
+/**
+ * @brief Load batch from interleaved x0 y0 z0 x1 y1 z1 ... (AoS)
+ * @param xyz Array of 3 * batch->count elements
+ * @param[out] batch Batch to fill
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vec3_batch_from_interleaved(const double_t *xyz, Vec3Batch *batch);
+
+/**
+ * @brief Store batch as interleaved x0 y0 z0 x1 y1 z1 ... (AoS)
+ * @param batch Batch to read
+ * @param[out] xyz Array of 3 * batch->count elements
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vec3_batch_to_interleaved(const Vec3Batch *batch, double_t *xyz);
+
+/**
+ * @brief Load batch from 3D vectors such as those from vector_3d()
+ * @param vectors Array of batch->count vectors of size 3
+ * @param[out] batch Batch to fill
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vec3_batch_from_vectors(const Vector *const *vectors, Vec3Batch *batch);
+
+/**
+ * @brief Store batch into existing 3D vectors
+ * @param batch Batch to read
+ * @param[out] vectors Array of batch->count vectors of size 3
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vec3_batch_to_vectors(const Vec3Batch *batch, Vector *const *vectors);
+
+/**
+ * @brief Load batch from interleaved x0 y0 z0 w0 x1 ... (AoS)
+ * @param xyzw Array of 4 * batch->count elements
+ * @param[out] batch Batch to fill
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Every four points are one 4x4 register transpose with AVX2
+ */
+int vec4_batch_from_interleaved(const double_t *xyzw, Vec4Batch *batch);
+
+/**
+ * @brief Store batch as interleaved x0 y0 z0 w0 x1 ... (AoS)
+ * @param batch Batch to read
+ * @param[out] xyzw Array of 4 * batch->count elements
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vec4_batch_to_interleaved(const Vec4Batch *batch, double_t *xyzw);
+
+/**
+ * @brief Load batch from 4D vectors such as those from vector_4d()
+ * @param vectors Array of batch->count vectors of size 4
+ * @param[out] batch Batch to fill
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vec4_batch_from_vectors(const Vector *const *vectors, Vec4Batch *batch);
+
+/**
+ * @brief Store batch into existing 4D vectors
+ * @param batch Batch to read
+ * @param[out] vectors Array of batch->count vectors of size 4
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vec4_batch_to_vectors(const Vec4Batch *batch, Vector *const *vectors);
+
+#endif // !__BATCH_H
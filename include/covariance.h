@@ -0,0 +1,52 @@
+/**
+ * @file covariance.h
+ * @brief Gram, covariance and correlation matrices of vector collections
+ * @date 18/10/26
+ */
+
+#ifndef __COVARIANCE_H
+#define __COVARIANCE_H
+
+#include "matrix.h"
+
+/**
+ * @brief Gram matrix of inner products (out[i][j] = vectors[i] . vectors[j])
+ * @param vectors Array of count vectors of equal size
+ * @param count Number of vectors
+ * @param[out] out count x count matrix to store result
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Computed as one symmetric rank-k update: only tiles on or above
+ *       the diagonal are multiplied, on the worker pool, and the lower
+ *       triangle is mirrored at the end
+ */
+int vector_gram(const Vector *const *vectors, size_t count, Matrix *out);
+
+/**
+ * @brief Sample covariance matrix, each vector is one variable
+ * @see vector_gram() for parameters
+ *
+ * out[i][j] is the covariance of the elements of vectors[i] and
+ * vectors[j], normalized by size - 1.
+ *
+ * @note Means are subtracted while the vectors are packed for the rank-k
+ *       update, no centered copies are made
+ * @note Returns VECTOR_ERROR_SIZE for vectors of fewer than two elements
+ */
+int vector_covariance(const Vector *const *vectors,
+                      size_t count,
+                      Matrix *out);
+
+/**
+ * @brief Pearson correlation matrix, each vector is one variable
+ * @see vector_gram() for parameters
+ *
+ * @note Rows and columns of constant vectors are zero, including their
+ *       diagonal entry
+ * @note Returns VECTOR_ERROR_SIZE for vectors of fewer than two elements
+ */
+int vector_correlation(const Vector *const *vectors,
+                       size_t count,
+                       Matrix *out);
+
+#endif // !__COVARIANCE_H
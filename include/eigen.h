@@ -0,0 +1,154 @@
+/**
+ * @file eigen.h
+ * @brief Symmetric eigensolvers, randomized SVD and PCA
+ * @date 18/10/26
+ */
+
+#ifndef __EIGEN_H
+#define __EIGEN_H
+
+#include "matrix.h"
+
+// Section: Symmetric Eigenproblems
+
+/**
+ * @brief All eigenpairs of a symmetric matrix
+ * @param a Square symmetric matrix
+ * @param[out] eigenvalues Vector of size n to store eigenvalues in
+ *             descending order
+ * @param[out] eigenvectors Matrix of a's shape to store unit eigenvectors
+ *             as columns, matching eigenvalues (can be NULL)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Householder tridiagonalization followed by implicit QR iterations
+ *       with Wilkinson shifts
+ * @note Returns VECTOR_ERROR_MATH if the iteration fails to converge
+ */
+int matrix_eigen_symmetric(const Matrix *a,
+                           Vector *eigenvalues,
+                           Matrix *eigenvectors);
+
+/**
+ * @brief Dominant eigenpair by power iteration
+ * @param a Square matrix
+ * @param[in,out] vector Start vector on entry (zero for a default start),
+ *                unit eigenvector on exit
+ * @param tolerance Relative change of the eigenvalue estimate to stop at
+ * @param max_iterations Iteration limit
+ * @param[out] eigenvalue Pointer to store eigenvalue of largest magnitude
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_MATH if not converged, vector and eigenvalue
+ *       hold the last estimate
+ */
+int matrix_power_iteration(const Matrix *a,
+                           Vector *vector,
+                           double_t tolerance,
+                           size_t max_iterations,
+                           double_t *eigenvalue);
+
+/**
+ * @brief k largest eigenpairs of a symmetric matrix by Lanczos iteration
+ * @param a Square symmetric matrix
+ * @param k Number of eigenpairs (1 <= k <= n)
+ * @param[out] eigenvalues Vector of size k to store eigenvalues in
+ *             descending order
+ * @param[out] eigenvectors Matrix of shape n x k to store unit
+ *             eigenvectors as columns (can be NULL)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Fully reorthogonalized Lanczos with explicit restarts, the Krylov
+ *       space grows on every restart so the iteration always terminates
+ */
+int matrix_eigen_topk(const Matrix *a,
+                      size_t k,
+                      Vector *eigenvalues,
+                      Matrix *eigenvectors);
+
+// Section: Singular Value Decomposition
+
+/**
+ * @brief Truncated SVD by randomized range finding (a ~ U * S * Vt)
+ * @param a Matrix (m x n)
+ * @param k Number of singular triplets (1 <= k <= min(m, n))
+ * @param oversample Extra random directions, 5 to 10 is typical
+ * @param power_iterations Subspace iterations, 1 to 3 sharpen slowly
+ *        decaying spectra
+ * @param[out] singular_values Vector of size k, descending
+ * @param[out] u Matrix of shape m x k for left singular vectors (can be NULL)
+ * @param[out] vt Matrix of shape k x n for right singular vectors as rows
+ *             (can be NULL)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Uses a fixed random seed, results are reproducible
+ */
+int matrix_svd_randomized(const Matrix *a,
+                          size_t k,
+                          size_t oversample,
+                          size_t power_iterations,
+                          Vector *singular_values,
+                          Matrix *u,
+                          Matrix *vt);
+
+// Section: Principal Component Analysis
+
+/**
+ * @brief Fitted principal component basis
+ */
+typedef struct NumenPCA NumenPCA;
+
+/**
+ * @brief Fit principal components to a collection of samples
+ * @param samples Array of count vectors of equal size
+ * @param count Number of samples (at least 2)
+ * @param components Number of components to keep
+ * @param[out] out_pca Pointer to store fitted basis
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Centers the samples and runs matrix_svd_randomized() on them
+ */
+int numen_pca_fit(const Vector *const *samples,
+                  size_t count,
+                  size_t components,
+                  NumenPCA **out_pca);
+
+/**
+ * @brief Free fitted basis
+ * @param pca Basis to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_pca_free(NumenPCA *pca);
+
+/**
+ * @brief Project one sample onto the components
+ * @param pca Fitted basis
+ * @param sample Vector of the fitted dimension
+ * @param[out] out Vector of size components to store coordinates
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_pca_project(const NumenPCA *pca, const Vector *sample, Vector *out);
+
+/**
+ * @brief Project many samples onto the components
+ * @param pca Fitted basis
+ * @param samples Array of count vectors of the fitted dimension
+ * @param count Number of samples
+ * @param[out] out Matrix of shape count x components, one row per sample
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note One matrix product, large batches run on the worker pool
+ */
+int numen_pca_project_batch(const NumenPCA *pca,
+                            const Vector *const *samples,
+                            size_t count,
+                            Matrix *out);
+
+/**
+ * @brief Variance captured by each component
+ * @param pca Fitted basis
+ * @param[out] out Vector of size components, descending
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_pca_explained_variance(const NumenPCA *pca, Vector *out);
+
+#endif // !__EIGEN_H
@@ -0,0 +1,69 @@
+/**
+ * @file gather.h
+ * @brief Indexed gather, scatter and scatter-add
+ * @date 18/10/26
+ */
+
+#ifndef __GATHER_H
+#define __GATHER_H
+
+#include "vector.h"
+
+/**
+ * @brief Indexed load (out[i] = src[indices[i]])
+ * @param src Vector to read from
+ * @param indices Array of out->size indices into src
+ * @param[out] out Vector to store gathered elements
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_INDEX before writing if any index is out of range
+ */
+int vector_gather(const Vector *src, const size_t *indices, Vector *out);
+
+/**
+ * @brief Indexed store (dest[indices[i]] = values[i])
+ * @param values Elements to store
+ * @param indices Array of values->size indices into dest
+ * @param[out] dest Vector to write into
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note For duplicate indices the last value wins, as in a sequential loop
+ * @note Returns VECTOR_ERROR_INDEX before writing if any index is out of range
+ */
+int vector_scatter(const Vector *values, const size_t *indices, Vector *dest);
+
+/**
+ * @brief Indexed accumulate (dest[indices[i]] += values[i])
+ * @param values Elements to add
+ * @param indices Array of values->size indices into dest
+ * @param[out] dest Vector to accumulate into
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Duplicate indices are all accumulated. With AVX-512CD, conflicting
+ *       lanes are detected per group and handled by a scalar fallback.
+ * @note Returns VECTOR_ERROR_INDEX before writing if any index is out of range
+ */
+int vector_scatter_add(const Vector *values,
+                       const size_t *indices,
+                       Vector *dest);
+
+/**
+ * @brief Multithreaded indexed accumulate (dest[indices[i]] += values[i])
+ * @param values Elements to add
+ * @param indices Array of values->size indices into dest
+ * @param[out] dest Vector to accumulate into
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Each thread accumulates into a private copy of dest which are then
+ *       reduced in parallel, so the temporary memory is threads * dest->size
+ * @note Threads are limited to values->size / dest->size, so the copies
+ *       never cost more than the updates; sparse updates into a large
+ *       dest run serially
+ * @note Summation order differs from vector_scatter_add(), results may
+ *       differ in the last bits
+ */
+int vector_scatter_add_parallel(const Vector *values,
+                                const size_t *indices,
+                                Vector *dest);
+
+#endif // !__GATHER_H
@@ -0,0 +1,169 @@
+/**
+ * @file graph.h
+ * @brief Task graphs of dependent vector operations
+ * @date 18/10/26
+ */
+
+#ifndef __GRAPH_H
+#define __GRAPH_H
+
+#include "async.h"
+#include "vector.h"
+
+/**
+ * @brief Graph of vector operations connected by data dependencies
+ *
+ * Nodes are added in program order. Dependencies are inferred from the
+ * vectors and scalars each node reads and writes (read-after-write,
+ * write-after-read and write-after-write), extra ordering can be added
+ * with numen_graph_depend(). Independent branches run concurrently on the
+ * worker pool and every node is split into chunks.
+ */
+typedef struct NumenGraph NumenGraph;
+
+/**
+ * @brief Identifier of a node within its graph
+ */
+typedef size_t NumenNode;
+
+// Section: Memory management
+
+/**
+ * @brief Create an empty task graph
+ * @param[out] out_graph Pointer to receive newly created graph
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned graph and must free it with numen_graph_free()
+ */
+int numen_graph_create(NumenGraph **out_graph);
+
+/**
+ * @brief Free a task graph
+ * @param graph Graph to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Vectors referenced by the graph are not freed
+ */
+int numen_graph_free(NumenGraph *graph);
+
+// Section: Nodes
+
+/**
+ * @brief Add node computing result = a + b
+ * @param graph Graph to extend
+ * @param a First operand
+ * @param b Second operand
+ * @param[out] result Vector to store result
+ * @param[out] out_node Optional pointer to receive node identifier
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_graph_add(NumenGraph *graph,
+                    const Vector *a,
+                    const Vector *b,
+                    Vector *result,
+                    NumenNode *out_node);
+
+/**
+ * @brief Add node computing result = a - b
+ * @see numen_graph_add() for parameters
+ */
+int numen_graph_sub(NumenGraph *graph,
+                    const Vector *a,
+                    const Vector *b,
+                    Vector *result,
+                    NumenNode *out_node);
+
+/**
+ * @brief Add node computing result = a * b element-wise
+ * @see numen_graph_add() for parameters
+ */
+int numen_graph_mult(NumenGraph *graph,
+                     const Vector *a,
+                     const Vector *b,
+                     Vector *result,
+                     NumenNode *out_node);
+
+/**
+ * @brief Add node computing result = a * scaler
+ * @param graph Graph to extend
+ * @param a Vector to scale
+ * @param scaler Scaling factor
+ * @param[out] result Vector to store result
+ * @param[out] out_node Optional pointer to receive node identifier
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_graph_scale(NumenGraph *graph,
+                      const Vector *a,
+                      double_t scaler,
+                      Vector *result,
+                      NumenNode *out_node);
+
+/**
+ * @brief Add node computing the dot product of a and b
+ * @param graph Graph to extend
+ * @param a First vector
+ * @param b Second vector
+ * @param[out] result Pointer to store dot product, tracked as a dependency
+ * @param[out] out_node Optional pointer to receive node identifier
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Chunk partial sums are combined in a fixed order, so the result
+ *       does not depend on scheduling
+ */
+int numen_graph_dot(NumenGraph *graph,
+                    const Vector *a,
+                    const Vector *b,
+                    double_t *result,
+                    NumenNode *out_node);
+
+/**
+ * @brief Add node normalizing vector in-place
+ * @param graph Graph to extend
+ * @param vector Vector to normalize
+ * @param[out] out_node Optional pointer to receive node identifier
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_graph_normalize(NumenGraph *graph,
+                          Vector *vector,
+                          NumenNode *out_node);
+
+/**
+ * @brief Add node running a user function
+ * @param graph Graph to extend
+ * @param fn Function to run
+ * @param arg Argument passed to fn
+ * @param[out] out_node Optional pointer to receive node identifier
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Custom nodes declare no data, order them with numen_graph_depend()
+ */
+int numen_graph_custom(NumenGraph *graph,
+                       NumenTaskFn fn,
+                       void *arg,
+                       NumenNode *out_node);
+
+/**
+ * @brief Add an explicit edge, node runs after dependency
+ * @param graph Graph to modify
+ * @param node Dependent node
+ * @param dependency Node that must finish first (added before node)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_graph_depend(NumenGraph *graph,
+                       NumenNode node,
+                       NumenNode dependency);
+
+// Section: Execution
+
+/**
+ * @brief Execute every node of the graph and wait for completion
+ * @param graph Graph to run
+ * @return VECTOR_SUCCESS if all nodes succeeded, first error code otherwise
+ *
+ * @note Nodes depending on a failed node are skipped
+ * @note A graph can be run any number of times, it must not be modified or
+ *       run concurrently while running
+ */
+int numen_graph_run(NumenGraph *graph);
+
+#endif // !__GRAPH_H
@@ -0,0 +1,257 @@
+/**
+ * @file intvec.h
+ * @brief Integer vector families (int32, int64 and uint8 counts)
+ * @date 18/10/26
+ */
+
+#ifndef __INTVEC_H
+#define __INTVEC_H
+
+#include "vector.h"
+#include <stdint.h>
+
+/**
+ * @brief Dynamic array of 32-bit signed integers
+ */
+typedef struct {
+    int32_t *elements; ///< Pointer to dynamically allocated array of elements
+    size_t size; ///< Current number of elements in vector
+    size_t capacity; ///< Currently allocated capacity of vector
+} VectorI32;
+
+/**
+ * @brief Dynamic array of 64-bit signed integers
+ */
+typedef struct {
+    int64_t *elements; ///< Pointer to dynamically allocated array of elements
+    size_t size; ///< Current number of elements in vector
+    size_t capacity; ///< Currently allocated capacity of vector
+} VectorI64;
+
+/**
+ * @brief Dynamic array of 8-bit saturating counters
+ */
+typedef struct {
+    uint8_t *elements; ///< Pointer to dynamically allocated array of elements
+    size_t size; ///< Current number of elements in vector
+    size_t capacity; ///< Currently allocated capacity of vector
+} VectorU8;
+
+/*
+ * Every function comes in an i32, i64 and u8 flavour taking the matching
+ * vector type. Signed arithmetic wraps modulo 2^bits, u8 arithmetic
+ * saturates to [0, 255] so counters never wrap back to zero.
+ */
+
+// Section: Validation
+
+/**
+ * @brief Check if a vector is valid (non-null and has allocated elements)
+ * @param vector Pointer to vector to check
+ * @return true if vector is valid, false otherwise
+ */
+bool vector_i32_valid(const VectorI32 *vector);
+bool vector_i64_valid(const VectorI64 *vector);
+bool vector_u8_valid(const VectorU8 *vector);
+
+// Section: Memory management
+
+/**
+ * @brief Create a new zero-initialized vector
+ * @param size Number of elements
+ * @param[out] out_vector Pointer to receive newly created vector
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned vector and must free it with the
+ *       matching free function
+ */
+int vector_i32_create(size_t size, VectorI32 **out_vector);
+int vector_i64_create(size_t size, VectorI64 **out_vector);
+int vector_u8_create(size_t size, VectorU8 **out_vector);
+
+/**
+ * @brief Create vector from C array
+ * @param arr Source array
+ * @param size Number of elements in array
+ * @param[out] out_vector Pointer to receive newly created vector
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_i32_from_array(const int32_t *arr,
+                          size_t size,
+                          VectorI32 **out_vector);
+int vector_i64_from_array(const int64_t *arr,
+                          size_t size,
+                          VectorI64 **out_vector);
+int vector_u8_from_array(const uint8_t *arr,
+                         size_t size,
+                         VectorU8 **out_vector);
+
+/**
+ * @brief Free memory allocated by vector
+ * @param vector Vector to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_i32_free(VectorI32 *vector);
+int vector_i64_free(VectorI64 *vector);
+int vector_u8_free(VectorU8 *vector);
+
+// Section: Element Access
+
+/**
+ * @brief Get element at specified index
+ * @param vector Vector to access
+ * @param index Index of element to get
+ * @param[out] out_val Pointer to receive element value
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_i32_get(const VectorI32 *vector, size_t index, int32_t *out_val);
+int vector_i64_get(const VectorI64 *vector, size_t index, int64_t *out_val);
+int vector_u8_get(const VectorU8 *vector, size_t index, uint8_t *out_val);
+
+/**
+ * @brief Set element at specified index
+ * @param vector Vector to modify
+ * @param index Index of element to set
+ * @param val Value to set
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_i32_set(VectorI32 *vector, size_t index, int32_t val);
+int vector_i64_set(VectorI64 *vector, size_t index, int64_t val);
+int vector_u8_set(VectorU8 *vector, size_t index, uint8_t val);
+
+/**
+ * @brief Convert to a double vector of the same size
+ * @param vector Vector to convert
+ * @param[out] result Vector to store converted elements
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note int64 magnitudes above 2^53 are rounded
+ */
+int vector_i32_to_vector(const VectorI32 *vector, Vector *result);
+int vector_i64_to_vector(const VectorI64 *vector, Vector *result);
+int vector_u8_to_vector(const VectorU8 *vector, Vector *result);
+
+// Section: Vector Arithmetic
+
+/**
+ * @brief Element-wise addition (result = a + b)
+ * @param a First operand
+ * @param b Second operand
+ * @param[out] result Vector to store result, may be a or b
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_i32_add(const VectorI32 *a, const VectorI32 *b, VectorI32 *result);
+int vector_i64_add(const VectorI64 *a, const VectorI64 *b, VectorI64 *result);
+int vector_u8_add(const VectorU8 *a, const VectorU8 *b, VectorU8 *result);
+
+/**
+ * @brief Element-wise subtraction (result = a - b)
+ * @see vector_i32_add()
+ */
+int vector_i32_sub(const VectorI32 *a, const VectorI32 *b, VectorI32 *result);
+int vector_i64_sub(const VectorI64 *a, const VectorI64 *b, VectorI64 *result);
+int vector_u8_sub(const VectorU8 *a, const VectorU8 *b, VectorU8 *result);
+
+/**
+ * @brief Element-wise multiplication (result = a * b)
+ * @see vector_i32_add()
+ */
+int vector_i32_mult(const VectorI32 *a,
+                    const VectorI32 *b,
+                    VectorI32 *result);
+int vector_i64_mult(const VectorI64 *a,
+                    const VectorI64 *b,
+                    VectorI64 *result);
+int vector_u8_mult(const VectorU8 *a, const VectorU8 *b, VectorU8 *result);
+
+// Section: Reductions
+
+/**
+ * @brief Sum of all elements, accumulated in 64 bits
+ * @param vector Vector to sum
+ * @param[out] sum Pointer to store sum
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note int32 and uint8 sums are exact, int64 sums wrap modulo 2^64
+ */
+int vector_i32_sum(const VectorI32 *vector, int64_t *sum);
+int vector_i64_sum(const VectorI64 *vector, int64_t *sum);
+int vector_u8_sum(const VectorU8 *vector, uint64_t *sum);
+
+/**
+ * @brief Dot product, products and sum accumulated in 64 bits
+ * @param a First vector
+ * @param b Second vector
+ * @param[out] result Pointer to store dot product
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Exact unless the result leaves the 64-bit range, int64 products
+ *       wrap modulo 2^64
+ */
+int vector_i32_dot(const VectorI32 *a, const VectorI32 *b, int64_t *result);
+int vector_i64_dot(const VectorI64 *a, const VectorI64 *b, int64_t *result);
+int vector_u8_dot(const VectorU8 *a, const VectorU8 *b, uint64_t *result);
+
+/**
+ * @brief Find minimum element in vector
+ * @param vector Vector to search
+ * @param[out] min Pointer to store minimum value
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_i32_min(const VectorI32 *vector, int32_t *min);
+int vector_i64_min(const VectorI64 *vector, int64_t *min);
+int vector_u8_min(const VectorU8 *vector, uint8_t *min);
+
+/**
+ * @brief Find maximum element in vector
+ * @param vector Vector to search
+ * @param[out] max Pointer to store maximum value
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_i32_max(const VectorI32 *vector, int32_t *max);
+int vector_i64_max(const VectorI64 *vector, int64_t *max);
+int vector_u8_max(const VectorU8 *vector, uint8_t *max);
+
+// Section: Counting
+
+/**
+ * @brief Add one at each index (counts[indices[i]] += 1)
+ * @param counts Vector of counters
+ * @param indices Array of count indices into counts, duplicates allowed
+ * @param count Number of indices
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_INDEX before writing if any index is out of
+ *       range
+ */
+int vector_i32_increment(VectorI32 *counts,
+                         const size_t *indices,
+                         size_t count);
+int vector_i64_increment(VectorI64 *counts,
+                         const size_t *indices,
+                         size_t count);
+int vector_u8_increment(VectorU8 *counts,
+                        const size_t *indices,
+                        size_t count);
+
+/**
+ * @brief Indexed accumulate (dest[indices[i]] += values[i])
+ * @param values Elements to add
+ * @param indices Array of values->size indices into dest
+ * @param[out] dest Vector to accumulate into
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_INDEX before writing if any index is out of
+ *       range
+ */
+int vector_i32_scatter_add(const VectorI32 *values,
+                           const size_t *indices,
+                           VectorI32 *dest);
+int vector_i64_scatter_add(const VectorI64 *values,
+                           const size_t *indices,
+                           VectorI64 *dest);
+int vector_u8_scatter_add(const VectorU8 *values,
+                          const size_t *indices,
+                          VectorU8 *dest);
+
+#endif // !__INTVEC_H
@@ -0,0 +1,78 @@
+/**
+ * @file jobs.h
+ * @brief Batched execution of many small heterogeneous jobs
+ * @date 18/10/26
+ */
+
+#ifndef __JOBS_H
+#define __JOBS_H
+
+#include "async.h"
+#include "vector.h"
+
+/**
+ * @brief Library function a job descriptor refers to
+ */
+typedef enum {
+    NUMEN_JOB_CUSTOM = 0, ///< status = fn(arg)
+    NUMEN_JOB_VECTOR_ADD, ///< vector_add(a, b, result)
+    NUMEN_JOB_VECTOR_SUB, ///< vector_sub(a, b, result)
+    NUMEN_JOB_VECTOR_MULT, ///< vector_mult(a, b, result)
+    NUMEN_JOB_VECTOR_SCALE, ///< vector_scale(a, scalar, result)
+    NUMEN_JOB_VECTOR_CROSS, ///< vector_cross(a, b, result)
+    NUMEN_JOB_VECTOR_NORMALIZE, ///< vector_normalize(result)
+    NUMEN_JOB_VECTOR_DOT, ///< vector_dot(a, b, out)
+    NUMEN_JOB_VECTOR_ANGLE, ///< vector_angle(a, b, out)
+    NUMEN_JOB_VECTOR_DISTANCE, ///< vector_distance(a, b, out)
+    NUMEN_JOB_VECTOR_MAGNITUDE, ///< vector_magnitude(a, out)
+    NUMEN_JOB_VECTOR_SUM, ///< vector_sum(a, out)
+    NUMEN_JOB_FACTORIAL ///< factorial(scalar, out, flags)
+} NumenJobType;
+
+/**
+ * @brief Descriptor of one small job
+ *
+ * Only the fields used by the job type need to be set.
+ */
+typedef struct {
+    NumenJobType type; ///< Function to call
+    const Vector *a; ///< First vector operand
+    const Vector *b; ///< Second vector operand
+    Vector *result; ///< Vector output
+    double_t scalar; ///< Scale factor or factorial input
+    uint8_t flags; ///< Factorial flags
+    double_t *out; ///< Scalar output
+    NumenTaskFn fn; ///< Custom function
+    void *arg; ///< Custom function argument
+    int status; ///< Receives the job's result code
+} NumenJob;
+
+/**
+ * @brief Run a batch of jobs on the worker pool and wait for completion
+ * @param jobs Array of job descriptors
+ * @param count Number of jobs
+ * @return VECTOR_SUCCESS if every job succeeded, otherwise the status of
+ *         the first failing job in array order
+ *
+ * @note Jobs are grouped into a few contiguous tasks per thread that idle
+ *       workers steal, so per-job dispatch cost is a loop iteration
+ * @note Every job's own result is stored in its status field
+ */
+int numen_batch_run(NumenJob *jobs, size_t count);
+
+/**
+ * @brief Asynchronous numen_batch_run()
+ * @param jobs Array of job descriptors, must stay alive until completion
+ * @param count Number of jobs
+ * @param deps Futures that must complete first
+ * @param dep_count Number of dependencies
+ * @param[out] out_future Pointer to receive future, or NULL
+ * @return VECTOR_SUCCESS if submitted, error code otherwise
+ */
+int numen_batch_submit(NumenJob *jobs,
+                       size_t count,
+                       NumenFuture *const *deps,
+                       size_t dep_count,
+                       NumenFuture **out_future);
+
+#endif // !__JOBS_H
@@ -0,0 +1,138 @@
+/**
+ * @file krylov.h
+ * @brief Iterative Krylov solvers for sparse and matrix-free operators
+ * @date 18/10/26
+ */
+
+#ifndef __KRYLOV_H
+#define __KRYLOV_H
+
+#include "sparse.h"
+
+/**
+ * @brief Apply a linear operator (y = A * x)
+ * @param ctx User context from NumenOperator
+ * @param x Input vector
+ * @param[out] y Output vector of the same size, never x
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+typedef int (*NumenOperatorFn)(void *ctx, const Vector *x, Vector *y);
+
+/**
+ * @brief Square linear operator given by its action on vectors
+ */
+typedef struct {
+    size_t size; ///< Rows and columns of the operator
+    NumenOperatorFn apply; ///< Computes y = A * x
+    void *ctx; ///< Passed to apply
+    const Vector *diagonal; ///< Diagonal of A for Jacobi preconditioning, may be NULL
+} NumenOperator;
+
+/**
+ * @brief Preconditioner applied by the solvers
+ */
+typedef enum {
+    NUMEN_PRECONDITIONER_NONE = 0, ///< Solve the system as given
+    NUMEN_PRECONDITIONER_JACOBI ///< Scale by the inverse diagonal
+} NumenPreconditioner;
+
+/**
+ * @brief Iterative solver configuration
+ */
+typedef struct {
+    double_t tolerance; ///< Stop once ||b - A x|| <= tolerance * ||b||
+    size_t max_iterations; ///< Iterations before giving up
+    size_t restart; ///< GMRES Krylov space dimension between restarts
+    NumenPreconditioner preconditioner; ///< Preconditioner to apply
+} NumenSolverConfig;
+
+/**
+ * @brief Outcome of an iterative solve
+ */
+typedef struct {
+    size_t iterations; ///< Iterations performed
+    double_t residual; ///< Final ||b - A x|| / ||b||
+} NumenSolverStats;
+
+// Section: Operators
+
+/**
+ * @brief Wrap a sparse matrix as an operator
+ * @param a Square sparse matrix, must outlive the operator
+ * @param diagonal Optional vector of a->rows elements, filled with the
+ *        diagonal of a and referenced for Jacobi preconditioning
+ * @param[out] out Operator to initialize
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note a is checked with sparse_check() once here, not on every product
+ */
+int numen_operator_sparse(const SparseMatrix *a,
+                          Vector *diagonal,
+                          NumenOperator *out);
+
+// Section: Solvers
+
+/**
+ * @brief Fill configuration with defaults
+ * @param[out] config Configuration to initialize
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Defaults: tolerance 1e-10, 1000 iterations, GMRES restart 30, no
+ *       preconditioner
+ */
+int numen_solver_config_default(NumenSolverConfig *config);
+
+/**
+ * @brief Conjugate gradient for symmetric positive definite operators
+ * @param a Operator
+ * @param b Right-hand side of a->size elements
+ * @param[in,out] x Initial guess, replaced by the solution, must not be b
+ * @param config Solver configuration, NULL for defaults
+ * @param[out] stats Optional pointer to receive iteration count and residual
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Each iteration is one operator application plus two fused passes
+ *       over the vectors, long vectors are split over the worker pool
+ * @note Returns VECTOR_ERROR_MATH if the tolerance is not reached or the
+ *       operator is found not to be positive definite, x holds the last
+ *       iterate
+ * @note Jacobi preconditioning needs a->diagonal and returns
+ *       VECTOR_ERROR_MATH for a zero diagonal entry
+ */
+int numen_cg(const NumenOperator *a,
+             const Vector *b,
+             Vector *x,
+             const NumenSolverConfig *config,
+             NumenSolverStats *stats);
+
+/**
+ * @brief Stabilized biconjugate gradient for general square operators
+ * @see numen_cg() for parameters
+ *
+ * @note Two operator applications per iteration, right preconditioned
+ * @note Returns VECTOR_ERROR_MATH on breakdown or if the tolerance is not
+ *       reached
+ */
+int numen_bicgstab(const NumenOperator *a,
+                   const Vector *b,
+                   Vector *x,
+                   const NumenSolverConfig *config,
+                   NumenSolverStats *stats);
+
+/**
+ * @brief Restarted GMRES for general square operators
+ * @see numen_cg() for parameters
+ *
+ * @note Right preconditioned, the Krylov basis is orthogonalized by
+ *       classical Gram-Schmidt with one reorthogonalization pass, so each
+ *       step reads the basis twice instead of once per basis vector
+ * @note Memory is (config->restart + 1) vectors of a->size elements
+ * @note Returns VECTOR_ERROR_MATH if the tolerance is not reached
+ */
+int numen_gmres(const NumenOperator *a,
+                const Vector *b,
+                Vector *x,
+                const NumenSolverConfig *config,
+                NumenSolverStats *stats);
+
+#endif // !__KRYLOV_H
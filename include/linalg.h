@@ -0,0 +1,272 @@
+/**
+ * @file linalg.h
+ * @brief Dense factorizations and linear solvers
+ * @date 18/10/26
+ */
+
+#ifndef __LINALG_H
+#define __LINALG_H
+
+#include "mask.h"
+#include "matrix.h"
+
+#define CHOLESKY_BATCH_MAX 8 ///< Largest matrix size of batched Cholesky
+
+// Section: LU Factorization
+
+/**
+ * @brief LU factorization with partial pivoting (P * a = L * U)
+ * @param a Square matrix to factor
+ * @param[out] lu Matrix of a's shape to store L (unit diagonal, below) and
+ *             U (on and above the diagonal), may be a itself
+ * @param[out] pivots Array of a->rows entries, row i was swapped with
+ *             row pivots[i] at step i
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Blocked right-looking algorithm, trailing updates are matrix
+ *       products on the worker pool
+ * @note Returns VECTOR_ERROR_MATH for a singular matrix, lu and pivots are
+ *       still filled
+ */
+int matrix_lu(const Matrix *a, Matrix *lu, size_t *pivots);
+
+/**
+ * @brief Solve a * x = b from an LU factorization
+ * @param lu Factors from matrix_lu()
+ * @param pivots Pivots from matrix_lu()
+ * @param b Right-hand side
+ * @param[out] x Vector to store solution, may be b itself
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_MATH if U has a zero on its diagonal
+ */
+int matrix_lu_solve(const Matrix *lu,
+                    const size_t *pivots,
+                    const Vector *b,
+                    Vector *x);
+
+/**
+ * @brief Solve a * x = b for square a
+ * @param a Square matrix
+ * @param b Right-hand side
+ * @param[out] x Vector to store solution, may be b itself
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_MATH if a is singular
+ */
+int matrix_solve(const Matrix *a, const Vector *b, Vector *x);
+
+/**
+ * @brief Solve many independent small systems a[i] * x[i] = b[i]
+ * @param a Array of count square matrices
+ * @param b Array of count right-hand sides
+ * @param[out] x Array of count solution vectors
+ * @param count Number of systems
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Systems are spread across the worker pool. Sizes may differ
+ *       between systems.
+ * @note Returns VECTOR_ERROR_MATH if any system is singular, the other
+ *       solutions are still written
+ */
+int matrix_solve_batched(const Matrix *const *a,
+                         const Vector *const *b,
+                         Vector *const *x,
+                         size_t count);
+
+// Section: Cholesky Factorization
+
+/**
+ * @brief Cholesky factorization of a symmetric positive definite matrix
+ *        (a = L * L^T)
+ * @param a Square SPD matrix, only the lower triangle is read
+ * @param[out] l Matrix of a's shape to store L, upper triangle is zeroed,
+ *             may be a itself
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Blocked right-looking algorithm, trailing updates are matrix
+ *       products on the worker pool
+ * @note Returns VECTOR_ERROR_MATH if a is not positive definite
+ */
+int matrix_cholesky(const Matrix *a, Matrix *l);
+
+/**
+ * @brief Solve a * x = b from a Cholesky factor
+ * @param l Factor from matrix_cholesky()
+ * @param b Right-hand side
+ * @param[out] x Vector to store solution, may be b itself
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int matrix_cholesky_solve(const Matrix *l, const Vector *b, Vector *x);
+
+/**
+ * @brief Solve a * x = b for symmetric positive definite a
+ * @param a Square SPD matrix, only the lower triangle is read
+ * @param b Right-hand side
+ * @param[out] x Vector to store solution, may be b itself
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_MATH if a is not positive definite
+ */
+int matrix_solve_spd(const Matrix *a, const Vector *b, Vector *x);
+
+/**
+ * @brief Cholesky factorization of every matrix of a batch, in place
+ * @param batch Batch of square SPD matrices of size 1 to CHOLESKY_BATCH_MAX
+ * @param[out] failed Mask of batch->count bits set for matrices that are
+ *             not positive definite (can be NULL)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Vectorized across matrices, large batches run on the worker pool
+ * @note Returns VECTOR_ERROR_MATH if any matrix failed, the others are
+ *       still factored
+ */
+int matrix_cholesky_batched(MatrixBatch *batch, VectorMask *failed);
+
+/**
+ * @brief Solve a[k] * x[k] = b[k] for every k from batched Cholesky factors
+ * @param l Factors from matrix_cholesky_batched()
+ * @param[in,out] rhs Batch of n x 1 right-hand sides, overwritten with x
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int matrix_cholesky_solve_batched(const MatrixBatch *l, MatrixBatch *rhs);
+
+// Section: QR Factorization
+
+/**
+ * @brief Householder QR factorization (a = Q * R)
+ * @param a Matrix to factor (m x n)
+ * @param[out] qr Matrix of a's shape to store R on and above the diagonal
+ *             and the Householder vectors below it, may be a itself
+ * @param[out] tau Vector of size min(m, n) to store reflector scales
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Blocked: reflectors of a panel are combined into compact WY form
+ *       (I - V T V^T) and applied to the trailing columns as matrix
+ *       products on the worker pool
+ */
+int matrix_qr(const Matrix *a, Matrix *qr, Vector *tau);
+
+/**
+ * @brief Expand a compact QR factorization
+ * @param qr Factors from matrix_qr()
+ * @param tau Reflector scales from matrix_qr()
+ * @param[out] q Matrix of shape m x min(m, n) to store thin Q (can be NULL)
+ * @param[out] r Matrix of shape min(m, n) x n to store R (can be NULL)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int matrix_qr_unpack(const Matrix *qr,
+                     const Vector *tau,
+                     Matrix *q,
+                     Matrix *r);
+
+/**
+ * @brief Least-squares solution minimizing ||a * x - b||
+ * @param a Matrix (m x n) with m >= n
+ * @param b Right-hand side of size m
+ * @param[out] x Vector of size n to store coefficients
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_MATH if a is rank deficient
+ */
+int matrix_least_squares(const Matrix *a, const Vector *b, Vector *x);
+
+/**
+ * @brief Incremental least-squares fit updated one observation at a time
+ *
+ * Keeps the n x n triangular factor of all rows seen so far and updates it
+ * with Givens rotations, so adding or removing a row costs O(n^2) instead
+ * of a full refactorization.
+ */
+typedef struct NumenQRStream NumenQRStream;
+
+/**
+ * @brief Create incremental least-squares fit
+ * @param n Number of coefficients
+ * @param forgetting Weight in (0, 1] applied to earlier rows on each add,
+ *        1 keeps every observation, smaller values down-weight old rows
+ *        exponentially but never drop them
+ *
+ * @note For a fixed-width window use forgetting 1 and
+ *       numen_qr_stream_remove() on the row leaving the window
+ * @param[out] out_stream Pointer to store created fit
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_qr_stream_create(size_t n,
+                           double_t forgetting,
+                           NumenQRStream **out_stream);
+
+/**
+ * @brief Free incremental fit
+ * @param stream Fit to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_qr_stream_free(NumenQRStream *stream);
+
+/**
+ * @brief Forget every observation
+ * @param stream Fit to reset
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_qr_stream_reset(NumenQRStream *stream);
+
+/**
+ * @brief Add one observation row * x = y
+ * @param stream Fit to update
+ * @param row Vector of n regressors
+ * @param y Observed value
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_qr_stream_add(NumenQRStream *stream, const Vector *row, double_t y);
+
+/**
+ * @brief Remove an observation previously added with numen_qr_stream_add()
+ * @param stream Fit to update
+ * @param row Vector of n regressors, as added
+ * @param y Observed value, as added
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Downdates the factor with the LINPACK dchdd rotations, O(n^2)
+ * @note Returns VECTOR_ERROR_MATH and leaves the fit unchanged if the
+ *       remaining rows no longer determine every coefficient
+ * @note The row is removed with unit weight, so with forgetting below 1
+ *       the caller must scale it by the weight it has decayed to
+ */
+int numen_qr_stream_remove(NumenQRStream *stream,
+                           const Vector *row,
+                           double_t y);
+
+/**
+ * @brief Current least-squares coefficients
+ * @param stream Fit to solve
+ * @param[out] x Vector of size n to store coefficients
+ * @param[out] out_rss Pointer to store residual sum of squares (can be NULL)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_MATH until the observations determine every
+ *       coefficient
+ */
+int numen_qr_stream_solve(const NumenQRStream *stream,
+                          Vector *x,
+                          double_t *out_rss);
+
+// Section: Triangular Systems
+
+/**
+ * @brief Solve t * x = b for triangular t
+ * @param t Square triangular matrix, the other triangle is ignored
+ * @param lower true if t is lower triangular, false if upper
+ * @param unit_diag true to assume ones on the diagonal
+ * @param b Right-hand side
+ * @param[out] x Vector to store solution, may be b itself
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_MATH on a zero diagonal element
+ */
+int matrix_solve_triangular(const Matrix *t,
+                            bool lower,
+                            bool unit_diag,
+                            const Vector *b,
+                            Vector *x);
+
+#endif // !__LINALG_H
@@ -0,0 +1,203 @@
+/**
+ * @file mask.h
+ * @brief Comparison bitmasks and masked element-wise operations
+ * @date 18/10/26
+ */
+
+#ifndef __MASK_H
+#define __MASK_H
+
+#include "vector.h"
+
+/**
+ * @brief Compact bitmask with one bit per vector element
+ *
+ * Element i maps to bit (i % 64) of word (i / 64). Bits past size in the
+ * last word are always kept clear.
+ */
+typedef struct {
+    uint64_t *bits; ///< Packed mask words
+    size_t size; ///< Number of elements covered by mask
+} VectorMask;
+
+/**
+ * @brief How vector_div_checked() treats zero divisors
+ */
+typedef enum {
+    VECTOR_DIV_IEEE = 0, ///< Leave IEEE 754 results (+-inf or nan) in place
+    VECTOR_DIV_SUBSTITUTE, ///< Overwrite zero-divisor positions with a value
+    VECTOR_DIV_STRICT ///< Fail before writing anything if any divisor is zero
+} VectorDivPolicy;
+
+// Section: Memory management
+
+/**
+ * @brief Create a new all-clear mask
+ * @param size Number of elements covered by mask
+ * @param[out] out_mask Pointer to receive newly created mask
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned mask and must free it with vector_mask_free()
+ */
+int vector_mask_create(size_t size, VectorMask **out_mask);
+
+/**
+ * @brief Free memory allocated by mask
+ * @param mask Mask to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_mask_free(VectorMask *mask);
+
+/**
+ * @brief Get mask bit at specified index
+ * @param mask Mask to access
+ * @param index Index of element
+ * @param[out] out_val Pointer to receive bit value
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_mask_get(const VectorMask *mask, size_t index, bool *out_val);
+
+// Section: Comparisons
+
+/**
+ * @brief Element-wise comparison (mask[i] = a[i] < b[i])
+ * @param a First operand
+ * @param b Second operand
+ * @param[out] mask Mask to store result (same size as a)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_cmp_lt(const Vector *a, const Vector *b, VectorMask *mask);
+
+/**
+ * @brief Element-wise comparison (mask[i] = a[i] > b[i])
+ * @param a First operand
+ * @param b Second operand
+ * @param[out] mask Mask to store result (same size as a)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_cmp_gt(const Vector *a, const Vector *b, VectorMask *mask);
+
+/**
+ * @brief Element-wise comparison (mask[i] = a[i] == b[i])
+ * @param a First operand
+ * @param b Second operand
+ * @param[out] mask Mask to store result (same size as a)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_cmp_eq(const Vector *a, const Vector *b, VectorMask *mask);
+
+/**
+ * @brief Compare against scalar (mask[i] = a[i] < scalar)
+ * @param a Vector to compare
+ * @param scalar Value to compare against
+ * @param[out] mask Mask to store result (same size as a)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_cmp_lt_scalar(const Vector *a, double_t scalar, VectorMask *mask);
+
+/**
+ * @brief Compare against scalar (mask[i] = a[i] > scalar)
+ * @param a Vector to compare
+ * @param scalar Value to compare against
+ * @param[out] mask Mask to store result (same size as a)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_cmp_gt_scalar(const Vector *a, double_t scalar, VectorMask *mask);
+
+/**
+ * @brief Compare against scalar (mask[i] = a[i] == scalar)
+ * @param a Vector to compare
+ * @param scalar Value to compare against
+ * @param[out] mask Mask to store result (same size as a)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_cmp_eq_scalar(const Vector *a, double_t scalar, VectorMask *mask);
+
+// Section: Masked Operations
+
+/**
+ * @brief Per-element selection (result[i] = mask[i] ? a[i] : b[i])
+ * @param mask Selection mask
+ * @param a Values taken where mask is set
+ * @param b Values taken where mask is clear
+ * @param[out] result Vector to store result
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_select(const VectorMask *mask,
+                  const Vector *a,
+                  const Vector *b,
+                  Vector *result);
+
+/**
+ * @brief Masked addition (result[i] = mask[i] ? a[i] + b[i] : a[i])
+ * @param a First operand
+ * @param b Second operand
+ * @param mask Elements to update
+ * @param[out] result Vector to store result
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_masked_add(const Vector *a,
+                      const Vector *b,
+                      const VectorMask *mask,
+                      Vector *result);
+
+/**
+ * @brief Masked scaling (result[i] = mask[i] ? a[i] * scaler : a[i])
+ * @param a Vector to scale
+ * @param scaler Scaling factor
+ * @param mask Elements to update
+ * @param[out] result Vector to store result
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_masked_scale(const Vector *a,
+                        double_t scaler,
+                        const VectorMask *mask,
+                        Vector *result);
+
+/**
+ * @brief Count set bits of mask
+ * @param mask Mask to count
+ * @param[out] count Pointer to store number of set elements
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_count_where(const VectorMask *mask, size_t *count);
+
+/**
+ * @brief Stream compaction, keep elements of a where mask is set
+ * @param a Source vector
+ * @param mask Elements to keep
+ * @param[out] result Vector to store kept elements in order
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note result is resized to the number of set bits and may be a itself
+ */
+int vector_compress(const Vector *a, const VectorMask *mask, Vector *result);
+
+// Section: Checked Arithmetic
+
+/**
+ * @brief Element-wise division with zero-divisor reporting (result = a / b)
+ * @param a Dividend
+ * @param b Divisor
+ * @param policy Treatment of zero divisors
+ * @param substitute Value written where b[i] is zero (VECTOR_DIV_SUBSTITUTE)
+ * @param[out] result Vector to store result, may be a or b
+ * @param[out] zero_mask Optional mask receiving zero-divisor positions
+ * @param[out] zero_count Optional pointer to store number of zero divisors
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The whole vector is divided at full SIMD width, zero divisors are
+ *       detected with a branch-free compare and patched afterwards
+ * @note With VECTOR_DIV_STRICT, returns VECTOR_ERROR_MATH and leaves result
+ *       untouched if any divisor is zero; zero_mask and zero_count are
+ *       still filled in
+ */
+int vector_div_checked(const Vector *a,
+                       const Vector *b,
+                       VectorDivPolicy policy,
+                       double_t substitute,
+                       Vector *result,
+                       VectorMask *zero_mask,
+                       size_t *zero_count);
+
+#endif // !__MASK_H
@@ -0,0 +1,250 @@
+/**
+ * @file matrix.h
+ * @brief Dense row-major matrices
+ * @date 18/10/26
+ */
+
+#ifndef __MATRIX_H
+#define __MATRIX_H
+
+#include "mask.h"
+#include "vector.h"
+
+#define MATRIX_BATCH_SMALL_MAX 4 ///< Largest dimension of batched small-matrix operations
+
+/**
+ * @brief Dense matrix stored row-major in one array
+ *
+ * Element (i, j) lives at elements[i * cols + j]. The matrix owns its
+ * elements array and is responsible for freeing it.
+ */
+typedef struct {
+    double_t *elements; ///< rows * cols elements, row-major
+    size_t rows; ///< Number of rows
+    size_t cols; ///< Number of columns
+} Matrix;
+
+/**
+ * @brief Many small matrices of one shape, interleaved element by element
+ *
+ * Element (i, j) of matrix k lives at elements[(i * cols + j) * count + k],
+ * so one element of every matrix is contiguous and kernels vectorize across
+ * matrices rather than within one (structure of arrays).
+ */
+typedef struct {
+    double_t *elements; ///< rows * cols * count elements
+    size_t rows; ///< Rows of each matrix
+    size_t cols; ///< Columns of each matrix
+    size_t count; ///< Number of matrices
+} MatrixBatch;
+
+// Section: Validation
+
+/**
+ * @brief Check if matrix is valid (non-NULL with allocated elements)
+ * @param matrix Matrix to check
+ * @return true if valid, false otherwise
+ */
+bool matrix_valid(const Matrix *matrix);
+
+// Section: Initialization
+
+/**
+ * @brief Create a zero-initialized matrix
+ * @param rows Number of rows
+ * @param cols Number of columns
+ * @param[out] out_matrix Pointer to receive newly created matrix
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned matrix and must free it with matrix_free()
+ */
+int matrix_create(size_t rows, size_t cols, Matrix **out_matrix);
+
+/**
+ * @brief Create an identity matrix
+ * @param size Number of rows and columns
+ * @param[out] out_matrix Pointer to receive newly created matrix
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned matrix and must free it with matrix_free()
+ */
+int matrix_create_identity(size_t size, Matrix **out_matrix);
+
+/**
+ * @brief Create matrix from a row-major C array
+ * @param arr Source array of rows * cols elements
+ * @param rows Number of rows
+ * @param cols Number of columns
+ * @param[out] out_matrix Pointer to receive newly created matrix
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned matrix and must free it with matrix_free()
+ */
+int matrix_from_array(const double_t *arr,
+                      size_t rows,
+                      size_t cols,
+                      Matrix **out_matrix);
+
+/**
+ * @brief Copy contents of one matrix into another of the same shape
+ * @param src Source matrix
+ * @param[out] dest Destination matrix
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int matrix_copy(const Matrix *src, Matrix *dest);
+
+/**
+ * @brief Free memory allocated by matrix
+ * @param matrix Matrix to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int matrix_free(Matrix *matrix);
+
+/**
+ * @brief Create a zero-initialized batch of matrices
+ * @param rows Rows of each matrix
+ * @param cols Columns of each matrix
+ * @param count Number of matrices
+ * @param[out] out_batch Pointer to receive newly created batch
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned batch and must free it with matrix_batch_free()
+ */
+int matrix_batch_create(size_t rows,
+                        size_t cols,
+                        size_t count,
+                        MatrixBatch **out_batch);
+
+/**
+ * @brief Free memory allocated by a matrix batch
+ * @param batch Batch to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int matrix_batch_free(MatrixBatch *batch);
+
+// Section: Element Access
+
+/**
+ * @brief Get element at (row, col)
+ * @param matrix Matrix to read
+ * @param row Row index
+ * @param col Column index
+ * @param[out] out_val Pointer to store value
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int matrix_get(const Matrix *matrix,
+               size_t row,
+               size_t col,
+               double_t *out_val);
+
+/**
+ * @brief Set element at (row, col)
+ * @param matrix Matrix to modify
+ * @param row Row index
+ * @param col Column index
+ * @param val Value to store
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int matrix_set(Matrix *matrix, size_t row, size_t col, double_t val);
+
+// Section: Layout
+
+/**
+ * @brief Transpose matrix out of place
+ * @param a Matrix to transpose
+ * @param[out] result Matrix of shape cols x rows to store transpose
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Works tile by tile so both source and destination stay in cache
+ */
+int matrix_transpose(const Matrix *a, Matrix *result);
+
+/**
+ * @brief Transpose square matrix in place
+ * @param matrix Square matrix to transpose
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int matrix_transpose_inplace(Matrix *matrix);
+
+// Section: Products
+
+/**
+ * @brief Matrix product (result = a * b)
+ * @param a Left matrix (m x k)
+ * @param b Right matrix (k x n)
+ * @param[out] result Matrix of shape m x n to store product
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Cache-blocked, large products run on the worker pool
+ * @note result must not alias a or b
+ */
+int matrix_mult(const Matrix *a, const Matrix *b, Matrix *result);
+
+/**
+ * @brief Matrix-vector product (result = a * x)
+ * @param a Matrix (m x n)
+ * @param x Vector of size n
+ * @param[out] result Vector of size m to store product
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note result must not alias x
+ */
+int matrix_mult_vector(const Matrix *a, const Vector *x, Vector *result);
+
+// Section: Batched Small Matrices
+
+/**
+ * @brief Determinants of a batch of square matrices
+ * @param a Batch of 1x1 to 4x4 matrices
+ * @param[out] det Vector of a->count elements to store determinants
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Closed-form expansion per size, each step runs across matrices
+ *       in SIMD lanes and large batches are split over the worker pool
+ */
+int matrix_batch_det(const MatrixBatch *a, Vector *det);
+
+/**
+ * @brief Inverses of a batch of square matrices
+ * @param a Batch of 1x1 to 4x4 matrices
+ * @param[out] inverse Batch of a's shape to store inverses, may be a itself
+ * @param[out] singular Optional mask of a->count bits, set for matrices
+ *             with zero or non-finite determinant
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Adjugate over determinant, no pivoting; suited to well-conditioned
+ *       transforms rather than general systems
+ * @note Returns VECTOR_ERROR_MATH if any matrix is singular, the inverse
+ *       of a singular matrix is all zeros and the others are still filled
+ */
+int matrix_batch_inverse(const MatrixBatch *a,
+                         MatrixBatch *inverse,
+                         VectorMask *singular);
+
+/**
+ * @brief Matrix products of two batches (result[k] = a[k] * b[k])
+ * @param a Batch of m x n matrices, dimensions at most 4
+ * @param b Batch of n x p matrices with a's count
+ * @param[out] result Batch of m x p matrices with a's count
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note result must not alias a or b
+ */
+int matrix_batch_mult(const MatrixBatch *a,
+                      const MatrixBatch *b,
+                      MatrixBatch *result);
+
+/**
+ * @brief Matrix-vector products of two batches (result[k] = a[k] * x[k])
+ * @param a Batch of m x n matrices, dimensions at most 4
+ * @param x Batch of n x 1 column vectors with a's count
+ * @param[out] result Batch of m x 1 column vectors with a's count
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note result must not alias a or x
+ */
+int matrix_batch_mult_vector(const MatrixBatch *a,
+                             const MatrixBatch *x,
+                             MatrixBatch *result);
+
+#endif // !__MATRIX_H
@@ -0,0 +1,242 @@
+/**
+ * @file ndarray.h
+ * @brief N-dimensional strided arrays with views and broadcasting
+ * @date 18/10/26
+ */
+
+#ifndef __NDARRAY_H
+#define __NDARRAY_H
+
+#include "matrix.h"
+
+#define NDARRAY_MAX_DIMS 8 ///< Largest number of dimensions
+
+/**
+ * @brief N-dimensional array of doubles described by shape and strides
+ *
+ * Element (i0, ..., in) lives at data[i0 * strides[0] + ... + in *
+ * strides[n]]. Strides count elements and may be zero (broadcast) or
+ * negative (reversed). Arrays from ndarray_create() own their elements;
+ * views returned by the reshape, transpose, slice and broadcast functions
+ * are plain values that borrow the elements of their source, which must
+ * outlive them.
+ */
+typedef struct {
+    double_t *data; ///< Address of element (0, ..., 0)
+    size_t ndim; ///< Number of dimensions, 1 to NDARRAY_MAX_DIMS
+    size_t shape[NDARRAY_MAX_DIMS]; ///< Extent of each dimension
+    ptrdiff_t strides[NDARRAY_MAX_DIMS]; ///< Element step of each dimension
+    double_t *owned; ///< Allocation owned by this array, NULL for views
+} NdArray;
+
+// Section: Validation
+
+/**
+ * @brief Check if array is valid (non-NULL with elements and dimensions)
+ * @param array Array to check
+ * @return true if valid, false otherwise
+ */
+bool ndarray_valid(const NdArray *array);
+
+/**
+ * @brief Check if array is laid out contiguously in row-major order
+ * @param array Array to check
+ * @return true if contiguous, false otherwise
+ */
+bool ndarray_contiguous(const NdArray *array);
+
+/**
+ * @brief Number of elements (product of the shape)
+ * @param array Array to measure
+ * @return Element count, 0 for an invalid array
+ */
+size_t ndarray_size(const NdArray *array);
+
+// Section: Initialization
+
+/**
+ * @brief Create a zero-initialized contiguous array
+ * @param ndim Number of dimensions, 1 to NDARRAY_MAX_DIMS
+ * @param shape Array of ndim extents, all non-zero
+ * @param[out] out_array Pointer to receive newly created array
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned array and must free it with ndarray_free()
+ */
+int ndarray_create(size_t ndim, const size_t *shape, NdArray **out_array);
+
+/**
+ * @brief Free an array from ndarray_create()
+ * @param array Array to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Views are plain values and are not freed
+ */
+int ndarray_free(NdArray *array);
+
+/**
+ * @brief One-dimensional view of a vector's elements
+ * @param vector Vector to view
+ * @param[out] out_view Array to receive the view
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The view is invalidated if the vector is resized
+ */
+int ndarray_from_vector(const Vector *vector, NdArray *out_view);
+
+/**
+ * @brief Two-dimensional view of a matrix's elements
+ * @param matrix Matrix to view
+ * @param[out] out_view Array to receive the view
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int ndarray_from_matrix(const Matrix *matrix, NdArray *out_view);
+
+// Section: Element Access
+
+/**
+ * @brief Get element at a multi-index
+ * @param array Array to access
+ * @param index Array of array->ndim indices
+ * @param[out] out_val Pointer to receive value
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_INDEX if any index is out of range
+ */
+int ndarray_get(const NdArray *array, const size_t *index, double_t *out_val);
+
+/**
+ * @brief Set element at a multi-index
+ * @param array Array to modify
+ * @param index Array of array->ndim indices
+ * @param val Value to store
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_INDEX if any index is out of range
+ */
+int ndarray_set(NdArray *array, const size_t *index, double_t val);
+
+// Section: Views
+
+/**
+ * @brief View with a new shape and the same elements in row-major order
+ * @param array Array to reshape
+ * @param ndim Number of dimensions of the view
+ * @param shape Array of ndim extents with the same product as array's
+ * @param[out] out_view Array to receive the view
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_INVALID_ARG if the strides of array cannot
+ *       express the new shape without a copy, see ndarray_copy()
+ */
+int ndarray_reshape(const NdArray *array,
+                    size_t ndim,
+                    const size_t *shape,
+                    NdArray *out_view);
+
+/**
+ * @brief View with permuted dimensions
+ * @param array Array to transpose
+ * @param axes Array of array->ndim distinct dimensions, dimension i of
+ *        the view is dimension axes[i] of array; NULL reverses them
+ * @param[out] out_view Array to receive the view
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int ndarray_transpose(const NdArray *array,
+                      const size_t *axes,
+                      NdArray *out_view);
+
+/**
+ * @brief View of a strided range along one dimension
+ * @param array Array to slice
+ * @param axis Dimension to slice
+ * @param start First index taken
+ * @param stop Index one past the range for positive steps, one before it
+ *        for negative steps (may be -1)
+ * @param step Index increment, non-zero, negative to reverse
+ * @param[out] out_view Array to receive the view
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_SIZE for an empty range
+ */
+int ndarray_slice(const NdArray *array,
+                  size_t axis,
+                  ptrdiff_t start,
+                  ptrdiff_t stop,
+                  ptrdiff_t step,
+                  NdArray *out_view);
+
+/**
+ * @brief View broadcast to a larger shape without copying
+ * @param array Array to broadcast
+ * @param ndim Number of dimensions of the view, at least array->ndim
+ * @param shape Target extents
+ * @param[out] out_view Array to receive the view
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Follows NumPy rules: shapes are aligned at the last dimension and
+ *       extents of 1 stretch with stride 0, otherwise returns
+ *       VECTOR_ERROR_SIZE
+ */
+int ndarray_broadcast_to(const NdArray *array,
+                         size_t ndim,
+                         const size_t *shape,
+                         NdArray *out_view);
+
+// Section: Element-wise Operations
+
+/**
+ * @brief Copy elements, broadcasting src to dest's shape
+ * @param src Array to read
+ * @param[out] dest Array to write, of any layout
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int ndarray_copy(const NdArray *src, NdArray *dest);
+
+/**
+ * @brief Set every element
+ * @param[out] array Array to fill
+ * @param val Value to store
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int ndarray_fill(NdArray *array, double_t val);
+
+/**
+ * @brief Element-wise sum with broadcasting (result = a + b)
+ * @param a First operand
+ * @param b Second operand
+ * @param[out] result Array with the broadcast shape of a and b
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Operands are broadcast in place through zero strides, nothing is
+ *       materialized. Dimensions that are contiguous in every operand are
+ *       merged, so the innermost loop runs over as many elements as
+ *       possible with unit strides (or a scalar operand) where it
+ *       vectorizes. Large arrays are split over the worker pool.
+ * @note result may be a or b itself, other overlaps are undefined
+ * @note Returns VECTOR_ERROR_SIZE if the shapes do not broadcast to
+ *       result's shape
+ */
+int ndarray_add(const NdArray *a, const NdArray *b, NdArray *result);
+
+/**
+ * @brief Element-wise difference with broadcasting (result = a - b)
+ * @see ndarray_add() for parameters
+ */
+int ndarray_sub(const NdArray *a, const NdArray *b, NdArray *result);
+
+/**
+ * @brief Element-wise product with broadcasting (result = a * b)
+ * @see ndarray_add() for parameters
+ */
+int ndarray_mult(const NdArray *a, const NdArray *b, NdArray *result);
+
+/**
+ * @brief Element-wise quotient with broadcasting (result = a / b)
+ * @see ndarray_add() for parameters
+ *
+ * @note Division by zero gives IEEE 754 results
+ */
+int ndarray_div(const NdArray *a, const NdArray *b, NdArray *result);
+
+#endif // !__NDARRAY_H
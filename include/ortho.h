@@ -0,0 +1,79 @@
+/**
+ * @file ortho.h
+ * @brief Orthonormalization of vector sets
+ * @date 18/10/26
+ */
+
+#ifndef __ORTHO_H
+#define __ORTHO_H
+
+#include "matrix.h"
+
+/**
+ * @brief Orthonormalization algorithm
+ */
+typedef enum {
+    NUMEN_ORTHO_GRAM_SCHMIDT = 0, ///< Blocked Gram-Schmidt, rank revealing
+    NUMEN_ORTHO_CHOLQR ///< CholQR2, fastest for well-conditioned full-rank sets
+} NumenOrthoMethod;
+
+// Section: Vector sets
+
+/**
+ * @brief Orthonormalize vectors in place, in order
+ * @param[in,out] vectors Array of count vectors of equal size
+ * @param count Number of vectors
+ * @param method Algorithm to use
+ * @param[out] out_rank Optional pointer to receive the number of
+ *             independent vectors
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Vector i ends up in the span of vectors 0..i, as in classical
+ *       Gram-Schmidt
+ * @note Gram-Schmidt projects each block of 32 vectors against all
+ *       earlier ones with two matrix products (block classical
+ *       Gram-Schmidt, reorthogonalized), then runs modified Gram-Schmidt
+ *       inside the block, repeated once for vectors that lose more than
+ *       half their norm. Vectors dependent on earlier ones are set to zero.
+ * @note CholQR factors the Gram matrix of the set with Cholesky and
+ *       applies the inverse factor, twice. It falls back to Gram-Schmidt
+ *       on the original vectors when a pivot is negligible against its
+ *       vector's squared norm (a numerically dependent set) or when the
+ *       result is not unit length.
+ */
+int vector_orthonormalize(Vector *const *vectors,
+                          size_t count,
+                          NumenOrthoMethod method,
+                          size_t *out_rank);
+
+/**
+ * @brief Remove the components of v along an orthonormal basis
+ * @param basis Array of count orthonormal vectors of v's size
+ * @param count Number of basis vectors
+ * @param[in,out] v Vector to orthogonalize
+ * @param[out] coefficients Optional vector of count elements to receive
+ *             the components that were removed
+ * @param[out] out_norm Optional pointer to receive the norm of the result
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note All coefficients come from one sweep over the basis and the
+ *       update from a second, instead of one pass per basis vector. The
+ *       projection is repeated once if v loses more than half its norm.
+ */
+int vector_orthogonalize(const Vector *const *basis,
+                         size_t count,
+                         Vector *v,
+                         Vector *coefficients,
+                         double_t *out_norm);
+
+// Section: Matrix columns
+
+/**
+ * @brief Orthonormalize the columns of a matrix in place
+ * @see vector_orthonormalize()
+ */
+int matrix_orthonormalize(Matrix *a,
+                          NumenOrthoMethod method,
+                          size_t *out_rank);
+
+#endif // !__ORTHO_H
@@ -0,0 +1,182 @@
+/**
+ * @file quaternion.h
+ * @brief Quaternion rotations and batched point rotation
+ * @date 18/10/26
+ */
+
+#ifndef __QUATERNION_H
+#define __QUATERNION_H
+
+#include "batch.h"
+#include "vector.h"
+
+/**
+ * @brief Quaternion w + xi + yj + zk
+ */
+typedef struct {
+    double_t w; ///< Scalar part
+    double_t x; ///< I component
+    double_t y; ///< J component
+    double_t z; ///< K component
+} Quaternion;
+
+/**
+ * @brief Batch of quaternions stored as separate component arrays (SoA)
+ */
+typedef struct {
+    double_t *w; ///< Scalar parts
+    double_t *x; ///< I components
+    double_t *y; ///< J components
+    double_t *z; ///< K components
+    size_t count; ///< Number of quaternions in batch
+} QuatBatch;
+
+// Section: Construction
+
+/**
+ * @brief Create rotation quaternion from axis and angle
+ * @param ax X component of rotation axis
+ * @param ay Y component of rotation axis
+ * @param az Z component of rotation axis
+ * @param angle Rotation angle in radians
+ * @param[out] out_quat Pointer to receive unit quaternion
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The axis does not need to be normalized
+ * @note Returns VECTOR_ERROR_MATH if axis has zero length
+ */
+int quaternion_from_axis_angle(double_t ax,
+                               double_t ay,
+                               double_t az,
+                               double_t angle,
+                               Quaternion *out_quat);
+
+/**
+ * @brief Create a batch of identity quaternions
+ * @param count Number of quaternions in batch
+ * @param[out] out_batch Pointer to receive newly created batch
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned batch and must free it with quat_batch_free()
+ */
+int quat_batch_create(size_t count, QuatBatch **out_batch);
+
+/**
+ * @brief Free memory allocated by a quaternion batch
+ * @param batch Batch to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int quat_batch_free(QuatBatch *batch);
+
+// Section: Quaternion Operations
+
+/**
+ * @brief Hamilton product (result = a * b)
+ * @param a First operand
+ * @param b Second operand
+ * @param[out] result Quaternion to store result
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Applying the result rotates by b first, then by a
+ */
+int quaternion_multiply(const Quaternion *a,
+                        const Quaternion *b,
+                        Quaternion *result);
+
+/**
+ * @brief Conjugate of quaternion (result = w - xi - yj - zk)
+ * @param q Quaternion to conjugate
+ * @param[out] result Quaternion to store result
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int quaternion_conjugate(const Quaternion *q, Quaternion *result);
+
+/**
+ * @brief Normalize quaternion in-place (make unit length)
+ * @param q Quaternion to normalize
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_MATH if quaternion has zero length
+ */
+int quaternion_normalize(Quaternion *q);
+
+/**
+ * @brief Spherical linear interpolation between two rotations
+ * @param a Start quaternion (should be normalized)
+ * @param b End quaternion (should be normalized)
+ * @param t Interpolation factor (0=a, 1=b)
+ * @param[out] result Quaternion to store interpolated result
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Always takes the shortest arc between the two rotations
+ * @note Falls back to normalized linear interpolation if nearly parallel
+ */
+int quaternion_slerp(const Quaternion *a,
+                     const Quaternion *b,
+                     double_t t,
+                     Quaternion *result);
+
+/**
+ * @brief Convert quaternion to 3x3 rotation matrix
+ * @param q Quaternion to convert
+ * @param[out] out_mat Array of 9 elements to receive row-major matrix
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Non-unit quaternions are implicitly normalized
+ * @note Returns VECTOR_ERROR_MATH if quaternion has zero length
+ */
+int quaternion_to_mat3(const Quaternion *q, double_t out_mat[9]);
+
+/**
+ * @brief Convert quaternion to 4x4 homogeneous rotation matrix
+ * @param q Quaternion to convert
+ * @param[out] out_mat Array of 16 elements to receive row-major matrix
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Non-unit quaternions are implicitly normalized
+ * @note Returns VECTOR_ERROR_MATH if quaternion has zero length
+ */
+int quaternion_to_mat4(const Quaternion *q, double_t out_mat[16]);
+
+// Section: Rotation
+
+/**
+ * @brief Rotate a single 3D vector
+ * @param q Rotation quaternion
+ * @param v Vector to rotate (must be 3D)
+ * @param[out] result Vector to store result (must be 3D)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int quaternion_rotate_vector(const Quaternion *q,
+                             const Vector *v,
+                             Vector *result);
+
+/**
+ * @brief Rotate every point of a batch by one quaternion
+ * @param q Rotation quaternion
+ * @param points Points to rotate
+ * @param[out] result Batch to store rotated points
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The quaternion is converted to a matrix once, so it need not be unit
+ * @note result may be the same batch as points
+ */
+int quaternion_rotate_points(const Quaternion *q,
+                             const Vec3Batch *points,
+                             Vec3Batch *result);
+
+/**
+ * @brief Rotate point i of a batch by quaternion i
+ * @param q Rotation quaternions (should be normalized)
+ * @param points Points to rotate
+ * @param[out] result Batch to store rotated points
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note All three batches must have the same count
+ * @note result may be the same batch as points
+ */
+int quaternion_rotate_points_each(const QuatBatch *q,
+                                  const Vec3Batch *points,
+                                  Vec3Batch *result);
+
+#endif // !__QUATERNION_H
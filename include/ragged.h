@@ -0,0 +1,190 @@
+/**
+ * @file ragged.h
+ * @brief Collections of variable-length vectors packed into one buffer
+ * @date 18/10/26
+ */
+
+#ifndef __RAGGED_H
+#define __RAGGED_H
+
+#include "vector.h"
+
+/**
+ * @brief Variable-length vectors stored back to back (CSR layout)
+ *
+ * Segment i holds values[offsets[i]] up to values[offsets[i + 1]], so a
+ * collection costs two allocations however many segments it holds, and
+ * batched kernels stream through it in order.
+ */
+typedef struct {
+    double_t *values; ///< Elements of all segments, back to back
+    size_t *offsets; ///< count + 1 segment starts, offsets[0] is 0
+    size_t count; ///< Number of segments
+    size_t values_capacity; ///< Allocated elements in values
+    size_t count_capacity; ///< Segments offsets has room for
+} RaggedVectors;
+
+// Section: Validation
+
+/**
+ * @brief Check if a ragged collection is valid
+ * @param ragged Collection to check
+ * @return true if ragged and its buffers are allocated
+ */
+bool ragged_valid(const RaggedVectors *ragged);
+
+// Section: Initialization
+
+/**
+ * @brief Create an empty collection
+ * @param values_capacity Elements to reserve
+ * @param count_capacity Segments to reserve
+ * @param[out] out_ragged Pointer to receive newly created collection
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller owns the returned collection and must free it with
+ *       ragged_free()
+ */
+int ragged_create(size_t values_capacity,
+                  size_t count_capacity,
+                  RaggedVectors **out_ragged);
+
+/**
+ * @brief Create a collection of zeroed segments
+ * @param lengths Length of each segment, zero allowed
+ * @param count Number of segments
+ * @param[out] out_ragged Pointer to receive newly created collection
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Offsets come from one prefix sum and values from one allocation,
+ *       segments are then filled in place through ragged_segment_data()
+ */
+int ragged_from_lengths(const size_t *lengths,
+                        size_t count,
+                        RaggedVectors **out_ragged);
+
+/**
+ * @brief Pack separately allocated vectors into one collection
+ * @param vectors Array of count vectors, sizes may differ
+ * @param count Number of vectors
+ * @param[out] out_ragged Pointer to receive newly created collection
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Large collections are copied on the worker pool
+ */
+int ragged_from_vectors(const Vector *const *vectors,
+                        size_t count,
+                        RaggedVectors **out_ragged);
+
+/**
+ * @brief Free memory allocated by a collection
+ * @param ragged Collection to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int ragged_free(RaggedVectors *ragged);
+
+// Section: Building
+
+/**
+ * @brief Append one segment
+ * @param ragged Collection to extend
+ * @param values Elements of the segment, may be NULL if length is 0
+ * @param length Number of elements
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Buffers grow geometrically, so appends are amortized O(length)
+ */
+int ragged_append(RaggedVectors *ragged,
+                  const double_t *values,
+                  size_t length);
+
+/**
+ * @brief Append many segments already laid out back to back
+ * @param ragged Collection to extend
+ * @param values Elements of all new segments, in order, may point into
+ *        ragged's own elements
+ * @param lengths Length of each new segment
+ * @param count Number of new segments
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Grows each buffer at most once and copies values in one pass
+ */
+int ragged_append_segments(RaggedVectors *ragged,
+                           const double_t *values,
+                           const size_t *lengths,
+                           size_t count);
+
+// Section: Access
+
+/**
+ * @brief Read-only view of one segment
+ * @param ragged Collection to access
+ * @param index Segment index
+ * @param[out] out_view View to fill
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The view is invalidated by appends that grow the collection
+ */
+int ragged_segment(const RaggedVectors *ragged,
+                   size_t index,
+                   VectorView *out_view);
+
+/**
+ * @brief Mutable pointer to the elements of one segment
+ * @param ragged Collection to access
+ * @param index Segment index
+ * @param[out] out_data Pointer to receive the first element
+ * @param[out] out_length Pointer to receive the segment length
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int ragged_segment_data(RaggedVectors *ragged,
+                        size_t index,
+                        double_t **out_data,
+                        size_t *out_length);
+
+// Section: Segment Reductions
+
+/**
+ * @brief Sum of each segment
+ * @param ragged Collection to reduce
+ * @param[out] result Vector of ragged->count elements
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Segments are split among tasks by element count plus a fixed
+ *       per-segment cost, and segments longer than 32768 elements are
+ *       reduced in chunks of that size spread over the tasks, so a few long
+ *       segments or millions of short ones both spread evenly
+ * @note Each chunk sums eight independent lanes combined in a fixed order
+ *       and chunk sums are added in segment order, so results do not
+ *       depend on the thread count
+ * @note Empty segments give 0
+ */
+int ragged_sum(const RaggedVectors *ragged, Vector *result);
+
+/**
+ * @brief Mean of each segment
+ * @see ragged_sum()
+ *
+ * @note Empty segments give 0
+ */
+int ragged_mean(const RaggedVectors *ragged, Vector *result);
+
+/**
+ * @brief Euclidean norm of each segment
+ * @see ragged_sum()
+ */
+int ragged_norm(const RaggedVectors *ragged, Vector *result);
+
+/**
+ * @brief Dot product of each segment with the leading elements of a query
+ * @param ragged Collection to reduce
+ * @param query Vector at least as long as the longest segment
+ * @param[out] result Vector of ragged->count elements
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ * @see ragged_sum()
+ */
+int ragged_dot(const RaggedVectors *ragged,
+               const Vector *query,
+               Vector *result);
+
+#endif // !__RAGGED_H
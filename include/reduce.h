@@ -0,0 +1,111 @@
+/**
+ * @file reduce.h
+ * @brief Reductions along one axis of matrices, arrays and vector batches
+ * @date 18/10/26
+ */
+
+#ifndef __REDUCE_H
+#define __REDUCE_H
+
+#include "matrix.h"
+#include "ndarray.h"
+
+/**
+ * @brief Reduction applied along an axis
+ *
+ * Minimum, maximum and argmax skip NaN elements like fmin() and fmax(),
+ * an output is NaN only if every element reduced into it is.
+ */
+typedef enum {
+    NUMEN_REDUCE_SUM,
+    NUMEN_REDUCE_MEAN,
+    NUMEN_REDUCE_MIN,
+    NUMEN_REDUCE_MAX,
+    NUMEN_REDUCE_NORM ///< Euclidean norm
+} NumenReduceOp;
+
+// Section: Arrays
+
+/**
+ * @brief Reduce an array along one axis
+ * @param array Array to reduce
+ * @param axis Dimension to reduce
+ * @param op Reduction to apply
+ * @param[out] result Array with the shape of array, the reduced
+ *        dimension either removed or kept with extent 1
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note When the dimensions after axis are contiguous, whole rows of them
+ *       are accumulated at once so reads stay sequential; otherwise each
+ *       output walks its own run along axis. Long axes are split into
+ *       chunks on the worker pool and the partial results are combined in
+ *       chunk order, so results do not depend on the thread count.
+ */
+int ndarray_reduce(const NdArray *array,
+                   size_t axis,
+                   NumenReduceOp op,
+                   NdArray *result);
+
+/**
+ * @brief Index of the maximum along one axis
+ * @param array Array to search
+ * @param axis Dimension to search
+ * @param[out] indices One index per remaining element, in row-major order
+ *        of the remaining dimensions
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Ties resolve to the lowest index
+ */
+int ndarray_argmax(const NdArray *array, size_t axis, size_t *indices);
+
+// Section: Matrices
+
+/**
+ * @brief Reduce a matrix down its columns (axis 0) or across its rows (axis 1)
+ * @param matrix Matrix to reduce
+ * @param axis 0 for one result per column, 1 for one per row
+ * @param op Reduction to apply
+ * @param[out] result Vector of matrix->cols (axis 0) or matrix->rows
+ *        (axis 1) elements
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int matrix_reduce(const Matrix *matrix,
+                  size_t axis,
+                  NumenReduceOp op,
+                  Vector *result);
+
+/**
+ * @brief Row index of each column's maximum (axis 0) or column index of
+ *        each row's maximum (axis 1)
+ * @see matrix_reduce() for parameters
+ */
+int matrix_argmax(const Matrix *matrix, size_t axis, size_t *indices);
+
+// Section: Vector Batches
+
+/**
+ * @brief Element-wise reduction across a batch of vectors
+ * @param vectors Array of count vectors of equal size
+ * @param count Number of vectors
+ * @param op Reduction to apply
+ * @param[out] result Vector of the same size, result[i] reduces element i
+ *        of every vector
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_batch_reduce(const Vector *const *vectors,
+                        size_t count,
+                        NumenReduceOp op,
+                        Vector *result);
+
+/**
+ * @brief Index of the vector holding the maximum of each element
+ * @param vectors Array of count vectors of equal size
+ * @param count Number of vectors
+ * @param[out] indices One index per element
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_batch_argmax(const Vector *const *vectors,
+                        size_t count,
+                        size_t *indices);
+
+#endif // !__REDUCE_H
@@ -0,0 +1,80 @@
+/**
+ * @file runtime.h
+ * @brief Worker pool configuration, thread placement and wake-up policy
+ * @date 18/10/26
+ */
+
+#ifndef __RUNTIME_H
+#define __RUNTIME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief How pool workers are pinned to CPUs
+ *
+ * Placement only considers CPUs the process may run on, so cgroup cpusets
+ * and taskset masks are respected. Pinning is only available on Linux and
+ * is ignored elsewhere.
+ */
+typedef enum {
+    NUMEN_AFFINITY_NONE = 0, ///< Let the OS schedule workers
+    NUMEN_AFFINITY_COMPACT, ///< Fill one cache domain before the next
+    NUMEN_AFFINITY_SCATTER, ///< Round-robin workers across cache domains
+    NUMEN_AFFINITY_LIST ///< Pin worker i to cpus[i % cpu_count]
+} NumenAffinity;
+
+/**
+ * @brief Worker pool configuration
+ */
+typedef struct {
+    size_t threads; ///< Worker threads, 0 for one per allowed CPU minus the caller
+    NumenAffinity affinity; ///< Pinning policy
+    const int *cpus; ///< CPU ids for NUMEN_AFFINITY_LIST
+    size_t cpu_count; ///< Number of entries in cpus
+    bool avoid_smt; ///< Pin at most one worker per physical core
+    uint32_t spin_us; ///< Busy-wait this long for work before parking, 0 to yield briefly
+    bool domain_partition; ///< Split parallel loops along L3/NUMA domains
+} NumenPoolConfig;
+
+/**
+ * @brief Fill configuration with defaults
+ * @param[out] config Configuration to initialize
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Defaults: one worker per allowed CPU minus one, no pinning, no
+ *       spinning, no domain partitioning
+ */
+int numen_pool_config_default(NumenPoolConfig *config);
+
+/**
+ * @brief Configure the worker pool
+ * @param config Configuration to apply
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Must be called before any pool work, returns VECTOR_ERROR_INIT once
+ *       the pool has started
+ * @note Returns VECTOR_ERROR_INVALID_ARG for NUMEN_AFFINITY_LIST without cpus
+ */
+int numen_pool_configure(const NumenPoolConfig *config);
+
+/**
+ * @brief Query number of threads that run pool work
+ * @param[out] out_threads Pointer to store workers plus the calling thread
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Starts the pool if it is not running yet
+ */
+int numen_pool_threads(size_t *out_threads);
+
+/**
+ * @brief Query number of cache domains the pool partitions work across
+ * @param[out] out_domains Pointer to store domain count
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Always 1 unless domain_partition is enabled
+ */
+int numen_pool_domains(size_t *out_domains);
+
+#endif // !__RUNTIME_H
@@ -0,0 +1,121 @@
+/**
+ * @file snapshot.h
+ * @brief Read-mostly vectors with lock-free snapshot reads
+ * @date 18/10/26
+ */
+
+#ifndef __SNAPSHOT_H
+#define __SNAPSHOT_H
+
+#include "vector.h"
+
+/**
+ * @brief Versioned vector published by writers and read through snapshots
+ *
+ * Readers never lock and never copy: they pin the current version and read
+ * it in place. Writers replace the whole version atomically, retired
+ * versions are freed once no reader can still hold them (epoch-based
+ * reclamation).
+ */
+typedef struct NumenSnapshot NumenSnapshot;
+
+/**
+ * @brief Per-thread reader registration for a snapshot vector
+ *
+ * A reader must only be used by one thread at a time.
+ */
+typedef struct NumenSnapshotReader NumenSnapshotReader;
+
+// Section: Handle
+
+/**
+ * @brief Create snapshot vector holding a copy of initial
+ * @param initial Contents of version 0
+ * @param[out] out_snapshot Pointer to store created handle
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_snapshot_create(const Vector *initial, NumenSnapshot **out_snapshot);
+
+/**
+ * @brief Free snapshot vector with every version it still holds
+ * @param snapshot Handle to free
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note No reader may be active
+ */
+int numen_snapshot_free(NumenSnapshot *snapshot);
+
+// Section: Writers
+
+/**
+ * @brief Publish a copy of source as the new version
+ * @param snapshot Handle to update
+ * @param source Contents of the new version
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The copy is made before publication, readers are never stalled
+ */
+int numen_snapshot_publish(NumenSnapshot *snapshot, const Vector *source);
+
+/**
+ * @brief Publish vector as the new version without copying
+ * @param snapshot Handle to update
+ * @param vector Vector to publish, ownership passes to the snapshot
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note On error the caller keeps ownership of vector
+ */
+int numen_snapshot_swap(NumenSnapshot *snapshot, Vector *vector);
+
+/**
+ * @brief Free retired versions no reader can still see
+ * @param snapshot Handle to clean up
+ * @param[out] out_pending Pointer to store versions still retired (can be NULL)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Publishing reclaims automatically, this is for idle writers
+ */
+int numen_snapshot_reclaim(NumenSnapshot *snapshot, size_t *out_pending);
+
+// Section: Readers
+
+/**
+ * @brief Register a reader
+ * @param snapshot Handle to read
+ * @param[out] out_reader Pointer to store reader
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_snapshot_reader_create(NumenSnapshot *snapshot,
+                                 NumenSnapshotReader **out_reader);
+
+/**
+ * @brief Unregister a reader
+ * @param reader Reader to release
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Releases any snapshot the reader still holds
+ */
+int numen_snapshot_reader_free(NumenSnapshotReader *reader);
+
+/**
+ * @brief Pin the current version
+ * @param reader Reader registration
+ * @param[out] out_vector Pointer to store the pinned, read-only vector
+ * @param[out] out_version Pointer to store version number (can be NULL)
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Lock-free. The vector stays valid until numen_snapshot_release()
+ * @note Returns VECTOR_ERROR_INIT if the reader already holds a snapshot
+ */
+int numen_snapshot_acquire(NumenSnapshotReader *reader,
+                           const Vector **out_vector,
+                           uint64_t *out_version);
+
+/**
+ * @brief Unpin the version held by reader
+ * @param reader Reader registration
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int numen_snapshot_release(NumenSnapshotReader *reader);
+
+#endif // !__SNAPSHOT_H
@@ -0,0 +1,63 @@
+/**
+ * @file sparse.h
+ * @brief Compressed sparse row matrices
+ * @date 18/10/26
+ */
+
+#ifndef __SPARSE_H
+#define __SPARSE_H
+
+#include "vector.h"
+
+/**
+ * @brief Sparse matrix in compressed sparse row (CSR) form
+ *
+ * The nonzeros of row i are values[offsets[i] .. offsets[i + 1]] in
+ * columns columns[offsets[i] .. offsets[i + 1]]. The arrays are borrowed,
+ * the caller keeps them alive and frees them.
+ */
+typedef struct {
+    const double_t *values; ///< Nonzero values, offsets[rows] entries
+    const size_t *columns; ///< Column of each nonzero
+    const size_t *offsets; ///< rows + 1 row start offsets, offsets[0] = 0
+    size_t rows; ///< Number of rows
+    size_t cols; ///< Number of columns
+} SparseMatrix;
+
+// Section: Validation
+
+/**
+ * @brief Check the structure of a sparse matrix
+ * @param matrix Matrix to check
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_INIT for missing arrays and decreasing
+ *       offsets, VECTOR_ERROR_INDEX for columns out of range
+ */
+int sparse_check(const SparseMatrix *matrix);
+
+// Section: Operations
+
+/**
+ * @brief Sparse matrix-vector product (y = a * x)
+ * @param a Sparse matrix
+ * @param x Vector of a->cols elements
+ * @param[out] y Vector of a->rows elements, must not be x
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Rows are split over the worker pool by nonzero count
+ * @note Checks a with sparse_check() on every call
+ */
+int sparse_mult_vector(const SparseMatrix *a, const Vector *x, Vector *y);
+
+/**
+ * @brief Extract the main diagonal
+ * @param a Square sparse matrix
+ * @param[out] diagonal Vector of a->rows elements, 0 where no entry is stored
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Duplicate diagonal entries are summed
+ */
+int sparse_diagonal(const SparseMatrix *a, Vector *diagonal);
+
+#endif // !__SPARSE_H
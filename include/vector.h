@@ -38,6 +38,14 @@ typedef struct {
     size_t capacity; ///< Currently allocated capacity of vector
 } Vector;
 
+/**
+ * @brief Read-only window onto elements owned by something else
+ */
+typedef struct {
+    const double_t *elements; ///< First element of the window
+    size_t size; ///< Number of elements in the window
+} VectorView;
+
 // Section: Validation
 
 /**
@@ -297,7 +305,9 @@ int vector_mult(const Vector *a, const Vector *b, Vector *result);
  * @param[out] result Vector to store result
  * @return VECTOR_SUCCESS on success, error code otherwise
  *
- * @note Returns VECTOR_ERROR_MATH if any element of b is zero
+ * @note Returns VECTOR_ERROR_MATH if any element of b is zero, result is
+ *       left untouched in that case
+ * @see vector_div_checked() for IEEE or substitute zero handling
  */
 int vector_div(const Vector *a, const Vector *b, Vector *result);
 
@@ -320,6 +330,19 @@ int vector_negate(const Vector *a, Vector *result);
  */
 int vector_dot(const Vector *a, const Vector *b, double_t *result);
 
+/**
+ * @brief Dot product of two vectors on the worker pool
+ * @param a First vector
+ * @param b Second vector
+ * @param[out] result Pointer to store dot product result
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Partial sums cover fixed-size chunks and are combined in order, so
+ *       the result is reproducible regardless of thread count
+ * @note Small vectors fall back to vector_dot
+ */
+int vector_dot_parallel(const Vector *a, const Vector *b, double_t *result);
+
 /**
  * @brief Cross product of two 3D vectors
  * @param a First vector (must be 3D)
@@ -493,6 +516,9 @@ int vector_round(Vector *vector);
  * @param b Second vector
  * @param tolerance Maximum allowed difference per element
  * @return VECTOR_SUCCESS if equal within tolerance, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_MATH if any element differs by more than tolerance
+ * @see vector_approx_equal() for a boolean result
  */
 int vector_equals(const Vector *a, const Vector *b, double_t tolerance);
 
@@ -501,6 +527,9 @@ int vector_equals(const Vector *a, const Vector *b, double_t tolerance);
  * @param vector Vector to check
  * @param tolerance Maximum allowed element magnitude
  * @return VECTOR_SUCCESS if all elements <= tolerance, error code otherwise
+ *
+ * @note Returns VECTOR_ERROR_MATH if any element magnitude exceeds tolerance
+ * @see vector_approx_zero() for a boolean result
  */
 int vector_is_zero(const Vector *vector, double_t tolerance);
 
@@ -519,6 +548,78 @@ int vector_is_unit(const Vector *vector, double_t tolerance);
  */
 int vector_print(const Vector *vector);
 
+// Section: Comparisons
+
+/**
+ * @brief Check if two vectors are equal within an absolute tolerance
+ * @param a First vector
+ * @param b Second vector
+ * @param tolerance Maximum allowed difference per element
+ * @param[out] result Pointer to store true if |a[i] - b[i]| <= tolerance for all i
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note NaN elements never compare equal
+ * @note Stops at the first block containing a mismatch
+ */
+int vector_approx_equal(const Vector *a,
+                        const Vector *b,
+                        double_t tolerance,
+                        bool *result);
+
+/**
+ * @brief Check if two vectors are equal within a number of ULPs
+ * @param a First vector
+ * @param b Second vector
+ * @param max_ulps Maximum allowed distance in units in the last place
+ * @param[out] result Pointer to store true if every pair is within max_ulps
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note NaN elements never compare equal, +0.0 and -0.0 are 0 ULPs apart
+ * @note Stops at the first block containing a mismatch
+ */
+int vector_ulp_equal(const Vector *a,
+                     const Vector *b,
+                     uint64_t max_ulps,
+                     bool *result);
+
+/**
+ * @brief Check if two vectors are bitwise identical
+ * @param a First vector
+ * @param b Second vector
+ * @param[out] result Pointer to store true if all element bits match
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Vectors of different sizes compare unequal rather than failing
+ */
+int vector_bitwise_equal(const Vector *a, const Vector *b, bool *result);
+
+/**
+ * @brief Check if vector is approximately zero
+ * @param vector Vector to check
+ * @param tolerance Maximum allowed element magnitude
+ * @param[out] result Pointer to store true if |v[i]| <= tolerance for all i
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note NaN elements are never considered zero
+ */
+int vector_approx_zero(const Vector *vector, double_t tolerance, bool *result);
+
+/**
+ * @brief Check if vector contains any NaN
+ * @param vector Vector to scan
+ * @param[out] result Pointer to store true if any element is NaN
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_has_nan(const Vector *vector, bool *result);
+
+/**
+ * @brief Check if all vector elements are finite
+ * @param vector Vector to scan
+ * @param[out] result Pointer to store true if no element is NaN or infinite
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ */
+int vector_all_finite(const Vector *vector, bool *result);
+
 // // --- Matrix-Vector operations ---
 // int vector_mat_mult(const Matrix *matrix, const Vector *vector, Vector *result);
 // int vector_transform(const Matrix *matrix, const Vector *vector);
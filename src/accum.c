@@ -0,0 +1,235 @@
+/**
+ * @file accum.c
+ * @brief Sharded accumulators for concurrent reductions into a vector
+ * @date 18/10/26
+ */
+
+#include "accum.h"
+#include "pool.h"
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ACCUM_CACHE_LINE 64
+#define ACCUM_LINE_DOUBLES (ACCUM_CACHE_LINE / sizeof(double_t))
+#define ACCUM_MERGE_CHUNK 8192 ///< Elements per merge task, line aligned
+
+struct NumenAccumShard {
+    alignas(ACCUM_CACHE_LINE) atomic_bool claimed;
+    NumenAccumulator *accum;
+    double_t *data;
+};
+
+struct NumenAccumulator {
+    size_t size;
+    size_t stride; ///< Replica length rounded up to whole cache lines
+    size_t shard_count;
+    _Atomic double_t *base; ///< Shared target of atomic adds
+    double_t *replicas; ///< shard_count rows of stride elements
+    NumenAccumShard *shards;
+};
+
+// --- Accumulator ---
+
+int numen_accum_create(size_t size,
+                       size_t shards,
+                       NumenAccumulator **out_accum) {
+    if (!out_accum)
+        return VECTOR_ERROR_NULL;
+    if (size == 0)
+        return VECTOR_ERROR_SIZE;
+
+    if (shards == 0)
+        shards = pool_thread_count();
+
+    NumenAccumulator *accum = malloc(sizeof(NumenAccumulator));
+    if (!accum)
+        return VECTOR_ERROR_MEM;
+
+    accum->size = size;
+    accum->stride = (size + ACCUM_LINE_DOUBLES - 1) / ACCUM_LINE_DOUBLES *
+                    ACCUM_LINE_DOUBLES;
+    accum->shard_count = shards;
+    accum->base = malloc(size * sizeof(_Atomic double_t));
+    accum->replicas = aligned_alloc(ACCUM_CACHE_LINE,
+                                    shards * accum->stride * sizeof(double_t));
+    accum->shards =
+        aligned_alloc(ACCUM_CACHE_LINE, shards * sizeof(NumenAccumShard));
+    if (!accum->base || !accum->replicas || !accum->shards) {
+        numen_accum_free(accum);
+        return VECTOR_ERROR_MEM;
+    }
+
+    for (size_t s = 0; s < shards; s++) {
+        atomic_init(&accum->shards[s].claimed, false);
+        accum->shards[s].accum = accum;
+        accum->shards[s].data = accum->replicas + s * accum->stride;
+    }
+
+    numen_accum_reset(accum);
+    *out_accum = accum;
+    return VECTOR_SUCCESS;
+}
+
+int numen_accum_free(NumenAccumulator *accum) {
+    if (!accum)
+        return VECTOR_ERROR_NULL;
+
+    free(accum->base);
+    free(accum->replicas);
+    free(accum->shards);
+    free(accum);
+    return VECTOR_SUCCESS;
+}
+
+int numen_accum_reset(NumenAccumulator *accum) {
+    if (!accum)
+        return VECTOR_ERROR_NULL;
+
+    for (size_t i = 0; i < accum->size; i++) {
+        atomic_init(&accum->base[i], 0.0);
+    }
+    memset(accum->replicas,
+           0,
+           accum->shard_count * accum->stride * sizeof(double_t));
+    return VECTOR_SUCCESS;
+}
+
+typedef struct {
+    const NumenAccumulator *accum;
+    double_t *out;
+} MergeJob;
+
+// Sum one column block across replicas, row by row for streaming access
+static void merge_chunk(void *ctx, size_t task) {
+    const MergeJob *job = ctx;
+    const NumenAccumulator *accum = job->accum;
+    const size_t begin = task * ACCUM_MERGE_CHUNK;
+    const size_t end = begin + ACCUM_MERGE_CHUNK < accum->size
+                           ? begin + ACCUM_MERGE_CHUNK
+                           : accum->size;
+
+    for (size_t i = begin; i < end; i++) {
+        job->out[i] = atomic_load_explicit(&accum->base[i],
+                                           memory_order_relaxed);
+    }
+    for (size_t s = 0; s < accum->shard_count; s++) {
+        const double_t *row = accum->replicas + s * accum->stride;
+        for (size_t i = begin; i < end; i++) {
+            job->out[i] += row[i];
+        }
+    }
+}
+
+int numen_accum_merge(const NumenAccumulator *accum, Vector *result) {
+    if (!accum || !result)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (result->size != accum->size)
+        return VECTOR_ERROR_SIZE;
+
+    MergeJob job = {.accum = accum, .out = result->elements};
+    const size_t tasks =
+        (accum->size + ACCUM_MERGE_CHUNK - 1) / ACCUM_MERGE_CHUNK;
+    if (tasks < 2) {
+        merge_chunk(&job, 0);
+        return VECTOR_SUCCESS;
+    }
+    return pool_parallel_for(tasks, merge_chunk, &job);
+}
+
+int numen_accum_atomic_add(NumenAccumulator *accum,
+                           size_t index,
+                           double_t value) {
+    if (!accum)
+        return VECTOR_ERROR_NULL;
+    if (index >= accum->size)
+        return VECTOR_ERROR_INDEX;
+
+    // C11 has no floating fetch_add, a relaxed CAS loop is the portable form
+    _Atomic double_t *slot = &accum->base[index];
+    double_t old = atomic_load_explicit(slot, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(slot,
+                                                  &old,
+                                                  old + value,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+    return VECTOR_SUCCESS;
+}
+
+// --- Shards ---
+
+int numen_accum_shard_acquire(NumenAccumulator *accum,
+                              NumenAccumShard **out_shard) {
+    if (!accum || !out_shard)
+        return VECTOR_ERROR_NULL;
+
+    for (size_t s = 0; s < accum->shard_count; s++) {
+        NumenAccumShard *shard = &accum->shards[s];
+        bool expected = false;
+        if (!atomic_load_explicit(&shard->claimed, memory_order_relaxed) &&
+            atomic_compare_exchange_strong(&shard->claimed, &expected, true)) {
+            *out_shard = shard;
+            return VECTOR_SUCCESS;
+        }
+    }
+    return VECTOR_ERROR_SIZE;
+}
+
+int numen_accum_shard_release(NumenAccumShard *shard) {
+    if (!shard)
+        return VECTOR_ERROR_NULL;
+    atomic_store_explicit(&shard->claimed, false, memory_order_release);
+    return VECTOR_SUCCESS;
+}
+
+int numen_accum_shard_add(NumenAccumShard *shard, const Vector *values) {
+    if (!shard || !values)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(values))
+        return VECTOR_ERROR_INIT;
+    if (values->size != shard->accum->size)
+        return VECTOR_ERROR_SIZE;
+
+    double_t *restrict data = shard->data;
+    const double_t *restrict src = values->elements;
+    for (size_t i = 0; i < values->size; i++) {
+        data[i] += src[i];
+    }
+    return VECTOR_SUCCESS;
+}
+
+int numen_accum_shard_add_at(NumenAccumShard *shard,
+                             size_t index,
+                             double_t value) {
+    if (!shard)
+        return VECTOR_ERROR_NULL;
+    if (index >= shard->accum->size)
+        return VECTOR_ERROR_INDEX;
+
+    shard->data[index] += value;
+    return VECTOR_SUCCESS;
+}
+
+int numen_accum_shard_add_indexed(NumenAccumShard *shard,
+                                  const size_t *indices,
+                                  const Vector *values) {
+    if (!shard || !indices || !values)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(values))
+        return VECTOR_ERROR_INIT;
+
+    const size_t size = shard->accum->size;
+    for (size_t i = 0; i < values->size; i++) {
+        if (indices[i] >= size)
+            return VECTOR_ERROR_INDEX;
+    }
+
+    for (size_t i = 0; i < values->size; i++) {
+        shard->data[indices[i]] += values->elements[i];
+    }
+    return VECTOR_SUCCESS;
+}
@@ -0,0 +1,376 @@
+/**
+ * @file append.c
+ * @brief Concurrent multi-producer append buffer
+ * @date 18/10/26
+ */
+
+#include "append.h"
+#include "simd.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define APPEND_CHUNK 1024 ///< Elements reserved per atomic add
+#define APPEND_FIRST_SEGMENT (16 * APPEND_CHUNK) ///< Elements in segment 0
+#define APPEND_MAX_SEGMENTS 40 ///< Segment k holds FIRST_SEGMENT << k
+
+/**
+ * @brief Storage for a range of chunks, never moved once allocated
+ */
+typedef struct {
+    atomic_size_t *fills; ///< Published element count of each chunk
+    double_t *data;
+} AppendSegment;
+
+struct NumenAppendBuffer {
+    atomic_size_t reserved; ///< Elements handed out to appenders
+    _Atomic(AppendSegment *) segments[APPEND_MAX_SEGMENTS];
+};
+
+struct NumenAppender {
+    NumenAppendBuffer *buffer;
+    AppendSegment *segment; ///< Segment of the current chunk, NULL if none
+    size_t chunk; ///< Chunk index within segment
+    size_t used; ///< Elements written to current chunk
+};
+
+// --- Segments ---
+
+static size_t segment_base(size_t index) {
+    return APPEND_FIRST_SEGMENT * (((size_t)1 << index) - 1);
+}
+
+static size_t segment_capacity(size_t index) {
+    return (size_t)APPEND_FIRST_SEGMENT << index;
+}
+
+static size_t segment_of(size_t position) {
+    return simd_log2_64(position / APPEND_FIRST_SEGMENT + 1);
+}
+
+static AppendSegment *segment_create(size_t index) {
+    const size_t capacity = segment_capacity(index);
+    const size_t chunks = capacity / APPEND_CHUNK;
+
+    AppendSegment *segment = malloc(sizeof(AppendSegment));
+    if (!segment)
+        return NULL;
+
+    segment->fills = malloc(chunks * sizeof(atomic_size_t));
+    segment->data = malloc(capacity * sizeof(double_t));
+    if (!segment->fills || !segment->data) {
+        free(segment->fills);
+        free(segment->data);
+        free(segment);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < chunks; i++) {
+        atomic_init(&segment->fills[i], 0);
+    }
+    return segment;
+}
+
+static void segment_free(AppendSegment *segment) {
+    if (!segment)
+        return;
+    free(segment->fills);
+    free(segment->data);
+    free(segment);
+}
+
+// Segment holding index, allocating it if this producer got there first
+static AppendSegment *segment_get(NumenAppendBuffer *buffer, size_t index) {
+    AppendSegment *segment =
+        atomic_load_explicit(&buffer->segments[index], memory_order_acquire);
+    if (segment)
+        return segment;
+
+    AppendSegment *fresh = segment_create(index);
+    if (!fresh)
+        return NULL;
+
+    if (atomic_compare_exchange_strong_explicit(&buffer->segments[index],
+                                                &segment,
+                                                fresh,
+                                                memory_order_acq_rel,
+                                                memory_order_acquire)) {
+        return fresh;
+    }
+
+    // Another producer won the race, segment now holds its pointer
+    segment_free(fresh);
+    return segment;
+}
+
+// --- Buffer ---
+
+int numen_append_buffer_create(NumenAppendBuffer **out_buffer) {
+    if (!out_buffer)
+        return VECTOR_ERROR_NULL;
+
+    NumenAppendBuffer *buffer = malloc(sizeof(NumenAppendBuffer));
+    if (!buffer)
+        return VECTOR_ERROR_MEM;
+
+    atomic_init(&buffer->reserved, 0);
+    for (size_t i = 0; i < APPEND_MAX_SEGMENTS; i++) {
+        atomic_init(&buffer->segments[i], NULL);
+    }
+
+    *out_buffer = buffer;
+    return VECTOR_SUCCESS;
+}
+
+int numen_append_buffer_free(NumenAppendBuffer *buffer) {
+    if (!buffer)
+        return VECTOR_ERROR_NULL;
+
+    for (size_t i = 0; i < APPEND_MAX_SEGMENTS; i++) {
+        segment_free(atomic_load(&buffer->segments[i]));
+    }
+    free(buffer);
+    return VECTOR_SUCCESS;
+}
+
+/**
+ * @brief Callback for each run of published elements
+ *
+ * Runs merge across chunks of one segment when the earlier chunk is full,
+ * since the elements are then adjacent in memory.
+ */
+typedef void (*AppendRunFn)(void *ctx, const double_t *data, size_t size);
+
+static void append_for_each_run(const NumenAppendBuffer *buffer,
+                                AppendRunFn fn,
+                                void *ctx) {
+    const size_t reserved = atomic_load(&buffer->reserved);
+
+    for (size_t k = 0; k < APPEND_MAX_SEGMENTS; k++) {
+        if (segment_base(k) >= reserved)
+            break;
+
+        AppendSegment *segment =
+            atomic_load_explicit(&buffer->segments[k], memory_order_acquire);
+        if (!segment)
+            continue;
+
+        const size_t chunks = segment_capacity(k) / APPEND_CHUNK;
+        const double_t *run = NULL;
+        size_t run_size = 0;
+
+        for (size_t c = 0; c < chunks; c++) {
+            size_t fill = atomic_load_explicit(&segment->fills[c],
+                                               memory_order_acquire);
+            if (fill == 0)
+                continue;
+
+            const double_t *data = segment->data + c * APPEND_CHUNK;
+            if (run && run + run_size == data) {
+                run_size += fill;
+            } else {
+                if (run)
+                    fn(ctx, run, run_size);
+                run = data;
+                run_size = fill;
+            }
+
+            // A partial chunk ends the run, the next chunk is not adjacent
+            if (fill < APPEND_CHUNK) {
+                fn(ctx, run, run_size);
+                run = NULL;
+                run_size = 0;
+            }
+        }
+
+        if (run)
+            fn(ctx, run, run_size);
+    }
+}
+
+typedef struct {
+    double_t *out; ///< NULL to count only
+    size_t size;
+    VectorView *views; ///< NULL to count only
+    size_t capacity;
+    size_t count;
+} AppendCollect;
+
+static void collect_size(void *ctx, const double_t *data, size_t size) {
+    (void)data;
+    ((AppendCollect *)ctx)->size += size;
+}
+
+static void collect_copy(void *ctx, const double_t *data, size_t size) {
+    AppendCollect *collect = ctx;
+    // Producers may publish more between the two passes, never overflow
+    if (size > collect->capacity - collect->size)
+        size = collect->capacity - collect->size;
+    memcpy(collect->out + collect->size, data, size * sizeof(double_t));
+    collect->size += size;
+}
+
+static void collect_view(void *ctx, const double_t *data, size_t size) {
+    AppendCollect *collect = ctx;
+    if (collect->views && collect->count < collect->capacity) {
+        collect->views[collect->count].elements = data;
+        collect->views[collect->count].size = size;
+    }
+    collect->count++;
+}
+
+int numen_append_size(const NumenAppendBuffer *buffer, size_t *out_size) {
+    if (!buffer || !out_size)
+        return VECTOR_ERROR_NULL;
+
+    AppendCollect collect = {0};
+    append_for_each_run(buffer, collect_size, &collect);
+    *out_size = collect.size;
+    return VECTOR_SUCCESS;
+}
+
+int numen_append_finalize(const NumenAppendBuffer *buffer,
+                          Vector **out_vector) {
+    if (!buffer || !out_vector)
+        return VECTOR_ERROR_NULL;
+
+    AppendCollect collect = {0};
+    append_for_each_run(buffer, collect_size, &collect);
+
+    Vector *vector = NULL;
+    int err = vector_create(collect.size, &vector);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    collect.out = vector->elements;
+    collect.capacity = collect.size;
+    collect.size = 0;
+    append_for_each_run(buffer, collect_copy, &collect);
+
+    vector->size = collect.size;
+    *out_vector = vector;
+    return VECTOR_SUCCESS;
+}
+
+int numen_append_views(const NumenAppendBuffer *buffer,
+                       VectorView *views,
+                       size_t capacity,
+                       size_t *out_count) {
+    if (!buffer || !out_count)
+        return VECTOR_ERROR_NULL;
+
+    AppendCollect collect = {
+        .views = views,
+        .capacity = views ? capacity : 0,
+    };
+    append_for_each_run(buffer, collect_view, &collect);
+
+    *out_count = collect.count;
+    if (views && collect.count > capacity)
+        return VECTOR_ERROR_SIZE;
+    return VECTOR_SUCCESS;
+}
+
+// --- Producers ---
+
+int numen_appender_create(NumenAppendBuffer *buffer,
+                          NumenAppender **out_appender) {
+    if (!buffer || !out_appender)
+        return VECTOR_ERROR_NULL;
+
+    NumenAppender *appender = malloc(sizeof(NumenAppender));
+    if (!appender)
+        return VECTOR_ERROR_MEM;
+
+    appender->buffer = buffer;
+    appender->segment = NULL;
+    appender->chunk = 0;
+    appender->used = 0;
+
+    *out_appender = appender;
+    return VECTOR_SUCCESS;
+}
+
+int numen_appender_free(NumenAppender *appender) {
+    if (!appender)
+        return VECTOR_ERROR_NULL;
+
+    numen_appender_flush(appender);
+    free(appender);
+    return VECTOR_SUCCESS;
+}
+
+int numen_appender_flush(NumenAppender *appender) {
+    if (!appender)
+        return VECTOR_ERROR_NULL;
+
+    if (appender->segment) {
+        atomic_store_explicit(&appender->segment->fills[appender->chunk],
+                              appender->used,
+                              memory_order_release);
+    }
+    return VECTOR_SUCCESS;
+}
+
+// Publish the current chunk and reserve a fresh one
+static int appender_next_chunk(NumenAppender *appender) {
+    numen_appender_flush(appender);
+
+    const size_t position = atomic_fetch_add_explicit(
+        &appender->buffer->reserved, APPEND_CHUNK, memory_order_relaxed);
+    const size_t index = segment_of(position);
+    if (index >= APPEND_MAX_SEGMENTS)
+        return VECTOR_ERROR_MEM;
+
+    AppendSegment *segment = segment_get(appender->buffer, index);
+    if (!segment)
+        return VECTOR_ERROR_MEM;
+
+    appender->segment = segment;
+    appender->chunk = (position - segment_base(index)) / APPEND_CHUNK;
+    appender->used = 0;
+    return VECTOR_SUCCESS;
+}
+
+int numen_append(NumenAppender *appender, double_t value) {
+    if (!appender)
+        return VECTOR_ERROR_NULL;
+
+    if (!appender->segment || appender->used == APPEND_CHUNK) {
+        int err = appender_next_chunk(appender);
+        if (err != VECTOR_SUCCESS)
+            return err;
+    }
+
+    appender->segment->data[appender->chunk * APPEND_CHUNK + appender->used] =
+        value;
+    appender->used++;
+    return VECTOR_SUCCESS;
+}
+
+int numen_append_many(NumenAppender *appender,
+                      const double_t *values,
+                      size_t count) {
+    if (!appender || (!values && count > 0))
+        return VECTOR_ERROR_NULL;
+
+    while (count > 0) {
+        if (!appender->segment || appender->used == APPEND_CHUNK) {
+            int err = appender_next_chunk(appender);
+            if (err != VECTOR_SUCCESS)
+                return err;
+        }
+
+        size_t room = APPEND_CHUNK - appender->used;
+        size_t take = count < room ? count : room;
+        memcpy(appender->segment->data + appender->chunk * APPEND_CHUNK +
+                   appender->used,
+               values,
+               take * sizeof(double_t));
+
+        appender->used += take;
+        values += take;
+        count -= take;
+    }
+    return VECTOR_SUCCESS;
+}
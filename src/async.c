@@ -0,0 +1,456 @@
+/**
+ * @file async.c
+ * @brief Asynchronous vector operations with completion futures
+ * @date 18/10/26
+ */
+
+#include "async.h"
+#include "future.h"
+#include "pool.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+/**
+ * @brief Entry in a future's completion list, either a dependent future or
+ *        a user callback
+ */
+typedef struct FutureLink {
+    struct FutureLink *next;
+    NumenFuture *successor;
+    NumenCallback callback;
+    void *user_data;
+} FutureLink;
+
+struct NumenFuture {
+    PoolTask task; ///< Queue node, must stay first
+    pthread_mutex_t lock;
+    pthread_cond_t completed;
+    bool done;
+    int status;
+    atomic_int dep_status; ///< First failing dependency status
+    atomic_size_t pending; ///< Unfinished dependencies plus submit guard
+    atomic_size_t refs; ///< Handle, scheduler and dependency list references
+    NumenTaskFn fn;
+    void *arg;
+    void (*release_arg)(void *arg);
+    FutureLink *links_head; ///< Run on completion in registration order
+    FutureLink *links_tail;
+};
+
+static void future_release(NumenFuture *future) {
+    if (atomic_fetch_sub(&future->refs, 1) == 1) {
+        pthread_mutex_destroy(&future->lock);
+        pthread_cond_destroy(&future->completed);
+        free(future);
+    }
+}
+
+static void future_schedule(NumenFuture *future);
+
+static void future_complete(NumenFuture *future, int status) {
+    if (future->release_arg)
+        future->release_arg(future->arg);
+
+    pthread_mutex_lock(&future->lock);
+    future->done = true;
+    future->status = status;
+    FutureLink *link = future->links_head;
+    future->links_head = NULL;
+    future->links_tail = NULL;
+    pthread_cond_broadcast(&future->completed);
+    pthread_mutex_unlock(&future->lock);
+
+    while (link) {
+        FutureLink *next = link->next;
+        if (link->successor) {
+            NumenFuture *successor = link->successor;
+            if (status != VECTOR_SUCCESS) {
+                int expected = VECTOR_SUCCESS;
+                atomic_compare_exchange_strong(
+                    &successor->dep_status, &expected, status);
+            }
+            if (atomic_fetch_sub(&successor->pending, 1) == 1)
+                future_schedule(successor);
+            future_release(successor);
+        } else {
+            link->callback(status, link->user_data);
+        }
+        free(link);
+        link = next;
+    }
+
+    // Drop the scheduler reference
+    future_release(future);
+}
+
+static void future_run(PoolTask *task) {
+    NumenFuture *future = (NumenFuture *)task;
+    future_complete(future, future->fn(future->arg));
+}
+
+static void future_schedule(NumenFuture *future) {
+    int dep_status = atomic_load(&future->dep_status);
+    if (dep_status != VECTOR_SUCCESS) {
+        future_complete(future, dep_status);
+        return;
+    }
+
+    // Without a queue slot, run on the calling thread rather than fail
+    future->task.run = future_run;
+    if (pool_submit(&future->task) != VECTOR_SUCCESS)
+        future_run(&future->task);
+}
+
+int future_submit(NumenTaskFn fn,
+                  void *arg,
+                  void (*release_arg)(void *arg),
+                  NumenFuture *const *deps,
+                  size_t dep_count,
+                  NumenFuture **out_future) {
+    if (!fn || (dep_count > 0 && !deps)) {
+        if (release_arg)
+            release_arg(arg);
+        return VECTOR_ERROR_NULL;
+    }
+    for (size_t i = 0; i < dep_count; i++) {
+        if (!deps[i]) {
+            if (release_arg)
+                release_arg(arg);
+            return VECTOR_ERROR_NULL;
+        }
+    }
+
+    NumenFuture *future = malloc(sizeof(NumenFuture));
+    if (!future) {
+        if (release_arg)
+            release_arg(arg);
+        return VECTOR_ERROR_MEM;
+    }
+
+    pthread_mutex_init(&future->lock, NULL);
+    pthread_cond_init(&future->completed, NULL);
+    future->done = false;
+    future->status = VECTOR_SUCCESS;
+    atomic_init(&future->dep_status, VECTOR_SUCCESS);
+    atomic_init(&future->pending, 1); // Guard until all edges are added
+    atomic_init(&future->refs, out_future ? 2 : 1);
+    future->fn = fn;
+    future->arg = arg;
+    future->release_arg = release_arg;
+    future->links_head = NULL;
+    future->links_tail = NULL;
+
+    for (size_t i = 0; i < dep_count; i++) {
+        NumenFuture *dep = deps[i];
+        FutureLink *link = malloc(sizeof(FutureLink));
+        if (!link) {
+            // Cannot track the edge, fail the future rather than run early
+            int expected = VECTOR_SUCCESS;
+            atomic_compare_exchange_strong(
+                &future->dep_status, &expected, VECTOR_ERROR_MEM);
+            continue;
+        }
+        link->next = NULL;
+        link->successor = future;
+        link->callback = NULL;
+        link->user_data = NULL;
+
+        pthread_mutex_lock(&dep->lock);
+        if (!dep->done) {
+            // Counted under the lock, so dep cannot complete in between
+            atomic_fetch_add(&future->pending, 1);
+            atomic_fetch_add(&future->refs, 1);
+            if (dep->links_tail)
+                dep->links_tail->next = link;
+            else
+                dep->links_head = link;
+            dep->links_tail = link;
+            link = NULL;
+        } else if (dep->status != VECTOR_SUCCESS) {
+            int expected = VECTOR_SUCCESS;
+            atomic_compare_exchange_strong(
+                &future->dep_status, &expected, dep->status);
+        }
+        pthread_mutex_unlock(&dep->lock);
+        free(link);
+    }
+
+    if (out_future)
+        *out_future = future;
+
+    if (atomic_fetch_sub(&future->pending, 1) == 1)
+        future_schedule(future);
+    return VECTOR_SUCCESS;
+}
+
+// --- Futures ---
+
+int numen_submit(NumenTaskFn fn,
+                 void *arg,
+                 NumenFuture *const *deps,
+                 size_t dep_count,
+                 NumenFuture **out_future) {
+    return future_submit(fn, arg, NULL, deps, dep_count, out_future);
+}
+
+int numen_wait(NumenFuture *future) {
+    if (!future)
+        return VECTOR_ERROR_NULL;
+
+    for (;;) {
+        pthread_mutex_lock(&future->lock);
+        if (future->done) {
+            int status = future->status;
+            pthread_mutex_unlock(&future->lock);
+            return status;
+        }
+        pthread_mutex_unlock(&future->lock);
+
+        // Help drain the queue, then sleep once there is nothing to run
+        if (!pool_try_run_one())
+            break;
+    }
+
+    pthread_mutex_lock(&future->lock);
+    while (!future->done) {
+        pthread_cond_wait(&future->completed, &future->lock);
+    }
+    int status = future->status;
+    pthread_mutex_unlock(&future->lock);
+    return status;
+}
+
+int numen_poll(NumenFuture *future, bool *done) {
+    if (!future || !done)
+        return VECTOR_ERROR_NULL;
+
+    pthread_mutex_lock(&future->lock);
+    *done = future->done;
+    pthread_mutex_unlock(&future->lock);
+    return VECTOR_SUCCESS;
+}
+
+int numen_on_complete(NumenFuture *future,
+                      NumenCallback callback,
+                      void *user_data) {
+    if (!future || !callback)
+        return VECTOR_ERROR_NULL;
+
+    FutureLink *link = malloc(sizeof(FutureLink));
+    if (!link)
+        return VECTOR_ERROR_MEM;
+    link->next = NULL;
+    link->successor = NULL;
+    link->callback = callback;
+    link->user_data = user_data;
+
+    pthread_mutex_lock(&future->lock);
+    if (!future->done) {
+        if (future->links_tail)
+            future->links_tail->next = link;
+        else
+            future->links_head = link;
+        future->links_tail = link;
+        pthread_mutex_unlock(&future->lock);
+        return VECTOR_SUCCESS;
+    }
+    int status = future->status;
+    pthread_mutex_unlock(&future->lock);
+
+    free(link);
+    callback(status, user_data);
+    return VECTOR_SUCCESS;
+}
+
+int numen_future_free(NumenFuture *future) {
+    if (!future)
+        return VECTOR_ERROR_NULL;
+
+    future_release(future);
+    return VECTOR_SUCCESS;
+}
+
+// --- Asynchronous vector operations ---
+
+typedef struct {
+    const Vector *a;
+    const Vector *b;
+    Vector *result;
+    double_t scaler;
+    double_t *out_scalar;
+} AsyncArgs;
+
+static int async_args(const Vector *a,
+                      const Vector *b,
+                      Vector *result,
+                      double_t scaler,
+                      double_t *out_scalar,
+                      AsyncArgs **out_args) {
+    AsyncArgs *args = malloc(sizeof(AsyncArgs));
+    if (!args)
+        return VECTOR_ERROR_MEM;
+
+    args->a = a;
+    args->b = b;
+    args->result = result;
+    args->scaler = scaler;
+    args->out_scalar = out_scalar;
+    *out_args = args;
+    return VECTOR_SUCCESS;
+}
+
+static int run_add(void *arg) {
+    AsyncArgs *args = arg;
+    return vector_add(args->a, args->b, args->result);
+}
+
+static int run_sub(void *arg) {
+    AsyncArgs *args = arg;
+    return vector_sub(args->a, args->b, args->result);
+}
+
+static int run_mult(void *arg) {
+    AsyncArgs *args = arg;
+    return vector_mult(args->a, args->b, args->result);
+}
+
+static int run_div(void *arg) {
+    AsyncArgs *args = arg;
+    return vector_div(args->a, args->b, args->result);
+}
+
+static int run_scale(void *arg) {
+    AsyncArgs *args = arg;
+    return vector_scale(args->a, args->scaler, args->result);
+}
+
+static int run_copy(void *arg) {
+    AsyncArgs *args = arg;
+    return vector_copy(args->a, args->result);
+}
+
+static int run_dot(void *arg) {
+    AsyncArgs *args = arg;
+    return vector_dot(args->a, args->b, args->out_scalar);
+}
+
+static int run_sum(void *arg) {
+    AsyncArgs *args = arg;
+    return vector_sum(args->a, args->out_scalar);
+}
+
+static int run_normalize(void *arg) {
+    AsyncArgs *args = arg;
+    return vector_normalize(args->result);
+}
+
+static int submit_op(NumenTaskFn fn,
+                     const Vector *a,
+                     const Vector *b,
+                     Vector *result,
+                     double_t scaler,
+                     double_t *out_scalar,
+                     NumenFuture *const *deps,
+                     size_t dep_count,
+                     NumenFuture **out_future) {
+    AsyncArgs *args;
+    int err = async_args(a, b, result, scaler, out_scalar, &args);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    return future_submit(fn, args, free, deps, dep_count, out_future);
+}
+
+int vector_add_async(const Vector *a,
+                     const Vector *b,
+                     Vector *result,
+                     NumenFuture *const *deps,
+                     size_t dep_count,
+                     NumenFuture **out_future) {
+    return submit_op(
+        run_add, a, b, result, 0.0, NULL, deps, dep_count, out_future);
+}
+
+int vector_sub_async(const Vector *a,
+                     const Vector *b,
+                     Vector *result,
+                     NumenFuture *const *deps,
+                     size_t dep_count,
+                     NumenFuture **out_future) {
+    return submit_op(
+        run_sub, a, b, result, 0.0, NULL, deps, dep_count, out_future);
+}
+
+int vector_mult_async(const Vector *a,
+                      const Vector *b,
+                      Vector *result,
+                      NumenFuture *const *deps,
+                      size_t dep_count,
+                      NumenFuture **out_future) {
+    return submit_op(
+        run_mult, a, b, result, 0.0, NULL, deps, dep_count, out_future);
+}
+
+int vector_div_async(const Vector *a,
+                     const Vector *b,
+                     Vector *result,
+                     NumenFuture *const *deps,
+                     size_t dep_count,
+                     NumenFuture **out_future) {
+    return submit_op(
+        run_div, a, b, result, 0.0, NULL, deps, dep_count, out_future);
+}
+
+int vector_scale_async(const Vector *a,
+                       double_t scaler,
+                       Vector *result,
+                       NumenFuture *const *deps,
+                       size_t dep_count,
+                       NumenFuture **out_future) {
+    return submit_op(
+        run_scale, a, NULL, result, scaler, NULL, deps, dep_count, out_future);
+}
+
+int vector_copy_async(const Vector *src,
+                      Vector *dest,
+                      NumenFuture *const *deps,
+                      size_t dep_count,
+                      NumenFuture **out_future) {
+    return submit_op(
+        run_copy, src, NULL, dest, 0.0, NULL, deps, dep_count, out_future);
+}
+
+int vector_dot_async(const Vector *a,
+                     const Vector *b,
+                     double_t *result,
+                     NumenFuture *const *deps,
+                     size_t dep_count,
+                     NumenFuture **out_future) {
+    return submit_op(
+        run_dot, a, b, NULL, 0.0, result, deps, dep_count, out_future);
+}
+
+int vector_sum_async(const Vector *vector,
+                     double_t *sum,
+                     NumenFuture *const *deps,
+                     size_t dep_count,
+                     NumenFuture **out_future) {
+    return submit_op(
+        run_sum, vector, NULL, NULL, 0.0, sum, deps, dep_count, out_future);
+}
+
+int vector_normalize_async(Vector *vector,
+                           NumenFuture *const *deps,
+                           size_t dep_count,
+                           NumenFuture **out_future) {
+    return submit_op(run_normalize,
+                     NULL,
+                     NULL,
+                     vector,
+                     0.0,
+                     NULL,
+                     deps,
+                     dep_count,
+                     out_future);
+}
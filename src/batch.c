@@ -0,0 +1,253 @@
+/**
+ * @file batch.c
+ * @brief Structure-of-arrays vector batches
+ * @date 18/10/26
+ */
+
+#include "batch.h"
+#include "simd.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// --- Batch initialization ---
+
+int vec3_batch_create(size_t count, Vec3Batch **out_batch) {
+    if (!out_batch)
+        return VECTOR_ERROR_NULL;
+    if (count > SIZE_MAX / 3 / sizeof(double_t))
+        return VECTOR_ERROR_MEM;
+
+    Vec3Batch *batch = malloc(sizeof(Vec3Batch));
+    if (!batch)
+        return VECTOR_ERROR_MEM;
+
+    // One block for all components, x | y | z
+    double_t *data = calloc(count > 0 ? 3 * count : 1, sizeof(double_t));
+    if (!data) {
+        free(batch);
+        return VECTOR_ERROR_MEM;
+    }
+
+    batch->x = data;
+    batch->y = data + count;
+    batch->z = data + 2 * count;
+    batch->count = count;
+    *out_batch = batch;
+    return VECTOR_SUCCESS;
+}
+
+int vec3_batch_free(Vec3Batch *batch) {
+    if (!batch)
+        return VECTOR_ERROR_NULL;
+
+    free(batch->x);
+    free(batch);
+    return VECTOR_SUCCESS;
+}
+
+int vec4_batch_create(size_t count, Vec4Batch **out_batch) {
+    if (!out_batch)
+        return VECTOR_ERROR_NULL;
+    if (count > SIZE_MAX / 4 / sizeof(double_t))
+        return VECTOR_ERROR_MEM;
+
+    Vec4Batch *batch = malloc(sizeof(Vec4Batch));
+    if (!batch)
+        return VECTOR_ERROR_MEM;
+
+    // One block for all components, x | y | z | w
+    double_t *data = calloc(count > 0 ? 4 * count : 1, sizeof(double_t));
+    if (!data) {
+        free(batch);
+        return VECTOR_ERROR_MEM;
+    }
+
+    batch->x = data;
+    batch->y = data + count;
+    batch->z = data + 2 * count;
+    batch->w = data + 3 * count;
+    batch->count = count;
+    *out_batch = batch;
+    return VECTOR_SUCCESS;
+}
+
+int vec4_batch_free(Vec4Batch *batch) {
+    if (!batch)
+        return VECTOR_ERROR_NULL;
+
+    free(batch->x);
+    free(batch);
+    return VECTOR_SUCCESS;
+}
+
+// --- Layout conversion ---
+
+int vec3_batch_from_interleaved(const double_t *xyz, Vec3Batch *batch) {
+    if (!xyz || !batch)
+        return VECTOR_ERROR_NULL;
+
+    double_t *restrict x = batch->x;
+    double_t *restrict y = batch->y;
+    double_t *restrict z = batch->z;
+    for (size_t i = 0; i < batch->count; i++) {
+        x[i] = xyz[3 * i];
+        y[i] = xyz[3 * i + 1];
+        z[i] = xyz[3 * i + 2];
+    }
+    return VECTOR_SUCCESS;
+}
+
+int vec3_batch_to_interleaved(const Vec3Batch *batch, double_t *xyz) {
+    if (!batch || !xyz)
+        return VECTOR_ERROR_NULL;
+
+    const double_t *restrict x = batch->x;
+    const double_t *restrict y = batch->y;
+    const double_t *restrict z = batch->z;
+    for (size_t i = 0; i < batch->count; i++) {
+        xyz[3 * i] = x[i];
+        xyz[3 * i + 1] = y[i];
+        xyz[3 * i + 2] = z[i];
+    }
+    return VECTOR_SUCCESS;
+}
+
+// Validate every vector before writing anything
+static int check_vectors(const Vector *const *vectors,
+                         size_t count,
+                         size_t size) {
+    for (size_t i = 0; i < count; i++) {
+        if (!vectors[i])
+            return VECTOR_ERROR_NULL;
+        if (!vector_valid(vectors[i]))
+            return VECTOR_ERROR_INIT;
+        if (vectors[i]->size != size)
+            return VECTOR_ERROR_SIZE;
+    }
+    return VECTOR_SUCCESS;
+}
+
+int vec3_batch_from_vectors(const Vector *const *vectors, Vec3Batch *batch) {
+    if (!vectors || !batch)
+        return VECTOR_ERROR_NULL;
+
+    int err = check_vectors(vectors, batch->count, 3);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    for (size_t i = 0; i < batch->count; i++) {
+        const double_t *v = vectors[i]->elements;
+        batch->x[i] = v[0];
+        batch->y[i] = v[1];
+        batch->z[i] = v[2];
+    }
+    return VECTOR_SUCCESS;
+}
+
+int vec3_batch_to_vectors(const Vec3Batch *batch, Vector *const *vectors) {
+    if (!batch || !vectors)
+        return VECTOR_ERROR_NULL;
+
+    int err = check_vectors((const Vector *const *)vectors, batch->count, 3);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    for (size_t i = 0; i < batch->count; i++) {
+        double_t *v = vectors[i]->elements;
+        v[0] = batch->x[i];
+        v[1] = batch->y[i];
+        v[2] = batch->z[i];
+    }
+    return VECTOR_SUCCESS;
+}
+
+int vec4_batch_from_interleaved(const double_t *xyzw, Vec4Batch *batch) {
+    if (!xyzw || !batch)
+        return VECTOR_ERROR_NULL;
+
+    size_t i = 0;
+#if defined(__AVX2__)
+    // Four points form a 4x4 block, transposing it yields x, y, z, w rows
+    for (; i + 4 <= batch->count; i += 4) {
+        __m256d r0 = _mm256_loadu_pd(xyzw + 4 * i);
+        __m256d r1 = _mm256_loadu_pd(xyzw + 4 * i + 4);
+        __m256d r2 = _mm256_loadu_pd(xyzw + 4 * i + 8);
+        __m256d r3 = _mm256_loadu_pd(xyzw + 4 * i + 12);
+        simd_transpose4x4_pd(&r0, &r1, &r2, &r3);
+        _mm256_storeu_pd(batch->x + i, r0);
+        _mm256_storeu_pd(batch->y + i, r1);
+        _mm256_storeu_pd(batch->z + i, r2);
+        _mm256_storeu_pd(batch->w + i, r3);
+    }
+#endif
+    for (; i < batch->count; i++) {
+        batch->x[i] = xyzw[4 * i];
+        batch->y[i] = xyzw[4 * i + 1];
+        batch->z[i] = xyzw[4 * i + 2];
+        batch->w[i] = xyzw[4 * i + 3];
+    }
+    return VECTOR_SUCCESS;
+}
+
+int vec4_batch_to_interleaved(const Vec4Batch *batch, double_t *xyzw) {
+    if (!batch || !xyzw)
+        return VECTOR_ERROR_NULL;
+
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= batch->count; i += 4) {
+        __m256d r0 = _mm256_loadu_pd(batch->x + i);
+        __m256d r1 = _mm256_loadu_pd(batch->y + i);
+        __m256d r2 = _mm256_loadu_pd(batch->z + i);
+        __m256d r3 = _mm256_loadu_pd(batch->w + i);
+        simd_transpose4x4_pd(&r0, &r1, &r2, &r3);
+        _mm256_storeu_pd(xyzw + 4 * i, r0);
+        _mm256_storeu_pd(xyzw + 4 * i + 4, r1);
+        _mm256_storeu_pd(xyzw + 4 * i + 8, r2);
+        _mm256_storeu_pd(xyzw + 4 * i + 12, r3);
+    }
+#endif
+    for (; i < batch->count; i++) {
+        xyzw[4 * i] = batch->x[i];
+        xyzw[4 * i + 1] = batch->y[i];
+        xyzw[4 * i + 2] = batch->z[i];
+        xyzw[4 * i + 3] = batch->w[i];
+    }
+    return VECTOR_SUCCESS;
+}
+
+int vec4_batch_from_vectors(const Vector *const *vectors, Vec4Batch *batch) {
+    if (!vectors || !batch)
+        return VECTOR_ERROR_NULL;
+
+    int err = check_vectors(vectors, batch->count, 4);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    for (size_t i = 0; i < batch->count; i++) {
+        const double_t *v = vectors[i]->elements;
+        batch->x[i] = v[0];
+        batch->y[i] = v[1];
+        batch->z[i] = v[2];
+        batch->w[i] = v[3];
+    }
+    return VECTOR_SUCCESS;
+}
+
+int vec4_batch_to_vectors(const Vec4Batch *batch, Vector *const *vectors) {
+    if (!batch || !vectors)
+        return VECTOR_ERROR_NULL;
+
+    int err = check_vectors((const Vector *const *)vectors, batch->count, 4);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    for (size_t i = 0; i < batch->count; i++) {
+        double_t *v = vectors[i]->elements;
+        v[0] = batch->x[i];
+        v[1] = batch->y[i];
+        v[2] = batch->z[i];
+        v[3] = batch->w[i];
+    }
+    return VECTOR_SUCCESS;
+}
@@ -0,0 +1,476 @@
+/**
+ * @file blas.c
+ * @brief Internal dense kernels on strided row-major blocks and sparse
+ *        kernels on CSR matrices
+ * @date 18/10/26
+ */
+
+#include "blas.h"
+#include "pool.h"
+#include "simd.h"
+#include "vector.h"
+#include <stdlib.h>
+
+#define GEMM_KC 256 ///< Depth of a k block, keeps A and B panels in L2
+#define GEMM_NC 512 ///< Width of a column block of B and C
+#define GEMM_ROWS_PER_TASK 32 ///< Rows of C per parallel task
+#define GEMM_PARALLEL_MIN 262144 ///< m * n * k below which threads do not pay
+#define SYRK_TILE 128 ///< Rows and columns of one tile of C
+#define CSRMV_NNZ_PER_TASK 32768 ///< Nonzeros per parallel task
+
+// --- GEMM ---
+
+// c_r[0..n) += a_r * b[0..n) for four rows r at once, one pass over b
+static void gemm_rows4(size_t n,
+                       const double_t *b,
+                       double_t a0,
+                       double_t a1,
+                       double_t a2,
+                       double_t a3,
+                       double_t *restrict c0,
+                       double_t *restrict c1,
+                       double_t *restrict c2,
+                       double_t *restrict c3) {
+    size_t j = 0;
+#if defined(__AVX2__) && defined(__FMA__)
+    const __m256d va0 = _mm256_set1_pd(a0);
+    const __m256d va1 = _mm256_set1_pd(a1);
+    const __m256d va2 = _mm256_set1_pd(a2);
+    const __m256d va3 = _mm256_set1_pd(a3);
+    for (; j + 4 <= n; j += 4) {
+        __m256d vb = _mm256_loadu_pd(b + j);
+        _mm256_storeu_pd(c0 + j,
+                         _mm256_fmadd_pd(va0, vb, _mm256_loadu_pd(c0 + j)));
+        _mm256_storeu_pd(c1 + j,
+                         _mm256_fmadd_pd(va1, vb, _mm256_loadu_pd(c1 + j)));
+        _mm256_storeu_pd(c2 + j,
+                         _mm256_fmadd_pd(va2, vb, _mm256_loadu_pd(c2 + j)));
+        _mm256_storeu_pd(c3 + j,
+                         _mm256_fmadd_pd(va3, vb, _mm256_loadu_pd(c3 + j)));
+    }
+#endif
+    for (; j < n; j++) {
+        const double_t bj = b[j];
+        c0[j] += a0 * bj;
+        c1[j] += a1 * bj;
+        c2[j] += a2 * bj;
+        c3[j] += a3 * bj;
+    }
+}
+
+static void gemm_row1(size_t n,
+                      const double_t *restrict b,
+                      double_t a0,
+                      double_t *restrict c0) {
+    for (size_t j = 0; j < n; j++) {
+        c0[j] += a0 * b[j];
+    }
+}
+
+void blas_gemm(size_t m,
+               size_t n,
+               size_t k,
+               double_t alpha,
+               const double_t *a,
+               size_t lda,
+               const double_t *b,
+               size_t ldb,
+               double_t *c,
+               size_t ldc) {
+    for (size_t jj = 0; jj < n; jj += GEMM_NC) {
+        const size_t nb = n - jj < GEMM_NC ? n - jj : GEMM_NC;
+
+        for (size_t kk = 0; kk < k; kk += GEMM_KC) {
+            const size_t kb = k - kk < GEMM_KC ? k - kk : GEMM_KC;
+
+            size_t i = 0;
+            for (; i + 4 <= m; i += 4) {
+                const double_t *a_row = a + i * lda + kk;
+                double_t *c_row = c + i * ldc + jj;
+                for (size_t p = 0; p < kb; p++) {
+                    gemm_rows4(nb,
+                               b + (kk + p) * ldb + jj,
+                               alpha * a_row[p],
+                               alpha * a_row[lda + p],
+                               alpha * a_row[2 * lda + p],
+                               alpha * a_row[3 * lda + p],
+                               c_row,
+                               c_row + ldc,
+                               c_row + 2 * ldc,
+                               c_row + 3 * ldc);
+                }
+            }
+            for (; i < m; i++) {
+                const double_t *a_row = a + i * lda + kk;
+                for (size_t p = 0; p < kb; p++) {
+                    gemm_row1(nb,
+                              b + (kk + p) * ldb + jj,
+                              alpha * a_row[p],
+                              c + i * ldc + jj);
+                }
+            }
+        }
+    }
+}
+
+void blas_gemm_nt(size_t m,
+                  size_t n,
+                  size_t k,
+                  double_t alpha,
+                  const double_t *a,
+                  size_t lda,
+                  const double_t *b,
+                  size_t ldb,
+                  double_t *c,
+                  size_t ldc) {
+    for (size_t kk = 0; kk < k; kk += GEMM_KC) {
+        const size_t kb = k - kk < GEMM_KC ? k - kk : GEMM_KC;
+
+        for (size_t i = 0; i < m; i++) {
+            const double_t *restrict a_row = a + i * lda + kk;
+            double_t *c_row = c + i * ldc;
+            size_t j = 0;
+
+            // Four dot products share each load of a_row
+            for (; j + 4 <= n; j += 4) {
+                const double_t *restrict b0 = b + j * ldb + kk;
+                const double_t *restrict b1 = b0 + ldb;
+                const double_t *restrict b2 = b1 + ldb;
+                const double_t *restrict b3 = b2 + ldb;
+                double_t s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+                for (size_t p = 0; p < kb; p++) {
+                    const double_t x = a_row[p];
+                    s0 += x * b0[p];
+                    s1 += x * b1[p];
+                    s2 += x * b2[p];
+                    s3 += x * b3[p];
+                }
+                c_row[j] += alpha * s0;
+                c_row[j + 1] += alpha * s1;
+                c_row[j + 2] += alpha * s2;
+                c_row[j + 3] += alpha * s3;
+            }
+            for (; j < n; j++) {
+                const double_t *restrict b0 = b + j * ldb + kk;
+                double_t s0 = 0.0;
+                for (size_t p = 0; p < kb; p++) {
+                    s0 += a_row[p] * b0[p];
+                }
+                c_row[j] += alpha * s0;
+            }
+        }
+    }
+}
+
+typedef struct {
+    size_t m, n, k;
+    double_t alpha;
+    const double_t *a;
+    size_t lda;
+    const double_t *b;
+    size_t ldb;
+    double_t *c;
+    size_t ldc;
+} GemmJob;
+
+static void gemm_task(void *ctx, size_t task) {
+    const GemmJob *job = ctx;
+    const size_t row = task * GEMM_ROWS_PER_TASK;
+    const size_t rows = job->m - row < GEMM_ROWS_PER_TASK
+                            ? job->m - row
+                            : GEMM_ROWS_PER_TASK;
+
+    blas_gemm(rows,
+              job->n,
+              job->k,
+              job->alpha,
+              job->a + row * job->lda,
+              job->lda,
+              job->b,
+              job->ldb,
+              job->c + row * job->ldc,
+              job->ldc);
+}
+
+int blas_gemm_parallel(size_t m,
+                       size_t n,
+                       size_t k,
+                       double_t alpha,
+                       const double_t *a,
+                       size_t lda,
+                       const double_t *b,
+                       size_t ldb,
+                       double_t *c,
+                       size_t ldc) {
+    const size_t tasks = (m + GEMM_ROWS_PER_TASK - 1) / GEMM_ROWS_PER_TASK;
+    if (tasks < 2 || (double)m * (double)n * (double)k < GEMM_PARALLEL_MIN) {
+        blas_gemm(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+        return VECTOR_SUCCESS;
+    }
+
+    GemmJob job = {
+        .m = m,
+        .n = n,
+        .k = k,
+        .alpha = alpha,
+        .a = a,
+        .lda = lda,
+        .b = b,
+        .ldb = ldb,
+        .c = c,
+        .ldc = ldc,
+    };
+    return pool_parallel_for(tasks, gemm_task, &job);
+}
+
+// --- SYRK ---
+
+typedef struct {
+    size_t n, k;
+    double_t alpha;
+    const double_t *a;
+    size_t lda;
+    const double_t *a_t; ///< k x n transpose of A
+    size_t ldt;
+    double_t *c;
+    size_t ldc;
+    size_t tiles; ///< Tiles along each side of C
+    bool lower; ///< Tiles on or below the diagonal instead of above
+} SyrkJob;
+
+// One tile of the upper triangle, tasks enumerate tile rows in order; the
+// lower triangle uses the mirrored tile
+static void syrk_task(void *ctx, size_t task) {
+    const SyrkJob *job = ctx;
+    size_t ti = 0;
+    size_t remaining = task;
+    while (remaining >= job->tiles - ti) {
+        remaining -= job->tiles - ti;
+        ti++;
+    }
+    size_t tj = ti + remaining;
+    if (job->lower) {
+        const size_t swap = ti;
+        ti = tj;
+        tj = swap;
+    }
+
+    const size_t i0 = ti * SYRK_TILE;
+    const size_t j0 = tj * SYRK_TILE;
+    const size_t mb = job->n - i0 < SYRK_TILE ? job->n - i0 : SYRK_TILE;
+    const size_t nb = job->n - j0 < SYRK_TILE ? job->n - j0 : SYRK_TILE;
+
+    blas_gemm(mb,
+              nb,
+              job->k,
+              job->alpha,
+              job->a + i0 * job->lda,
+              job->lda,
+              job->a_t + j0,
+              job->ldt,
+              job->c + i0 * job->ldc + j0,
+              job->ldc);
+}
+
+int blas_syrk(size_t n,
+              size_t k,
+              double_t alpha,
+              const double_t *a,
+              size_t lda,
+              double_t *c,
+              size_t ldc) {
+    if (n == 0 || k == 0)
+        return VECTOR_SUCCESS;
+
+    // The GEMM kernel streams rows of B, so B = A^T is packed once
+    double_t *a_t = malloc(k * n * sizeof(double_t));
+    if (!a_t)
+        return VECTOR_ERROR_MEM;
+    for (size_t i = 0; i < n; i++) {
+        const double_t *row = a + i * lda;
+        for (size_t p = 0; p < k; p++) {
+            a_t[p * n + i] = row[p];
+        }
+    }
+
+    int err = blas_syrk_packed(n, k, alpha, a, lda, a_t, n, c, ldc);
+    free(a_t);
+    return err;
+}
+
+static int syrk_run(size_t n,
+                    size_t k,
+                    double_t alpha,
+                    const double_t *a,
+                    size_t lda,
+                    const double_t *a_t,
+                    size_t ldt,
+                    double_t *c,
+                    size_t ldc,
+                    bool lower) {
+    if (n == 0 || k == 0)
+        return VECTOR_SUCCESS;
+
+    const size_t tiles = (n + SYRK_TILE - 1) / SYRK_TILE;
+    SyrkJob job = {
+        .n = n,
+        .k = k,
+        .alpha = alpha,
+        .a = a,
+        .lda = lda,
+        .a_t = a_t,
+        .ldt = ldt,
+        .c = c,
+        .ldc = ldc,
+        .tiles = tiles,
+        .lower = lower,
+    };
+
+    const size_t tasks = tiles * (tiles + 1) / 2;
+    if (tasks < 2 || 0.5 * (double)n * (double)n * (double)k <
+                         GEMM_PARALLEL_MIN) {
+        for (size_t task = 0; task < tasks; task++) {
+            syrk_task(&job, task);
+        }
+        return VECTOR_SUCCESS;
+    }
+    return pool_parallel_for(tasks, syrk_task, &job);
+}
+
+int blas_syrk_packed(size_t n,
+                     size_t k,
+                     double_t alpha,
+                     const double_t *a,
+                     size_t lda,
+                     const double_t *a_t,
+                     size_t ldt,
+                     double_t *c,
+                     size_t ldc) {
+    return syrk_run(n, k, alpha, a, lda, a_t, ldt, c, ldc, false);
+}
+
+int blas_syrk_lower_packed(size_t n,
+                           size_t k,
+                           double_t alpha,
+                           const double_t *a,
+                           size_t lda,
+                           const double_t *a_t,
+                           size_t ldt,
+                           double_t *c,
+                           size_t ldc) {
+    return syrk_run(n, k, alpha, a, lda, a_t, ldt, c, ldc, true);
+}
+
+// --- Triangular solve ---
+
+void blas_trsm_lower_unit(size_t m,
+                          size_t n,
+                          const double_t *l,
+                          size_t ldl,
+                          double_t *b,
+                          size_t ldb) {
+    for (size_t i = 1; i < m; i++) {
+        double_t *b_row = b + i * ldb;
+        for (size_t p = 0; p < i; p++) {
+            gemm_row1(n, b + p * ldb, -l[i * ldl + p], b_row);
+        }
+    }
+}
+
+// --- Householder ---
+
+double_t blas_householder(double_t *x, size_t len, size_t stride) {
+    double_t sigma = 0.0;
+    for (size_t i = 1; i < len; i++) {
+        sigma += x[i * stride] * x[i * stride];
+    }
+    if (sigma == 0.0)
+        return 0.0;
+
+    const double_t alpha = x[0];
+    const double_t norm = sqrt(alpha * alpha + sigma);
+    const double_t beta = alpha >= 0.0 ? -norm : norm;
+    const double_t scale = 1.0 / (alpha - beta);
+    for (size_t i = 1; i < len; i++) {
+        x[i * stride] *= scale;
+    }
+    x[0] = beta;
+    return (beta - alpha) / beta;
+}
+
+// --- Sparse ---
+
+typedef struct {
+    const SparseMatrix *a;
+    const double_t *x;
+    double_t *y;
+    size_t nnz;
+    size_t tasks;
+} CsrmvJob;
+
+// First row whose nonzeros start at or after target
+static size_t csr_row_at(const size_t *offsets, size_t rows, size_t target) {
+    size_t lo = 0;
+    size_t hi = rows;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (offsets[mid] < target)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static void csrmv_rows(const SparseMatrix *a,
+                       const double_t *restrict x,
+                       double_t *restrict y,
+                       size_t begin,
+                       size_t end) {
+    const double_t *values = a->values;
+    const size_t *columns = a->columns;
+    const size_t *offsets = a->offsets;
+
+    for (size_t i = begin; i < end; i++) {
+        double_t sum = 0.0;
+        for (size_t p = offsets[i]; p < offsets[i + 1]; p++) {
+            sum += values[p] * x[columns[p]];
+        }
+        y[i] = sum;
+    }
+}
+
+// Task boundaries split the nonzeros evenly, so long rows do not pile up
+// on one thread
+static void csrmv_task(void *ctx, size_t task) {
+    CsrmvJob *job = ctx;
+    const SparseMatrix *a = job->a;
+    const size_t begin =
+        task == 0 ? 0
+                  : csr_row_at(a->offsets, a->rows,
+                               task * job->nnz / job->tasks);
+    const size_t end =
+        task + 1 == job->tasks
+            ? a->rows
+            : csr_row_at(a->offsets, a->rows,
+                         (task + 1) * job->nnz / job->tasks);
+    csrmv_rows(a, job->x, job->y, begin, end);
+}
+
+int blas_csrmv(const SparseMatrix *a, const double_t *x, double_t *y) {
+    const size_t nnz = a->offsets[a->rows];
+    const size_t tasks = nnz / CSRMV_NNZ_PER_TASK;
+    if (tasks < 2) {
+        csrmv_rows(a, x, y, 0, a->rows);
+        return VECTOR_SUCCESS;
+    }
+
+    CsrmvJob job = {
+        .a = a,
+        .x = x,
+        .y = y,
+        .nnz = nnz,
+        .tasks = tasks,
+    };
+    return pool_parallel_for(tasks, csrmv_task, &job);
+}
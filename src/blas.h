@@ -0,0 +1,146 @@
+/**
+ * @file blas.h
+ * @brief Internal dense kernels on strided row-major blocks and sparse
+ *        kernels on CSR matrices
+ * @date 18/10/26
+ *
+ * Every block is given by a pointer to its first element and a leading
+ * dimension (distance between consecutive rows), so kernels work on
+ * sub-blocks of larger matrices without copying.
+ */
+
+#ifndef __BLAS_H
+#define __BLAS_H
+
+#include "sparse.h"
+#include <stddef.h>
+#include <math.h>
+
+/**
+ * @brief C += alpha * A * B with A m x k, B k x n, C m x n
+ */
+void blas_gemm(size_t m,
+               size_t n,
+               size_t k,
+               double_t alpha,
+               const double_t *a,
+               size_t lda,
+               const double_t *b,
+               size_t ldb,
+               double_t *c,
+               size_t ldc);
+
+/**
+ * @brief C += alpha * A * B^T with A m x k, B n x k, C m x n
+ *
+ * @note Dot-product form for operands stored as rows, each k block of B
+ *       is reused across all rows of A while it is in cache
+ */
+void blas_gemm_nt(size_t m,
+                  size_t n,
+                  size_t k,
+                  double_t alpha,
+                  const double_t *a,
+                  size_t lda,
+                  const double_t *b,
+                  size_t ldb,
+                  double_t *c,
+                  size_t ldc);
+
+/**
+ * @brief blas_gemm() split over rows of C on the worker pool
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Small products run on the calling thread
+ */
+int blas_gemm_parallel(size_t m,
+                       size_t n,
+                       size_t k,
+                       double_t alpha,
+                       const double_t *a,
+                       size_t lda,
+                       const double_t *b,
+                       size_t ldb,
+                       double_t *c,
+                       size_t ldc);
+
+/**
+ * @brief Upper triangle of C += alpha * A * A^T with A n x k, C n x n
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Only tiles on or above the diagonal are computed, split over the
+ *       worker pool. Entries below the diagonal inside diagonal tiles are
+ *       updated too, the rest of the lower triangle is left alone.
+ */
+int blas_syrk(size_t n,
+              size_t k,
+              double_t alpha,
+              const double_t *a,
+              size_t lda,
+              double_t *c,
+              size_t ldc);
+
+/**
+ * @brief blas_syrk() with the transpose of A supplied by the caller
+ * @param a_t k x n transpose of A, leading dimension ldt
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note For callers that pack A themselves and can write both layouts in
+ *       the same pass into buffers they reuse
+ */
+int blas_syrk_packed(size_t n,
+                     size_t k,
+                     double_t alpha,
+                     const double_t *a,
+                     size_t lda,
+                     const double_t *a_t,
+                     size_t ldt,
+                     double_t *c,
+                     size_t ldc);
+
+/**
+ * @brief blas_syrk_packed() for the lower triangle of C
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Only tiles on or below the diagonal are computed. Entries above
+ *       the diagonal inside diagonal tiles are updated too.
+ */
+int blas_syrk_lower_packed(size_t n,
+                           size_t k,
+                           double_t alpha,
+                           const double_t *a,
+                           size_t lda,
+                           const double_t *a_t,
+                           size_t ldt,
+                           double_t *c,
+                           size_t ldc);
+
+/**
+ * @brief B = L^-1 * B with L m x m unit lower triangular, B m x n
+ */
+void blas_trsm_lower_unit(size_t m,
+                          size_t n,
+                          const double_t *l,
+                          size_t ldl,
+                          double_t *b,
+                          size_t ldb);
+
+/**
+ * @brief Householder reflector H = I - tau * v * v^T with
+ *        H * x = (beta, 0, ..., 0)
+ * @return tau, 0 if x is already in that form
+ *
+ * x has len elements at the given stride. On return x[0] holds beta and
+ * x[1..] hold v[1..], v[0] = 1 is implicit. x is unchanged if tau is 0.
+ */
+double_t blas_householder(double_t *x, size_t len, size_t stride);
+
+/**
+ * @brief y = A * x for a CSR matrix, split over the worker pool
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note No structure checks, see sparse_check(). y must not alias x.
+ */
+int blas_csrmv(const SparseMatrix *a, const double_t *x, double_t *y);
+
+#endif // !__BLAS_H
@@ -0,0 +1,168 @@
+/**
+ * @file covariance.c
+ * @brief Gram, covariance and correlation matrices of vector collections
+ * @date 18/10/26
+ */
+
+#include "covariance.h"
+#include "blas.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Elements of each vector in one packed slice, two GEMM k blocks so every
+// tile of the product is loaded once per 512 elements however many
+// vectors there are
+#define COVARIANCE_KC 512
+#define COVARIANCE_MIRROR_TILE 64
+
+typedef enum {
+    PRODUCT_GRAM,
+    PRODUCT_COVARIANCE,
+    PRODUCT_CORRELATION
+} ProductKind;
+
+static int check_vectors(const Vector *const *vectors,
+                         size_t count,
+                         const Matrix *out) {
+    if (!vectors || !out)
+        return VECTOR_ERROR_NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (!vectors[i])
+            return VECTOR_ERROR_NULL;
+    }
+
+    if (!matrix_valid(out))
+        return VECTOR_ERROR_INIT;
+    for (size_t i = 0; i < count; i++) {
+        if (!vector_valid(vectors[i]))
+            return VECTOR_ERROR_INIT;
+    }
+
+    if (count == 0 || out->rows != count || out->cols != count)
+        return VECTOR_ERROR_SIZE;
+    for (size_t i = 1; i < count; i++) {
+        if (vectors[i]->size != vectors[0]->size)
+            return VECTOR_ERROR_SIZE;
+    }
+    return VECTOR_SUCCESS;
+}
+
+static int vector_products(const Vector *const *vectors,
+                           size_t count,
+                           Matrix *out,
+                           ProductKind kind) {
+    int err = check_vectors(vectors, count, out);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    const size_t len = vectors[0]->size;
+    if (kind != PRODUCT_GRAM && len < 2)
+        return VECTOR_ERROR_SIZE;
+
+    double_t *c = out->elements;
+    memset(c, 0, count * count * sizeof(double_t));
+    if (len == 0)
+        return VECTOR_SUCCESS;
+
+    const size_t kc = len < COVARIANCE_KC ? len : COVARIANCE_KC;
+    double_t *means = calloc(count, sizeof(double_t));
+    double_t *panel = malloc(count * kc * sizeof(double_t));
+    double_t *panel_t = malloc(kc * count * sizeof(double_t));
+    if (!means || !panel || !panel_t) {
+        free(means);
+        free(panel);
+        free(panel_t);
+        return VECTOR_ERROR_MEM;
+    }
+
+    if (kind != PRODUCT_GRAM) {
+        for (size_t i = 0; i < count; i++) {
+            const double_t *v = vectors[i]->elements;
+            double_t sum = 0.0;
+            for (size_t p = 0; p < len; p++) {
+                sum += v[p];
+            }
+            means[i] = sum / (double_t)len;
+        }
+    }
+
+    // Accumulate slice by slice: pack (and center) kc elements of every
+    // vector into both layouts the kernel reads, then one rank-kc update
+    // of the upper triangle, computed tile by tile
+    for (size_t k0 = 0; k0 < len && err == VECTOR_SUCCESS; k0 += kc) {
+        const size_t kb = len - k0 < kc ? len - k0 : kc;
+        for (size_t i = 0; i < count; i++) {
+            const double_t *v = vectors[i]->elements + k0;
+            double_t *row = panel + i * kb;
+            const double_t mean = means[i];
+            for (size_t p = 0; p < kb; p++) {
+                const double_t value = v[p] - mean;
+                row[p] = value;
+                panel_t[p * count + i] = value;
+            }
+        }
+        err = blas_syrk_packed(
+            count, kb, 1.0, panel, kb, panel_t, count, c, count);
+    }
+
+    if (err == VECTOR_SUCCESS) {
+        // Per-row scale, reusing means: 1 / (len - 1) folded into the
+        // covariance, 1 / sqrt(c_ii) for correlation
+        const double_t scale =
+            kind == PRODUCT_COVARIANCE ? 1.0 / (double_t)(len - 1) : 1.0;
+        for (size_t i = 0; i < count; i++) {
+            const double_t d = c[i * count + i];
+            means[i] = kind == PRODUCT_CORRELATION
+                           ? (d > 0.0 ? 1.0 / sqrt(d) : 0.0)
+                           : 1.0;
+        }
+
+        // Scale the upper triangle and mirror it tile by tile, so the
+        // column-wise writes stay within a few cache lines
+        for (size_t ii = 0; ii < count; ii += COVARIANCE_MIRROR_TILE) {
+            const size_t i_end = ii + COVARIANCE_MIRROR_TILE < count
+                                     ? ii + COVARIANCE_MIRROR_TILE
+                                     : count;
+            for (size_t jj = ii; jj < count; jj += COVARIANCE_MIRROR_TILE) {
+                const size_t j_end = jj + COVARIANCE_MIRROR_TILE < count
+                                         ? jj + COVARIANCE_MIRROR_TILE
+                                         : count;
+                for (size_t i = ii; i < i_end; i++) {
+                    const double_t row_scale = scale * means[i];
+                    for (size_t j = i > jj ? i : jj; j < j_end; j++) {
+                        const double_t value =
+                            c[i * count + j] * row_scale * means[j];
+                        c[i * count + j] = value;
+                        c[j * count + i] = value;
+                    }
+                }
+            }
+        }
+        if (kind == PRODUCT_CORRELATION) {
+            for (size_t i = 0; i < count; i++) {
+                c[i * count + i] = means[i] > 0.0 ? 1.0 : 0.0;
+            }
+        }
+    }
+
+    free(means);
+    free(panel);
+    free(panel_t);
+    return err;
+}
+
+int vector_gram(const Vector *const *vectors, size_t count, Matrix *out) {
+    return vector_products(vectors, count, out, PRODUCT_GRAM);
+}
+
+int vector_covariance(const Vector *const *vectors,
+                      size_t count,
+                      Matrix *out) {
+    return vector_products(vectors, count, out, PRODUCT_COVARIANCE);
+}
+
+int vector_correlation(const Vector *const *vectors,
+                       size_t count,
+                       Matrix *out) {
+    return vector_products(vectors, count, out, PRODUCT_CORRELATION);
+}
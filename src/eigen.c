@@ -0,0 +1,962 @@
+/**
+ * @file eigen.c
+ * @brief Symmetric eigensolvers, randomized SVD and PCA
+ * @date 18/10/26
+ */
+
+#include "eigen.h"
+#include "blas.h"
+#include "linalg.h"
+#include <float.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EIGEN_SWEEPS_PER_VALUE 30 ///< QR steps per eigenvalue before failing
+#define LANCZOS_MIN_STEPS 32
+#define LANCZOS_TOLERANCE 1e-10 ///< Ritz residual relative to largest |value|
+#define SVD_SEED 0x9e3779b97f4a7c15u
+#define PCA_OVERSAMPLE 10
+#define PCA_POWER_ITERATIONS 2
+
+// --- Random numbers ---
+
+static uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15u);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+    return z ^ (z >> 31);
+}
+
+// Standard normal sample (Box-Muller, one of the pair)
+static double_t random_gaussian(uint64_t *state) {
+    const double_t scale = 1.0 / 9007199254740992.0; // 2^-53
+    double_t u1 = ((double_t)(splitmix64(state) >> 11) + 1.0) * scale;
+    double_t u2 = (double_t)(splitmix64(state) >> 11) * scale;
+    return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+// --- Small helpers ---
+
+static double_t dot(const double_t *a, const double_t *b, size_t n) {
+    double_t sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+// y = A * x for row-major n x n A
+static void matvec(const double_t *a, size_t n, const double_t *x, double_t *y) {
+    for (size_t i = 0; i < n; i++) {
+        y[i] = dot(a + i * n, x, n);
+    }
+}
+
+typedef struct {
+    double_t value;
+    size_t index;
+} EigenOrder;
+
+static int compare_descending(const void *lhs, const void *rhs) {
+    const EigenOrder *a = lhs;
+    const EigenOrder *b = rhs;
+    return (a->value < b->value) - (a->value > b->value);
+}
+
+// Indices of d sorted by descending value
+static int sort_descending(const double_t *d, size_t n, size_t *order) {
+    EigenOrder *pairs = malloc(n * sizeof(EigenOrder));
+    if (!pairs)
+        return VECTOR_ERROR_MEM;
+
+    for (size_t i = 0; i < n; i++) {
+        pairs[i].value = d[i];
+        pairs[i].index = i;
+    }
+    qsort(pairs, n, sizeof(EigenOrder), compare_descending);
+    for (size_t i = 0; i < n; i++) {
+        order[i] = pairs[i].index;
+    }
+
+    free(pairs);
+    return VECTOR_SUCCESS;
+}
+
+// --- Tridiagonal eigenproblem ---
+
+/*
+ * Reduce symmetric a (n x n, overwritten) to tridiagonal form
+ * Q^T * a * Q = T with diagonal d and subdiagonal e. If z is given it
+ * receives Q^T, so eigenvectors end up as its rows.
+ */
+static int tridiagonalize(double_t *a,
+                          size_t n,
+                          double_t *d,
+                          double_t *e,
+                          double_t *z) {
+    double_t *v = malloc(2 * n * sizeof(double_t));
+    if (!v)
+        return VECTOR_ERROR_MEM;
+    double_t *w = v + n;
+
+    if (z) {
+        memset(z, 0, n * n * sizeof(double_t));
+        for (size_t i = 0; i < n; i++) {
+            z[i * n + i] = 1.0;
+        }
+    }
+
+    for (size_t k = 0; k + 2 < n; k++) {
+        const size_t len = n - k - 1;
+        for (size_t i = 0; i < len; i++) {
+            v[i] = a[(k + 1 + i) * n + k];
+        }
+
+        const double_t tau = blas_householder(v, len, 1);
+        e[k] = v[0];
+        if (tau == 0.0)
+            continue;
+        v[0] = 1.0;
+
+        // S = H S H on the trailing block as S -= v w^T + w v^T
+        double_t *s = a + (k + 1) * n + (k + 1);
+        for (size_t i = 0; i < len; i++) {
+            w[i] = tau * dot(s + i * n, v, len);
+        }
+        const double_t half = 0.5 * tau * dot(w, v, len);
+        for (size_t i = 0; i < len; i++) {
+            w[i] -= half * v[i];
+        }
+        for (size_t i = 0; i < len; i++) {
+            double_t *row = s + i * n;
+            for (size_t j = 0; j < len; j++) {
+                row[j] -= v[i] * w[j] + w[i] * v[j];
+            }
+        }
+
+        // Z = H Z on rows k + 1 .. n
+        if (z) {
+            double_t *rows = z + (k + 1) * n;
+            double_t *u = w; // w is free again
+            memset(u, 0, n * sizeof(double_t));
+            for (size_t i = 0; i < len; i++) {
+                const double_t *row = rows + i * n;
+                for (size_t j = 0; j < n; j++) {
+                    u[j] += v[i] * row[j];
+                }
+            }
+            for (size_t i = 0; i < len; i++) {
+                double_t *row = rows + i * n;
+                const double_t scale = tau * v[i];
+                for (size_t j = 0; j < n; j++) {
+                    row[j] -= scale * u[j];
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        d[i] = a[i * n + i];
+    }
+    if (n >= 2)
+        e[n - 2] = a[(n - 1) * n + (n - 2)];
+
+    free(v);
+    return VECTOR_SUCCESS;
+}
+
+// One implicit QR step with Wilkinson shift on the block [start, end]
+static void tridiagonal_qr_step(double_t *d,
+                                double_t *e,
+                                size_t start,
+                                size_t end,
+                                double_t *z,
+                                size_t z_cols) {
+    const double_t td = 0.5 * (d[end - 1] - d[end]);
+    const double_t e_end = e[end - 1];
+    double_t mu = d[end];
+    if (td == 0.0) {
+        mu -= fabs(e_end);
+    } else {
+        const double_t h = hypot(td, e_end);
+        mu -= e_end * e_end / (td + (td > 0.0 ? h : -h));
+    }
+
+    double_t x = d[start] - mu;
+    double_t bulge = e[start];
+    for (size_t k = start; k < end && bulge != 0.0; k++) {
+        const double_t r = hypot(x, bulge);
+        const double_t c = x / r;
+        const double_t s = -bulge / r;
+
+        // T = G^T T G on rows and columns k, k + 1
+        const double_t sdk = s * d[k] + c * e[k];
+        const double_t dkp1 = s * e[k] + c * d[k + 1];
+        d[k] = c * (c * d[k] - s * e[k]) - s * (c * e[k] - s * d[k + 1]);
+        d[k + 1] = s * sdk + c * dkp1;
+        e[k] = c * sdk - s * dkp1;
+        if (k > start)
+            e[k - 1] = c * e[k - 1] - s * bulge;
+
+        x = e[k];
+        if (k + 1 < end) {
+            bulge = -s * e[k + 1];
+            e[k + 1] = c * e[k + 1];
+        }
+
+        if (z) {
+            double_t *row_k = z + k * z_cols;
+            double_t *row_k1 = row_k + z_cols;
+            for (size_t j = 0; j < z_cols; j++) {
+                const double_t zk = row_k[j];
+                const double_t zk1 = row_k1[j];
+                row_k[j] = c * zk - s * zk1;
+                row_k1[j] = s * zk + c * zk1;
+            }
+        }
+    }
+}
+
+/*
+ * Eigenvalues of the symmetric tridiagonal (d, e) into d. Rotations are
+ * applied to the rows of z (n rows of z_cols), if given.
+ */
+static int tridiagonal_qr(double_t *d,
+                          double_t *e,
+                          size_t n,
+                          double_t *z,
+                          size_t z_cols) {
+    const size_t max_steps = EIGEN_SWEEPS_PER_VALUE * n;
+    size_t steps = 0;
+    size_t end = n - 1;
+
+    while (end > 0) {
+        for (size_t i = 0; i < end; i++) {
+            if (fabs(e[i]) <= DBL_EPSILON * (fabs(d[i]) + fabs(d[i + 1])) ||
+                fabs(e[i]) < DBL_MIN)
+                e[i] = 0.0;
+        }
+        while (end > 0 && e[end - 1] == 0.0) {
+            end--;
+        }
+        if (end == 0)
+            break;
+
+        size_t start = end - 1;
+        while (start > 0 && e[start - 1] != 0.0) {
+            start--;
+        }
+
+        if (++steps > max_steps)
+            return VECTOR_ERROR_MATH;
+        tridiagonal_qr_step(d, e, start, end, z, z_cols);
+    }
+    return VECTOR_SUCCESS;
+}
+
+// --- Symmetric eigenproblems ---
+
+int matrix_eigen_symmetric(const Matrix *a,
+                           Vector *eigenvalues,
+                           Matrix *eigenvectors) {
+    if (!a || !eigenvalues)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a) || !vector_valid(eigenvalues) ||
+        (eigenvectors && !matrix_valid(eigenvectors)))
+        return VECTOR_ERROR_INIT;
+
+    const size_t n = a->rows;
+    if (a->cols != n || eigenvalues->size != n ||
+        (eigenvectors && (eigenvectors->rows != n || eigenvectors->cols != n)))
+        return VECTOR_ERROR_SIZE;
+
+    double_t *work = malloc((n * n + 2 * n) * sizeof(double_t));
+    double_t *z = eigenvectors ? malloc(n * n * sizeof(double_t)) : NULL;
+    size_t *order = malloc(n * sizeof(size_t));
+    if (!work || !order || (eigenvectors && !z)) {
+        free(work);
+        free(z);
+        free(order);
+        return VECTOR_ERROR_MEM;
+    }
+
+    double_t *d = work + n * n;
+    double_t *e = d + n;
+    memcpy(work, a->elements, n * n * sizeof(double_t));
+
+    int err = tridiagonalize(work, n, d, e, z);
+    if (err == VECTOR_SUCCESS)
+        err = tridiagonal_qr(d, e, n, z, n);
+    if (err == VECTOR_SUCCESS)
+        err = sort_descending(d, n, order);
+
+    if (err == VECTOR_SUCCESS) {
+        for (size_t i = 0; i < n; i++) {
+            eigenvalues->elements[i] = d[order[i]];
+        }
+        if (eigenvectors) {
+            for (size_t j = 0; j < n; j++) {
+                const double_t *row = z + order[j] * n;
+                for (size_t i = 0; i < n; i++) {
+                    eigenvectors->elements[i * n + j] = row[i];
+                }
+            }
+        }
+    }
+
+    free(work);
+    free(z);
+    free(order);
+    return err;
+}
+
+int matrix_power_iteration(const Matrix *a,
+                           Vector *vector,
+                           double_t tolerance,
+                           size_t max_iterations,
+                           double_t *eigenvalue) {
+    if (!a || !vector || !eigenvalue)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a) || !vector_valid(vector))
+        return VECTOR_ERROR_INIT;
+    if (a->rows != a->cols || vector->size != a->rows)
+        return VECTOR_ERROR_SIZE;
+
+    const size_t n = a->rows;
+    double_t *x = vector->elements;
+    double_t *y = malloc(n * sizeof(double_t));
+    if (!y)
+        return VECTOR_ERROR_MEM;
+
+    double_t norm = sqrt(dot(x, x, n));
+    if (norm == 0.0) {
+        for (size_t i = 0; i < n; i++) {
+            x[i] = 1.0;
+        }
+        norm = sqrt((double_t)n);
+    }
+    for (size_t i = 0; i < n; i++) {
+        x[i] /= norm;
+    }
+
+    int err = VECTOR_ERROR_MATH;
+    double_t lambda = 0.0;
+    for (size_t iter = 0; iter < max_iterations; iter++) {
+        matvec(a->elements, n, x, y);
+
+        // Rayleigh quotient, x is unit length
+        const double_t next = dot(x, y, n);
+        norm = sqrt(dot(y, y, n));
+        if (norm == 0.0) {
+            lambda = 0.0;
+            err = VECTOR_SUCCESS;
+            break;
+        }
+        for (size_t i = 0; i < n; i++) {
+            x[i] = y[i] / norm;
+        }
+
+        const bool converged =
+            iter > 0 && fabs(next - lambda) <= tolerance * fabs(next);
+        lambda = next;
+        if (converged) {
+            err = VECTOR_SUCCESS;
+            break;
+        }
+    }
+
+    *eigenvalue = lambda;
+    free(y);
+    return err;
+}
+
+// Copy the k leading eigenpairs of the dense solver into the outputs
+static int topk_dense(const Matrix *a,
+                      size_t k,
+                      Vector *eigenvalues,
+                      Matrix *eigenvectors) {
+    const size_t n = a->rows;
+    Vector *values = NULL;
+    Matrix *vectors = NULL;
+
+    int err = vector_create(n, &values);
+    if (err == VECTOR_SUCCESS && eigenvectors)
+        err = matrix_create(n, n, &vectors);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_eigen_symmetric(a, values, vectors);
+
+    if (err == VECTOR_SUCCESS) {
+        memcpy(eigenvalues->elements, values->elements, k * sizeof(double_t));
+        if (eigenvectors) {
+            for (size_t i = 0; i < n; i++) {
+                memcpy(eigenvectors->elements + i * k,
+                       vectors->elements + i * n,
+                       k * sizeof(double_t));
+            }
+        }
+    }
+
+    vector_free(values);
+    if (vectors)
+        matrix_free(vectors);
+    return err;
+}
+
+typedef struct {
+    double_t *basis; ///< Lanczos vectors as rows, steps x n
+    double_t *d; ///< Diagonal of T
+    double_t *e; ///< Subdiagonal of T (beta)
+    double_t *z; ///< Ritz rotations, steps x steps
+    double_t *w; ///< Next Lanczos vector
+    size_t *order;
+} LanczosWorkspace;
+
+static void lanczos_free(LanczosWorkspace *ws) {
+    free(ws->basis);
+    free(ws->d);
+    free(ws->e);
+    free(ws->z);
+    free(ws->w);
+    free(ws->order);
+}
+
+static int lanczos_init(LanczosWorkspace *ws, size_t n, size_t steps) {
+    ws->basis = malloc(steps * n * sizeof(double_t));
+    ws->d = malloc(steps * sizeof(double_t));
+    ws->e = malloc(steps * sizeof(double_t));
+    ws->z = malloc(steps * steps * sizeof(double_t));
+    ws->w = malloc(n * sizeof(double_t));
+    ws->order = malloc(steps * sizeof(size_t));
+    if (!ws->basis || !ws->d || !ws->e || !ws->z || !ws->w || !ws->order) {
+        lanczos_free(ws);
+        return VECTOR_ERROR_MEM;
+    }
+    return VECTOR_SUCCESS;
+}
+
+/*
+ * Lanczos from the unit vector start for at most steps steps, with full
+ * reorthogonalization. Returns the steps taken, fewer on an invariant
+ * subspace, and the final beta through out_beta.
+ */
+static size_t lanczos_run(const double_t *a,
+                          size_t n,
+                          const double_t *start,
+                          size_t steps,
+                          LanczosWorkspace *ws,
+                          double_t *out_beta) {
+    double_t anorm = 0.0;
+    memcpy(ws->basis, start, n * sizeof(double_t));
+
+    for (size_t j = 0; j < steps; j++) {
+        const double_t *q = ws->basis + j * n;
+        matvec(a, n, q, ws->w);
+
+        ws->d[j] = dot(ws->w, q, n);
+        anorm = fmax(anorm, fabs(ws->d[j]));
+
+        // Classical Gram-Schmidt twice against every previous vector
+        for (int pass = 0; pass < 2; pass++) {
+            for (size_t i = 0; i <= j; i++) {
+                const double_t *qi = ws->basis + i * n;
+                const double_t proj = dot(ws->w, qi, n);
+                for (size_t c = 0; c < n; c++) {
+                    ws->w[c] -= proj * qi[c];
+                }
+            }
+        }
+
+        const double_t beta = sqrt(dot(ws->w, ws->w, n));
+        *out_beta = beta;
+        if (j + 1 == steps || beta <= DBL_EPSILON * fmax(anorm, beta) * n) {
+            if (j + 1 < steps)
+                *out_beta = 0.0;
+            return j + 1;
+        }
+
+        ws->e[j] = beta;
+        double_t *next = ws->basis + (j + 1) * n;
+        for (size_t c = 0; c < n; c++) {
+            next[c] = ws->w[c] / beta;
+        }
+    }
+    return steps;
+}
+
+// Ritz vector of T's eigenvector z_row into out (n)
+static void ritz_vector(const LanczosWorkspace *ws,
+                        size_t n,
+                        size_t steps,
+                        const double_t *z_row,
+                        double_t *out) {
+    memset(out, 0, n * sizeof(double_t));
+    for (size_t j = 0; j < steps; j++) {
+        const double_t *q = ws->basis + j * n;
+        for (size_t c = 0; c < n; c++) {
+            out[c] += z_row[j] * q[c];
+        }
+    }
+}
+
+int matrix_eigen_topk(const Matrix *a,
+                      size_t k,
+                      Vector *eigenvalues,
+                      Matrix *eigenvectors) {
+    if (!a || !eigenvalues)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a) || !vector_valid(eigenvalues) ||
+        (eigenvectors && !matrix_valid(eigenvectors)))
+        return VECTOR_ERROR_INIT;
+
+    const size_t n = a->rows;
+    if (a->cols != n || k == 0 || k > n || eigenvalues->size != k ||
+        (eigenvectors && (eigenvectors->rows != n || eigenvectors->cols != k)))
+        return VECTOR_ERROR_SIZE;
+
+    size_t steps = 2 * k + LANCZOS_MIN_STEPS;
+    if (steps >= n)
+        return topk_dense(a, k, eigenvalues, eigenvectors);
+
+    double_t *start = malloc(2 * n * sizeof(double_t));
+    if (!start)
+        return VECTOR_ERROR_MEM;
+    double_t *ritz = start + n;
+
+    uint64_t seed = SVD_SEED;
+    for (size_t i = 0; i < n; i++) {
+        start[i] = random_gaussian(&seed);
+    }
+
+    int err = VECTOR_SUCCESS;
+    for (;;) {
+        // Once the space would span everything the dense solver is cheaper
+        if (steps >= n) {
+            err = topk_dense(a, k, eigenvalues, eigenvectors);
+            break;
+        }
+
+        const double_t norm = sqrt(dot(start, start, n));
+        for (size_t i = 0; i < n; i++) {
+            start[i] /= norm;
+        }
+
+        LanczosWorkspace ws;
+        err = lanczos_init(&ws, n, steps);
+        if (err != VECTOR_SUCCESS)
+            break;
+
+        double_t beta = 0.0;
+        const size_t taken = lanczos_run(a->elements, n, start, steps, &ws,
+                                         &beta);
+        if (taken < k) {
+            // Start vector lies in a small invariant subspace
+            lanczos_free(&ws);
+            steps = n;
+            continue;
+        }
+
+        memset(ws.z, 0, taken * taken * sizeof(double_t));
+        for (size_t i = 0; i < taken; i++) {
+            ws.z[i * taken + i] = 1.0;
+        }
+        err = tridiagonal_qr(ws.d, ws.e, taken, ws.z, taken);
+        if (err == VECTOR_SUCCESS)
+            err = sort_descending(ws.d, taken, ws.order);
+        if (err != VECTOR_SUCCESS) {
+            lanczos_free(&ws);
+            break;
+        }
+
+        // Residual of Ritz pair i is |beta * last component of z_i|
+        const double_t scale = fmax(fabs(ws.d[ws.order[0]]), DBL_MIN);
+        bool converged = true;
+        for (size_t i = 0; i < k; i++) {
+            const double_t *z_row = ws.z + ws.order[i] * taken;
+            if (fabs(beta * z_row[taken - 1]) > LANCZOS_TOLERANCE * scale)
+                converged = false;
+        }
+
+        if (converged) {
+            for (size_t i = 0; i < k; i++) {
+                eigenvalues->elements[i] = ws.d[ws.order[i]];
+                if (!eigenvectors)
+                    continue;
+                ritz_vector(&ws, n, taken, ws.z + ws.order[i] * taken, ritz);
+                for (size_t r = 0; r < n; r++) {
+                    eigenvectors->elements[r * k + i] = ritz[r];
+                }
+            }
+            lanczos_free(&ws);
+            break;
+        }
+
+        // Restart from the wanted Ritz vectors with a larger space
+        memset(start, 0, n * sizeof(double_t));
+        for (size_t i = 0; i < k; i++) {
+            ritz_vector(&ws, n, taken, ws.z + ws.order[i] * taken, ritz);
+            for (size_t r = 0; r < n; r++) {
+                start[r] += ritz[r];
+            }
+        }
+        lanczos_free(&ws);
+        steps *= 2;
+    }
+
+    free(start);
+    return err;
+}
+
+// --- Randomized SVD ---
+
+// Replace y (m x l) by an orthonormal basis of its columns
+static int orthonormalize(Matrix *y) {
+    Matrix *qr = NULL;
+    Vector *tau = NULL;
+
+    int err = matrix_create(y->rows, y->cols, &qr);
+    if (err == VECTOR_SUCCESS)
+        err = vector_create(y->cols, &tau);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_qr(y, qr, tau);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_qr_unpack(qr, tau, y, NULL);
+
+    if (qr)
+        matrix_free(qr);
+    vector_free(tau);
+    return err;
+}
+
+int matrix_svd_randomized(const Matrix *a,
+                          size_t k,
+                          size_t oversample,
+                          size_t power_iterations,
+                          Vector *singular_values,
+                          Matrix *u,
+                          Matrix *vt) {
+    if (!a || !singular_values)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a) || !vector_valid(singular_values) ||
+        (u && !matrix_valid(u)) || (vt && !matrix_valid(vt)))
+        return VECTOR_ERROR_INIT;
+
+    const size_t m = a->rows;
+    const size_t n = a->cols;
+    const size_t rank = m < n ? m : n;
+    if (k == 0 || k > rank || singular_values->size != k ||
+        (u && (u->rows != m || u->cols != k)) ||
+        (vt && (vt->rows != k || vt->cols != n)))
+        return VECTOR_ERROR_SIZE;
+
+    const size_t l = k + oversample < rank ? k + oversample : rank;
+
+    // Matrices in creation order, freed together
+    Matrix *omega = NULL, *y = NULL, *a_t = NULL, *zq = NULL, *q_t = NULL;
+    Matrix *b = NULL, *b_t = NULL, *g = NULL, *w = NULL;
+    Vector *lambda = NULL;
+
+    int err = matrix_create(n, l, &omega);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_create(m, l, &y);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_create(n, m, &a_t);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_create(n, l, &zq);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_create(l, m, &q_t);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_create(l, n, &b);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_create(n, l, &b_t);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_create(l, l, &g);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_create(l, l, &w);
+    if (err == VECTOR_SUCCESS)
+        err = vector_create(l, &lambda);
+    if (err != VECTOR_SUCCESS)
+        goto cleanup;
+
+    uint64_t seed = SVD_SEED;
+    for (size_t i = 0; i < n * l; i++) {
+        omega->elements[i] = random_gaussian(&seed);
+    }
+
+    // Range of a: Y = A * Omega, sharpened by (A A^T)^q
+    err = matrix_mult(a, omega, y);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_transpose(a, a_t);
+    for (size_t it = 0; err == VECTOR_SUCCESS && it < power_iterations; it++) {
+        err = orthonormalize(y);
+        if (err == VECTOR_SUCCESS)
+            err = matrix_mult(a_t, y, zq);
+        if (err == VECTOR_SUCCESS)
+            err = orthonormalize(zq);
+        if (err == VECTOR_SUCCESS)
+            err = matrix_mult(a, zq, y);
+    }
+    if (err == VECTOR_SUCCESS)
+        err = orthonormalize(y);
+
+    // B = Q^T A is small (l x n); its SVD from the eigenpairs of B B^T
+    if (err == VECTOR_SUCCESS)
+        err = matrix_transpose(y, q_t);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_mult(q_t, a, b);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_transpose(b, b_t);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_mult(b, b_t, g);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_eigen_symmetric(g, lambda, w);
+    if (err != VECTOR_SUCCESS)
+        goto cleanup;
+
+    for (size_t i = 0; i < k; i++) {
+        singular_values->elements[i] = sqrt(fmax(lambda->elements[i], 0.0));
+    }
+
+    // U = Q * W[:, :k]
+    if (u) {
+        memset(u->elements, 0, m * k * sizeof(double_t));
+        blas_gemm(m, k, l, 1.0, y->elements, l, w->elements, l, u->elements,
+                  k);
+    }
+
+    // Vt[i] = W[:, i]^T B / s_i
+    if (vt) {
+        memset(vt->elements, 0, k * n * sizeof(double_t));
+        for (size_t i = 0; i < k; i++) {
+            const double_t s = singular_values->elements[i];
+            if (s == 0.0)
+                continue;
+            double_t *row = vt->elements + i * n;
+            for (size_t p = 0; p < l; p++) {
+                const double_t scale = w->elements[p * l + i] / s;
+                const double_t *b_row = b->elements + p * n;
+                for (size_t c = 0; c < n; c++) {
+                    row[c] += scale * b_row[c];
+                }
+            }
+        }
+    }
+
+cleanup:
+    if (omega)
+        matrix_free(omega);
+    if (y)
+        matrix_free(y);
+    if (a_t)
+        matrix_free(a_t);
+    if (zq)
+        matrix_free(zq);
+    if (q_t)
+        matrix_free(q_t);
+    if (b)
+        matrix_free(b);
+    if (b_t)
+        matrix_free(b_t);
+    if (g)
+        matrix_free(g);
+    if (w)
+        matrix_free(w);
+    vector_free(lambda);
+    return err;
+}
+
+// --- PCA ---
+
+struct NumenPCA {
+    size_t dim;
+    size_t components;
+    double_t *mean; ///< dim
+    double_t *basis_t; ///< dim x components, components as columns
+    double_t *variance; ///< components
+};
+
+int numen_pca_free(NumenPCA *pca) {
+    if (!pca)
+        return VECTOR_ERROR_NULL;
+
+    free(pca->mean);
+    free(pca->basis_t);
+    free(pca->variance);
+    free(pca);
+    return VECTOR_SUCCESS;
+}
+
+// Check samples share size dim before reading any of them
+static int check_samples(const Vector *const *samples,
+                         size_t count,
+                         size_t dim) {
+    for (size_t i = 0; i < count; i++) {
+        if (!samples[i])
+            return VECTOR_ERROR_NULL;
+        if (!vector_valid(samples[i]))
+            return VECTOR_ERROR_INIT;
+        if (samples[i]->size != dim)
+            return VECTOR_ERROR_SIZE;
+    }
+    return VECTOR_SUCCESS;
+}
+
+int numen_pca_fit(const Vector *const *samples,
+                  size_t count,
+                  size_t components,
+                  NumenPCA **out_pca) {
+    if (!samples || !out_pca || (count > 0 && !samples[0]))
+        return VECTOR_ERROR_NULL;
+    if (count < 2)
+        return VECTOR_ERROR_SIZE;
+
+    const size_t dim = samples[0]->size;
+    int err = check_samples(samples, count, dim);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    if (components == 0 || components > dim || components > count)
+        return VECTOR_ERROR_SIZE;
+
+    NumenPCA *pca = calloc(1, sizeof(NumenPCA));
+    if (!pca)
+        return VECTOR_ERROR_MEM;
+    pca->dim = dim;
+    pca->components = components;
+    pca->mean = calloc(dim, sizeof(double_t));
+    pca->basis_t = malloc(dim * components * sizeof(double_t));
+    pca->variance = malloc(components * sizeof(double_t));
+
+    Matrix *x = NULL, *vt = NULL;
+    Vector *s = NULL;
+    if (!pca->mean || !pca->basis_t || !pca->variance) {
+        err = VECTOR_ERROR_MEM;
+        goto cleanup;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const double_t *v = samples[i]->elements;
+        for (size_t c = 0; c < dim; c++) {
+            pca->mean[c] += v[c];
+        }
+    }
+    for (size_t c = 0; c < dim; c++) {
+        pca->mean[c] /= (double_t)count;
+    }
+
+    err = matrix_create(count, dim, &x);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_create(components, dim, &vt);
+    if (err == VECTOR_SUCCESS)
+        err = vector_create(components, &s);
+    if (err != VECTOR_SUCCESS)
+        goto cleanup;
+
+    for (size_t i = 0; i < count; i++) {
+        const double_t *v = samples[i]->elements;
+        double_t *row = x->elements + i * dim;
+        for (size_t c = 0; c < dim; c++) {
+            row[c] = v[c] - pca->mean[c];
+        }
+    }
+
+    err = matrix_svd_randomized(x, components, PCA_OVERSAMPLE,
+                                PCA_POWER_ITERATIONS, s, NULL, vt);
+    if (err != VECTOR_SUCCESS)
+        goto cleanup;
+
+    for (size_t i = 0; i < components; i++) {
+        const double_t sv = s->elements[i];
+        pca->variance[i] = sv * sv / (double_t)(count - 1);
+        for (size_t c = 0; c < dim; c++) {
+            pca->basis_t[c * components + i] = vt->elements[i * dim + c];
+        }
+    }
+
+cleanup:
+    if (x)
+        matrix_free(x);
+    if (vt)
+        matrix_free(vt);
+    vector_free(s);
+    if (err != VECTOR_SUCCESS) {
+        numen_pca_free(pca);
+        return err;
+    }
+    *out_pca = pca;
+    return VECTOR_SUCCESS;
+}
+
+int numen_pca_project(const NumenPCA *pca, const Vector *sample, Vector *out) {
+    if (!pca || !sample || !out)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(sample) || !vector_valid(out))
+        return VECTOR_ERROR_INIT;
+    if (sample->size != pca->dim || out->size != pca->components)
+        return VECTOR_ERROR_SIZE;
+
+    const size_t k = pca->components;
+    memset(out->elements, 0, k * sizeof(double_t));
+    for (size_t c = 0; c < pca->dim; c++) {
+        const double_t centered = sample->elements[c] - pca->mean[c];
+        const double_t *basis_row = pca->basis_t + c * k;
+        for (size_t i = 0; i < k; i++) {
+            out->elements[i] += centered * basis_row[i];
+        }
+    }
+    return VECTOR_SUCCESS;
+}
+
+int numen_pca_project_batch(const NumenPCA *pca,
+                            const Vector *const *samples,
+                            size_t count,
+                            Matrix *out) {
+    if (!pca || !samples || !out)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(out))
+        return VECTOR_ERROR_INIT;
+    if (out->rows != count || out->cols != pca->components)
+        return VECTOR_ERROR_SIZE;
+
+    int err = check_samples(samples, count, pca->dim);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    const size_t dim = pca->dim;
+    double_t *centered = malloc(count * dim * sizeof(double_t));
+    if (!centered)
+        return VECTOR_ERROR_MEM;
+
+    for (size_t i = 0; i < count; i++) {
+        const double_t *v = samples[i]->elements;
+        double_t *row = centered + i * dim;
+        for (size_t c = 0; c < dim; c++) {
+            row[c] = v[c] - pca->mean[c];
+        }
+    }
+
+    memset(out->elements, 0, count * pca->components * sizeof(double_t));
+    err = blas_gemm_parallel(count,
+                             pca->components,
+                             dim,
+                             1.0,
+                             centered,
+                             dim,
+                             pca->basis_t,
+                             pca->components,
+                             out->elements,
+                             pca->components);
+    free(centered);
+    return err;
+}
+
+int numen_pca_explained_variance(const NumenPCA *pca, Vector *out) {
+    if (!pca || !out)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(out))
+        return VECTOR_ERROR_INIT;
+    if (out->size != pca->components)
+        return VECTOR_ERROR_SIZE;
+
+    memcpy(out->elements, pca->variance, pca->components * sizeof(double_t));
+    return VECTOR_SUCCESS;
+}
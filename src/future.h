@@ -0,0 +1,31 @@
+/**
+ * @file future.h
+ * @brief Internal future submission shared by asynchronous modules
+ * @date 18/10/26
+ */
+
+#ifndef __FUTURE_H
+#define __FUTURE_H
+
+#include "async.h"
+
+/**
+ * @brief numen_submit() that also owns its argument
+ * @param fn Function to run
+ * @param arg Argument passed to fn
+ * @param release_arg Called on arg once fn ran or was skipped, may be NULL
+ * @param deps Futures that must complete first
+ * @param dep_count Number of dependencies
+ * @param[out] out_future Pointer to receive future, or NULL
+ * @return VECTOR_SUCCESS if submitted, error code otherwise
+ *
+ * @note arg is released even when submission fails
+ */
+int future_submit(NumenTaskFn fn,
+                  void *arg,
+                  void (*release_arg)(void *arg),
+                  NumenFuture *const *deps,
+                  size_t dep_count,
+                  NumenFuture **out_future);
+
+#endif // !__FUTURE_H
@@ -0,0 +1,211 @@
+/**
+ * @file gather.c
+ * @brief Indexed gather, scatter and scatter-add
+ * @date 18/10/26
+ */
+
+#include "gather.h"
+#include "pool.h"
+#include "simd.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Below this many updates per thread the private copies cost more than
+// they save
+#define SCATTER_PARALLEL_MIN_PER_THREAD 4096
+
+// Branch-free maximum scan so range checks do not block vectorization
+static bool indices_in_range(const size_t *indices,
+                             size_t count,
+                             size_t limit) {
+    size_t max_index = 0;
+    for (size_t i = 0; i < count; i++) {
+        max_index = indices[i] > max_index ? indices[i] : max_index;
+    }
+    return count == 0 || max_index < limit;
+}
+
+static int check_indexed(const Vector *values,
+                         const size_t *indices,
+                         const Vector *target) {
+    if (!values || !indices || !target)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(values) || !vector_valid(target))
+        return VECTOR_ERROR_INIT;
+    if (!indices_in_range(indices, values->size, target->size))
+        return VECTOR_ERROR_INDEX;
+    return VECTOR_SUCCESS;
+}
+
+int vector_gather(const Vector *src, const size_t *indices, Vector *out) {
+    int err = check_indexed(out, indices, src);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    const double_t *s_data = src->elements;
+    double_t *o_data = out->elements;
+    const size_t count = out->size;
+
+    size_t i = 0;
+#if defined(__AVX512F__)
+    for (; i + 8 <= count; i += 8) {
+        __m512i idx = _mm512_loadu_si512((const void *)(indices + i));
+        _mm512_storeu_pd(o_data + i, _mm512_i64gather_pd(idx, s_data, 8));
+    }
+#elif defined(__AVX2__)
+    for (; i + 4 <= count; i += 4) {
+        __m256i idx = _mm256_loadu_si256((const __m256i *)(indices + i));
+        _mm256_storeu_pd(o_data + i, _mm256_i64gather_pd(s_data, idx, 8));
+    }
+#endif
+    for (; i < count; i++) {
+        o_data[i] = s_data[indices[i]];
+    }
+
+    return VECTOR_SUCCESS;
+}
+
+int vector_scatter(const Vector *values, const size_t *indices, Vector *dest) {
+    int err = check_indexed(values, indices, dest);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    const double_t *v_data = values->elements;
+    double_t *d_data = dest->elements;
+    const size_t count = values->size;
+
+    size_t i = 0;
+#if defined(__AVX512F__)
+    // Overlapping lanes are written low to high, so the last value wins
+    for (; i + 8 <= count; i += 8) {
+        __m512i idx = _mm512_loadu_si512((const void *)(indices + i));
+        _mm512_i64scatter_pd(d_data, idx, _mm512_loadu_pd(v_data + i), 8);
+    }
+#endif
+    for (; i < count; i++) {
+        d_data[indices[i]] = v_data[i];
+    }
+
+    return VECTOR_SUCCESS;
+}
+
+static void scatter_add_span(const double_t *v_data,
+                             const size_t *indices,
+                             size_t count,
+                             double_t *d_data) {
+    size_t i = 0;
+#if defined(__AVX512F__) && defined(__AVX512CD__)
+    for (; i + 8 <= count; i += 8) {
+        __m512i idx = _mm512_loadu_si512((const void *)(indices + i));
+        __m512d val = _mm512_loadu_pd(v_data + i);
+
+        // Each lane gets a bitmask of earlier lanes with the same index
+        __m512i conflicts = _mm512_conflict_epi64(idx);
+        if (_mm512_test_epi64_mask(conflicts, conflicts) == 0) {
+            __m512d cur = _mm512_i64gather_pd(idx, d_data, 8);
+            _mm512_i64scatter_pd(d_data, idx, _mm512_add_pd(cur, val), 8);
+        } else {
+            for (size_t j = i; j < i + 8; j++) {
+                d_data[indices[j]] += v_data[j];
+            }
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        d_data[indices[i]] += v_data[i];
+    }
+}
+
+int vector_scatter_add(const Vector *values,
+                       const size_t *indices,
+                       Vector *dest) {
+    int err = check_indexed(values, indices, dest);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    scatter_add_span(values->elements, indices, values->size, dest->elements);
+    return VECTOR_SUCCESS;
+}
+
+// --- Parallel scatter-add ---
+
+typedef struct {
+    const double_t *v_data;
+    const size_t *indices;
+    size_t count;
+    double_t *d_data;
+    size_t dest_size;
+    double_t *privates; ///< threads private copies of dest, back to back
+    size_t threads;
+} ScatterAddJob;
+
+// Phase 1: thread t accumulates its slice of updates into its own copy
+static void scatter_add_private(void *ctx, size_t t) {
+    ScatterAddJob *job = ctx;
+    const size_t begin = job->count * t / job->threads;
+    const size_t end = job->count * (t + 1) / job->threads;
+    double_t *priv = job->privates + t * job->dest_size;
+
+    memset(priv, 0, job->dest_size * sizeof(double_t));
+    scatter_add_span(
+        job->v_data + begin, job->indices + begin, end - begin, priv);
+}
+
+// Phase 2: thread t reduces one slice of dest across all private copies
+static void scatter_add_reduce(void *ctx, size_t t) {
+    ScatterAddJob *job = ctx;
+    const size_t begin = job->dest_size * t / job->threads;
+    const size_t end = job->dest_size * (t + 1) / job->threads;
+
+    for (size_t p = 0; p < job->threads; p++) {
+        const double_t *priv = job->privates + p * job->dest_size;
+        for (size_t i = begin; i < end; i++) {
+            job->d_data[i] += priv[i];
+        }
+    }
+}
+
+int vector_scatter_add_parallel(const Vector *values,
+                                const size_t *indices,
+                                Vector *dest) {
+    int err = check_indexed(values, indices, dest);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    // Each thread zeroes and reduces a full copy of dest, so only use as
+    // many as the updates pay for; sparse updates stay serial
+    size_t threads = pool_thread_count();
+    if (threads > values->size / SCATTER_PARALLEL_MIN_PER_THREAD)
+        threads = values->size / SCATTER_PARALLEL_MIN_PER_THREAD;
+    if (threads > values->size / dest->size)
+        threads = values->size / dest->size;
+    if (threads <= 1) {
+        scatter_add_span(
+            values->elements, indices, values->size, dest->elements);
+        return VECTOR_SUCCESS;
+    }
+
+    if (threads > SIZE_MAX / dest->size / sizeof(double_t))
+        return VECTOR_ERROR_MEM;
+    double_t *privates = malloc(threads * dest->size * sizeof(double_t));
+    if (!privates)
+        return VECTOR_ERROR_MEM;
+
+    ScatterAddJob job = {
+        .v_data = values->elements,
+        .indices = indices,
+        .count = values->size,
+        .d_data = dest->elements,
+        .dest_size = dest->size,
+        .privates = privates,
+        .threads = threads,
+    };
+
+    err = pool_parallel_for(threads, scatter_add_private, &job);
+    if (err == VECTOR_SUCCESS)
+        err = pool_parallel_for(threads, scatter_add_reduce, &job);
+
+    free(privates);
+    return err;
+}
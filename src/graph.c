@@ -0,0 +1,554 @@
+/**
+ * @file graph.c
+ * @brief Task graphs of dependent vector operations
+ * @date 18/10/26
+ */
+
+#include "graph.h"
+#include "pool.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define GRAPH_CHUNK_SIZE 16384 ///< Elements per chunk task within a node
+#define GRAPH_NO_NODE SIZE_MAX
+
+typedef enum {
+    NODE_ADD,
+    NODE_SUB,
+    NODE_MULT,
+    NODE_SCALE,
+    NODE_DOT,
+    NODE_NORMALIZE,
+    NODE_CUSTOM
+} NodeOp;
+
+typedef struct {
+    PoolTask task; ///< Queue node, must stay first
+    NumenGraph *graph;
+    NodeOp op;
+    const Vector *a;
+    const Vector *b;
+    Vector *result;
+    double_t scaler;
+    double_t *out_scalar;
+    NumenTaskFn fn;
+    void *arg;
+    size_t *successors;
+    size_t successor_count;
+    size_t successor_capacity;
+    size_t dep_count; ///< Static in-degree
+    atomic_size_t pending; ///< Unfinished dependencies in the current run
+    atomic_int dep_status; ///< First failing dependency in the current run
+    double_t *partials; ///< Per-chunk partial sums for reductions
+} GraphNode;
+
+/**
+ * @brief Last writer and readers since that write, per vector or scalar
+ */
+typedef struct {
+    const void *key;
+    size_t last_writer;
+    size_t *readers;
+    size_t reader_count;
+    size_t reader_capacity;
+} GraphResource;
+
+struct NumenGraph {
+    GraphNode *nodes;
+    size_t node_count;
+    size_t node_capacity;
+    GraphResource *resources;
+    size_t resource_count;
+    size_t resource_capacity;
+    atomic_size_t remaining; ///< Nodes not yet finished in the current run
+    atomic_int status; ///< First error of the current run
+    bool done; ///< Set under lock by the thread finishing the last node
+    pthread_mutex_t lock;
+    pthread_cond_t finished;
+};
+
+// --- Memory management ---
+
+int numen_graph_create(NumenGraph **out_graph) {
+    if (!out_graph)
+        return VECTOR_ERROR_NULL;
+
+    NumenGraph *graph = calloc(1, sizeof(NumenGraph));
+    if (!graph)
+        return VECTOR_ERROR_MEM;
+
+    pthread_mutex_init(&graph->lock, NULL);
+    pthread_cond_init(&graph->finished, NULL);
+    *out_graph = graph;
+    return VECTOR_SUCCESS;
+}
+
+int numen_graph_free(NumenGraph *graph) {
+    if (!graph)
+        return VECTOR_ERROR_NULL;
+
+    for (size_t i = 0; i < graph->node_count; i++) {
+        free(graph->nodes[i].successors);
+    }
+    for (size_t i = 0; i < graph->resource_count; i++) {
+        free(graph->resources[i].readers);
+    }
+    free(graph->nodes);
+    free(graph->resources);
+    pthread_mutex_destroy(&graph->lock);
+    pthread_cond_destroy(&graph->finished);
+    free(graph);
+    return VECTOR_SUCCESS;
+}
+
+// --- Graph construction ---
+
+static int grow(void **items, size_t *capacity, size_t count, size_t size) {
+    if (count < *capacity)
+        return VECTOR_SUCCESS;
+
+    size_t new_capacity = *capacity ? *capacity * 2 : 8;
+    void *new_items = realloc(*items, new_capacity * size);
+    if (!new_items)
+        return VECTOR_ERROR_MEM;
+
+    *items = new_items;
+    *capacity = new_capacity;
+    return VECTOR_SUCCESS;
+}
+
+static int add_edge(NumenGraph *graph, size_t from, size_t to) {
+    if (from == to)
+        return VECTOR_SUCCESS;
+
+    GraphNode *src = &graph->nodes[from];
+    for (size_t i = 0; i < src->successor_count; i++) {
+        if (src->successors[i] == to)
+            return VECTOR_SUCCESS;
+    }
+
+    int err = grow((void **)&src->successors,
+                   &src->successor_capacity,
+                   src->successor_count,
+                   sizeof(size_t));
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    src->successors[src->successor_count++] = to;
+    graph->nodes[to].dep_count++;
+    return VECTOR_SUCCESS;
+}
+
+static int find_resource(NumenGraph *graph,
+                         const void *key,
+                         GraphResource **out_resource) {
+    for (size_t i = 0; i < graph->resource_count; i++) {
+        if (graph->resources[i].key == key) {
+            *out_resource = &graph->resources[i];
+            return VECTOR_SUCCESS;
+        }
+    }
+
+    int err = grow((void **)&graph->resources,
+                   &graph->resource_capacity,
+                   graph->resource_count,
+                   sizeof(GraphResource));
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    GraphResource *resource = &graph->resources[graph->resource_count++];
+    resource->key = key;
+    resource->last_writer = GRAPH_NO_NODE;
+    resource->readers = NULL;
+    resource->reader_count = 0;
+    resource->reader_capacity = 0;
+    *out_resource = resource;
+    return VECTOR_SUCCESS;
+}
+
+static int track_read(NumenGraph *graph, size_t node, const void *key) {
+    if (!key)
+        return VECTOR_SUCCESS;
+
+    GraphResource *res;
+    int err = find_resource(graph, key, &res);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    if (res->last_writer != GRAPH_NO_NODE) {
+        if ((err = add_edge(graph, res->last_writer, node)))
+            return err;
+    }
+
+    if ((err = grow((void **)&res->readers,
+                    &res->reader_capacity,
+                    res->reader_count,
+                    sizeof(size_t))))
+        return err;
+    res->readers[res->reader_count++] = node;
+    return VECTOR_SUCCESS;
+}
+
+static int track_write(NumenGraph *graph, size_t node, const void *key) {
+    if (!key)
+        return VECTOR_SUCCESS;
+
+    GraphResource *res;
+    int err = find_resource(graph, key, &res);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    if (res->last_writer != GRAPH_NO_NODE) {
+        if ((err = add_edge(graph, res->last_writer, node)))
+            return err;
+    }
+    for (size_t i = 0; i < res->reader_count; i++) {
+        if ((err = add_edge(graph, res->readers[i], node)))
+            return err;
+    }
+
+    res->reader_count = 0;
+    res->last_writer = node;
+    return VECTOR_SUCCESS;
+}
+
+// Undoes a partially tracked node, whose edges and reads are always the
+// last entries of their lists
+static void untrack(NumenGraph *graph, size_t node) {
+    for (size_t i = 0; i < node; i++) {
+        GraphNode *src = &graph->nodes[i];
+        if (src->successor_count &&
+            src->successors[src->successor_count - 1] == node)
+            src->successor_count--;
+    }
+    for (size_t i = 0; i < graph->resource_count; i++) {
+        GraphResource *res = &graph->resources[i];
+        while (res->reader_count &&
+               res->readers[res->reader_count - 1] == node)
+            res->reader_count--;
+    }
+}
+
+static int add_node(NumenGraph *graph,
+                    const GraphNode *proto,
+                    const void *write_key,
+                    NumenNode *out_node) {
+    if (!graph)
+        return VECTOR_ERROR_NULL;
+
+    int err = grow((void **)&graph->nodes,
+                   &graph->node_capacity,
+                   graph->node_count,
+                   sizeof(GraphNode));
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    const size_t index = graph->node_count;
+    GraphNode *node = &graph->nodes[index];
+    *node = *proto;
+    node->graph = graph;
+    node->successors = NULL;
+    node->successor_count = 0;
+    node->successor_capacity = 0;
+    node->dep_count = 0;
+    node->partials = NULL;
+
+    // Reads before the write, so in-place nodes do not depend on themselves
+    if ((err = track_read(graph, index, proto->a)) ||
+        (err = track_read(graph, index, proto->b)) ||
+        (err = track_write(graph, index, write_key))) {
+        untrack(graph, index);
+        return err;
+    }
+
+    // Counted only once its dependencies are recorded
+    graph->node_count++;
+    if (out_node)
+        *out_node = index;
+    return VECTOR_SUCCESS;
+}
+
+int numen_graph_add(NumenGraph *graph,
+                    const Vector *a,
+                    const Vector *b,
+                    Vector *result,
+                    NumenNode *out_node) {
+    GraphNode proto = {.op = NODE_ADD, .a = a, .b = b, .result = result};
+    return add_node(graph, &proto, result, out_node);
+}
+
+int numen_graph_sub(NumenGraph *graph,
+                    const Vector *a,
+                    const Vector *b,
+                    Vector *result,
+                    NumenNode *out_node) {
+    GraphNode proto = {.op = NODE_SUB, .a = a, .b = b, .result = result};
+    return add_node(graph, &proto, result, out_node);
+}
+
+int numen_graph_mult(NumenGraph *graph,
+                     const Vector *a,
+                     const Vector *b,
+                     Vector *result,
+                     NumenNode *out_node) {
+    GraphNode proto = {.op = NODE_MULT, .a = a, .b = b, .result = result};
+    return add_node(graph, &proto, result, out_node);
+}
+
+int numen_graph_scale(NumenGraph *graph,
+                      const Vector *a,
+                      double_t scaler,
+                      Vector *result,
+                      NumenNode *out_node) {
+    GraphNode proto = {
+        .op = NODE_SCALE, .a = a, .scaler = scaler, .result = result};
+    return add_node(graph, &proto, result, out_node);
+}
+
+int numen_graph_dot(NumenGraph *graph,
+                    const Vector *a,
+                    const Vector *b,
+                    double_t *result,
+                    NumenNode *out_node) {
+    GraphNode proto = {.op = NODE_DOT, .a = a, .b = b, .out_scalar = result};
+    return add_node(graph, &proto, result, out_node);
+}
+
+int numen_graph_normalize(NumenGraph *graph,
+                          Vector *vector,
+                          NumenNode *out_node) {
+    GraphNode proto = {.op = NODE_NORMALIZE, .a = vector, .result = vector};
+    return add_node(graph, &proto, vector, out_node);
+}
+
+int numen_graph_custom(NumenGraph *graph,
+                       NumenTaskFn fn,
+                       void *arg,
+                       NumenNode *out_node) {
+    if (!fn)
+        return VECTOR_ERROR_NULL;
+
+    GraphNode proto = {.op = NODE_CUSTOM, .fn = fn, .arg = arg};
+    return add_node(graph, &proto, NULL, out_node);
+}
+
+int numen_graph_depend(NumenGraph *graph,
+                       NumenNode node,
+                       NumenNode dependency) {
+    if (!graph)
+        return VECTOR_ERROR_NULL;
+    if (node >= graph->node_count || dependency >= graph->node_count)
+        return VECTOR_ERROR_INDEX;
+    // Edges only point forward, which keeps the graph acyclic
+    if (dependency >= node)
+        return VECTOR_ERROR_INVALID_ARG;
+
+    return add_edge(graph, dependency, node);
+}
+
+// --- Chunk kernels ---
+
+static size_t chunk_count(size_t size) {
+    return (size + GRAPH_CHUNK_SIZE - 1) / GRAPH_CHUNK_SIZE;
+}
+
+static void elementwise_chunk(void *ctx, size_t chunk) {
+    GraphNode *node = ctx;
+    const size_t begin = chunk * GRAPH_CHUNK_SIZE;
+    size_t end = begin + GRAPH_CHUNK_SIZE;
+    if (end > node->result->size)
+        end = node->result->size;
+
+    const double_t *a_data = node->a->elements;
+    const double_t *b_data = node->b ? node->b->elements : NULL;
+    double_t *r_data = node->result->elements;
+
+    switch (node->op) {
+    case NODE_ADD:
+        for (size_t i = begin; i < end; i++) {
+            r_data[i] = a_data[i] + b_data[i];
+        }
+        break;
+    case NODE_SUB:
+        for (size_t i = begin; i < end; i++) {
+            r_data[i] = a_data[i] - b_data[i];
+        }
+        break;
+    case NODE_MULT:
+        for (size_t i = begin; i < end; i++) {
+            r_data[i] = a_data[i] * b_data[i];
+        }
+        break;
+    default:
+        for (size_t i = begin; i < end; i++) {
+            r_data[i] = a_data[i] * node->scaler;
+        }
+        break;
+    }
+}
+
+// Partial dot product of one chunk, through the Kahan kernel of vector_dot
+static void dot_chunk(void *ctx, size_t chunk) {
+    GraphNode *node = ctx;
+    const size_t begin = chunk * GRAPH_CHUNK_SIZE;
+    size_t end = begin + GRAPH_CHUNK_SIZE;
+    if (end > node->a->size)
+        end = node->a->size;
+
+    const size_t len = end - begin;
+    const Vector *b = node->b ? node->b : node->a;
+    const Vector a_slice = {node->a->elements + begin, len, len};
+    const Vector b_slice = {b->elements + begin, len, len};
+    vector_dot(&a_slice, &b_slice, &node->partials[chunk]);
+}
+
+static int reduce_chunks(GraphNode *node, double_t *out_sum) {
+    const size_t chunks = chunk_count(node->a->size);
+    node->partials = malloc((chunks ? chunks : 1) * sizeof(double_t));
+    if (!node->partials)
+        return VECTOR_ERROR_MEM;
+
+    int err = pool_parallel_for(chunks, dot_chunk, node);
+    if (err == VECTOR_SUCCESS) {
+        // Fixed order keeps the result independent of scheduling
+        double_t sum = 0.0;
+        for (size_t i = 0; i < chunks; i++) {
+            sum += node->partials[i];
+        }
+        *out_sum = sum;
+    }
+
+    free(node->partials);
+    node->partials = NULL;
+    return err;
+}
+
+// --- Execution ---
+
+static int node_execute(GraphNode *node) {
+    switch (node->op) {
+    case NODE_ADD:
+    case NODE_SUB:
+    case NODE_MULT:
+    case NODE_SCALE:
+        if (!node->a || !node->result ||
+            (node->op != NODE_SCALE && !node->b))
+            return VECTOR_ERROR_NULL;
+        if (!vector_valid(node->a) || !vector_valid(node->result) ||
+            (node->b && !vector_valid(node->b)))
+            return VECTOR_ERROR_INIT;
+        if (node->a->size != node->result->size ||
+            (node->b && node->b->size != node->a->size))
+            return VECTOR_ERROR_SIZE;
+        return pool_parallel_for(
+            chunk_count(node->a->size), elementwise_chunk, node);
+
+    case NODE_DOT:
+        if (!node->a || !node->b || !node->out_scalar)
+            return VECTOR_ERROR_NULL;
+        if (!vector_valid(node->a) || !vector_valid(node->b))
+            return VECTOR_ERROR_INIT;
+        if (node->a->size != node->b->size)
+            return VECTOR_ERROR_SIZE;
+        return reduce_chunks(node, node->out_scalar);
+
+    case NODE_NORMALIZE: {
+        if (!node->result)
+            return VECTOR_ERROR_NULL;
+        if (!vector_valid(node->result))
+            return VECTOR_ERROR_INIT;
+
+        double_t dot;
+        int err = reduce_chunks(node, &dot);
+        if (err != VECTOR_SUCCESS)
+            return err;
+        if (dot == 0.0)
+            return VECTOR_ERROR_MATH;
+
+        node->scaler = 1.0 / sqrt(dot);
+        return pool_parallel_for(
+            chunk_count(node->a->size), elementwise_chunk, node);
+    }
+
+    default:
+        return node->fn(node->arg);
+    }
+}
+
+static void node_run(PoolTask *task);
+
+static void node_schedule(GraphNode *node) {
+    node->task.run = node_run;
+    if (pool_submit(&node->task) != VECTOR_SUCCESS)
+        node_run(&node->task);
+}
+
+static void node_run(PoolTask *task) {
+    GraphNode *node = (GraphNode *)task;
+    NumenGraph *graph = node->graph;
+
+    int status = atomic_load(&node->dep_status);
+    if (status == VECTOR_SUCCESS) {
+        status = node_execute(node);
+        if (status != VECTOR_SUCCESS) {
+            int expected = VECTOR_SUCCESS;
+            atomic_compare_exchange_strong(&graph->status, &expected, status);
+        }
+    }
+
+    for (size_t i = 0; i < node->successor_count; i++) {
+        GraphNode *next = &graph->nodes[node->successors[i]];
+        if (status != VECTOR_SUCCESS) {
+            int expected = VECTOR_SUCCESS;
+            atomic_compare_exchange_strong(
+                &next->dep_status, &expected, status);
+        }
+        if (atomic_fetch_sub(&next->pending, 1) == 1)
+            node_schedule(next);
+    }
+
+    if (atomic_fetch_sub(&graph->remaining, 1) == 1) {
+        pthread_mutex_lock(&graph->lock);
+        graph->done = true;
+        pthread_cond_broadcast(&graph->finished);
+        pthread_mutex_unlock(&graph->lock);
+    }
+}
+
+int numen_graph_run(NumenGraph *graph) {
+    if (!graph)
+        return VECTOR_ERROR_NULL;
+    if (graph->node_count == 0)
+        return VECTOR_SUCCESS;
+
+    atomic_store(&graph->status, VECTOR_SUCCESS);
+    atomic_store(&graph->remaining, graph->node_count);
+    graph->done = false;
+    for (size_t i = 0; i < graph->node_count; i++) {
+        atomic_store(&graph->nodes[i].pending, graph->nodes[i].dep_count);
+        atomic_store(&graph->nodes[i].dep_status, VECTOR_SUCCESS);
+    }
+
+    for (size_t i = 0; i < graph->node_count; i++) {
+        if (graph->nodes[i].dep_count == 0)
+            node_schedule(&graph->nodes[i]);
+    }
+
+    // Help run queued work, then sleep once there is nothing to run
+    while (atomic_load(&graph->remaining) > 0) {
+        if (!pool_try_run_one())
+            break;
+    }
+
+    // Wait on the flag, not the counter, so the graph outlives the
+    // finishing thread's broadcast
+    pthread_mutex_lock(&graph->lock);
+    while (!graph->done) {
+        pthread_cond_wait(&graph->finished, &graph->lock);
+    }
+    pthread_mutex_unlock(&graph->lock);
+
+    return atomic_load(&graph->status);
+}
@@ -0,0 +1,311 @@
+/**
+ * @file intvec.c
+ * @brief Integer vector families (int32, int64 and uint8 counts)
+ * @date 18/10/26
+ */
+
+#include "intvec.h"
+#include "simd.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The three families share everything but their element type and the
+ * arithmetic of add, sub and mult, so the functions are stamped out per
+ * family. Signed families compute in the unsigned type of the same width
+ * to wrap without undefined behaviour.
+ */
+
+// Every index below size
+static bool indices_in_range(const size_t *indices, size_t count, size_t size) {
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] >= size)
+            return false;
+    }
+    return true;
+}
+
+// --- Element arithmetic ---
+
+#define WRAP_ADD(T, U, x, y) ((T)((U)(x) + (U)(y)))
+#define WRAP_SUB(T, U, x, y) ((T)((U)(x) - (U)(y)))
+#define WRAP_MULT(T, U, x, y) ((T)((U)(x) * (U)(y)))
+
+#define SAT_ADD(T, U, x, y) \
+    ((T)((unsigned)(x) + (y) > UINT8_MAX ? UINT8_MAX : (x) + (y)))
+#define SAT_SUB(T, U, x, y) ((T)((x) > (y) ? (x) - (y) : 0))
+#define SAT_MULT(T, U, x, y) \
+    ((T)((unsigned)(x) * (y) > UINT8_MAX ? UINT8_MAX : (x) * (y)))
+
+// --- Sums ---
+
+static uint64_t sum_span_i32(const int32_t *x, size_t n) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += (uint64_t)(int64_t)x[i];
+    }
+    return sum;
+}
+
+static uint64_t sum_span_i64(const int64_t *x, size_t n) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += (uint64_t)x[i];
+    }
+    return sum;
+}
+
+// Byte sums against zero add 32 counters per instruction
+static uint64_t sum_span_u8(const uint8_t *x, size_t n) {
+    uint64_t sum = 0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(x + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, zero));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < n; i++) {
+        sum += x[i];
+    }
+    return sum;
+}
+
+// --- Families ---
+
+/*
+ * NAME: function infix, Type: vector struct, T: element, U: unsigned
+ * element, W: widened result of sums and dots, OP: WRAP or SAT arithmetic
+ */
+#define INT_VECTOR_DEFINE(NAME, Type, T, U, W, OP)                            \
+    bool vector_##NAME##_valid(const Type *vector) {                          \
+        return (vector != NULL && vector->elements != NULL);                  \
+    }                                                                         \
+                                                                              \
+    int vector_##NAME##_create(size_t size, Type **out_vector) {              \
+        if (!out_vector)                                                      \
+            return VECTOR_ERROR_NULL;                                         \
+                                                                              \
+        Type *vector = malloc(sizeof(Type));                                  \
+        if (!vector)                                                          \
+            return VECTOR_ERROR_MEM;                                          \
+                                                                              \
+        if (size == 0) {                                                      \
+            vector->elements = NULL;                                          \
+        } else {                                                              \
+            vector->elements = calloc(size, sizeof(T));                       \
+            if (!vector->elements) {                                          \
+                free(vector);                                                 \
+                return VECTOR_ERROR_MEM;                                      \
+            }                                                                 \
+        }                                                                     \
+                                                                              \
+        vector->size = size;                                                  \
+        vector->capacity = size;                                              \
+        *out_vector = vector;                                                 \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    int vector_##NAME##_from_array(const T *arr,                              \
+                                   size_t size,                               \
+                                   Type **out_vector) {                       \
+        if (!arr || !out_vector)                                              \
+            return VECTOR_ERROR_NULL;                                         \
+                                                                              \
+        int err = vector_##NAME##_create(size, out_vector);                   \
+        if (err != VECTOR_SUCCESS)                                            \
+            return err;                                                       \
+                                                                              \
+        if (size > 0)                                                         \
+            memcpy((*out_vector)->elements, arr, size * sizeof(T));           \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    int vector_##NAME##_free(Type *vector) {                                  \
+        if (!vector)                                                          \
+            return VECTOR_ERROR_NULL;                                         \
+                                                                              \
+        free(vector->elements);                                               \
+        free(vector);                                                         \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    int vector_##NAME##_get(const Type *vector, size_t index, T *out_val) {   \
+        if (!vector || !out_val)                                              \
+            return VECTOR_ERROR_NULL;                                         \
+        if (!vector_##NAME##_valid(vector))                                   \
+            return VECTOR_ERROR_INIT;                                         \
+        if (index >= vector->size)                                            \
+            return VECTOR_ERROR_INDEX;                                        \
+                                                                              \
+        *out_val = vector->elements[index];                                   \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    int vector_##NAME##_set(Type *vector, size_t index, T val) {              \
+        if (!vector)                                                          \
+            return VECTOR_ERROR_NULL;                                         \
+        if (!vector_##NAME##_valid(vector))                                   \
+            return VECTOR_ERROR_INIT;                                         \
+        if (index >= vector->size)                                            \
+            return VECTOR_ERROR_INDEX;                                        \
+                                                                              \
+        vector->elements[index] = val;                                        \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    int vector_##NAME##_to_vector(const Type *vector, Vector *result) {       \
+        if (!vector || !result)                                               \
+            return VECTOR_ERROR_NULL;                                         \
+        if (!vector_##NAME##_valid(vector) || !vector_valid(result))          \
+            return VECTOR_ERROR_INIT;                                         \
+        if (vector->size != result->size)                                     \
+            return VECTOR_ERROR_SIZE;                                         \
+                                                                              \
+        for (size_t i = 0; i < vector->size; i++) {                           \
+            result->elements[i] = (double_t)vector->elements[i];              \
+        }                                                                     \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    static int check_binary_##NAME(const Type *a,                             \
+                                   const Type *b,                             \
+                                   const Type *result) {                      \
+        if (!a || !b || !result)                                              \
+            return VECTOR_ERROR_NULL;                                         \
+        if (!vector_##NAME##_valid(a) || !vector_##NAME##_valid(b) ||         \
+            !vector_##NAME##_valid(result))                                   \
+            return VECTOR_ERROR_INIT;                                         \
+        if (a->size != b->size || a->size != result->size)                    \
+            return VECTOR_ERROR_SIZE;                                         \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    INT_VECTOR_BINARY(NAME, Type, T, U, add, OP##_ADD)                        \
+    INT_VECTOR_BINARY(NAME, Type, T, U, sub, OP##_SUB)                        \
+    INT_VECTOR_BINARY(NAME, Type, T, U, mult, OP##_MULT)                      \
+                                                                              \
+    int vector_##NAME##_sum(const Type *vector, W *sum) {                     \
+        if (!vector || !sum)                                                  \
+            return VECTOR_ERROR_NULL;                                         \
+        if (!vector_##NAME##_valid(vector))                                   \
+            return VECTOR_ERROR_INIT;                                         \
+                                                                              \
+        *sum = (W)sum_span_##NAME(vector->elements, vector->size);            \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    int vector_##NAME##_dot(const Type *a, const Type *b, W *result) {        \
+        if (!a || !b || !result)                                              \
+            return VECTOR_ERROR_NULL;                                         \
+        if (!vector_##NAME##_valid(a) || !vector_##NAME##_valid(b))           \
+            return VECTOR_ERROR_INIT;                                         \
+        if (a->size != b->size)                                               \
+            return VECTOR_ERROR_SIZE;                                         \
+                                                                              \
+        const T *a_data = a->elements;                                        \
+        const T *b_data = b->elements;                                        \
+        uint64_t sum = 0;                                                     \
+        for (size_t i = 0; i < a->size; i++) {                                \
+            sum += (uint64_t)(W)a_data[i] * (uint64_t)(W)b_data[i];           \
+        }                                                                     \
+        *result = (W)sum;                                                     \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    int vector_##NAME##_min(const Type *vector, T *min) {                     \
+        if (!vector || !min)                                                  \
+            return VECTOR_ERROR_NULL;                                         \
+        if (!vector_##NAME##_valid(vector))                                   \
+            return VECTOR_ERROR_INIT;                                         \
+        if (vector->size == 0)                                                \
+            return VECTOR_ERROR_SIZE;                                         \
+                                                                              \
+        const T *data = vector->elements;                                     \
+        T current_min = data[0];                                              \
+        for (size_t i = 1; i < vector->size; i++) {                           \
+            current_min = data[i] < current_min ? data[i] : current_min;      \
+        }                                                                     \
+        *min = current_min;                                                   \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    int vector_##NAME##_max(const Type *vector, T *max) {                     \
+        if (!vector || !max)                                                  \
+            return VECTOR_ERROR_NULL;                                         \
+        if (!vector_##NAME##_valid(vector))                                   \
+            return VECTOR_ERROR_INIT;                                         \
+        if (vector->size == 0)                                                \
+            return VECTOR_ERROR_SIZE;                                         \
+                                                                              \
+        const T *data = vector->elements;                                     \
+        T current_max = data[0];                                              \
+        for (size_t i = 1; i < vector->size; i++) {                           \
+            current_max = data[i] > current_max ? data[i] : current_max;      \
+        }                                                                     \
+        *max = current_max;                                                   \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    int vector_##NAME##_increment(Type *counts,                               \
+                                  const size_t *indices,                      \
+                                  size_t count) {                             \
+        if (!counts || (!indices && count > 0))                               \
+            return VECTOR_ERROR_NULL;                                         \
+        if (!vector_##NAME##_valid(counts))                                   \
+            return VECTOR_ERROR_INIT;                                         \
+        if (!indices_in_range(indices, count, counts->size))                  \
+            return VECTOR_ERROR_INDEX;                                        \
+                                                                              \
+        T *data = counts->elements;                                           \
+        for (size_t i = 0; i < count; i++) {                                  \
+            data[indices[i]] = OP##_ADD(T, U, data[indices[i]], 1);           \
+        }                                                                     \
+        return VECTOR_SUCCESS;                                                \
+    }                                                                         \
+                                                                              \
+    int vector_##NAME##_scatter_add(const Type *values,                       \
+                                    const size_t *indices,                    \
+                                    Type *dest) {                             \
+        if (!values || !indices || !dest)                                     \
+            return VECTOR_ERROR_NULL;                                         \
+        if (!vector_##NAME##_valid(values) || !vector_##NAME##_valid(dest))   \
+            return VECTOR_ERROR_INIT;                                         \
+        if (!indices_in_range(indices, values->size, dest->size))             \
+            return VECTOR_ERROR_INDEX;                                        \
+                                                                              \
+        const T *v_data = values->elements;                                   \
+        T *d_data = dest->elements;                                           \
+        for (size_t i = 0; i < values->size; i++) {                           \
+            const size_t at = indices[i];                                     \
+            d_data[at] = OP##_ADD(T, U, d_data[at], v_data[i]);               \
+        }                                                                     \
+        return VECTOR_SUCCESS;                                                \
+    }
+
+// Element-wise result = a OP b, result may alias either operand
+#define INT_VECTOR_BINARY(NAME, Type, T, U, OPNAME, EXPR)                     \
+    int vector_##NAME##_##OPNAME(const Type *a,                               \
+                                 const Type *b,                               \
+                                 Type *result) {                              \
+        int err = check_binary_##NAME(a, b, result);                          \
+        if (err != VECTOR_SUCCESS)                                            \
+            return err;                                                       \
+                                                                              \
+        const T *a_data = a->elements;                                        \
+        const T *b_data = b->elements;                                        \
+        T *r_data = result->elements;                                         \
+        for (size_t i = 0; i < a->size; i++) {                                \
+            r_data[i] = EXPR(T, U, a_data[i], b_data[i]);                     \
+        }                                                                     \
+        return VECTOR_SUCCESS;                                                \
+    }
+
+INT_VECTOR_DEFINE(i32, VectorI32, int32_t, uint32_t, int64_t, WRAP)
+INT_VECTOR_DEFINE(i64, VectorI64, int64_t, uint64_t, int64_t, WRAP)
+INT_VECTOR_DEFINE(u8, VectorU8, uint8_t, uint8_t, uint64_t, SAT)
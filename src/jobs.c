@@ -0,0 +1,112 @@
+/**
+ * @file jobs.c
+ * @brief Batched execution of many small heterogeneous jobs
+ * @date 18/10/26
+ */
+
+#include "jobs.h"
+#include "future.h"
+#include "pool.h"
+#include "utils.h"
+#include <stdlib.h>
+
+#define JOBS_TASKS_PER_THREAD 8 ///< Tasks per thread, slack for stealing
+
+static int job_execute(NumenJob *job) {
+    switch (job->type) {
+    case NUMEN_JOB_CUSTOM:
+        return job->fn ? job->fn(job->arg) : VECTOR_ERROR_NULL;
+    case NUMEN_JOB_VECTOR_ADD:
+        return vector_add(job->a, job->b, job->result);
+    case NUMEN_JOB_VECTOR_SUB:
+        return vector_sub(job->a, job->b, job->result);
+    case NUMEN_JOB_VECTOR_MULT:
+        return vector_mult(job->a, job->b, job->result);
+    case NUMEN_JOB_VECTOR_SCALE:
+        return vector_scale(job->a, job->scalar, job->result);
+    case NUMEN_JOB_VECTOR_CROSS:
+        return vector_cross(job->a, job->b, job->result);
+    case NUMEN_JOB_VECTOR_NORMALIZE:
+        return vector_normalize(job->result);
+    case NUMEN_JOB_VECTOR_DOT:
+        return vector_dot(job->a, job->b, job->out);
+    case NUMEN_JOB_VECTOR_ANGLE:
+        return vector_angle(job->a, job->b, job->out);
+    case NUMEN_JOB_VECTOR_DISTANCE:
+        return vector_distance(job->a, job->b, job->out);
+    case NUMEN_JOB_VECTOR_MAGNITUDE:
+        return vector_magnitude(job->a, job->out);
+    case NUMEN_JOB_VECTOR_SUM:
+        return vector_sum(job->a, job->out);
+    case NUMEN_JOB_FACTORIAL:
+        if (!job->out)
+            return VECTOR_ERROR_NULL;
+        return factorial(job->scalar, job->out, job->flags)
+                   ? VECTOR_SUCCESS
+                   : VECTOR_ERROR_MATH;
+    default:
+        return VECTOR_ERROR_INVALID_ARG;
+    }
+}
+
+typedef struct {
+    NumenJob *jobs;
+    size_t count;
+    size_t tasks;
+} BatchRun;
+
+static void batch_task(void *ctx, size_t task) {
+    BatchRun *run = ctx;
+    const size_t begin = run->count * task / run->tasks;
+    const size_t end = run->count * (task + 1) / run->tasks;
+
+    for (size_t i = begin; i < end; i++) {
+        run->jobs[i].status = job_execute(&run->jobs[i]);
+    }
+}
+
+int numen_batch_run(NumenJob *jobs, size_t count) {
+    if (!jobs && count > 0)
+        return VECTOR_ERROR_NULL;
+    if (count == 0)
+        return VECTOR_SUCCESS;
+
+    size_t tasks = pool_thread_count() * JOBS_TASKS_PER_THREAD;
+    if (tasks > count)
+        tasks = count;
+
+    BatchRun run = {.jobs = jobs, .count = count, .tasks = tasks};
+    int err = pool_parallel_for(tasks, batch_task, &run);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    for (size_t i = 0; i < count; i++) {
+        if (jobs[i].status != VECTOR_SUCCESS)
+            return jobs[i].status;
+    }
+    return VECTOR_SUCCESS;
+}
+
+static int batch_submitted(void *arg) {
+    BatchRun *run = arg;
+    return numen_batch_run(run->jobs, run->count);
+}
+
+int numen_batch_submit(NumenJob *jobs,
+                       size_t count,
+                       NumenFuture *const *deps,
+                       size_t dep_count,
+                       NumenFuture **out_future) {
+    if (!jobs && count > 0)
+        return VECTOR_ERROR_NULL;
+
+    BatchRun *run = malloc(sizeof(BatchRun));
+    if (!run)
+        return VECTOR_ERROR_MEM;
+    run->jobs = jobs;
+    run->count = count;
+    run->tasks = 0;
+
+    return future_submit(
+        batch_submitted, run, free, deps, dep_count, out_future);
+}
@@ -0,0 +1,819 @@
+/**
+ * @file krylov.c
+ * @brief Iterative Krylov solvers for sparse and matrix-free operators
+ * @date 18/10/26
+ */
+
+#include "krylov.h"
+#include "blas.h"
+#include "pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Elements per task of the fused vector kernels. Fixed so the reductions
+// do not depend on the number of threads.
+#define KRYLOV_CHUNK 16384
+#define KRYLOV_MAX_SUMS 2 ///< Partial sums per chunk outside GMRES
+
+// --- Fused vector kernels ---
+
+/*
+ * Every solver step that touches whole vectors is one of these passes.
+ * Each does its updates and dot products in a single sweep over the
+ * chunk, instead of one sweep per BLAS-1 call.
+ */
+typedef enum {
+    KERNEL_RESIDUAL, ///< r = b - r, z = m * r; sums r.r, r.z
+    KERNEL_DOT, ///< sums u.v
+    KERNEL_DOT_NORM, ///< sums u.v, u.u
+    KERNEL_SCALE, ///< u *= alpha
+    KERNEL_PRECONDITION, ///< z = m * u
+    KERNEL_CG_UPDATE, ///< x += alpha p, r -= alpha q, z = m * r; sums r.r, r.z
+    KERNEL_CG_DIRECTION, ///< p = z + beta p
+    KERNEL_BICG_DIRECTION, ///< p = r + beta (p - omega v), z = m * p
+    KERNEL_BICG_HALF, ///< r -= alpha v, w = m * r; sums r.r
+    KERNEL_BICG_UPDATE, ///< x += alpha z + omega w, r -= omega q; sums r.r, u.r
+    KERNEL_MULTI_DOT, ///< sums basis[i].u for i < count
+    KERNEL_MULTI_AXPY, ///< u -= sum coeffs[i] basis[i]; sums u.u
+    KERNEL_BASIS_UPDATE ///< x += m * sum coeffs[i] basis[i]
+} KernelKind;
+
+typedef struct {
+    KernelKind kind;
+    size_t size;
+    size_t tasks;
+    size_t sums; ///< Partial sums per chunk
+    double_t *partials; ///< tasks * sums
+    const double_t *m; ///< Inverse diagonal, NULL without preconditioner
+    double_t alpha;
+    double_t beta;
+    double_t omega;
+    const double_t *b;
+    double_t *x;
+    double_t *r;
+    double_t *z;
+    double_t *p;
+    double_t *q;
+    double_t *u;
+    double_t *v;
+    double_t *w;
+    const double_t *basis; ///< count vectors of size elements
+    const double_t *coeffs;
+    size_t count;
+} KrylovJob;
+
+static void kernel_chunk(void *ctx, size_t task) {
+    KrylovJob *job = ctx;
+    const size_t begin = task * KRYLOV_CHUNK;
+    const size_t end =
+        begin + KRYLOV_CHUNK < job->size ? begin + KRYLOV_CHUNK : job->size;
+    const double_t *m = job->m;
+    const double_t alpha = job->alpha;
+    const double_t beta = job->beta;
+    const double_t omega = job->omega;
+    double_t *sums = job->partials + task * job->sums;
+    double_t s0 = 0.0;
+    double_t s1 = 0.0;
+
+    switch (job->kind) {
+    case KERNEL_RESIDUAL:
+        for (size_t i = begin; i < end; i++) {
+            const double_t ri = job->b[i] - job->r[i];
+            job->r[i] = ri;
+            s0 += ri * ri;
+            if (m) {
+                const double_t zi = m[i] * ri;
+                job->z[i] = zi;
+                s1 += ri * zi;
+            }
+        }
+        sums[0] = s0;
+        sums[1] = m ? s1 : s0;
+        break;
+    case KERNEL_DOT:
+        for (size_t i = begin; i < end; i++) {
+            s0 += job->u[i] * job->v[i];
+        }
+        sums[0] = s0;
+        break;
+    case KERNEL_DOT_NORM:
+        for (size_t i = begin; i < end; i++) {
+            s0 += job->u[i] * job->v[i];
+            s1 += job->u[i] * job->u[i];
+        }
+        sums[0] = s0;
+        sums[1] = s1;
+        break;
+    case KERNEL_SCALE:
+        for (size_t i = begin; i < end; i++) {
+            job->u[i] *= alpha;
+        }
+        break;
+    case KERNEL_PRECONDITION:
+        for (size_t i = begin; i < end; i++) {
+            job->z[i] = m[i] * job->u[i];
+        }
+        break;
+    case KERNEL_CG_UPDATE:
+        for (size_t i = begin; i < end; i++) {
+            job->x[i] += alpha * job->p[i];
+            const double_t ri = job->r[i] - alpha * job->q[i];
+            job->r[i] = ri;
+            s0 += ri * ri;
+            if (m) {
+                const double_t zi = m[i] * ri;
+                job->z[i] = zi;
+                s1 += ri * zi;
+            }
+        }
+        sums[0] = s0;
+        sums[1] = m ? s1 : s0;
+        break;
+    case KERNEL_CG_DIRECTION:
+        for (size_t i = begin; i < end; i++) {
+            job->p[i] = job->z[i] + beta * job->p[i];
+        }
+        break;
+    case KERNEL_BICG_DIRECTION:
+        for (size_t i = begin; i < end; i++) {
+            const double_t pi =
+                job->r[i] + beta * (job->p[i] - omega * job->v[i]);
+            job->p[i] = pi;
+            if (m)
+                job->z[i] = m[i] * pi;
+        }
+        break;
+    case KERNEL_BICG_HALF:
+        for (size_t i = begin; i < end; i++) {
+            const double_t ri = job->r[i] - alpha * job->v[i];
+            job->r[i] = ri;
+            s0 += ri * ri;
+            if (m)
+                job->w[i] = m[i] * ri;
+        }
+        sums[0] = s0;
+        break;
+    case KERNEL_BICG_UPDATE:
+        // w may alias r, so read it before r is overwritten
+        for (size_t i = begin; i < end; i++) {
+            job->x[i] += alpha * job->z[i] + omega * job->w[i];
+            const double_t ri = job->r[i] - omega * job->q[i];
+            job->r[i] = ri;
+            s0 += ri * ri;
+            s1 += job->u[i] * ri;
+        }
+        sums[0] = s0;
+        sums[1] = s1;
+        break;
+    case KERNEL_MULTI_DOT:
+        // Basis-major so each chunk of u stays in cache across the basis
+        for (size_t j = 0; j < job->count; j++) {
+            const double_t *vj = job->basis + j * job->size;
+            double_t sum = 0.0;
+            for (size_t i = begin; i < end; i++) {
+                sum += vj[i] * job->u[i];
+            }
+            sums[j] = sum;
+        }
+        break;
+    case KERNEL_MULTI_AXPY:
+        for (size_t j = 0; j < job->count; j++) {
+            const double_t *vj = job->basis + j * job->size;
+            const double_t cj = job->coeffs[j];
+            for (size_t i = begin; i < end; i++) {
+                job->u[i] -= cj * vj[i];
+            }
+        }
+        for (size_t i = begin; i < end; i++) {
+            s0 += job->u[i] * job->u[i];
+        }
+        sums[0] = s0;
+        break;
+    case KERNEL_BASIS_UPDATE:
+        for (size_t i = begin; i < end; i++) {
+            job->z[i] = 0.0;
+        }
+        for (size_t j = 0; j < job->count; j++) {
+            const double_t *vj = job->basis + j * job->size;
+            const double_t cj = job->coeffs[j];
+            for (size_t i = begin; i < end; i++) {
+                job->z[i] += cj * vj[i];
+            }
+        }
+        for (size_t i = begin; i < end; i++) {
+            job->x[i] += m ? m[i] * job->z[i] : job->z[i];
+        }
+        break;
+    }
+}
+
+// Sums each kernel produces
+static size_t kernel_sums(const KrylovJob *job) {
+    switch (job->kind) {
+    case KERNEL_DOT:
+    case KERNEL_BICG_HALF:
+    case KERNEL_MULTI_AXPY:
+        return 1;
+    case KERNEL_RESIDUAL:
+    case KERNEL_DOT_NORM:
+    case KERNEL_CG_UPDATE:
+    case KERNEL_BICG_UPDATE:
+        return 2;
+    case KERNEL_MULTI_DOT:
+        return job->count;
+    default:
+        return 0;
+    }
+}
+
+/*
+ * Run one kernel over all chunks and add up its partial sums in chunk
+ * order, so results are the same for any thread count.
+ */
+static int run_kernel(KrylovJob *job, KernelKind kind, double_t *out_sums) {
+    job->kind = kind;
+    int err = VECTOR_SUCCESS;
+    if (job->tasks < 2) {
+        kernel_chunk(job, 0);
+    } else {
+        err = pool_parallel_for(job->tasks, kernel_chunk, job);
+        if (err != VECTOR_SUCCESS)
+            return err;
+    }
+
+    if (out_sums) {
+        const size_t sums = kernel_sums(job);
+        for (size_t s = 0; s < sums; s++) {
+            double_t total = 0.0;
+            for (size_t t = 0; t < job->tasks; t++) {
+                total += job->partials[t * job->sums + s];
+            }
+            out_sums[s] = total;
+        }
+    }
+    return err;
+}
+
+// --- Operators ---
+
+static int sparse_apply(void *ctx, const Vector *x, Vector *y) {
+    return blas_csrmv(ctx, x->elements, y->elements);
+}
+
+int numen_operator_sparse(const SparseMatrix *a,
+                          Vector *diagonal,
+                          NumenOperator *out) {
+    if (!a || !out)
+        return VECTOR_ERROR_NULL;
+
+    int err = sparse_check(a);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    if (a->rows != a->cols)
+        return VECTOR_ERROR_SIZE;
+
+    if (diagonal) {
+        err = sparse_diagonal(a, diagonal);
+        if (err != VECTOR_SUCCESS)
+            return err;
+    }
+
+    out->size = a->rows;
+    out->apply = sparse_apply;
+    out->ctx = (void *)a;
+    out->diagonal = diagonal;
+    return VECTOR_SUCCESS;
+}
+
+static int apply_operator(const NumenOperator *a,
+                          const double_t *x,
+                          double_t *y) {
+    const Vector in = {(double_t *)x, a->size, a->size};
+    Vector out = {y, a->size, a->size};
+    return a->apply(a->ctx, &in, &out);
+}
+
+// --- Solvers ---
+
+int numen_solver_config_default(NumenSolverConfig *config) {
+    if (!config)
+        return VECTOR_ERROR_NULL;
+
+    config->tolerance = 1e-10;
+    config->max_iterations = 1000;
+    config->restart = 30;
+    config->preconditioner = NUMEN_PRECONDITIONER_NONE;
+    return VECTOR_SUCCESS;
+}
+
+// Shared argument checks, fills cfg from config or the defaults
+static int check_solver(const NumenOperator *a,
+                        const Vector *b,
+                        const Vector *x,
+                        const NumenSolverConfig *config,
+                        NumenSolverConfig *cfg) {
+    if (!a || !a->apply || !b || !x)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(b) || !vector_valid(x))
+        return VECTOR_ERROR_INIT;
+    if (b->size != a->size || x->size != a->size)
+        return VECTOR_ERROR_SIZE;
+    if (x->elements == b->elements)
+        return VECTOR_ERROR_INVALID_ARG;
+
+    if (config)
+        *cfg = *config;
+    else
+        numen_solver_config_default(cfg);
+    if (!(cfg->tolerance >= 0.0))
+        return VECTOR_ERROR_INVALID_ARG;
+
+    if (cfg->preconditioner == NUMEN_PRECONDITIONER_JACOBI) {
+        if (!a->diagonal)
+            return VECTOR_ERROR_INVALID_ARG;
+        if (!vector_valid(a->diagonal))
+            return VECTOR_ERROR_INIT;
+        if (a->diagonal->size != a->size)
+            return VECTOR_ERROR_SIZE;
+    }
+    return VECTOR_SUCCESS;
+}
+
+/*
+ * Allocate vectors vectors of a->size elements plus the inverse diagonal
+ * and kernel partials, and point the job at them.
+ */
+static int setup_job(KrylovJob *job,
+                     const NumenOperator *a,
+                     const NumenSolverConfig *cfg,
+                     size_t vectors,
+                     size_t sums,
+                     double_t **out_vectors) {
+    const size_t n = a->size;
+    const bool jacobi = cfg->preconditioner == NUMEN_PRECONDITIONER_JACOBI;
+
+    memset(job, 0, sizeof(KrylovJob));
+    job->size = n;
+    job->tasks = (n + KRYLOV_CHUNK - 1) / KRYLOV_CHUNK;
+    job->sums = sums;
+
+    const size_t total = (vectors + (jacobi ? 1 : 0)) * n + job->tasks * sums;
+    double_t *block = malloc(total * sizeof(double_t));
+    if (!block)
+        return VECTOR_ERROR_MEM;
+
+    double_t *next = block + vectors * n;
+    if (jacobi) {
+        double_t *m = next;
+        next += n;
+        for (size_t i = 0; i < n; i++) {
+            const double_t d = a->diagonal->elements[i];
+            if (d == 0.0) {
+                free(block);
+                return VECTOR_ERROR_MATH;
+            }
+            m[i] = 1.0 / d;
+        }
+        job->m = m;
+    }
+    job->partials = next;
+
+    *out_vectors = block;
+    return VECTOR_SUCCESS;
+}
+
+static double_t norm2(KrylovJob *job, double_t *u, int *err) {
+    double_t sums[KRYLOV_MAX_SUMS];
+    double_t *saved_u = job->u;
+    double_t *saved_v = job->v;
+    job->u = u;
+    job->v = u;
+    *err = run_kernel(job, KERNEL_DOT, sums);
+    job->u = saved_u;
+    job->v = saved_v;
+    return sqrt(sums[0]);
+}
+
+static void finish_stats(NumenSolverStats *stats,
+                         size_t iterations,
+                         double_t residual) {
+    if (stats) {
+        stats->iterations = iterations;
+        stats->residual = residual;
+    }
+}
+
+int numen_cg(const NumenOperator *a,
+             const Vector *b,
+             Vector *x,
+             const NumenSolverConfig *config,
+             NumenSolverStats *stats) {
+    NumenSolverConfig cfg;
+    int err = check_solver(a, b, x, config, &cfg);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    KrylovJob job;
+    double_t *block = NULL;
+    err = setup_job(&job, a, &cfg, 4, KRYLOV_MAX_SUMS, &block);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    const size_t n = a->size;
+    double_t *r = block;
+    double_t *p = r + n;
+    double_t *q = p + n;
+    double_t *z = job.m ? q + n : r;
+    job.b = b->elements;
+    job.x = x->elements;
+    job.r = r;
+    job.z = z;
+    job.p = p;
+    job.q = q;
+    job.u = p;
+    job.v = q;
+
+    size_t iterations = 0;
+    double_t residual = 0.0;
+    const double_t bnorm = norm2(&job, b->elements, &err);
+    if (err != VECTOR_SUCCESS)
+        goto cleanup;
+    if (bnorm == 0.0) {
+        memset(x->elements, 0, n * sizeof(double_t));
+        goto cleanup;
+    }
+
+    double_t sums[KRYLOV_MAX_SUMS];
+    err = apply_operator(a, x->elements, r);
+    if (err == VECTOR_SUCCESS)
+        err = run_kernel(&job, KERNEL_RESIDUAL, sums);
+    if (err != VECTOR_SUCCESS)
+        goto cleanup;
+
+    double_t rz = sums[1];
+    residual = sqrt(sums[0]) / bnorm;
+    memcpy(p, z, n * sizeof(double_t));
+
+    while (residual > cfg.tolerance) {
+        if (iterations == cfg.max_iterations) {
+            err = VECTOR_ERROR_MATH;
+            break;
+        }
+
+        err = apply_operator(a, p, q);
+        if (err == VECTOR_SUCCESS)
+            err = run_kernel(&job, KERNEL_DOT, sums);
+        if (err != VECTOR_SUCCESS)
+            break;
+
+        const double_t pq = sums[0];
+        if (!(pq > 0.0) || !(rz > 0.0)) {
+            err = VECTOR_ERROR_MATH;
+            break;
+        }
+
+        job.alpha = rz / pq;
+        err = run_kernel(&job, KERNEL_CG_UPDATE, sums);
+        if (err != VECTOR_SUCCESS)
+            break;
+
+        job.beta = sums[1] / rz;
+        rz = sums[1];
+        err = run_kernel(&job, KERNEL_CG_DIRECTION, NULL);
+        if (err != VECTOR_SUCCESS)
+            break;
+
+        iterations++;
+        residual = sqrt(sums[0]) / bnorm;
+    }
+
+cleanup:
+    finish_stats(stats, iterations, residual);
+    free(block);
+    return err;
+}
+
+int numen_bicgstab(const NumenOperator *a,
+                   const Vector *b,
+                   Vector *x,
+                   const NumenSolverConfig *config,
+                   NumenSolverStats *stats) {
+    NumenSolverConfig cfg;
+    int err = check_solver(a, b, x, config, &cfg);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    KrylovJob job;
+    double_t *block = NULL;
+    err = setup_job(&job, a, &cfg, 7, KRYLOV_MAX_SUMS, &block);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    // r_hat is the fixed shadow residual, p_hat and s_hat the
+    // preconditioned directions (aliases of p and s without one)
+    const size_t n = a->size;
+    double_t *r = block;
+    double_t *r_hat = r + n;
+    double_t *p = r_hat + n;
+    double_t *v = p + n;
+    double_t *t = v + n;
+    double_t *p_hat = job.m ? t + n : p;
+    double_t *s_hat = job.m ? t + 2 * n : r;
+    job.b = b->elements;
+    job.x = x->elements;
+    job.r = r;
+    job.p = p;
+    job.v = v;
+    job.z = p_hat;
+    job.w = s_hat;
+    job.q = t;
+
+    size_t iterations = 0;
+    double_t residual = 0.0;
+    const double_t bnorm = norm2(&job, b->elements, &err);
+    if (err != VECTOR_SUCCESS)
+        goto cleanup;
+    if (bnorm == 0.0) {
+        memset(x->elements, 0, n * sizeof(double_t));
+        goto cleanup;
+    }
+
+    // The recurred residual drifts from b - A x, so convergence is
+    // confirmed on the true residual and the iteration restarted from it
+    // if that falls short
+    for (;;) {
+        double_t sums[KRYLOV_MAX_SUMS];
+        const double_t *saved = job.m;
+        job.m = NULL; // only r is wanted here
+        err = apply_operator(a, x->elements, r);
+        if (err == VECTOR_SUCCESS)
+            err = run_kernel(&job, KERNEL_RESIDUAL, sums);
+        job.m = saved;
+        if (err != VECTOR_SUCCESS)
+            break;
+
+        residual = sqrt(sums[0]) / bnorm;
+        if (residual <= cfg.tolerance)
+            break;
+        if (iterations == cfg.max_iterations) {
+            err = VECTOR_ERROR_MATH;
+            break;
+        }
+
+        memcpy(r_hat, r, n * sizeof(double_t));
+        memset(p, 0, n * sizeof(double_t));
+        memset(v, 0, n * sizeof(double_t));
+        memset(t, 0, n * sizeof(double_t));
+        double_t rho = sums[0];
+        double_t rho_old = 1.0;
+        double_t alpha = 1.0;
+        double_t omega = 1.0;
+
+        while (residual > cfg.tolerance) {
+            if (iterations == cfg.max_iterations || rho == 0.0) {
+                err = VECTOR_ERROR_MATH;
+                break;
+            }
+
+            job.beta = (rho / rho_old) * (alpha / omega);
+            job.omega = omega;
+            err = run_kernel(&job, KERNEL_BICG_DIRECTION, NULL);
+            if (err == VECTOR_SUCCESS)
+                err = apply_operator(a, p_hat, v);
+            if (err != VECTOR_SUCCESS)
+                break;
+
+            job.u = r_hat;
+            err = run_kernel(&job, KERNEL_DOT, sums);
+            if (err != VECTOR_SUCCESS)
+                break;
+            if (sums[0] == 0.0) {
+                err = VECTOR_ERROR_MATH;
+                break;
+            }
+
+            alpha = rho / sums[0];
+            job.alpha = alpha;
+            err = run_kernel(&job, KERNEL_BICG_HALF, sums);
+            if (err != VECTOR_SUCCESS)
+                break;
+            iterations++;
+
+            // Converged half way: x += alpha p_hat through the full
+            // update with omega = 0
+            const bool half = sqrt(sums[0]) / bnorm <= cfg.tolerance;
+            if (half) {
+                omega = 0.0;
+            } else {
+                err = apply_operator(a, s_hat, t);
+                if (err != VECTOR_SUCCESS)
+                    break;
+
+                job.u = t;
+                job.v = r;
+                err = run_kernel(&job, KERNEL_DOT_NORM, sums);
+                job.v = v;
+                if (err != VECTOR_SUCCESS)
+                    break;
+                if (sums[1] == 0.0) {
+                    err = VECTOR_ERROR_MATH;
+                    break;
+                }
+                omega = sums[0] / sums[1];
+            }
+
+            job.omega = omega;
+            job.u = r_hat;
+            err = run_kernel(&job, KERNEL_BICG_UPDATE, sums);
+            if (err != VECTOR_SUCCESS)
+                break;
+
+            rho_old = rho;
+            rho = sums[1];
+            residual = sqrt(sums[0]) / bnorm;
+            if (!half && omega == 0.0 && residual > cfg.tolerance) {
+                err = VECTOR_ERROR_MATH;
+                break;
+            }
+        }
+        if (err != VECTOR_SUCCESS)
+            break;
+    }
+
+cleanup:
+    finish_stats(stats, iterations, residual);
+    free(block);
+    return err;
+}
+
+int numen_gmres(const NumenOperator *a,
+                const Vector *b,
+                Vector *x,
+                const NumenSolverConfig *config,
+                NumenSolverStats *stats) {
+    NumenSolverConfig cfg;
+    int err = check_solver(a, b, x, config, &cfg);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    if (cfg.restart == 0)
+        return VECTOR_ERROR_INVALID_ARG;
+
+    const size_t n = a->size;
+    const size_t m = cfg.restart < n ? cfg.restart : n;
+
+    KrylovJob job;
+    double_t *block = NULL;
+    err = setup_job(&job, a, &cfg, m + 2, m + 1, &block);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    // Hessenberg columns, rotations and the small right-hand side
+    double_t *small = malloc(((m + 1) * m + 5 * m + 2) * sizeof(double_t));
+    if (!small) {
+        free(block);
+        return VECTOR_ERROR_MEM;
+    }
+    double_t *h = small; // column j at h + j * (m + 1)
+    double_t *cs = h + (m + 1) * m;
+    double_t *sn = cs + m;
+    double_t *g = sn + m;
+    double_t *y = g + m + 1;
+    double_t *h2 = y + m;
+
+    double_t *basis = block;
+    double_t *z = basis + (m + 1) * n;
+    job.b = b->elements;
+    job.x = x->elements;
+    job.z = z;
+    job.basis = basis;
+
+    size_t iterations = 0;
+    double_t residual = 0.0;
+    const double_t bnorm = norm2(&job, b->elements, &err);
+    if (err != VECTOR_SUCCESS)
+        goto cleanup;
+    if (bnorm == 0.0) {
+        memset(x->elements, 0, n * sizeof(double_t));
+        goto cleanup;
+    }
+
+    for (;;) {
+        // True residual at every restart
+        double_t sums[KRYLOV_MAX_SUMS];
+        const double_t *saved = job.m;
+        job.m = NULL;
+        job.r = basis;
+        err = apply_operator(a, x->elements, basis);
+        if (err == VECTOR_SUCCESS)
+            err = run_kernel(&job, KERNEL_RESIDUAL, sums);
+        job.m = saved;
+        if (err != VECTOR_SUCCESS)
+            break;
+
+        const double_t beta = sqrt(sums[0]);
+        residual = beta / bnorm;
+        if (residual <= cfg.tolerance)
+            break;
+        if (iterations == cfg.max_iterations) {
+            err = VECTOR_ERROR_MATH;
+            break;
+        }
+
+        job.u = basis;
+        job.alpha = 1.0 / beta;
+        err = run_kernel(&job, KERNEL_SCALE, NULL);
+        if (err != VECTOR_SUCCESS)
+            break;
+
+        memset(g, 0, (m + 1) * sizeof(double_t));
+        g[0] = beta;
+        size_t k = 0;
+
+        while (k < m && iterations < cfg.max_iterations) {
+            const size_t j = k;
+            double_t *vj = basis + j * n;
+            double_t *w = vj + n;
+            double_t *hj = h + j * (m + 1);
+
+            if (job.m) {
+                job.u = vj;
+                err = run_kernel(&job, KERNEL_PRECONDITION, NULL);
+                if (err == VECTOR_SUCCESS)
+                    err = apply_operator(a, z, w);
+            } else {
+                err = apply_operator(a, vj, w);
+            }
+            if (err != VECTOR_SUCCESS)
+                break;
+
+            // Classical Gram-Schmidt, twice for orthogonality
+            double_t norm = 0.0;
+            job.u = w;
+            job.count = j + 1;
+            for (int pass = 0; pass < 2 && err == VECTOR_SUCCESS; pass++) {
+                double_t *coeffs = pass == 0 ? hj : h2;
+                err = run_kernel(&job, KERNEL_MULTI_DOT, coeffs);
+                job.coeffs = coeffs;
+                if (err == VECTOR_SUCCESS)
+                    err = run_kernel(&job, KERNEL_MULTI_AXPY, &norm);
+            }
+            if (err != VECTOR_SUCCESS)
+                break;
+            for (size_t i = 0; i <= j; i++) {
+                hj[i] += h2[i];
+            }
+            norm = sqrt(norm);
+            hj[j + 1] = norm;
+
+            // Apply previous rotations, then zero the subdiagonal
+            for (size_t i = 0; i < j; i++) {
+                const double_t tmp = cs[i] * hj[i] + sn[i] * hj[i + 1];
+                hj[i + 1] = -sn[i] * hj[i] + cs[i] * hj[i + 1];
+                hj[i] = tmp;
+            }
+            const double_t rot = hypot(hj[j], hj[j + 1]);
+            cs[j] = rot > 0.0 ? hj[j] / rot : 1.0;
+            sn[j] = rot > 0.0 ? hj[j + 1] / rot : 0.0;
+            hj[j] = rot;
+            hj[j + 1] = 0.0;
+            g[j + 1] = -sn[j] * g[j];
+            g[j] = cs[j] * g[j];
+
+            iterations++;
+            k++;
+            residual = fabs(g[j + 1]) / bnorm;
+            if (residual <= cfg.tolerance || norm == 0.0)
+                break;
+
+            job.u = w;
+            job.alpha = 1.0 / norm;
+            err = run_kernel(&job, KERNEL_SCALE, NULL);
+            if (err != VECTOR_SUCCESS)
+                break;
+        }
+        if (err != VECTOR_SUCCESS)
+            break;
+
+        // y = R^-1 g, then x += M^-1 * V * y
+        for (size_t i = k; i-- > 0;) {
+            double_t sum = g[i];
+            for (size_t c = i + 1; c < k; c++) {
+                sum -= h[c * (m + 1) + i] * y[c];
+            }
+            const double_t diag = h[i * (m + 1) + i];
+            y[i] = diag != 0.0 ? sum / diag : 0.0;
+        }
+
+        job.coeffs = y;
+        job.count = k;
+        err = run_kernel(&job, KERNEL_BASIS_UPDATE, NULL);
+        if (err != VECTOR_SUCCESS)
+            break;
+    }
+
+cleanup:
+    finish_stats(stats, iterations, residual);
+    free(small);
+    free(block);
+    return err;
+}
@@ -0,0 +1,1128 @@
+/**
+ * @file linalg.c
+ * @brief Dense factorizations and linear solvers
+ * @date 18/10/26
+ */
+
+#include "linalg.h"
+#include "blas.h"
+#include "pool.h"
+#include <float.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LU_BLOCK 32 ///< Panel width of the blocked LU
+#define SOLVE_BATCH_PER_TASK 8 ///< Systems per pool task
+#define CHOLESKY_BLOCK 64 ///< Panel width of the blocked Cholesky
+#define QR_BLOCK 32 ///< Reflectors per compact WY block
+#define CHOLESKY_BATCH_CHUNK 256 ///< Matrices per task, whole mask words
+
+// --- Triangular kernels ---
+
+// Forward substitution on a strided lower triangle, in place
+static int solve_lower(const double_t *t,
+                       size_t n,
+                       size_t ldt,
+                       bool unit_diag,
+                       double_t *x) {
+    for (size_t i = 0; i < n; i++) {
+        const double_t *row = t + i * ldt;
+        double_t sum = x[i];
+        for (size_t j = 0; j < i; j++) {
+            sum -= row[j] * x[j];
+        }
+        if (!unit_diag) {
+            if (row[i] == 0.0)
+                return VECTOR_ERROR_MATH;
+            sum /= row[i];
+        }
+        x[i] = sum;
+    }
+    return VECTOR_SUCCESS;
+}
+
+// Back substitution on a strided upper triangle, in place
+static int solve_upper(const double_t *t,
+                       size_t n,
+                       size_t ldt,
+                       bool unit_diag,
+                       double_t *x) {
+    for (size_t i = n; i-- > 0;) {
+        const double_t *row = t + i * ldt;
+        double_t sum = x[i];
+        for (size_t j = i + 1; j < n; j++) {
+            sum -= row[j] * x[j];
+        }
+        if (!unit_diag) {
+            if (row[i] == 0.0)
+                return VECTOR_ERROR_MATH;
+            sum /= row[i];
+        }
+        x[i] = sum;
+    }
+    return VECTOR_SUCCESS;
+}
+
+// --- LU ---
+
+static void swap_rows(double_t *a, size_t n, size_t r1, size_t r2) {
+    double_t *row1 = a + r1 * n;
+    double_t *row2 = a + r2 * n;
+    for (size_t j = 0; j < n; j++) {
+        double_t tmp = row1[j];
+        row1[j] = row2[j];
+        row2[j] = tmp;
+    }
+}
+
+/*
+ * In-place blocked LU of an n x n row-major array. Each step factors a
+ * LU_BLOCK wide panel column by column, solves for the block row of U and
+ * updates the trailing matrix with one product.
+ */
+static int lu_factor(double_t *a, size_t n, size_t *pivots) {
+    bool singular = false;
+
+    for (size_t j0 = 0; j0 < n; j0 += LU_BLOCK) {
+        const size_t jb = n - j0 < LU_BLOCK ? n - j0 : LU_BLOCK;
+        const size_t panel_end = j0 + jb;
+
+        // Panel factorization
+        for (size_t j = j0; j < panel_end; j++) {
+            size_t pivot = j;
+            double_t best = fabs(a[j * n + j]);
+            for (size_t i = j + 1; i < n; i++) {
+                double_t value = fabs(a[i * n + j]);
+                if (value > best) {
+                    best = value;
+                    pivot = i;
+                }
+            }
+
+            pivots[j] = pivot;
+            if (pivot != j)
+                swap_rows(a, n, j, pivot);
+
+            const double_t diag = a[j * n + j];
+            if (diag == 0.0) {
+                singular = true;
+                continue;
+            }
+
+            const double_t *pivot_row = a + j * n;
+            for (size_t i = j + 1; i < n; i++) {
+                double_t *row = a + i * n;
+                const double_t factor = row[j] / diag;
+                row[j] = factor;
+                for (size_t c = j + 1; c < panel_end; c++) {
+                    row[c] -= factor * pivot_row[c];
+                }
+            }
+        }
+
+        if (panel_end == n)
+            break;
+
+        const size_t rest = n - panel_end;
+
+        // U12 = L11^-1 * A12
+        blas_trsm_lower_unit(jb,
+                             rest,
+                             a + j0 * n + j0,
+                             n,
+                             a + j0 * n + panel_end,
+                             n);
+
+        // A22 -= L21 * U12
+        int err = blas_gemm_parallel(rest,
+                                     rest,
+                                     jb,
+                                     -1.0,
+                                     a + panel_end * n + j0,
+                                     n,
+                                     a + j0 * n + panel_end,
+                                     n,
+                                     a + panel_end * n + panel_end,
+                                     n);
+        if (err != VECTOR_SUCCESS)
+            return err;
+    }
+
+    return singular ? VECTOR_ERROR_MATH : VECTOR_SUCCESS;
+}
+
+// x holds b on entry and the solution on exit
+static int lu_solve(const double_t *lu,
+                    size_t n,
+                    const size_t *pivots,
+                    double_t *x) {
+    for (size_t i = 0; i < n; i++) {
+        if (pivots[i] != i) {
+            double_t tmp = x[i];
+            x[i] = x[pivots[i]];
+            x[pivots[i]] = tmp;
+        }
+    }
+
+    solve_lower(lu, n, n, true, x);
+    return solve_upper(lu, n, n, false, x);
+}
+
+int matrix_lu(const Matrix *a, Matrix *lu, size_t *pivots) {
+    if (!a || !lu || !pivots)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a) || !matrix_valid(lu))
+        return VECTOR_ERROR_INIT;
+    if (a->rows != a->cols || lu->rows != a->rows || lu->cols != a->cols)
+        return VECTOR_ERROR_SIZE;
+
+    if (lu != a)
+        matrix_copy(a, lu);
+    return lu_factor(lu->elements, lu->rows, pivots);
+}
+
+// Shared checks of square solvers: t square, b and x of matching size
+static int check_square_system(const Matrix *t,
+                               const Vector *b,
+                               const Vector *x) {
+    if (!t || !b || !x)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(t) || !vector_valid(b) || !vector_valid(x))
+        return VECTOR_ERROR_INIT;
+    if (t->rows != t->cols || b->size != t->rows || x->size != t->rows)
+        return VECTOR_ERROR_SIZE;
+    return VECTOR_SUCCESS;
+}
+
+int matrix_lu_solve(const Matrix *lu,
+                    const size_t *pivots,
+                    const Vector *b,
+                    Vector *x) {
+    if (!pivots)
+        return VECTOR_ERROR_NULL;
+    int err = check_square_system(lu, b, x);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    memmove(x->elements, b->elements, b->size * sizeof(double_t));
+    return lu_solve(lu->elements, lu->rows, pivots, x->elements);
+}
+
+// Factor a private copy and solve, used by the single and batched solvers
+static int solve_system(const Matrix *a, const Vector *b, Vector *x) {
+    const size_t n = a->rows;
+    double_t *lu = malloc(n * n * sizeof(double_t));
+    size_t *pivots = malloc(n * sizeof(size_t));
+    if (!lu || !pivots) {
+        free(lu);
+        free(pivots);
+        return VECTOR_ERROR_MEM;
+    }
+
+    memcpy(lu, a->elements, n * n * sizeof(double_t));
+    int err = lu_factor(lu, n, pivots);
+    if (err == VECTOR_SUCCESS) {
+        memmove(x->elements, b->elements, n * sizeof(double_t));
+        err = lu_solve(lu, n, pivots, x->elements);
+    }
+
+    free(lu);
+    free(pivots);
+    return err;
+}
+
+int matrix_solve(const Matrix *a, const Vector *b, Vector *x) {
+    int err = check_square_system(a, b, x);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    return solve_system(a, b, x);
+}
+
+typedef struct {
+    const Matrix *const *a;
+    const Vector *const *b;
+    Vector *const *x;
+    size_t count;
+    atomic_int status; ///< First error seen, VECTOR_SUCCESS if none
+} SolveBatchJob;
+
+static void solve_batch_task(void *ctx, size_t task) {
+    SolveBatchJob *job = ctx;
+    const size_t begin = task * SOLVE_BATCH_PER_TASK;
+    const size_t end = begin + SOLVE_BATCH_PER_TASK < job->count
+                           ? begin + SOLVE_BATCH_PER_TASK
+                           : job->count;
+
+    for (size_t i = begin; i < end; i++) {
+        int err = solve_system(job->a[i], job->b[i], job->x[i]);
+        if (err != VECTOR_SUCCESS) {
+            int expected = VECTOR_SUCCESS;
+            atomic_compare_exchange_strong(&job->status, &expected, err);
+        }
+    }
+}
+
+int matrix_solve_batched(const Matrix *const *a,
+                         const Vector *const *b,
+                         Vector *const *x,
+                         size_t count) {
+    if (!a || !b || !x)
+        return VECTOR_ERROR_NULL;
+
+    for (size_t i = 0; i < count; i++) {
+        int err = check_square_system(a[i], b[i], x[i]);
+        if (err != VECTOR_SUCCESS)
+            return err;
+    }
+
+    SolveBatchJob job = {.a = a, .b = b, .x = x, .count = count};
+    atomic_init(&job.status, VECTOR_SUCCESS);
+
+    const size_t tasks =
+        (count + SOLVE_BATCH_PER_TASK - 1) / SOLVE_BATCH_PER_TASK;
+    int err = pool_parallel_for(tasks, solve_batch_task, &job);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    return atomic_load(&job.status);
+}
+
+// --- Cholesky ---
+
+// Unblocked Cholesky of the jb x jb diagonal block at a (stride n)
+static int cholesky_block(double_t *a, size_t jb, size_t n) {
+    for (size_t j = 0; j < jb; j++) {
+        double_t *row_j = a + j * n;
+        double_t d = row_j[j];
+        for (size_t p = 0; p < j; p++) {
+            d -= row_j[p] * row_j[p];
+        }
+        if (!(d > 0.0))
+            return VECTOR_ERROR_MATH;
+        d = sqrt(d);
+        row_j[j] = d;
+
+        for (size_t i = j + 1; i < jb; i++) {
+            double_t *row_i = a + i * n;
+            double_t sum = row_i[j];
+            for (size_t p = 0; p < j; p++) {
+                sum -= row_i[p] * row_j[p];
+            }
+            row_i[j] = sum / d;
+        }
+    }
+    return VECTOR_SUCCESS;
+}
+
+/*
+ * In-place blocked lower Cholesky of an n x n row-major array. Each step
+ * factors a diagonal block, solves the panel below it against that block
+ * and subtracts the panel's outer product from the trailing matrix.
+ */
+static int cholesky_factor(double_t *a, size_t n) {
+    double_t *panel_t = NULL;
+
+    for (size_t j0 = 0; j0 < n; j0 += CHOLESKY_BLOCK) {
+        const size_t jb = n - j0 < CHOLESKY_BLOCK ? n - j0 : CHOLESKY_BLOCK;
+        const size_t panel_end = j0 + jb;
+        double_t *diag = a + j0 * n + j0;
+
+        int err = cholesky_block(diag, jb, n);
+        if (err != VECTOR_SUCCESS) {
+            free(panel_t);
+            return err;
+        }
+        if (panel_end == n)
+            break;
+
+        const size_t rest = n - panel_end;
+
+        // L21 = A21 * L11^-T, one forward substitution per row
+        for (size_t i = panel_end; i < n; i++) {
+            double_t *row = a + i * n + j0;
+            for (size_t c = 0; c < jb; c++) {
+                const double_t *l_row = diag + c * n;
+                double_t sum = row[c];
+                for (size_t p = 0; p < c; p++) {
+                    sum -= row[p] * l_row[p];
+                }
+                row[c] = sum / l_row[c];
+            }
+        }
+
+        // A22 -= L21 * L21^T on the lower triangle only, which is all the
+        // later steps read, through a transposed copy of the panel
+        if (!panel_t) {
+            panel_t = malloc(CHOLESKY_BLOCK * (n - CHOLESKY_BLOCK) *
+                             sizeof(double_t));
+            if (!panel_t)
+                return VECTOR_ERROR_MEM;
+        }
+        for (size_t i = 0; i < rest; i++) {
+            const double_t *row = a + (panel_end + i) * n + j0;
+            for (size_t c = 0; c < jb; c++) {
+                panel_t[c * rest + i] = row[c];
+            }
+        }
+
+        err = blas_syrk_lower_packed(rest,
+                                     jb,
+                                     -1.0,
+                                     a + panel_end * n + j0,
+                                     n,
+                                     panel_t,
+                                     rest,
+                                     a + panel_end * n + panel_end,
+                                     n);
+        if (err != VECTOR_SUCCESS) {
+            free(panel_t);
+            return err;
+        }
+    }
+
+    free(panel_t);
+    for (size_t i = 0; i < n; i++) {
+        memset(a + i * n + i + 1, 0, (n - i - 1) * sizeof(double_t));
+    }
+    return VECTOR_SUCCESS;
+}
+
+// x holds b on entry and the solution on exit
+static void cholesky_solve(const double_t *l, size_t n, double_t *x) {
+    solve_lower(l, n, n, false, x);
+
+    // L^T x = y, walking columns of L as rows of L^T
+    for (size_t i = n; i-- > 0;) {
+        double_t sum = x[i];
+        for (size_t j = i + 1; j < n; j++) {
+            sum -= l[j * n + i] * x[j];
+        }
+        x[i] = sum / l[i * n + i];
+    }
+}
+
+int matrix_cholesky(const Matrix *a, Matrix *l) {
+    if (!a || !l)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a) || !matrix_valid(l))
+        return VECTOR_ERROR_INIT;
+    if (a->rows != a->cols || l->rows != a->rows || l->cols != a->cols)
+        return VECTOR_ERROR_SIZE;
+
+    if (l != a)
+        matrix_copy(a, l);
+    return cholesky_factor(l->elements, l->rows);
+}
+
+int matrix_cholesky_solve(const Matrix *l, const Vector *b, Vector *x) {
+    int err = check_square_system(l, b, x);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    memmove(x->elements, b->elements, b->size * sizeof(double_t));
+    cholesky_solve(l->elements, l->rows, x->elements);
+    return VECTOR_SUCCESS;
+}
+
+int matrix_solve_spd(const Matrix *a, const Vector *b, Vector *x) {
+    int err = check_square_system(a, b, x);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    const size_t n = a->rows;
+    double_t *l = malloc(n * n * sizeof(double_t));
+    if (!l)
+        return VECTOR_ERROR_MEM;
+
+    memcpy(l, a->elements, n * n * sizeof(double_t));
+    err = cholesky_factor(l, n);
+    if (err == VECTOR_SUCCESS) {
+        memmove(x->elements, b->elements, n * sizeof(double_t));
+        cholesky_solve(l, n, x->elements);
+    }
+
+    free(l);
+    return err;
+}
+
+typedef struct {
+    MatrixBatch *batch;
+    const MatrixBatch *factors;
+    uint64_t *failed; ///< Mask words, NULL if not requested
+    atomic_bool any_failed;
+} CholeskyBatchJob;
+
+#define BATCH_AT(data, n, count, i, j) ((data) + ((i) * (n) + (j)) * (count))
+
+/*
+ * One chunk of matrices, the loops over k are innermost and contiguous so
+ * every step runs across CHOLESKY_BATCH_CHUNK matrices in SIMD lanes.
+ * Failed matrices continue with a unit pivot so their lanes stay finite.
+ */
+static void cholesky_batch_task(void *ctx, size_t task) {
+    CholeskyBatchJob *job = ctx;
+    const size_t n = job->batch->rows;
+    const size_t count = job->batch->count;
+    const size_t begin = task * CHOLESKY_BATCH_CHUNK;
+    const size_t lanes = count - begin < CHOLESKY_BATCH_CHUNK
+                             ? count - begin
+                             : CHOLESKY_BATCH_CHUNK;
+    double_t *base = job->batch->elements + begin;
+    bool bad[CHOLESKY_BATCH_CHUNK] = {false};
+
+    for (size_t j = 0; j < n; j++) {
+        double_t *restrict l_jj = BATCH_AT(base, n, count, j, j);
+        for (size_t p = 0; p < j; p++) {
+            const double_t *restrict l_jp = BATCH_AT(base, n, count, j, p);
+            for (size_t k = 0; k < lanes; k++) {
+                l_jj[k] -= l_jp[k] * l_jp[k];
+            }
+        }
+        for (size_t k = 0; k < lanes; k++) {
+            const bool ok = l_jj[k] > 0.0;
+            bad[k] |= !ok;
+            l_jj[k] = ok ? sqrt(l_jj[k]) : 1.0;
+        }
+
+        for (size_t i = j + 1; i < n; i++) {
+            double_t *restrict l_ij = BATCH_AT(base, n, count, i, j);
+            for (size_t p = 0; p < j; p++) {
+                const double_t *restrict l_ip = BATCH_AT(base, n, count, i, p);
+                const double_t *restrict l_jp = BATCH_AT(base, n, count, j, p);
+                for (size_t k = 0; k < lanes; k++) {
+                    l_ij[k] -= l_ip[k] * l_jp[k];
+                }
+            }
+            for (size_t k = 0; k < lanes; k++) {
+                l_ij[k] /= l_jj[k];
+            }
+            memset(BATCH_AT(base, n, count, j, i), 0, lanes * sizeof(double_t));
+        }
+    }
+
+    bool any = false;
+    for (size_t k = 0; k < lanes; k++) {
+        any |= bad[k];
+        if (job->failed && bad[k])
+            job->failed[(begin + k) / 64] |= (uint64_t)1 << ((begin + k) % 64);
+    }
+    if (any)
+        atomic_store(&job->any_failed, true);
+}
+
+int matrix_cholesky_batched(MatrixBatch *batch, VectorMask *failed) {
+    if (!batch)
+        return VECTOR_ERROR_NULL;
+    if (!batch->elements || (failed && !failed->bits))
+        return VECTOR_ERROR_INIT;
+    if (batch->rows != batch->cols || batch->rows > CHOLESKY_BATCH_MAX ||
+        (failed && failed->size != batch->count))
+        return VECTOR_ERROR_SIZE;
+
+    CholeskyBatchJob job = {
+        .batch = batch,
+        .failed = failed ? failed->bits : NULL,
+    };
+    atomic_init(&job.any_failed, false);
+    if (failed)
+        memset(failed->bits, 0, (failed->size + 63) / 64 * sizeof(uint64_t));
+
+    const size_t tasks =
+        (batch->count + CHOLESKY_BATCH_CHUNK - 1) / CHOLESKY_BATCH_CHUNK;
+    int err = pool_parallel_for(tasks, cholesky_batch_task, &job);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    return atomic_load(&job.any_failed) ? VECTOR_ERROR_MATH : VECTOR_SUCCESS;
+}
+
+static void cholesky_solve_batch_task(void *ctx, size_t task) {
+    CholeskyBatchJob *job = ctx;
+    const size_t n = job->factors->rows;
+    const size_t count = job->factors->count;
+    const size_t begin = task * CHOLESKY_BATCH_CHUNK;
+    const size_t lanes = count - begin < CHOLESKY_BATCH_CHUNK
+                             ? count - begin
+                             : CHOLESKY_BATCH_CHUNK;
+    const double_t *l = job->factors->elements + begin;
+    double_t *x = job->batch->elements + begin;
+
+    // Forward: L y = b
+    for (size_t i = 0; i < n; i++) {
+        double_t *restrict x_i = x + i * count;
+        for (size_t p = 0; p < i; p++) {
+            const double_t *restrict l_ip = BATCH_AT(l, n, count, i, p);
+            const double_t *restrict x_p = x + p * count;
+            for (size_t k = 0; k < lanes; k++) {
+                x_i[k] -= l_ip[k] * x_p[k];
+            }
+        }
+        const double_t *restrict l_ii = BATCH_AT(l, n, count, i, i);
+        for (size_t k = 0; k < lanes; k++) {
+            x_i[k] /= l_ii[k];
+        }
+    }
+
+    // Backward: L^T x = y
+    for (size_t i = n; i-- > 0;) {
+        double_t *restrict x_i = x + i * count;
+        for (size_t p = i + 1; p < n; p++) {
+            const double_t *restrict l_pi = BATCH_AT(l, n, count, p, i);
+            const double_t *restrict x_p = x + p * count;
+            for (size_t k = 0; k < lanes; k++) {
+                x_i[k] -= l_pi[k] * x_p[k];
+            }
+        }
+        const double_t *restrict l_ii = BATCH_AT(l, n, count, i, i);
+        for (size_t k = 0; k < lanes; k++) {
+            x_i[k] /= l_ii[k];
+        }
+    }
+}
+
+int matrix_cholesky_solve_batched(const MatrixBatch *l, MatrixBatch *rhs) {
+    if (!l || !rhs)
+        return VECTOR_ERROR_NULL;
+    if (!l->elements || !rhs->elements)
+        return VECTOR_ERROR_INIT;
+    if (l->rows != l->cols || rhs->rows != l->rows || rhs->cols != 1 ||
+        rhs->count != l->count)
+        return VECTOR_ERROR_SIZE;
+
+    CholeskyBatchJob job = {.batch = rhs, .factors = l};
+    const size_t tasks =
+        (l->count + CHOLESKY_BATCH_CHUNK - 1) / CHOLESKY_BATCH_CHUNK;
+    return pool_parallel_for(tasks, cholesky_solve_batch_task, &job);
+}
+
+// --- QR ---
+
+// Apply reflector j of a (m x n) to columns [c0, c1) of rows j..m of c
+static void apply_reflector(const double_t *a,
+                            size_t m,
+                            size_t n,
+                            size_t j,
+                            double_t tau,
+                            double_t *c,
+                            size_t ldc,
+                            size_t c0,
+                            size_t c1,
+                            double_t *w) {
+    if (tau == 0.0 || c0 >= c1)
+        return;
+
+    const size_t width = c1 - c0;
+    memcpy(w, c + j * ldc + c0, width * sizeof(double_t));
+    for (size_t i = j + 1; i < m; i++) {
+        const double_t v = a[i * n + j];
+        const double_t *row = c + i * ldc + c0;
+        for (size_t col = 0; col < width; col++) {
+            w[col] += v * row[col];
+        }
+    }
+
+    for (size_t col = 0; col < width; col++) {
+        w[col] *= tau;
+    }
+    double_t *top = c + j * ldc + c0;
+    for (size_t col = 0; col < width; col++) {
+        top[col] -= w[col];
+    }
+    for (size_t i = j + 1; i < m; i++) {
+        const double_t v = a[i * n + j];
+        double_t *row = c + i * ldc + c0;
+        for (size_t col = 0; col < width; col++) {
+            row[col] -= v * w[col];
+        }
+    }
+}
+
+// Upper triangular T with H_0 ... H_{jb-1} = I - V * T * V^T
+static void qr_build_t(const double_t *v,
+                       size_t rows,
+                       size_t jb,
+                       const double_t *tau,
+                       double_t *t) {
+    memset(t, 0, jb * jb * sizeof(double_t));
+
+    for (size_t i = 0; i < jb; i++) {
+        t[i * jb + i] = tau[i];
+        if (tau[i] == 0.0)
+            continue;
+
+        // z = V[:, 0:i]^T * v_i, v_i is zero above row i
+        double_t z[QR_BLOCK];
+        for (size_t p = 0; p < i; p++) {
+            double_t sum = 0.0;
+            for (size_t r = i; r < rows; r++) {
+                sum += v[r * jb + p] * v[r * jb + i];
+            }
+            z[p] = sum;
+        }
+
+        for (size_t p = 0; p < i; p++) {
+            double_t sum = 0.0;
+            for (size_t q = p; q < i; q++) {
+                sum += t[p * jb + q] * z[q];
+            }
+            t[p * jb + i] = -tau[i] * sum;
+        }
+    }
+}
+
+typedef struct {
+    double_t *w; ///< Row workspace, n elements
+    double_t *v; ///< Panel reflectors, m x QR_BLOCK
+    double_t *v_t; ///< Transposed panel reflectors, QR_BLOCK x m
+    double_t *t; ///< QR_BLOCK x QR_BLOCK
+    double_t *work; ///< QR_BLOCK x n
+} QRWorkspace;
+
+static void qr_workspace_free(QRWorkspace *ws) {
+    free(ws->w);
+    free(ws->v);
+    free(ws->v_t);
+    free(ws->t);
+    free(ws->work);
+}
+
+static int qr_workspace_init(QRWorkspace *ws, size_t m, size_t n) {
+    ws->w = malloc(n * sizeof(double_t));
+    ws->v = malloc(m * QR_BLOCK * sizeof(double_t));
+    ws->v_t = malloc(m * QR_BLOCK * sizeof(double_t));
+    ws->t = malloc(QR_BLOCK * QR_BLOCK * sizeof(double_t));
+    ws->work = malloc(QR_BLOCK * n * sizeof(double_t));
+    if (!ws->w || !ws->v || !ws->v_t || !ws->t || !ws->work) {
+        qr_workspace_free(ws);
+        return VECTOR_ERROR_MEM;
+    }
+    return VECTOR_SUCCESS;
+}
+
+/*
+ * In-place blocked Householder QR of an m x n row-major array. Reflectors
+ * of each panel are applied to the panel one at a time, then to the
+ * trailing columns together as C -= V * (T^T * (V^T * C)).
+ */
+static int qr_factor(double_t *a, size_t m, size_t n, double_t *tau) {
+    const size_t k = m < n ? m : n;
+    QRWorkspace ws;
+    int err = qr_workspace_init(&ws, m, n);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    for (size_t j0 = 0; j0 < k && err == VECTOR_SUCCESS; j0 += QR_BLOCK) {
+        const size_t jb = k - j0 < QR_BLOCK ? k - j0 : QR_BLOCK;
+        const size_t panel_end = j0 + jb;
+
+        for (size_t j = j0; j < panel_end; j++) {
+            tau[j] = blas_householder(a + j * n + j, m - j, n);
+            apply_reflector(a, m, n, j, tau[j], a, n, j + 1, panel_end, ws.w);
+        }
+        if (panel_end == n)
+            break;
+
+        const size_t rows = m - j0;
+        const size_t cols = n - panel_end;
+        double_t *c = a + j0 * n + panel_end;
+
+        for (size_t i = 0; i < rows; i++) {
+            for (size_t p = 0; p < jb; p++) {
+                double_t v = i == p  ? 1.0
+                             : i > p ? a[(j0 + i) * n + j0 + p]
+                                     : 0.0;
+                ws.v[i * jb + p] = v;
+                ws.v_t[p * rows + i] = v;
+            }
+        }
+        qr_build_t(ws.v, rows, jb, tau + j0, ws.t);
+
+        // work = V^T * C
+        memset(ws.work, 0, jb * cols * sizeof(double_t));
+        err = blas_gemm_parallel(
+            jb, cols, rows, 1.0, ws.v_t, rows, c, n, ws.work, cols);
+        if (err != VECTOR_SUCCESS)
+            break;
+
+        // work = T^T * work, bottom row first so inputs are still intact
+        for (size_t i = jb; i-- > 0;) {
+            double_t *row = ws.work + i * cols;
+            const double_t t_ii = ws.t[i * jb + i];
+            for (size_t col = 0; col < cols; col++) {
+                row[col] *= t_ii;
+            }
+            for (size_t p = 0; p < i; p++) {
+                const double_t t_pi = ws.t[p * jb + i];
+                const double_t *src = ws.work + p * cols;
+                for (size_t col = 0; col < cols; col++) {
+                    row[col] += t_pi * src[col];
+                }
+            }
+        }
+
+        // C -= V * work
+        err = blas_gemm_parallel(
+            rows, cols, jb, -1.0, ws.v, jb, ws.work, cols, c, n);
+    }
+
+    qr_workspace_free(&ws);
+    return err;
+}
+
+// b = Q^T * b for the m-element b
+static void qr_apply_qt(const double_t *qr,
+                        size_t m,
+                        size_t n,
+                        const double_t *tau,
+                        double_t *b) {
+    const size_t k = m < n ? m : n;
+    for (size_t j = 0; j < k; j++) {
+        if (tau[j] == 0.0)
+            continue;
+
+        double_t w = b[j];
+        for (size_t i = j + 1; i < m; i++) {
+            w += qr[i * n + j] * b[i];
+        }
+        w *= tau[j];
+
+        b[j] -= w;
+        for (size_t i = j + 1; i < m; i++) {
+            b[i] -= w * qr[i * n + j];
+        }
+    }
+}
+
+int matrix_qr(const Matrix *a, Matrix *qr, Vector *tau) {
+    if (!a || !qr || !tau)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a) || !matrix_valid(qr) || !vector_valid(tau))
+        return VECTOR_ERROR_INIT;
+    if (qr->rows != a->rows || qr->cols != a->cols ||
+        tau->size != (a->rows < a->cols ? a->rows : a->cols))
+        return VECTOR_ERROR_SIZE;
+
+    if (qr != a)
+        matrix_copy(a, qr);
+    return qr_factor(qr->elements, qr->rows, qr->cols, tau->elements);
+}
+
+int matrix_qr_unpack(const Matrix *qr,
+                     const Vector *tau,
+                     Matrix *q,
+                     Matrix *r) {
+    if (!qr || !tau)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(qr) || !vector_valid(tau) || (q && !matrix_valid(q)) ||
+        (r && !matrix_valid(r)))
+        return VECTOR_ERROR_INIT;
+
+    const size_t m = qr->rows;
+    const size_t n = qr->cols;
+    const size_t k = m < n ? m : n;
+    if (tau->size != k || (q && (q->rows != m || q->cols != k)) ||
+        (r && (r->rows != k || r->cols != n)))
+        return VECTOR_ERROR_SIZE;
+
+    if (r) {
+        for (size_t i = 0; i < k; i++) {
+            double_t *row = r->elements + i * n;
+            memset(row, 0, i * sizeof(double_t));
+            memcpy(row + i,
+                   qr->elements + i * n + i,
+                   (n - i) * sizeof(double_t));
+        }
+    }
+
+    if (q) {
+        double_t *w = malloc(k * sizeof(double_t));
+        if (!w)
+            return VECTOR_ERROR_MEM;
+
+        // Q = H_0 * ... * H_{k-1} * I, applied right to left
+        memset(q->elements, 0, m * k * sizeof(double_t));
+        for (size_t i = 0; i < k; i++) {
+            q->elements[i * k + i] = 1.0;
+        }
+        for (size_t j = k; j-- > 0;) {
+            apply_reflector(qr->elements,
+                            m,
+                            n,
+                            j,
+                            tau->elements[j],
+                            q->elements,
+                            k,
+                            j,
+                            k,
+                            w);
+        }
+        free(w);
+    }
+    return VECTOR_SUCCESS;
+}
+
+int matrix_least_squares(const Matrix *a, const Vector *b, Vector *x) {
+    if (!a || !b || !x)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a) || !vector_valid(b) || !vector_valid(x))
+        return VECTOR_ERROR_INIT;
+    if (a->rows < a->cols || b->size != a->rows || x->size != a->cols)
+        return VECTOR_ERROR_SIZE;
+
+    const size_t m = a->rows;
+    const size_t n = a->cols;
+    double_t *qr = malloc(m * n * sizeof(double_t));
+    double_t *tau = malloc(n * sizeof(double_t));
+    double_t *rhs = malloc(m * sizeof(double_t));
+    if (!qr || !tau || !rhs) {
+        free(qr);
+        free(tau);
+        free(rhs);
+        return VECTOR_ERROR_MEM;
+    }
+
+    memcpy(qr, a->elements, m * n * sizeof(double_t));
+    memcpy(rhs, b->elements, m * sizeof(double_t));
+
+    int err = qr_factor(qr, m, n, tau);
+    if (err == VECTOR_SUCCESS) {
+        qr_apply_qt(qr, m, n, tau, rhs);
+
+        // Rank check relative to the largest diagonal of R
+        double_t max_diag = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            max_diag = fmax(max_diag, fabs(qr[i * n + i]));
+        }
+        const double_t tol = max_diag * DBL_EPSILON * (double_t)m;
+        for (size_t i = 0; i < n; i++) {
+            if (!(fabs(qr[i * n + i]) > tol))
+                err = VECTOR_ERROR_MATH;
+        }
+    }
+    if (err == VECTOR_SUCCESS) {
+        err = solve_upper(qr, n, n, false, rhs);
+        memcpy(x->elements, rhs, n * sizeof(double_t));
+    }
+
+    free(qr);
+    free(tau);
+    free(rhs);
+    return err;
+}
+
+// --- Incremental QR ---
+
+struct NumenQRStream {
+    size_t n;
+    double_t forgetting;
+    double_t *r; ///< n x n upper triangular factor
+    double_t *z; ///< Q^T * y restricted to the first n rows
+    double_t *row; ///< Workspace for the incoming row
+    double_t *cosines; ///< Workspace for the rotations of a downdate
+    double_t rss; ///< Residual sum of squares
+};
+
+int numen_qr_stream_create(size_t n,
+                           double_t forgetting,
+                           NumenQRStream **out_stream) {
+    if (!out_stream)
+        return VECTOR_ERROR_NULL;
+    if (n == 0)
+        return VECTOR_ERROR_SIZE;
+    if (!(forgetting > 0.0 && forgetting <= 1.0))
+        return VECTOR_ERROR_INVALID_ARG;
+
+    NumenQRStream *stream = malloc(sizeof(NumenQRStream));
+    if (!stream)
+        return VECTOR_ERROR_MEM;
+
+    stream->n = n;
+    stream->forgetting = forgetting;
+    stream->r = malloc(n * n * sizeof(double_t));
+    stream->z = malloc(n * sizeof(double_t));
+    stream->row = malloc(n * sizeof(double_t));
+    stream->cosines = malloc(n * sizeof(double_t));
+    if (!stream->r || !stream->z || !stream->row || !stream->cosines) {
+        numen_qr_stream_free(stream);
+        return VECTOR_ERROR_MEM;
+    }
+
+    numen_qr_stream_reset(stream);
+    *out_stream = stream;
+    return VECTOR_SUCCESS;
+}
+
+int numen_qr_stream_free(NumenQRStream *stream) {
+    if (!stream)
+        return VECTOR_ERROR_NULL;
+
+    free(stream->r);
+    free(stream->z);
+    free(stream->row);
+    free(stream->cosines);
+    free(stream);
+    return VECTOR_SUCCESS;
+}
+
+int numen_qr_stream_reset(NumenQRStream *stream) {
+    if (!stream)
+        return VECTOR_ERROR_NULL;
+
+    memset(stream->r, 0, stream->n * stream->n * sizeof(double_t));
+    memset(stream->z, 0, stream->n * sizeof(double_t));
+    stream->rss = 0.0;
+    return VECTOR_SUCCESS;
+}
+
+int numen_qr_stream_add(NumenQRStream *stream, const Vector *row, double_t y) {
+    if (!stream || !row)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(row))
+        return VECTOR_ERROR_INIT;
+    if (row->size != stream->n)
+        return VECTOR_ERROR_SIZE;
+
+    const size_t n = stream->n;
+    double_t *r = stream->r;
+    double_t *z = stream->z;
+    double_t *w = stream->row;
+
+    if (stream->forgetting < 1.0) {
+        const double_t scale = sqrt(stream->forgetting);
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = i; j < n; j++) {
+                r[i * n + j] *= scale;
+            }
+            z[i] *= scale;
+        }
+        stream->rss *= stream->forgetting;
+    }
+
+    // Rotate the new row into R, one Givens rotation per column
+    memcpy(w, row->elements, n * sizeof(double_t));
+    for (size_t j = 0; j < n; j++) {
+        if (w[j] == 0.0)
+            continue;
+
+        double_t *r_row = r + j * n;
+        const double_t radius = hypot(r_row[j], w[j]);
+        const double_t c = r_row[j] / radius;
+        const double_t s = w[j] / radius;
+
+        r_row[j] = radius;
+        w[j] = 0.0;
+        for (size_t col = j + 1; col < n; col++) {
+            const double_t top = r_row[col];
+            r_row[col] = c * top + s * w[col];
+            w[col] = c * w[col] - s * top;
+        }
+
+        const double_t top = z[j];
+        z[j] = c * top + s * y;
+        y = c * y - s * top;
+    }
+
+    stream->rss += y * y;
+    return VECTOR_SUCCESS;
+}
+
+int numen_qr_stream_remove(NumenQRStream *stream,
+                           const Vector *row,
+                           double_t y) {
+    if (!stream || !row)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(row))
+        return VECTOR_ERROR_INIT;
+    if (row->size != stream->n)
+        return VECTOR_ERROR_SIZE;
+
+    const size_t n = stream->n;
+    double_t *r = stream->r;
+    double_t *z = stream->z;
+    double_t *s = stream->row;
+    double_t *c = stream->cosines;
+
+    // Solve R^T a = row; the downdate exists only if ||a|| < 1, and this is
+    // checked before the factor is touched (LINPACK dchdd). Rounding leaves
+    // ||a|| just below 1 when the last determining row is removed.
+    memcpy(s, row->elements, n * sizeof(double_t));
+    double_t norm2 = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        const double_t *r_row = r + i * n;
+        if (r_row[i] == 0.0)
+            return VECTOR_ERROR_MATH;
+        s[i] /= r_row[i];
+        for (size_t j = i + 1; j < n; j++) {
+            s[j] -= r_row[j] * s[i];
+        }
+        norm2 += s[i] * s[i];
+    }
+    if (!(norm2 < 1.0 - (double_t)n * DBL_EPSILON))
+        return VECTOR_ERROR_MATH;
+
+    // Rotations that fold a back into the unit vector, last to first
+    double_t alpha = sqrt(1.0 - norm2);
+    for (size_t i = n; i-- > 0;) {
+        const double_t scale = alpha + fabs(s[i]);
+        const double_t a = alpha / scale;
+        const double_t b = s[i] / scale;
+        const double_t radius = sqrt(a * a + b * b);
+        c[i] = a / radius;
+        s[i] = b / radius;
+        alpha = scale * radius;
+    }
+
+    // Column j of R mixes with the row being removed, bottom up
+    for (size_t j = 0; j < n; j++) {
+        double_t removed = 0.0;
+        for (size_t i = j + 1; i-- > 0;) {
+            const double_t top = r[i * n + j];
+            r[i * n + j] = c[i] * top - s[i] * removed;
+            removed = c[i] * removed + s[i] * top;
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        z[i] = (z[i] - s[i] * y) / c[i];
+        y = c[i] * y - s[i] * z[i];
+    }
+
+    // Rounding can push the residual a hair below zero
+    stream->rss = stream->rss > y * y ? stream->rss - y * y : 0.0;
+    return VECTOR_SUCCESS;
+}
+
+int numen_qr_stream_solve(const NumenQRStream *stream,
+                          Vector *x,
+                          double_t *out_rss) {
+    if (!stream || !x)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(x))
+        return VECTOR_ERROR_INIT;
+    if (x->size != stream->n)
+        return VECTOR_ERROR_SIZE;
+
+    memcpy(x->elements, stream->z, stream->n * sizeof(double_t));
+    int err = solve_upper(stream->r, stream->n, stream->n, false, x->elements);
+    if (err == VECTOR_SUCCESS && out_rss)
+        *out_rss = stream->rss;
+    return err;
+}
+
+// --- Triangular systems ---
+
+int matrix_solve_triangular(const Matrix *t,
+                            bool lower,
+                            bool unit_diag,
+                            const Vector *b,
+                            Vector *x) {
+    int err = check_square_system(t, b, x);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    memmove(x->elements, b->elements, b->size * sizeof(double_t));
+    if (lower)
+        return solve_lower(
+            t->elements, t->rows, t->cols, unit_diag, x->elements);
+    return solve_upper(t->elements, t->rows, t->cols, unit_diag, x->elements);
+}
@@ -0,0 +1,501 @@
+/**
+ * @file mask.c
+ * @brief Comparison bitmasks and masked element-wise operations
+ * @date 18/10/26
+ */
+
+#include "mask.h"
+#include "simd.h"
+#include <stdlib.h>
+
+typedef enum { CMP_LT, CMP_GT, CMP_EQ } CmpOp;
+
+#define MASK_WORD_BITS 64
+
+static size_t mask_words(size_t size) {
+    return (size + MASK_WORD_BITS - 1) / MASK_WORD_BITS;
+}
+
+static bool mask_valid(const VectorMask *mask) {
+    return (mask != NULL && (mask->bits != NULL || mask->size == 0));
+}
+
+#if defined(__AVX2__) && !defined(__AVX512F__)
+// Expand 4 mask bits into a lane-wide blend mask
+static inline __m256d mask4_to_pd(unsigned bits) {
+    const __m256i sel = _mm256_setr_epi64x(1, 2, 4, 8);
+    __m256i v = _mm256_and_si256(_mm256_set1_epi64x(bits), sel);
+    return _mm256_castsi256_pd(_mm256_cmpeq_epi64(v, sel));
+}
+#endif
+
+// --- Memory management ---
+
+int vector_mask_create(size_t size, VectorMask **out_mask) {
+    if (!out_mask)
+        return VECTOR_ERROR_NULL;
+
+    VectorMask *mask = malloc(sizeof(VectorMask));
+    if (!mask)
+        return VECTOR_ERROR_MEM;
+
+    mask->bits = NULL;
+    if (size > 0) {
+        mask->bits = calloc(mask_words(size), sizeof(uint64_t));
+        if (!mask->bits) {
+            free(mask);
+            return VECTOR_ERROR_MEM;
+        }
+    }
+
+    mask->size = size;
+    *out_mask = mask;
+    return VECTOR_SUCCESS;
+}
+
+int vector_mask_free(VectorMask *mask) {
+    if (!mask)
+        return VECTOR_ERROR_NULL;
+
+    free(mask->bits);
+    free(mask);
+    return VECTOR_SUCCESS;
+}
+
+int vector_mask_get(const VectorMask *mask, size_t index, bool *out_val) {
+    if (!mask || !out_val)
+        return VECTOR_ERROR_NULL;
+    if (!mask_valid(mask))
+        return VECTOR_ERROR_INIT;
+    if (index >= mask->size)
+        return VECTOR_ERROR_INDEX;
+
+    const uint64_t word = mask->bits[index / MASK_WORD_BITS];
+    *out_val = (word >> (index % MASK_WORD_BITS)) & 1;
+    return VECTOR_SUCCESS;
+}
+
+// --- Comparisons ---
+
+// Compare n <= 64 elements into one mask word, rhs is b or broadcast scalar
+static uint64_t compare_word(const double_t *a,
+                             const double_t *b,
+                             double_t scalar,
+                             size_t n,
+                             CmpOp op) {
+    uint64_t word = 0;
+    size_t j = 0;
+
+#if defined(__AVX512F__)
+    const __m512d vs = _mm512_set1_pd(scalar);
+    for (; j + 8 <= n; j += 8) {
+        __m512d va = _mm512_loadu_pd(a + j);
+        __m512d vb = b ? _mm512_loadu_pd(b + j) : vs;
+        __mmask8 m;
+        switch (op) {
+        case CMP_LT:
+            m = _mm512_cmp_pd_mask(va, vb, _CMP_LT_OQ);
+            break;
+        case CMP_GT:
+            m = _mm512_cmp_pd_mask(va, vb, _CMP_GT_OQ);
+            break;
+        default:
+            m = _mm512_cmp_pd_mask(va, vb, _CMP_EQ_OQ);
+            break;
+        }
+        word |= (uint64_t)m << j;
+    }
+#elif defined(__AVX2__)
+    const __m256d vs = _mm256_set1_pd(scalar);
+    for (; j + 4 <= n; j += 4) {
+        __m256d va = _mm256_loadu_pd(a + j);
+        __m256d vb = b ? _mm256_loadu_pd(b + j) : vs;
+        __m256d m;
+        switch (op) {
+        case CMP_LT:
+            m = _mm256_cmp_pd(va, vb, _CMP_LT_OQ);
+            break;
+        case CMP_GT:
+            m = _mm256_cmp_pd(va, vb, _CMP_GT_OQ);
+            break;
+        default:
+            m = _mm256_cmp_pd(va, vb, _CMP_EQ_OQ);
+            break;
+        }
+        word |= (uint64_t)_mm256_movemask_pd(m) << j;
+    }
+#endif
+
+    // Remainder (or whole word without SIMD), branch-free bit packing
+    switch (op) {
+    case CMP_LT:
+        for (; j < n; j++) {
+            word |= (uint64_t)(a[j] < (b ? b[j] : scalar)) << j;
+        }
+        break;
+    case CMP_GT:
+        for (; j < n; j++) {
+            word |= (uint64_t)(a[j] > (b ? b[j] : scalar)) << j;
+        }
+        break;
+    default:
+        for (; j < n; j++) {
+            word |= (uint64_t)(a[j] == (b ? b[j] : scalar)) << j;
+        }
+        break;
+    }
+
+    return word;
+}
+
+static int compare(const Vector *a,
+                   const Vector *b,
+                   double_t scalar,
+                   CmpOp op,
+                   VectorMask *mask) {
+    if (!a || !mask)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(a) || (b && !vector_valid(b)) || !mask_valid(mask))
+        return VECTOR_ERROR_INIT;
+    if ((b && a->size != b->size) || a->size != mask->size)
+        return VECTOR_ERROR_SIZE;
+
+    const double_t *b_data = b ? b->elements : NULL;
+    for (size_t base = 0; base < a->size; base += MASK_WORD_BITS) {
+        size_t n = a->size - base;
+        if (n > MASK_WORD_BITS)
+            n = MASK_WORD_BITS;
+        mask->bits[base / MASK_WORD_BITS] = compare_word(
+            a->elements + base, b_data ? b_data + base : NULL, scalar, n, op);
+    }
+
+    return VECTOR_SUCCESS;
+}
+
+int vector_cmp_lt(const Vector *a, const Vector *b, VectorMask *mask) {
+    if (!b)
+        return VECTOR_ERROR_NULL;
+    return compare(a, b, 0.0, CMP_LT, mask);
+}
+
+int vector_cmp_gt(const Vector *a, const Vector *b, VectorMask *mask) {
+    if (!b)
+        return VECTOR_ERROR_NULL;
+    return compare(a, b, 0.0, CMP_GT, mask);
+}
+
+int vector_cmp_eq(const Vector *a, const Vector *b, VectorMask *mask) {
+    if (!b)
+        return VECTOR_ERROR_NULL;
+    return compare(a, b, 0.0, CMP_EQ, mask);
+}
+
+int vector_cmp_lt_scalar(const Vector *a, double_t scalar, VectorMask *mask) {
+    return compare(a, NULL, scalar, CMP_LT, mask);
+}
+
+int vector_cmp_gt_scalar(const Vector *a, double_t scalar, VectorMask *mask) {
+    return compare(a, NULL, scalar, CMP_GT, mask);
+}
+
+int vector_cmp_eq_scalar(const Vector *a, double_t scalar, VectorMask *mask) {
+    return compare(a, NULL, scalar, CMP_EQ, mask);
+}
+
+// --- Masked operations ---
+
+int vector_select(const VectorMask *mask,
+                  const Vector *a,
+                  const Vector *b,
+                  Vector *result) {
+    if (!mask || !a || !b || !result)
+        return VECTOR_ERROR_NULL;
+    if (!mask_valid(mask) || !vector_valid(a) || !vector_valid(b) ||
+        !vector_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (a->size != b->size || a->size != result->size ||
+        a->size != mask->size)
+        return VECTOR_ERROR_SIZE;
+
+    const double_t *a_data = a->elements;
+    const double_t *b_data = b->elements;
+    double_t *r_data = result->elements;
+
+    for (size_t base = 0; base < a->size; base += MASK_WORD_BITS) {
+        const uint64_t word = mask->bits[base / MASK_WORD_BITS];
+        size_t n = a->size - base;
+        if (n > MASK_WORD_BITS)
+            n = MASK_WORD_BITS;
+
+        size_t j = 0;
+#if defined(__AVX512F__)
+        for (; j + 8 <= n; j += 8) {
+            __mmask8 m = (__mmask8)(word >> j);
+            __m512d va = _mm512_loadu_pd(a_data + base + j);
+            __m512d vb = _mm512_loadu_pd(b_data + base + j);
+            _mm512_storeu_pd(r_data + base + j,
+                             _mm512_mask_blend_pd(m, vb, va));
+        }
+#elif defined(__AVX2__)
+        for (; j + 4 <= n; j += 4) {
+            __m256d m = mask4_to_pd((unsigned)(word >> j) & 0xF);
+            __m256d va = _mm256_loadu_pd(a_data + base + j);
+            __m256d vb = _mm256_loadu_pd(b_data + base + j);
+            _mm256_storeu_pd(r_data + base + j, _mm256_blendv_pd(vb, va, m));
+        }
+#endif
+        for (; j < n; j++) {
+            size_t i = base + j;
+            r_data[i] = ((word >> j) & 1) ? a_data[i] : b_data[i];
+        }
+    }
+
+    return VECTOR_SUCCESS;
+}
+
+int vector_masked_add(const Vector *a,
+                      const Vector *b,
+                      const VectorMask *mask,
+                      Vector *result) {
+    if (!a || !b || !mask || !result)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(a) || !vector_valid(b) || !mask_valid(mask) ||
+        !vector_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (a->size != b->size || a->size != result->size ||
+        a->size != mask->size)
+        return VECTOR_ERROR_SIZE;
+
+    const double_t *a_data = a->elements;
+    const double_t *b_data = b->elements;
+    double_t *r_data = result->elements;
+
+    for (size_t base = 0; base < a->size; base += MASK_WORD_BITS) {
+        const uint64_t word = mask->bits[base / MASK_WORD_BITS];
+        size_t n = a->size - base;
+        if (n > MASK_WORD_BITS)
+            n = MASK_WORD_BITS;
+
+        size_t j = 0;
+#if defined(__AVX512F__)
+        for (; j + 8 <= n; j += 8) {
+            __mmask8 m = (__mmask8)(word >> j);
+            __m512d va = _mm512_loadu_pd(a_data + base + j);
+            __m512d vb = _mm512_loadu_pd(b_data + base + j);
+            _mm512_storeu_pd(r_data + base + j,
+                             _mm512_mask_add_pd(va, m, va, vb));
+        }
+#elif defined(__AVX2__)
+        for (; j + 4 <= n; j += 4) {
+            __m256d m = mask4_to_pd((unsigned)(word >> j) & 0xF);
+            __m256d va = _mm256_loadu_pd(a_data + base + j);
+            __m256d vb = _mm256_loadu_pd(b_data + base + j);
+            _mm256_storeu_pd(r_data + base + j,
+                             _mm256_blendv_pd(va, _mm256_add_pd(va, vb), m));
+        }
+#endif
+        for (; j < n; j++) {
+            size_t i = base + j;
+            r_data[i] =
+                ((word >> j) & 1) ? a_data[i] + b_data[i] : a_data[i];
+        }
+    }
+
+    return VECTOR_SUCCESS;
+}
+
+int vector_masked_scale(const Vector *a,
+                        double_t scaler,
+                        const VectorMask *mask,
+                        Vector *result) {
+    if (!a || !mask || !result)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(a) || !mask_valid(mask) || !vector_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (a->size != result->size || a->size != mask->size)
+        return VECTOR_ERROR_SIZE;
+
+    const double_t *a_data = a->elements;
+    double_t *r_data = result->elements;
+
+    for (size_t base = 0; base < a->size; base += MASK_WORD_BITS) {
+        const uint64_t word = mask->bits[base / MASK_WORD_BITS];
+        size_t n = a->size - base;
+        if (n > MASK_WORD_BITS)
+            n = MASK_WORD_BITS;
+
+        size_t j = 0;
+#if defined(__AVX512F__)
+        const __m512d vs = _mm512_set1_pd(scaler);
+        for (; j + 8 <= n; j += 8) {
+            __mmask8 m = (__mmask8)(word >> j);
+            __m512d va = _mm512_loadu_pd(a_data + base + j);
+            _mm512_storeu_pd(r_data + base + j,
+                             _mm512_mask_mul_pd(va, m, va, vs));
+        }
+#elif defined(__AVX2__)
+        const __m256d vs = _mm256_set1_pd(scaler);
+        for (; j + 4 <= n; j += 4) {
+            __m256d m = mask4_to_pd((unsigned)(word >> j) & 0xF);
+            __m256d va = _mm256_loadu_pd(a_data + base + j);
+            _mm256_storeu_pd(r_data + base + j,
+                             _mm256_blendv_pd(va, _mm256_mul_pd(va, vs), m));
+        }
+#endif
+        for (; j < n; j++) {
+            size_t i = base + j;
+            r_data[i] = ((word >> j) & 1) ? a_data[i] * scaler : a_data[i];
+        }
+    }
+
+    return VECTOR_SUCCESS;
+}
+
+int vector_count_where(const VectorMask *mask, size_t *count) {
+    if (!mask || !count)
+        return VECTOR_ERROR_NULL;
+    if (!mask_valid(mask))
+        return VECTOR_ERROR_INIT;
+
+    size_t total = 0;
+    const size_t words = mask_words(mask->size);
+    for (size_t w = 0; w < words; w++) {
+        total += simd_popcount64(mask->bits[w]);
+    }
+
+    *count = total;
+    return VECTOR_SUCCESS;
+}
+
+int vector_compress(const Vector *a, const VectorMask *mask, Vector *result) {
+    if (!a || !mask || !result)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(a) || !mask_valid(mask))
+        return VECTOR_ERROR_INIT;
+    if (a->size != mask->size)
+        return VECTOR_ERROR_SIZE;
+
+    size_t count;
+    int err = vector_count_where(mask, &count);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    // Capture the source before resizing, result may be a itself. The
+    // write cursor never overtakes the read cursor, so in-place is safe.
+    const size_t size = a->size;
+    const double_t *a_data = a->elements;
+    if ((err = vector_resize(result, count)))
+        return err;
+    double_t *r_data = result->elements;
+
+    size_t k = 0;
+    for (size_t base = 0; base < size; base += MASK_WORD_BITS) {
+        uint64_t word = mask->bits[base / MASK_WORD_BITS];
+        if (!word)
+            continue;
+
+#if defined(__AVX512F__)
+        size_t n = size - base;
+        if (n > MASK_WORD_BITS)
+            n = MASK_WORD_BITS;
+        size_t j = 0;
+        for (; j + 8 <= n; j += 8) {
+            __mmask8 m = (__mmask8)(word >> j);
+            __m512d va = _mm512_loadu_pd(a_data + base + j);
+            _mm512_mask_compressstoreu_pd(r_data + k, m, va);
+            k += simd_popcount64(m);
+        }
+        word &= ~simd_low_bits(j);
+#endif
+        // Visit set bits only, cheap for sparse masks
+        while (word) {
+            r_data[k++] = a_data[base + simd_ctz64(word)];
+            word &= word - 1;
+        }
+    }
+
+    return VECTOR_SUCCESS;
+}
+
+// --- Checked arithmetic ---
+
+static void divide_span(const double_t *a,
+                        const double_t *b,
+                        double_t *r,
+                        size_t n) {
+    for (size_t j = 0; j < n; j++) {
+        r[j] = a[j] / b[j];
+    }
+}
+
+int vector_div_checked(const Vector *a,
+                       const Vector *b,
+                       VectorDivPolicy policy,
+                       double_t substitute,
+                       Vector *result,
+                       VectorMask *zero_mask,
+                       size_t *zero_count) {
+    if (!a || !b || !result)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(a) || !vector_valid(b) || !vector_valid(result) ||
+        (zero_mask && !mask_valid(zero_mask)))
+        return VECTOR_ERROR_INIT;
+    if (a->size != b->size || a->size != result->size ||
+        (zero_mask && zero_mask->size != a->size))
+        return VECTOR_ERROR_SIZE;
+    if (policy != VECTOR_DIV_IEEE && policy != VECTOR_DIV_SUBSTITUTE &&
+        policy != VECTOR_DIV_STRICT)
+        return VECTOR_ERROR_INVALID_ARG;
+
+    const size_t size = a->size;
+    const double_t *a_data = a->elements;
+    const double_t *b_data = b->elements;
+    double_t *r_data = result->elements;
+    size_t zeros = 0;
+
+    if (policy == VECTOR_DIV_STRICT) {
+        // Vectorized pre-scan so nothing is written on failure
+        for (size_t base = 0; base < size; base += MASK_WORD_BITS) {
+            size_t n = size - base;
+            if (n > MASK_WORD_BITS)
+                n = MASK_WORD_BITS;
+            uint64_t word = compare_word(b_data + base, NULL, 0.0, n, CMP_EQ);
+            if (zero_mask)
+                zero_mask->bits[base / MASK_WORD_BITS] = word;
+            zeros += simd_popcount64(word);
+        }
+
+        if (zero_count)
+            *zero_count = zeros;
+        if (zeros)
+            return VECTOR_ERROR_MATH;
+
+        divide_span(a_data, b_data, r_data, size);
+        return VECTOR_SUCCESS;
+    }
+
+    for (size_t base = 0; base < size; base += MASK_WORD_BITS) {
+        size_t n = size - base;
+        if (n > MASK_WORD_BITS)
+            n = MASK_WORD_BITS;
+
+        // Read the divisors before result (which may alias b) is written
+        uint64_t word = compare_word(b_data + base, NULL, 0.0, n, CMP_EQ);
+        divide_span(a_data + base, b_data + base, r_data + base, n);
+
+        if (zero_mask)
+            zero_mask->bits[base / MASK_WORD_BITS] = word;
+        zeros += simd_popcount64(word);
+
+        if (policy == VECTOR_DIV_SUBSTITUTE) {
+            while (word) {
+                r_data[base + simd_ctz64(word)] = substitute;
+                word &= word - 1;
+            }
+        }
+    }
+
+    if (zero_count)
+        *zero_count = zeros;
+    return VECTOR_SUCCESS;
+}
@@ -0,0 +1,695 @@
+/**
+ * @file matrix.c
+ * @brief Dense row-major matrices
+ * @date 18/10/26
+ */
+
+#include "matrix.h"
+#include "blas.h"
+#include "pool.h"
+#include "simd.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Square tile edge for transposes: two 32x32 tiles of doubles fit in L1
+#define MATRIX_TRANSPOSE_TILE 32
+#define SMALL_BATCH_CHUNK 256 ///< Matrices per task, whole mask words
+
+bool matrix_valid(const Matrix *matrix) {
+    return (matrix != NULL && matrix->elements != NULL);
+}
+
+// --- Matrix initialization ---
+
+int matrix_create(size_t rows, size_t cols, Matrix **out_matrix) {
+    if (!out_matrix)
+        return VECTOR_ERROR_NULL;
+    if (rows == 0 || cols == 0)
+        return VECTOR_ERROR_SIZE;
+    if (rows > SIZE_MAX / cols / sizeof(double_t))
+        return VECTOR_ERROR_MEM;
+
+    Matrix *matrix = malloc(sizeof(Matrix));
+    if (!matrix)
+        return VECTOR_ERROR_MEM;
+
+    matrix->elements = calloc(rows * cols, sizeof(double_t));
+    if (!matrix->elements) {
+        free(matrix);
+        return VECTOR_ERROR_MEM;
+    }
+
+    matrix->rows = rows;
+    matrix->cols = cols;
+    *out_matrix = matrix;
+    return VECTOR_SUCCESS;
+}
+
+int matrix_create_identity(size_t size, Matrix **out_matrix) {
+    int err = matrix_create(size, size, out_matrix);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    for (size_t i = 0; i < size; i++) {
+        (*out_matrix)->elements[i * size + i] = 1.0;
+    }
+    return VECTOR_SUCCESS;
+}
+
+int matrix_from_array(const double_t *arr,
+                      size_t rows,
+                      size_t cols,
+                      Matrix **out_matrix) {
+    if (!arr || !out_matrix)
+        return VECTOR_ERROR_NULL;
+
+    int err = matrix_create(rows, cols, out_matrix);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    memcpy((*out_matrix)->elements, arr, rows * cols * sizeof(double_t));
+    return VECTOR_SUCCESS;
+}
+
+int matrix_copy(const Matrix *src, Matrix *dest) {
+    if (!src || !dest)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(src) || !matrix_valid(dest))
+        return VECTOR_ERROR_INIT;
+    if (src->rows != dest->rows || src->cols != dest->cols)
+        return VECTOR_ERROR_SIZE;
+
+    memmove(dest->elements,
+            src->elements,
+            src->rows * src->cols * sizeof(double_t));
+    return VECTOR_SUCCESS;
+}
+
+int matrix_free(Matrix *matrix) {
+    if (!matrix)
+        return VECTOR_ERROR_NULL;
+
+    free(matrix->elements);
+    free(matrix);
+    return VECTOR_SUCCESS;
+}
+
+int matrix_batch_create(size_t rows,
+                        size_t cols,
+                        size_t count,
+                        MatrixBatch **out_batch) {
+    if (!out_batch)
+        return VECTOR_ERROR_NULL;
+    if (rows == 0 || cols == 0 || count == 0)
+        return VECTOR_ERROR_SIZE;
+    if (rows * cols > SIZE_MAX / count / sizeof(double_t))
+        return VECTOR_ERROR_MEM;
+
+    MatrixBatch *batch = malloc(sizeof(MatrixBatch));
+    if (!batch)
+        return VECTOR_ERROR_MEM;
+
+    batch->elements = calloc(rows * cols * count, sizeof(double_t));
+    if (!batch->elements) {
+        free(batch);
+        return VECTOR_ERROR_MEM;
+    }
+
+    batch->rows = rows;
+    batch->cols = cols;
+    batch->count = count;
+    *out_batch = batch;
+    return VECTOR_SUCCESS;
+}
+
+int matrix_batch_free(MatrixBatch *batch) {
+    if (!batch)
+        return VECTOR_ERROR_NULL;
+
+    free(batch->elements);
+    free(batch);
+    return VECTOR_SUCCESS;
+}
+
+// --- Element access ---
+
+int matrix_get(const Matrix *matrix,
+               size_t row,
+               size_t col,
+               double_t *out_val) {
+    if (!matrix || !out_val)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(matrix))
+        return VECTOR_ERROR_INIT;
+    if (row >= matrix->rows || col >= matrix->cols)
+        return VECTOR_ERROR_INDEX;
+
+    *out_val = matrix->elements[row * matrix->cols + col];
+    return VECTOR_SUCCESS;
+}
+
+int matrix_set(Matrix *matrix, size_t row, size_t col, double_t val) {
+    if (!matrix)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(matrix))
+        return VECTOR_ERROR_INIT;
+    if (row >= matrix->rows || col >= matrix->cols)
+        return VECTOR_ERROR_INDEX;
+
+    matrix->elements[row * matrix->cols + col] = val;
+    return VECTOR_SUCCESS;
+}
+
+// --- Transpose ---
+
+// dst (4x4 block) = transpose of src (4x4 block)
+static void transpose4x4(const double_t *src,
+                         size_t src_stride,
+                         double_t *dst,
+                         size_t dst_stride) {
+#if defined(__AVX2__)
+    __m256d r0 = _mm256_loadu_pd(src);
+    __m256d r1 = _mm256_loadu_pd(src + src_stride);
+    __m256d r2 = _mm256_loadu_pd(src + 2 * src_stride);
+    __m256d r3 = _mm256_loadu_pd(src + 3 * src_stride);
+    simd_transpose4x4_pd(&r0, &r1, &r2, &r3);
+    _mm256_storeu_pd(dst, r0);
+    _mm256_storeu_pd(dst + dst_stride, r1);
+    _mm256_storeu_pd(dst + 2 * dst_stride, r2);
+    _mm256_storeu_pd(dst + 3 * dst_stride, r3);
+#else
+    for (size_t i = 0; i < 4; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            dst[j * dst_stride + i] = src[i * src_stride + j];
+        }
+    }
+#endif
+}
+
+// Swap the 4x4 blocks at a and b, transposing both (b may equal a)
+static void swap_transpose4x4(double_t *a, double_t *b, size_t stride) {
+#if defined(__AVX2__)
+    __m256d a0 = _mm256_loadu_pd(a);
+    __m256d a1 = _mm256_loadu_pd(a + stride);
+    __m256d a2 = _mm256_loadu_pd(a + 2 * stride);
+    __m256d a3 = _mm256_loadu_pd(a + 3 * stride);
+    __m256d b0 = _mm256_loadu_pd(b);
+    __m256d b1 = _mm256_loadu_pd(b + stride);
+    __m256d b2 = _mm256_loadu_pd(b + 2 * stride);
+    __m256d b3 = _mm256_loadu_pd(b + 3 * stride);
+    simd_transpose4x4_pd(&a0, &a1, &a2, &a3);
+    simd_transpose4x4_pd(&b0, &b1, &b2, &b3);
+    _mm256_storeu_pd(b, a0);
+    _mm256_storeu_pd(b + stride, a1);
+    _mm256_storeu_pd(b + 2 * stride, a2);
+    _mm256_storeu_pd(b + 3 * stride, a3);
+    _mm256_storeu_pd(a, b0);
+    _mm256_storeu_pd(a + stride, b1);
+    _mm256_storeu_pd(a + 2 * stride, b2);
+    _mm256_storeu_pd(a + 3 * stride, b3);
+#else
+    double_t a_t[16];
+    double_t b_t[16];
+    for (size_t i = 0; i < 4; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            a_t[j * 4 + i] = a[i * stride + j];
+            b_t[j * 4 + i] = b[i * stride + j];
+        }
+    }
+    for (size_t i = 0; i < 4; i++) {
+        memcpy(a + i * stride, b_t + i * 4, 4 * sizeof(double_t));
+        memcpy(b + i * stride, a_t + i * 4, 4 * sizeof(double_t));
+    }
+#endif
+}
+
+int matrix_transpose(const Matrix *a, Matrix *result) {
+    if (!a || !result)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a) || !matrix_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (result->rows != a->cols || result->cols != a->rows)
+        return VECTOR_ERROR_SIZE;
+    if (result->elements == a->elements)
+        return a->rows == a->cols ? matrix_transpose_inplace(result)
+                                  : VECTOR_ERROR_INVALID_ARG;
+
+    const size_t rows = a->rows;
+    const size_t cols = a->cols;
+    const double_t *src = a->elements;
+    double_t *dst = result->elements;
+
+    for (size_t ti = 0; ti < rows; ti += MATRIX_TRANSPOSE_TILE) {
+        const size_t i_end = ti + MATRIX_TRANSPOSE_TILE < rows
+                                 ? ti + MATRIX_TRANSPOSE_TILE
+                                 : rows;
+        for (size_t tj = 0; tj < cols; tj += MATRIX_TRANSPOSE_TILE) {
+            const size_t j_end = tj + MATRIX_TRANSPOSE_TILE < cols
+                                     ? tj + MATRIX_TRANSPOSE_TILE
+                                     : cols;
+
+            size_t i = ti;
+            for (; i + 4 <= i_end; i += 4) {
+                size_t j = tj;
+                for (; j + 4 <= j_end; j += 4) {
+                    transpose4x4(src + i * cols + j,
+                                 cols,
+                                 dst + j * rows + i,
+                                 rows);
+                }
+                for (; j < j_end; j++) {
+                    for (size_t k = i; k < i + 4; k++) {
+                        dst[j * rows + k] = src[k * cols + j];
+                    }
+                }
+            }
+            for (; i < i_end; i++) {
+                for (size_t j = tj; j < j_end; j++) {
+                    dst[j * rows + i] = src[i * cols + j];
+                }
+            }
+        }
+    }
+    return VECTOR_SUCCESS;
+}
+
+int matrix_transpose_inplace(Matrix *matrix) {
+    if (!matrix)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(matrix))
+        return VECTOR_ERROR_INIT;
+    if (matrix->rows != matrix->cols)
+        return VECTOR_ERROR_SIZE;
+
+    const size_t n = matrix->rows;
+    const size_t n4 = n - n % 4;
+    double_t *data = matrix->elements;
+
+    // Tile pairs (ti, tj) with tj >= ti, swapping 4x4 blocks across the
+    // diagonal; diagonal blocks swap with themselves
+    for (size_t ti = 0; ti < n4; ti += MATRIX_TRANSPOSE_TILE) {
+        const size_t i_end =
+            ti + MATRIX_TRANSPOSE_TILE < n4 ? ti + MATRIX_TRANSPOSE_TILE : n4;
+        for (size_t tj = ti; tj < n4; tj += MATRIX_TRANSPOSE_TILE) {
+            const size_t j_end = tj + MATRIX_TRANSPOSE_TILE < n4
+                                     ? tj + MATRIX_TRANSPOSE_TILE
+                                     : n4;
+            for (size_t i = ti; i < i_end; i += 4) {
+                for (size_t j = tj == ti ? i : tj; j < j_end; j += 4) {
+                    swap_transpose4x4(data + i * n + j, data + j * n + i, n);
+                }
+            }
+        }
+    }
+
+    // Ragged edge: last n % 4 columns against last n % 4 rows
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i >= n4 ? i + 1 : n4; j < n; j++) {
+            double_t tmp = data[i * n + j];
+            data[i * n + j] = data[j * n + i];
+            data[j * n + i] = tmp;
+        }
+    }
+    return VECTOR_SUCCESS;
+}
+
+// --- Products ---
+
+int matrix_mult(const Matrix *a, const Matrix *b, Matrix *result) {
+    if (!a || !b || !result)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a) || !matrix_valid(b) || !matrix_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (a->cols != b->rows || result->rows != a->rows ||
+        result->cols != b->cols)
+        return VECTOR_ERROR_SIZE;
+    if (result->elements == a->elements || result->elements == b->elements)
+        return VECTOR_ERROR_INVALID_ARG;
+
+    memset(result->elements,
+           0,
+           result->rows * result->cols * sizeof(double_t));
+    return blas_gemm_parallel(a->rows,
+                              b->cols,
+                              a->cols,
+                              1.0,
+                              a->elements,
+                              a->cols,
+                              b->elements,
+                              b->cols,
+                              result->elements,
+                              result->cols);
+}
+
+int matrix_mult_vector(const Matrix *a, const Vector *x, Vector *result) {
+    if (!a || !x || !result)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a) || !vector_valid(x) || !vector_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (x->size != a->cols || result->size != a->rows)
+        return VECTOR_ERROR_SIZE;
+    if (result->elements == x->elements)
+        return VECTOR_ERROR_INVALID_ARG;
+
+    const double_t *restrict xs = x->elements;
+    for (size_t i = 0; i < a->rows; i++) {
+        const double_t *restrict row = a->elements + i * a->cols;
+        double_t sum = 0.0;
+        for (size_t j = 0; j < a->cols; j++) {
+            sum += row[j] * xs[j];
+        }
+        result->elements[i] = sum;
+    }
+    return VECTOR_SUCCESS;
+}
+
+// --- Batched small matrices ---
+
+// Element e (row-major index) of lane k in a chunk with the batch's stride
+#define LANE(base, e) (base)[(size_t)(e) * count + k]
+
+typedef struct {
+    const MatrixBatch *a;
+    const MatrixBatch *b;
+    MatrixBatch *out;
+    double_t *det;
+    uint64_t *singular; ///< Mask words, NULL if not requested
+    atomic_bool any_singular;
+} SmallBatchJob;
+
+static size_t small_batch_lanes(size_t count, size_t task) {
+    const size_t begin = task * SMALL_BATCH_CHUNK;
+    return count - begin < SMALL_BATCH_CHUNK ? count - begin
+                                             : SMALL_BATCH_CHUNK;
+}
+
+static int run_small_batch(size_t count, PoolTaskFn fn, SmallBatchJob *job) {
+    const size_t tasks = (count + SMALL_BATCH_CHUNK - 1) / SMALL_BATCH_CHUNK;
+    if (tasks < 2) {
+        fn(job, 0);
+        return VECTOR_SUCCESS;
+    }
+    return pool_parallel_for(tasks, fn, job);
+}
+
+static void det_task(void *ctx, size_t task) {
+    SmallBatchJob *job = ctx;
+    const size_t count = job->a->count;
+    const size_t lanes = small_batch_lanes(count, task);
+    const double_t *a = job->a->elements + task * SMALL_BATCH_CHUNK;
+    double_t *det = job->det + task * SMALL_BATCH_CHUNK;
+
+    switch (job->a->rows) {
+    case 1:
+        for (size_t k = 0; k < lanes; k++) {
+            det[k] = LANE(a, 0);
+        }
+        break;
+    case 2:
+        for (size_t k = 0; k < lanes; k++) {
+            det[k] = LANE(a, 0) * LANE(a, 3) - LANE(a, 1) * LANE(a, 2);
+        }
+        break;
+    case 3:
+        for (size_t k = 0; k < lanes; k++) {
+            const double_t a00 = LANE(a, 0), a01 = LANE(a, 1), a02 = LANE(a, 2);
+            const double_t a10 = LANE(a, 3), a11 = LANE(a, 4), a12 = LANE(a, 5);
+            const double_t a20 = LANE(a, 6), a21 = LANE(a, 7), a22 = LANE(a, 8);
+            det[k] = a00 * (a11 * a22 - a12 * a21) -
+                     a01 * (a10 * a22 - a12 * a20) +
+                     a02 * (a10 * a21 - a11 * a20);
+        }
+        break;
+    default:
+        // Laplace expansion along the first two rows: 2x2 minors of rows
+        // 0-1 against complementary minors of rows 2-3
+        for (size_t k = 0; k < lanes; k++) {
+            const double_t a00 = LANE(a, 0), a01 = LANE(a, 1);
+            const double_t a02 = LANE(a, 2), a03 = LANE(a, 3);
+            const double_t a10 = LANE(a, 4), a11 = LANE(a, 5);
+            const double_t a12 = LANE(a, 6), a13 = LANE(a, 7);
+            const double_t a20 = LANE(a, 8), a21 = LANE(a, 9);
+            const double_t a22 = LANE(a, 10), a23 = LANE(a, 11);
+            const double_t a30 = LANE(a, 12), a31 = LANE(a, 13);
+            const double_t a32 = LANE(a, 14), a33 = LANE(a, 15);
+
+            const double_t s0 = a00 * a11 - a10 * a01;
+            const double_t s1 = a00 * a12 - a10 * a02;
+            const double_t s2 = a00 * a13 - a10 * a03;
+            const double_t s3 = a01 * a12 - a11 * a02;
+            const double_t s4 = a01 * a13 - a11 * a03;
+            const double_t s5 = a02 * a13 - a12 * a03;
+            const double_t c0 = a20 * a31 - a30 * a21;
+            const double_t c1 = a20 * a32 - a30 * a22;
+            const double_t c2 = a20 * a33 - a30 * a23;
+            const double_t c3 = a21 * a32 - a31 * a22;
+            const double_t c4 = a21 * a33 - a31 * a23;
+            const double_t c5 = a22 * a33 - a32 * a23;
+            det[k] = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        }
+        break;
+    }
+}
+
+// 1 / det, or 0 for a singular lane so its inverse is all zeros
+static double_t inverse_scale(double_t det, bool *bad) {
+    const bool ok = det != 0.0 && isfinite(det);
+    *bad = !ok;
+    return ok ? 1.0 / det : 0.0;
+}
+
+/*
+ * All elements of a lane are loaded before any is stored, so the output
+ * may be the input batch.
+ */
+static void inverse_task(void *ctx, size_t task) {
+    SmallBatchJob *job = ctx;
+    const size_t count = job->a->count;
+    const size_t begin = task * SMALL_BATCH_CHUNK;
+    const size_t lanes = small_batch_lanes(count, task);
+    const double_t *a = job->a->elements + begin;
+    double_t *out = job->out->elements + begin;
+    bool bad[SMALL_BATCH_CHUNK] = {false};
+
+    switch (job->a->rows) {
+    case 1:
+        for (size_t k = 0; k < lanes; k++) {
+            LANE(out, 0) = inverse_scale(LANE(a, 0), &bad[k]);
+        }
+        break;
+    case 2:
+        for (size_t k = 0; k < lanes; k++) {
+            const double_t a00 = LANE(a, 0), a01 = LANE(a, 1);
+            const double_t a10 = LANE(a, 2), a11 = LANE(a, 3);
+            const double_t inv = inverse_scale(a00 * a11 - a01 * a10, &bad[k]);
+            LANE(out, 0) = a11 * inv;
+            LANE(out, 1) = -a01 * inv;
+            LANE(out, 2) = -a10 * inv;
+            LANE(out, 3) = a00 * inv;
+        }
+        break;
+    case 3:
+        for (size_t k = 0; k < lanes; k++) {
+            const double_t a00 = LANE(a, 0), a01 = LANE(a, 1), a02 = LANE(a, 2);
+            const double_t a10 = LANE(a, 3), a11 = LANE(a, 4), a12 = LANE(a, 5);
+            const double_t a20 = LANE(a, 6), a21 = LANE(a, 7), a22 = LANE(a, 8);
+
+            // Cofactors of the first row give the determinant too
+            const double_t c00 = a11 * a22 - a12 * a21;
+            const double_t c01 = a12 * a20 - a10 * a22;
+            const double_t c02 = a10 * a21 - a11 * a20;
+            const double_t inv =
+                inverse_scale(a00 * c00 + a01 * c01 + a02 * c02, &bad[k]);
+
+            LANE(out, 0) = c00 * inv;
+            LANE(out, 1) = (a02 * a21 - a01 * a22) * inv;
+            LANE(out, 2) = (a01 * a12 - a02 * a11) * inv;
+            LANE(out, 3) = c01 * inv;
+            LANE(out, 4) = (a00 * a22 - a02 * a20) * inv;
+            LANE(out, 5) = (a02 * a10 - a00 * a12) * inv;
+            LANE(out, 6) = c02 * inv;
+            LANE(out, 7) = (a01 * a20 - a00 * a21) * inv;
+            LANE(out, 8) = (a00 * a11 - a01 * a10) * inv;
+        }
+        break;
+    default:
+        // Adjugate from the same 2x2 minors as the determinant
+        for (size_t k = 0; k < lanes; k++) {
+            const double_t a00 = LANE(a, 0), a01 = LANE(a, 1);
+            const double_t a02 = LANE(a, 2), a03 = LANE(a, 3);
+            const double_t a10 = LANE(a, 4), a11 = LANE(a, 5);
+            const double_t a12 = LANE(a, 6), a13 = LANE(a, 7);
+            const double_t a20 = LANE(a, 8), a21 = LANE(a, 9);
+            const double_t a22 = LANE(a, 10), a23 = LANE(a, 11);
+            const double_t a30 = LANE(a, 12), a31 = LANE(a, 13);
+            const double_t a32 = LANE(a, 14), a33 = LANE(a, 15);
+
+            const double_t s0 = a00 * a11 - a10 * a01;
+            const double_t s1 = a00 * a12 - a10 * a02;
+            const double_t s2 = a00 * a13 - a10 * a03;
+            const double_t s3 = a01 * a12 - a11 * a02;
+            const double_t s4 = a01 * a13 - a11 * a03;
+            const double_t s5 = a02 * a13 - a12 * a03;
+            const double_t c0 = a20 * a31 - a30 * a21;
+            const double_t c1 = a20 * a32 - a30 * a22;
+            const double_t c2 = a20 * a33 - a30 * a23;
+            const double_t c3 = a21 * a32 - a31 * a22;
+            const double_t c4 = a21 * a33 - a31 * a23;
+            const double_t c5 = a22 * a33 - a32 * a23;
+            const double_t inv = inverse_scale(
+                s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0,
+                &bad[k]);
+
+            LANE(out, 0) = (a11 * c5 - a12 * c4 + a13 * c3) * inv;
+            LANE(out, 1) = (-a01 * c5 + a02 * c4 - a03 * c3) * inv;
+            LANE(out, 2) = (a31 * s5 - a32 * s4 + a33 * s3) * inv;
+            LANE(out, 3) = (-a21 * s5 + a22 * s4 - a23 * s3) * inv;
+            LANE(out, 4) = (-a10 * c5 + a12 * c2 - a13 * c1) * inv;
+            LANE(out, 5) = (a00 * c5 - a02 * c2 + a03 * c1) * inv;
+            LANE(out, 6) = (-a30 * s5 + a32 * s2 - a33 * s1) * inv;
+            LANE(out, 7) = (a20 * s5 - a22 * s2 + a23 * s1) * inv;
+            LANE(out, 8) = (a10 * c4 - a11 * c2 + a13 * c0) * inv;
+            LANE(out, 9) = (-a00 * c4 + a01 * c2 - a03 * c0) * inv;
+            LANE(out, 10) = (a30 * s4 - a31 * s2 + a33 * s0) * inv;
+            LANE(out, 11) = (-a20 * s4 + a21 * s2 - a23 * s0) * inv;
+            LANE(out, 12) = (-a10 * c3 + a11 * c1 - a12 * c0) * inv;
+            LANE(out, 13) = (a00 * c3 - a01 * c1 + a02 * c0) * inv;
+            LANE(out, 14) = (-a30 * s3 + a31 * s1 - a32 * s0) * inv;
+            LANE(out, 15) = (a20 * s3 - a21 * s1 + a22 * s0) * inv;
+        }
+        break;
+    }
+
+    bool any = false;
+    for (size_t k = 0; k < lanes; k++) {
+        any |= bad[k];
+        if (job->singular && bad[k])
+            job->singular[(begin + k) / 64] |= (uint64_t)1
+                                               << ((begin + k) % 64);
+    }
+    if (any)
+        atomic_store(&job->any_singular, true);
+}
+
+/*
+ * Generic shapes: each output element accumulates one product term per
+ * pass over the chunk's lanes, all passes contiguous
+ */
+static void mult_task(void *ctx, size_t task) {
+    SmallBatchJob *job = ctx;
+    const size_t count = job->a->count;
+    const size_t begin = task * SMALL_BATCH_CHUNK;
+    const size_t lanes = small_batch_lanes(count, task);
+    const size_t m = job->a->rows;
+    const size_t n = job->a->cols;
+    const size_t p = job->b->cols;
+
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < p; j++) {
+            double_t *restrict c_ij =
+                job->out->elements + (i * p + j) * count + begin;
+            const double_t *restrict a_i0 =
+                job->a->elements + (i * n) * count + begin;
+            const double_t *restrict b_0j =
+                job->b->elements + j * count + begin;
+            for (size_t k = 0; k < lanes; k++) {
+                c_ij[k] = a_i0[k] * b_0j[k];
+            }
+            for (size_t q = 1; q < n; q++) {
+                const double_t *restrict a_iq = a_i0 + q * count;
+                const double_t *restrict b_qj = b_0j + q * p * count;
+                for (size_t k = 0; k < lanes; k++) {
+                    c_ij[k] += a_iq[k] * b_qj[k];
+                }
+            }
+        }
+    }
+}
+
+static bool small_batch_valid(const MatrixBatch *batch) {
+    return batch->elements != NULL;
+}
+
+static bool small_batch_dims(const MatrixBatch *batch) {
+    return batch->rows >= 1 && batch->rows <= MATRIX_BATCH_SMALL_MAX &&
+           batch->cols >= 1 && batch->cols <= MATRIX_BATCH_SMALL_MAX;
+}
+
+int matrix_batch_det(const MatrixBatch *a, Vector *det) {
+    if (!a || !det)
+        return VECTOR_ERROR_NULL;
+    if (!small_batch_valid(a) || !vector_valid(det))
+        return VECTOR_ERROR_INIT;
+    if (!small_batch_dims(a) || a->rows != a->cols || det->size != a->count)
+        return VECTOR_ERROR_SIZE;
+
+    SmallBatchJob job = {.a = a, .det = det->elements};
+    return run_small_batch(a->count, det_task, &job);
+}
+
+int matrix_batch_inverse(const MatrixBatch *a,
+                         MatrixBatch *inverse,
+                         VectorMask *singular) {
+    if (!a || !inverse)
+        return VECTOR_ERROR_NULL;
+    if (!small_batch_valid(a) || !small_batch_valid(inverse) ||
+        (singular && !singular->bits))
+        return VECTOR_ERROR_INIT;
+    if (!small_batch_dims(a) || a->rows != a->cols ||
+        inverse->rows != a->rows || inverse->cols != a->cols ||
+        inverse->count != a->count ||
+        (singular && singular->size != a->count))
+        return VECTOR_ERROR_SIZE;
+
+    SmallBatchJob job = {
+        .a = a,
+        .out = inverse,
+        .singular = singular ? singular->bits : NULL,
+    };
+    atomic_init(&job.any_singular, false);
+    if (singular)
+        memset(singular->bits,
+               0,
+               (singular->size + 63) / 64 * sizeof(uint64_t));
+
+    int err = run_small_batch(a->count, inverse_task, &job);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    return atomic_load(&job.any_singular) ? VECTOR_ERROR_MATH
+                                          : VECTOR_SUCCESS;
+}
+
+int matrix_batch_mult(const MatrixBatch *a,
+                      const MatrixBatch *b,
+                      MatrixBatch *result) {
+    if (!a || !b || !result)
+        return VECTOR_ERROR_NULL;
+    if (!small_batch_valid(a) || !small_batch_valid(b) ||
+        !small_batch_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (!small_batch_dims(a) || !small_batch_dims(b) ||
+        a->cols != b->rows || result->rows != a->rows ||
+        result->cols != b->cols || b->count != a->count ||
+        result->count != a->count)
+        return VECTOR_ERROR_SIZE;
+    if (result->elements == a->elements || result->elements == b->elements)
+        return VECTOR_ERROR_INVALID_ARG;
+
+    SmallBatchJob job = {.a = a, .b = b, .out = result};
+    return run_small_batch(a->count, mult_task, &job);
+}
+
+int matrix_batch_mult_vector(const MatrixBatch *a,
+                             const MatrixBatch *x,
+                             MatrixBatch *result) {
+    if (!a || !x || !result)
+        return VECTOR_ERROR_NULL;
+    if (!small_batch_valid(a) || !small_batch_valid(x) ||
+        !small_batch_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (x->cols != 1 || result->cols != 1)
+        return VECTOR_ERROR_SIZE;
+    return matrix_batch_mult(a, x, result);
+}
@@ -0,0 +1,711 @@
+/**
+ * @file ndarray.c
+ * @brief N-dimensional strided arrays with views and broadcasting
+ * @date 18/10/26
+ */
+
+#include "ndarray.h"
+#include "pool.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NDARRAY_PARALLEL_MIN 65536 ///< Elements below which threads do not pay
+#define NDARRAY_TASK_ELEMENTS 32768 ///< Target elements per parallel task
+
+bool ndarray_valid(const NdArray *array) {
+    return array != NULL && array->data != NULL && array->ndim >= 1 &&
+           array->ndim <= NDARRAY_MAX_DIMS;
+}
+
+bool ndarray_contiguous(const NdArray *array) {
+    if (!ndarray_valid(array))
+        return false;
+
+    ptrdiff_t expected = 1;
+    for (size_t d = array->ndim; d-- > 0;) {
+        if (array->shape[d] != 1 && array->strides[d] != expected)
+            return false;
+        expected *= (ptrdiff_t)array->shape[d];
+    }
+    return true;
+}
+
+size_t ndarray_size(const NdArray *array) {
+    if (!ndarray_valid(array))
+        return 0;
+
+    size_t size = 1;
+    for (size_t d = 0; d < array->ndim; d++) {
+        size *= array->shape[d];
+    }
+    return size;
+}
+
+// Row-major strides for shape
+static void contiguous_strides(size_t ndim,
+                               const size_t *shape,
+                               ptrdiff_t *strides) {
+    ptrdiff_t stride = 1;
+    for (size_t d = ndim; d-- > 0;) {
+        strides[d] = stride;
+        stride *= (ptrdiff_t)shape[d];
+    }
+}
+
+// --- Initialization ---
+
+int ndarray_create(size_t ndim, const size_t *shape, NdArray **out_array) {
+    if (!shape || !out_array)
+        return VECTOR_ERROR_NULL;
+    if (ndim == 0 || ndim > NDARRAY_MAX_DIMS)
+        return VECTOR_ERROR_SIZE;
+
+    size_t size = 1;
+    for (size_t d = 0; d < ndim; d++) {
+        if (shape[d] == 0)
+            return VECTOR_ERROR_SIZE;
+        if (size > PTRDIFF_MAX / sizeof(double_t) / shape[d])
+            return VECTOR_ERROR_MEM;
+        size *= shape[d];
+    }
+
+    NdArray *array = malloc(sizeof(NdArray));
+    if (!array)
+        return VECTOR_ERROR_MEM;
+
+    array->owned = calloc(size, sizeof(double_t));
+    if (!array->owned) {
+        free(array);
+        return VECTOR_ERROR_MEM;
+    }
+
+    array->data = array->owned;
+    array->ndim = ndim;
+    memcpy(array->shape, shape, ndim * sizeof(size_t));
+    contiguous_strides(ndim, shape, array->strides);
+    *out_array = array;
+    return VECTOR_SUCCESS;
+}
+
+int ndarray_free(NdArray *array) {
+    if (!array)
+        return VECTOR_ERROR_NULL;
+
+    free(array->owned);
+    free(array);
+    return VECTOR_SUCCESS;
+}
+
+int ndarray_from_vector(const Vector *vector, NdArray *out_view) {
+    if (!vector || !out_view)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(vector))
+        return VECTOR_ERROR_INIT;
+    if (vector->size == 0)
+        return VECTOR_ERROR_SIZE;
+
+    memset(out_view, 0, sizeof(NdArray));
+    out_view->data = vector->elements;
+    out_view->ndim = 1;
+    out_view->shape[0] = vector->size;
+    out_view->strides[0] = 1;
+    return VECTOR_SUCCESS;
+}
+
+int ndarray_from_matrix(const Matrix *matrix, NdArray *out_view) {
+    if (!matrix || !out_view)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(matrix))
+        return VECTOR_ERROR_INIT;
+
+    memset(out_view, 0, sizeof(NdArray));
+    out_view->data = matrix->elements;
+    out_view->ndim = 2;
+    out_view->shape[0] = matrix->rows;
+    out_view->shape[1] = matrix->cols;
+    out_view->strides[0] = (ptrdiff_t)matrix->cols;
+    out_view->strides[1] = 1;
+    return VECTOR_SUCCESS;
+}
+
+// --- Element access ---
+
+static int element_at(const NdArray *array,
+                      const size_t *index,
+                      double_t **out_ptr) {
+    if (!array || !index)
+        return VECTOR_ERROR_NULL;
+    if (!ndarray_valid(array))
+        return VECTOR_ERROR_INIT;
+
+    ptrdiff_t offset = 0;
+    for (size_t d = 0; d < array->ndim; d++) {
+        if (index[d] >= array->shape[d])
+            return VECTOR_ERROR_INDEX;
+        offset += (ptrdiff_t)index[d] * array->strides[d];
+    }
+    *out_ptr = array->data + offset;
+    return VECTOR_SUCCESS;
+}
+
+int ndarray_get(const NdArray *array, const size_t *index, double_t *out_val) {
+    if (!out_val)
+        return VECTOR_ERROR_NULL;
+
+    double_t *ptr = NULL;
+    int err = element_at(array, index, &ptr);
+    if (err == VECTOR_SUCCESS)
+        *out_val = *ptr;
+    return err;
+}
+
+int ndarray_set(NdArray *array, const size_t *index, double_t val) {
+    double_t *ptr = NULL;
+    int err = element_at(array, index, &ptr);
+    if (err == VECTOR_SUCCESS)
+        *ptr = val;
+    return err;
+}
+
+// --- Views ---
+
+/*
+ * Strides for a new shape over the same row-major element order, or
+ * false if a copy is needed. Dimensions are matched in groups with equal
+ * extent products; the old dimensions of each group must be mutually
+ * contiguous.
+ */
+static bool reshape_strides(const NdArray *array,
+                            size_t ndim,
+                            const size_t *shape,
+                            ptrdiff_t *strides) {
+    // Extent-1 dimensions do not constrain the layout
+    size_t old_shape[NDARRAY_MAX_DIMS];
+    ptrdiff_t old_strides[NDARRAY_MAX_DIMS];
+    size_t old_ndim = 0;
+    for (size_t d = 0; d < array->ndim; d++) {
+        if (array->shape[d] != 1) {
+            old_shape[old_ndim] = array->shape[d];
+            old_strides[old_ndim] = array->strides[d];
+            old_ndim++;
+        }
+    }
+
+    size_t oi = 0;
+    size_t ni = 0;
+    while (oi < old_ndim && ni < ndim) {
+        size_t np = shape[ni];
+        size_t op = old_shape[oi];
+        size_t nj = ni + 1;
+        size_t oj = oi + 1;
+        while (np != op) {
+            if (np < op)
+                np *= shape[nj++];
+            else
+                op *= old_shape[oj++];
+        }
+
+        for (size_t ok = oi; ok + 1 < oj; ok++) {
+            if (old_strides[ok] !=
+                old_strides[ok + 1] * (ptrdiff_t)old_shape[ok + 1])
+                return false;
+        }
+
+        strides[nj - 1] = old_strides[oj - 1];
+        for (size_t nk = nj - 1; nk > ni; nk--) {
+            strides[nk - 1] = strides[nk] * (ptrdiff_t)shape[nk];
+        }
+        ni = nj;
+        oi = oj;
+    }
+
+    // Trailing extent-1 dimensions
+    for (; ni < ndim; ni++) {
+        strides[ni] = 1;
+    }
+    return true;
+}
+
+int ndarray_reshape(const NdArray *array,
+                    size_t ndim,
+                    const size_t *shape,
+                    NdArray *out_view) {
+    if (!array || !shape || !out_view)
+        return VECTOR_ERROR_NULL;
+    if (!ndarray_valid(array))
+        return VECTOR_ERROR_INIT;
+    if (ndim == 0 || ndim > NDARRAY_MAX_DIMS)
+        return VECTOR_ERROR_SIZE;
+
+    size_t size = 1;
+    for (size_t d = 0; d < ndim; d++) {
+        if (shape[d] == 0)
+            return VECTOR_ERROR_SIZE;
+        size *= shape[d];
+    }
+    if (size != ndarray_size(array))
+        return VECTOR_ERROR_SIZE;
+
+    ptrdiff_t strides[NDARRAY_MAX_DIMS];
+    if (!reshape_strides(array, ndim, shape, strides))
+        return VECTOR_ERROR_INVALID_ARG;
+
+    NdArray view = {0};
+    view.data = array->data;
+    view.ndim = ndim;
+    memcpy(view.shape, shape, ndim * sizeof(size_t));
+    memcpy(view.strides, strides, ndim * sizeof(ptrdiff_t));
+    *out_view = view;
+    return VECTOR_SUCCESS;
+}
+
+int ndarray_transpose(const NdArray *array,
+                      const size_t *axes,
+                      NdArray *out_view) {
+    if (!array || !out_view)
+        return VECTOR_ERROR_NULL;
+    if (!ndarray_valid(array))
+        return VECTOR_ERROR_INIT;
+
+    const size_t ndim = array->ndim;
+    NdArray view = {0};
+    view.data = array->data;
+    view.ndim = ndim;
+
+    bool seen[NDARRAY_MAX_DIMS] = {false};
+    for (size_t d = 0; d < ndim; d++) {
+        const size_t from = axes ? axes[d] : ndim - 1 - d;
+        if (from >= ndim || seen[from])
+            return VECTOR_ERROR_INVALID_ARG;
+        seen[from] = true;
+        view.shape[d] = array->shape[from];
+        view.strides[d] = array->strides[from];
+    }
+
+    *out_view = view;
+    return VECTOR_SUCCESS;
+}
+
+int ndarray_slice(const NdArray *array,
+                  size_t axis,
+                  ptrdiff_t start,
+                  ptrdiff_t stop,
+                  ptrdiff_t step,
+                  NdArray *out_view) {
+    if (!array || !out_view)
+        return VECTOR_ERROR_NULL;
+    if (!ndarray_valid(array))
+        return VECTOR_ERROR_INIT;
+    if (axis >= array->ndim || step == 0)
+        return VECTOR_ERROR_INVALID_ARG;
+
+    const ptrdiff_t extent = (ptrdiff_t)array->shape[axis];
+    size_t count = 0;
+    if (step > 0) {
+        if (start < 0 || stop > extent)
+            return VECTOR_ERROR_INDEX;
+        if (start < stop)
+            count = (size_t)((stop - start + step - 1) / step);
+    } else {
+        if (start >= extent || stop < -1)
+            return VECTOR_ERROR_INDEX;
+        if (start > stop)
+            count = (size_t)((start - stop - step - 1) / -step);
+    }
+    if (count == 0)
+        return VECTOR_ERROR_SIZE;
+
+    NdArray view = *array;
+    view.owned = NULL;
+    view.data = array->data + start * array->strides[axis];
+    view.shape[axis] = count;
+    view.strides[axis] = array->strides[axis] * step;
+    *out_view = view;
+    return VECTOR_SUCCESS;
+}
+
+// Broadcast strides of array against ndim/shape, aligned at the end
+static bool broadcast_strides(const NdArray *array,
+                              size_t ndim,
+                              const size_t *shape,
+                              ptrdiff_t *strides) {
+    if (array->ndim > ndim)
+        return false;
+
+    const size_t lead = ndim - array->ndim;
+    for (size_t d = 0; d < ndim; d++) {
+        if (d < lead) {
+            strides[d] = 0;
+            continue;
+        }
+        const size_t extent = array->shape[d - lead];
+        if (extent == shape[d])
+            strides[d] = array->strides[d - lead];
+        else if (extent == 1)
+            strides[d] = 0;
+        else
+            return false;
+    }
+    return true;
+}
+
+int ndarray_broadcast_to(const NdArray *array,
+                         size_t ndim,
+                         const size_t *shape,
+                         NdArray *out_view) {
+    if (!array || !shape || !out_view)
+        return VECTOR_ERROR_NULL;
+    if (!ndarray_valid(array))
+        return VECTOR_ERROR_INIT;
+    if (ndim == 0 || ndim > NDARRAY_MAX_DIMS)
+        return VECTOR_ERROR_SIZE;
+    for (size_t d = 0; d < ndim; d++) {
+        if (shape[d] == 0)
+            return VECTOR_ERROR_SIZE;
+    }
+
+    NdArray view = {0};
+    if (!broadcast_strides(array, ndim, shape, view.strides))
+        return VECTOR_ERROR_SIZE;
+
+    view.data = array->data;
+    view.ndim = ndim;
+    memcpy(view.shape, shape, ndim * sizeof(size_t));
+    *out_view = view;
+    return VECTOR_SUCCESS;
+}
+
+// --- Element-wise kernels ---
+
+typedef enum {
+    NDARRAY_OP_COPY,
+    NDARRAY_OP_FILL,
+    NDARRAY_OP_ADD,
+    NDARRAY_OP_SUB,
+    NDARRAY_OP_MULT,
+    NDARRAY_OP_DIV
+} NdArrayOp;
+
+/*
+ * Result and up to two operands walked together over a coalesced shape:
+ * extent-1 dimensions dropped, dimensions contiguous in every operand
+ * merged into one
+ */
+typedef struct {
+    NdArrayOp op;
+    double_t value; ///< Fill value
+    size_t ndim;
+    size_t shape[NDARRAY_MAX_DIMS];
+    double_t *r;
+    const double_t *a;
+    const double_t *b;
+    ptrdiff_t rs[NDARRAY_MAX_DIMS];
+    ptrdiff_t as[NDARRAY_MAX_DIMS];
+    ptrdiff_t bs[NDARRAY_MAX_DIMS];
+    size_t outer; ///< Product of all but the innermost extent
+    size_t outer_per_task;
+    size_t inner_per_task; ///< Innermost elements per task when rows split
+    size_t inner_splits; ///< Tasks per row when rows split
+} NdIter;
+
+static void iter_coalesce(NdIter *it) {
+    size_t ndim = 0;
+    for (size_t d = 0; d < it->ndim; d++) {
+        if (it->shape[d] == 1)
+            continue;
+
+        if (ndim > 0) {
+            const size_t p = ndim - 1;
+            const ptrdiff_t extent = (ptrdiff_t)it->shape[d];
+            if (it->rs[p] == it->rs[d] * extent &&
+                it->as[p] == it->as[d] * extent &&
+                it->bs[p] == it->bs[d] * extent) {
+                it->shape[p] *= it->shape[d];
+                it->rs[p] = it->rs[d];
+                it->as[p] = it->as[d];
+                it->bs[p] = it->bs[d];
+                continue;
+            }
+        }
+        it->shape[ndim] = it->shape[d];
+        it->rs[ndim] = it->rs[d];
+        it->as[ndim] = it->as[d];
+        it->bs[ndim] = it->bs[d];
+        ndim++;
+    }
+
+    if (ndim == 0) {
+        it->shape[0] = 1;
+        it->rs[0] = it->as[0] = it->bs[0] = 1;
+        ndim = 1;
+    }
+    it->ndim = ndim;
+
+    it->outer = 1;
+    for (size_t d = 0; d + 1 < ndim; d++) {
+        it->outer *= it->shape[d];
+    }
+}
+
+/*
+ * Innermost loop of each operation, specialized for all-unit strides
+ * and for one scalar operand so the common cases vectorize
+ */
+#define NDARRAY_INNER(EXPR)                                                   \
+    do {                                                                      \
+        if (rs == 1 && as == 1 && bs == 1) {                                  \
+            for (size_t i = 0; i < n; i++) {                                  \
+                const double_t x = a[i], y = b[i];                            \
+                r[i] = (EXPR);                                                \
+            }                                                                 \
+        } else if (rs == 1 && as == 1 && bs == 0) {                           \
+            const double_t y = b[0];                                          \
+            for (size_t i = 0; i < n; i++) {                                  \
+                const double_t x = a[i];                                      \
+                r[i] = (EXPR);                                                \
+            }                                                                 \
+        } else if (rs == 1 && as == 0 && bs == 1) {                           \
+            const double_t x = a[0];                                          \
+            for (size_t i = 0; i < n; i++) {                                  \
+                const double_t y = b[i];                                      \
+                r[i] = (EXPR);                                                \
+            }                                                                 \
+        } else {                                                              \
+            for (size_t i = 0; i < n; i++) {                                  \
+                const double_t x = a[(ptrdiff_t)i * as];                      \
+                const double_t y = b[(ptrdiff_t)i * bs];                      \
+                r[(ptrdiff_t)i * rs] = (EXPR);                                \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+static void inner_loop(const NdIter *it,
+                       size_t n,
+                       double_t *r,
+                       const double_t *a,
+                       const double_t *b) {
+    const ptrdiff_t rs = it->rs[it->ndim - 1];
+    const ptrdiff_t as = it->as[it->ndim - 1];
+    const ptrdiff_t bs = it->bs[it->ndim - 1];
+
+    switch (it->op) {
+    case NDARRAY_OP_COPY:
+        NDARRAY_INNER(((void)y, x));
+        break;
+    case NDARRAY_OP_FILL: {
+        const double_t value = it->value;
+        for (size_t i = 0; i < n; i++) {
+            r[(ptrdiff_t)i * rs] = value;
+        }
+        break;
+    }
+    case NDARRAY_OP_ADD:
+        NDARRAY_INNER(x + y);
+        break;
+    case NDARRAY_OP_SUB:
+        NDARRAY_INNER(x - y);
+        break;
+    case NDARRAY_OP_MULT:
+        NDARRAY_INNER(x * y);
+        break;
+    case NDARRAY_OP_DIV:
+        NDARRAY_INNER(x / y);
+        break;
+    }
+}
+
+// Multi-index and operand positions of outer iteration row
+static void iter_seek(const NdIter *it,
+                      size_t row,
+                      size_t *index,
+                      double_t **r,
+                      const double_t **a,
+                      const double_t **b) {
+    *r = it->r;
+    *a = it->a;
+    *b = it->b;
+    for (size_t d = it->ndim - 1; d-- > 0;) {
+        index[d] = row % it->shape[d];
+        row /= it->shape[d];
+        *r += (ptrdiff_t)index[d] * it->rs[d];
+        *a += (ptrdiff_t)index[d] * it->as[d];
+        *b += (ptrdiff_t)index[d] * it->bs[d];
+    }
+}
+
+// Run outer iterations [begin, end), carrying a multi-index odometer
+static void iter_range(const NdIter *it, size_t begin, size_t end) {
+    const size_t outer_ndim = it->ndim - 1;
+    const size_t n = it->shape[outer_ndim];
+    size_t index[NDARRAY_MAX_DIMS] = {0};
+    double_t *r;
+    const double_t *a;
+    const double_t *b;
+    iter_seek(it, begin, index, &r, &a, &b);
+
+    for (size_t o = begin; o < end; o++) {
+        inner_loop(it, n, r, a, b);
+
+        for (size_t d = outer_ndim; d-- > 0;) {
+            r += it->rs[d];
+            a += it->as[d];
+            b += it->bs[d];
+            if (++index[d] < it->shape[d])
+                break;
+            r -= (ptrdiff_t)it->shape[d] * it->rs[d];
+            a -= (ptrdiff_t)it->shape[d] * it->as[d];
+            b -= (ptrdiff_t)it->shape[d] * it->bs[d];
+            index[d] = 0;
+        }
+    }
+}
+
+static void iter_task(void *ctx, size_t task) {
+    const NdIter *it = ctx;
+    const size_t begin = task * it->outer_per_task;
+    const size_t end = begin + it->outer_per_task < it->outer
+                           ? begin + it->outer_per_task
+                           : it->outer;
+    iter_range(it, begin, end);
+}
+
+// One slice of one outer iteration, for rows longer than a task
+static void iter_split_task(void *ctx, size_t task) {
+    const NdIter *it = ctx;
+    const size_t n = it->shape[it->ndim - 1];
+    const size_t row = task / it->inner_splits;
+    const size_t begin = task % it->inner_splits * it->inner_per_task;
+    const size_t end =
+        begin + it->inner_per_task < n ? begin + it->inner_per_task : n;
+
+    size_t index[NDARRAY_MAX_DIMS] = {0};
+    double_t *r;
+    const double_t *a;
+    const double_t *b;
+    iter_seek(it, row, index, &r, &a, &b);
+
+    const size_t last = it->ndim - 1;
+    inner_loop(it,
+               end - begin,
+               r + (ptrdiff_t)begin * it->rs[last],
+               a + (ptrdiff_t)begin * it->as[last],
+               b + (ptrdiff_t)begin * it->bs[last]);
+}
+
+static int iter_run(NdIter *it) {
+    iter_coalesce(it);
+
+    const size_t inner = it->shape[it->ndim - 1];
+    const size_t total = it->outer * inner;
+    if (total < NDARRAY_PARALLEL_MIN) {
+        iter_range(it, 0, it->outer);
+        return VECTOR_SUCCESS;
+    }
+
+    // Rows too long for one task, which is every coalesced contiguous
+    // operation, are cut into slices instead of grouped
+    if (inner >= NDARRAY_TASK_ELEMENTS) {
+        it->inner_per_task = NDARRAY_TASK_ELEMENTS;
+        it->inner_splits = (inner + NDARRAY_TASK_ELEMENTS - 1) /
+                           NDARRAY_TASK_ELEMENTS;
+        return pool_parallel_for(it->outer * it->inner_splits,
+                                 iter_split_task,
+                                 it);
+    }
+
+    it->outer_per_task = NDARRAY_TASK_ELEMENTS / inner;
+    const size_t tasks =
+        (it->outer + it->outer_per_task - 1) / it->outer_per_task;
+    return pool_parallel_for(tasks, iter_task, it);
+}
+
+/*
+ * Validate and set up result op= (a, b). Operands broadcast to result's
+ * shape; a and b may be NULL for operations that do not read them.
+ */
+static int iter_init(NdIter *it,
+                     NdArrayOp op,
+                     const NdArray *a,
+                     const NdArray *b,
+                     NdArray *result) {
+    if (!ndarray_valid(result) || (a && !ndarray_valid(a)) ||
+        (b && !ndarray_valid(b)))
+        return VECTOR_ERROR_INIT;
+
+    memset(it, 0, sizeof(NdIter));
+    it->op = op;
+    it->ndim = result->ndim;
+    memcpy(it->shape, result->shape, result->ndim * sizeof(size_t));
+    memcpy(it->rs, result->strides, result->ndim * sizeof(ptrdiff_t));
+
+    if ((a && !broadcast_strides(a, it->ndim, it->shape, it->as)) ||
+        (b && !broadcast_strides(b, it->ndim, it->shape, it->bs)))
+        return VECTOR_ERROR_SIZE;
+
+    // Writing through a zero stride would race and lose updates
+    for (size_t d = 0; d < it->ndim; d++) {
+        if (it->shape[d] > 1 && it->rs[d] == 0)
+            return VECTOR_ERROR_INVALID_ARG;
+    }
+
+    it->r = result->data;
+    it->a = a ? a->data : result->data;
+    it->b = b ? b->data : it->a;
+    if (!b)
+        memcpy(it->bs, it->as, sizeof(it->bs));
+    return VECTOR_SUCCESS;
+}
+
+static int ndarray_binary(NdArrayOp op,
+                          const NdArray *a,
+                          const NdArray *b,
+                          NdArray *result) {
+    if (!a || !b || !result)
+        return VECTOR_ERROR_NULL;
+
+    NdIter it;
+    int err = iter_init(&it, op, a, b, result);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    return iter_run(&it);
+}
+
+int ndarray_copy(const NdArray *src, NdArray *dest) {
+    if (!src || !dest)
+        return VECTOR_ERROR_NULL;
+
+    NdIter it;
+    int err = iter_init(&it, NDARRAY_OP_COPY, src, NULL, dest);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    return iter_run(&it);
+}
+
+int ndarray_fill(NdArray *array, double_t val) {
+    if (!array)
+        return VECTOR_ERROR_NULL;
+
+    NdIter it;
+    int err = iter_init(&it, NDARRAY_OP_FILL, NULL, NULL, array);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    it.value = val;
+    return iter_run(&it);
+}
+
+int ndarray_add(const NdArray *a, const NdArray *b, NdArray *result) {
+    return ndarray_binary(NDARRAY_OP_ADD, a, b, result);
+}
+
+int ndarray_sub(const NdArray *a, const NdArray *b, NdArray *result) {
+    return ndarray_binary(NDARRAY_OP_SUB, a, b, result);
+}
+
+int ndarray_mult(const NdArray *a, const NdArray *b, NdArray *result) {
+    return ndarray_binary(NDARRAY_OP_MULT, a, b, result);
+}
+
+int ndarray_div(const NdArray *a, const NdArray *b, NdArray *result) {
+    return ndarray_binary(NDARRAY_OP_DIV, a, b, result);
+}
@@ -0,0 +1,374 @@
+/**
+ * @file ortho.c
+ * @brief Orthonormalization of vector sets
+ * @date 18/10/26
+ */
+
+#include "ortho.h"
+#include "blas.h"
+#include "linalg.h"
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ORTHO_BLOCK 32 ///< Vectors per block of the blocked Gram-Schmidt
+#define ORTHO_CHUNK 1024 ///< Elements per chunk of the basis sweeps
+#define ORTHO_REORTH 0.7071067811865476 ///< Repeat if norm drops below this
+#define ORTHO_DEPENDENT 1e-10 ///< Relative norm of a dependent vector
+#define ORTHO_CHOLQR_PIVOT 1e-10 ///< Smallest L_ii^2 / G_ii CholQR accepts
+#define ORTHO_CHOLQR_UNIT 1e-8 ///< Allowed |norm^2 - 1| after CholQR2
+
+// --- Row kernels ---
+
+static double_t row_dot(const double_t *a, const double_t *b, size_t n) {
+    double_t sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+static void row_axpy(double_t alpha,
+                     const double_t *restrict x,
+                     double_t *restrict y,
+                     size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        y[i] += alpha * x[i];
+    }
+}
+
+static void row_scale(double_t alpha, double_t *x, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        x[i] *= alpha;
+    }
+}
+
+// --- Gram-Schmidt ---
+
+/*
+ * Orthonormalize the count rows of w (each n long) in place. Returns the
+ * number of independent rows through out_rank, dependent rows are zeroed.
+ */
+static int gram_schmidt_rows(double_t *w,
+                             size_t count,
+                             size_t n,
+                             size_t *out_rank) {
+    double_t *coeffs = malloc(ORTHO_BLOCK * count * sizeof(double_t));
+    double_t *norms = malloc(count * sizeof(double_t));
+    if (!coeffs || !norms) {
+        free(coeffs);
+        free(norms);
+        return VECTOR_ERROR_MEM;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        norms[i] = sqrt(row_dot(w + i * n, w + i * n, n));
+    }
+
+    int err = VECTOR_SUCCESS;
+    size_t rank = 0;
+    for (size_t j0 = 0; j0 < count && err == VECTOR_SUCCESS;
+         j0 += ORTHO_BLOCK) {
+        const size_t jb = count - j0 < ORTHO_BLOCK ? count - j0 : ORTHO_BLOCK;
+        double_t *block = w + j0 * n;
+
+        // Against the finished rows: C = B Q^T, B -= C Q, twice
+        for (int pass = 0; pass < 2 && j0 > 0; pass++) {
+            memset(coeffs, 0, jb * j0 * sizeof(double_t));
+            blas_gemm_nt(jb, j0, n, 1.0, block, n, w, n, coeffs, j0);
+            err = blas_gemm_parallel(jb, n, j0, -1.0, coeffs, j0, w, n, block,
+                                     n);
+            if (err != VECTOR_SUCCESS)
+                break;
+        }
+
+        // Modified Gram-Schmidt within the block
+        for (size_t r = j0; r < j0 + jb && err == VECTOR_SUCCESS; r++) {
+            double_t *row = w + r * n;
+            double_t norm = sqrt(row_dot(row, row, n));
+
+            for (int pass = 0; pass < 2; pass++) {
+                const double_t before = norm;
+                for (size_t s = j0; s < r; s++) {
+                    const double_t *prev = w + s * n;
+                    row_axpy(-row_dot(row, prev, n), prev, row, n);
+                }
+                norm = sqrt(row_dot(row, row, n));
+                if (norm > ORTHO_REORTH * before)
+                    break;
+            }
+
+            if (norm <= ORTHO_DEPENDENT * norms[r] || norm == 0.0) {
+                memset(row, 0, n * sizeof(double_t));
+            } else {
+                row_scale(1.0 / norm, row, n);
+                rank++;
+            }
+        }
+    }
+
+    free(coeffs);
+    free(norms);
+    if (out_rank)
+        *out_rank = rank;
+    return err;
+}
+
+// --- CholQR ---
+
+// w = L^-1 w for lower triangular L (count x count), blocked on the rows
+static int solve_lower_rows(const double_t *l,
+                            size_t count,
+                            double_t *w,
+                            size_t n) {
+    for (size_t i0 = 0; i0 < count; i0 += ORTHO_BLOCK) {
+        const size_t ib = count - i0 < ORTHO_BLOCK ? count - i0 : ORTHO_BLOCK;
+        if (i0 > 0) {
+            int err = blas_gemm_parallel(ib, n, i0, -1.0, l + i0 * count,
+                                         count, w, n, w + i0 * n, n);
+            if (err != VECTOR_SUCCESS)
+                return err;
+        }
+
+        for (size_t i = i0; i < i0 + ib; i++) {
+            double_t *row = w + i * n;
+            for (size_t p = i0; p < i; p++) {
+                row_axpy(-l[i * count + p], w + p * n, row, n);
+            }
+            row_scale(1.0 / l[i * count + i], row, n);
+        }
+    }
+    return VECTOR_SUCCESS;
+}
+
+/*
+ * One CholQR step on the rows of w: G = W W^T = L L^T, W = L^-1 W. Fails
+ * with VECTOR_ERROR_MATH, w untouched, when a pivot is rounding noise
+ * relative to its row's squared norm, as for (nearly) dependent rows.
+ * diag receives the count diagonal entries of G.
+ */
+static int cholqr_rows(double_t *w,
+                       size_t count,
+                       size_t n,
+                       double_t *g,
+                       double_t *diag) {
+    memset(g, 0, count * count * sizeof(double_t));
+    int err = blas_syrk(count, n, 1.0, w, n, g, count);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    // matrix_cholesky() reads the lower triangle
+    for (size_t i = 0; i < count; i++) {
+        diag[i] = g[i * count + i];
+        for (size_t j = i + 1; j < count; j++) {
+            g[j * count + i] = g[i * count + j];
+        }
+    }
+
+    Matrix gram = {g, count, count};
+    err = matrix_cholesky(&gram, &gram);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    // Cholesky only rejects pivots <= 0, noise-sized ones get through
+    for (size_t i = 0; i < count; i++) {
+        const double_t pivot = g[i * count + i];
+        if (!(pivot * pivot >= ORTHO_CHOLQR_PIVOT * diag[i]))
+            return VECTOR_ERROR_MATH;
+    }
+    return solve_lower_rows(g, count, w, n);
+}
+
+// CholQR2 on the rows of w, VECTOR_ERROR_MATH if the result is not orthonormal
+static int cholqr2_rows(double_t *w, size_t count, size_t n) {
+    // More rows than dimensions are always dependent
+    if (count > n)
+        return VECTOR_ERROR_MATH;
+
+    double_t *g = malloc((count * count + count) * sizeof(double_t));
+    if (!g)
+        return VECTOR_ERROR_MEM;
+    double_t *diag = g + count * count;
+
+    // The second pass restores orthogonality lost in the first
+    int err = VECTOR_SUCCESS;
+    for (int pass = 0; pass < 2 && err == VECTOR_SUCCESS; pass++) {
+        err = cholqr_rows(w, count, n, g, diag);
+    }
+    free(g);
+
+    for (size_t i = 0; i < count && err == VECTOR_SUCCESS; i++) {
+        const double_t *row = w + i * n;
+        if (!(fabs(row_dot(row, row, n) - 1.0) <= ORTHO_CHOLQR_UNIT))
+            err = VECTOR_ERROR_MATH;
+    }
+    return err;
+}
+
+// --- Entry points ---
+
+static int orthonormalize_rows(double_t *w,
+                               size_t count,
+                               size_t n,
+                               NumenOrthoMethod method,
+                               size_t *out_rank) {
+    if (method == NUMEN_ORTHO_GRAM_SCHMIDT)
+        return gram_schmidt_rows(w, count, n, out_rank);
+    if (method != NUMEN_ORTHO_CHOLQR)
+        return VECTOR_ERROR_INVALID_ARG;
+
+    // Keep the input for the Gram-Schmidt fallback, a failed first pass
+    // may already have rewritten w
+    double_t *saved = malloc(count * n * sizeof(double_t));
+    if (!saved)
+        return VECTOR_ERROR_MEM;
+    memcpy(saved, w, count * n * sizeof(double_t));
+
+    int err = cholqr2_rows(w, count, n);
+    if (err == VECTOR_ERROR_MATH) {
+        memcpy(w, saved, count * n * sizeof(double_t));
+        free(saved);
+        return gram_schmidt_rows(w, count, n, out_rank);
+    }
+    free(saved);
+
+    if (err == VECTOR_SUCCESS && out_rank)
+        *out_rank = count;
+    return err;
+}
+
+int vector_orthonormalize(Vector *const *vectors,
+                          size_t count,
+                          NumenOrthoMethod method,
+                          size_t *out_rank) {
+    if (!vectors)
+        return VECTOR_ERROR_NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (!vectors[i])
+            return VECTOR_ERROR_NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!vector_valid(vectors[i]))
+            return VECTOR_ERROR_INIT;
+    }
+    for (size_t i = 1; i < count; i++) {
+        if (vectors[i]->size != vectors[0]->size)
+            return VECTOR_ERROR_SIZE;
+    }
+    if (count == 0) {
+        if (out_rank)
+            *out_rank = 0;
+        return VECTOR_SUCCESS;
+    }
+
+    // Pack into one row-major block so the products run on contiguous rows
+    const size_t n = vectors[0]->size;
+    double_t *w = malloc(count * n * sizeof(double_t));
+    if (!w)
+        return VECTOR_ERROR_MEM;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(w + i * n, vectors[i]->elements, n * sizeof(double_t));
+    }
+
+    int err = orthonormalize_rows(w, count, n, method, out_rank);
+    if (err == VECTOR_SUCCESS) {
+        for (size_t i = 0; i < count; i++) {
+            memcpy(vectors[i]->elements, w + i * n, n * sizeof(double_t));
+        }
+    }
+
+    free(w);
+    return err;
+}
+
+int matrix_orthonormalize(Matrix *a,
+                          NumenOrthoMethod method,
+                          size_t *out_rank) {
+    if (!a)
+        return VECTOR_ERROR_NULL;
+    if (!matrix_valid(a))
+        return VECTOR_ERROR_INIT;
+
+    // Columns become rows of the transposed copy
+    Matrix *t = NULL;
+    int err = matrix_create(a->cols, a->rows, &t);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_transpose(a, t);
+    if (err == VECTOR_SUCCESS)
+        err = orthonormalize_rows(t->elements, t->rows, t->cols, method,
+                                  out_rank);
+    if (err == VECTOR_SUCCESS)
+        err = matrix_transpose(t, a);
+
+    if (t)
+        matrix_free(t);
+    return err;
+}
+
+int vector_orthogonalize(const Vector *const *basis,
+                         size_t count,
+                         Vector *v,
+                         Vector *coefficients,
+                         double_t *out_norm) {
+    if (!basis || !v)
+        return VECTOR_ERROR_NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (!basis[i])
+            return VECTOR_ERROR_NULL;
+    }
+    if (!vector_valid(v) || (coefficients && !vector_valid(coefficients)))
+        return VECTOR_ERROR_INIT;
+    for (size_t i = 0; i < count; i++) {
+        if (!vector_valid(basis[i]))
+            return VECTOR_ERROR_INIT;
+        if (basis[i]->size != v->size)
+            return VECTOR_ERROR_SIZE;
+    }
+    if (coefficients && coefficients->size != count)
+        return VECTOR_ERROR_SIZE;
+
+    double_t *c = calloc(2 * count + 1, sizeof(double_t));
+    if (!c)
+        return VECTOR_ERROR_MEM;
+    double_t *total = c + count;
+
+    const size_t n = v->size;
+    double_t *x = v->elements;
+    double_t norm = sqrt(row_dot(x, x, n));
+
+    // Chunk-major sweeps keep each chunk of v in L1 while the basis streams
+    for (int pass = 0; pass < 2 && count > 0; pass++) {
+        const double_t before = norm;
+
+        memset(c, 0, count * sizeof(double_t));
+        for (size_t c0 = 0; c0 < n; c0 += ORTHO_CHUNK) {
+            const size_t len = n - c0 < ORTHO_CHUNK ? n - c0 : ORTHO_CHUNK;
+            for (size_t i = 0; i < count; i++) {
+                c[i] += row_dot(basis[i]->elements + c0, x + c0, len);
+            }
+        }
+
+        double_t sum = 0.0;
+        for (size_t c0 = 0; c0 < n; c0 += ORTHO_CHUNK) {
+            const size_t len = n - c0 < ORTHO_CHUNK ? n - c0 : ORTHO_CHUNK;
+            for (size_t i = 0; i < count; i++) {
+                row_axpy(-c[i], basis[i]->elements + c0, x + c0, len);
+            }
+            sum += row_dot(x + c0, x + c0, len);
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            total[i] += c[i];
+        }
+        norm = sqrt(sum);
+        if (norm > ORTHO_REORTH * before)
+            break;
+    }
+
+    if (coefficients)
+        memcpy(coefficients->elements, total, count * sizeof(double_t));
+    if (out_norm)
+        *out_norm = norm;
+    free(c);
+    return VECTOR_SUCCESS;
+}
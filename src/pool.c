@@ -0,0 +1,853 @@
+/**
+ * @file pool.c
+ * @brief Internal work-stealing worker pool shared by parallel kernels
+ * @date 18/10/26
+ */
+
+#define _GNU_SOURCE // CPU affinity and sched_getcpu
+
+#include "pool.h"
+#include "runtime.h"
+#include "vector.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define POOL_QUEUE_MIN_CAPACITY 64
+#define POOL_DEQUE_MIN_CAPACITY 256
+#define POOL_SPIN_ROUNDS 64 ///< Failed steal rounds before a worker parks
+#define POOL_NOT_WORKER SIZE_MAX
+#define POOL_CACHE_LINE 64
+#define POOL_SPIN_CLOCK_EVERY 64 ///< Spin iterations between clock reads
+
+// --- Chase-Lev deque ---
+
+typedef struct DequeBuffer {
+    int64_t capacity; ///< Power of two
+    struct DequeBuffer *retired; ///< Previous buffer, kept for late thieves
+    _Atomic(PoolTask *) slots[];
+} DequeBuffer;
+
+/**
+ * @brief Single-owner work-stealing deque (Chase & Lev, with the C11
+ *        orderings of Le et al.)
+ *
+ * The owner pushes and takes at the bottom, thieves steal from the top.
+ */
+typedef struct {
+    _Atomic int64_t top;
+    _Atomic int64_t bottom;
+    _Atomic(DequeBuffer *) buffer;
+} Deque;
+
+static DequeBuffer *deque_buffer_create(int64_t capacity) {
+    DequeBuffer *buffer = malloc(sizeof(DequeBuffer) +
+                                 (size_t)capacity * sizeof(PoolTask *));
+    if (!buffer)
+        return NULL;
+
+    buffer->capacity = capacity;
+    buffer->retired = NULL;
+    for (int64_t i = 0; i < capacity; i++) {
+        atomic_init(&buffer->slots[i], NULL);
+    }
+    return buffer;
+}
+
+static int deque_init(Deque *deque) {
+    DequeBuffer *buffer = deque_buffer_create(POOL_DEQUE_MIN_CAPACITY);
+    if (!buffer)
+        return VECTOR_ERROR_MEM;
+
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->buffer, buffer);
+    return VECTOR_SUCCESS;
+}
+
+static int deque_push(Deque *deque, PoolTask *task) {
+    int64_t b = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    DequeBuffer *buffer =
+        atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+
+    if (b - t > buffer->capacity - 1) {
+        DequeBuffer *bigger = deque_buffer_create(buffer->capacity * 2);
+        if (!bigger)
+            return VECTOR_ERROR_MEM;
+        for (int64_t i = t; i < b; i++) {
+            atomic_store_explicit(
+                &bigger->slots[i & (bigger->capacity - 1)],
+                atomic_load_explicit(
+                    &buffer->slots[i & (buffer->capacity - 1)],
+                    memory_order_relaxed),
+                memory_order_relaxed);
+        }
+        // A thief may still be reading the old buffer, keep it reachable
+        bigger->retired = buffer;
+        atomic_store_explicit(&deque->buffer, bigger, memory_order_release);
+        buffer = bigger;
+    }
+
+    atomic_store_explicit(&buffer->slots[b & (buffer->capacity - 1)],
+                          task,
+                          memory_order_relaxed);
+    // Publishes the slot to thieves that acquire bottom
+    atomic_store_explicit(&deque->bottom, b + 1, memory_order_release);
+    return VECTOR_SUCCESS;
+}
+
+static PoolTask *deque_take(Deque *deque) {
+    int64_t b = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    DequeBuffer *buffer =
+        atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    PoolTask *task = NULL;
+    if (t <= b) {
+        task = atomic_load_explicit(&buffer->slots[b & (buffer->capacity - 1)],
+                                    memory_order_relaxed);
+        if (t == b) {
+            // Last element, race the thieves for it
+            if (!atomic_compare_exchange_strong_explicit(&deque->top,
+                                                         &t,
+                                                         t + 1,
+                                                         memory_order_seq_cst,
+                                                         memory_order_relaxed))
+                task = NULL;
+            atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+        }
+    } else {
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+static PoolTask *deque_steal(Deque *deque) {
+    int64_t t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (t >= b)
+        return NULL;
+
+    DequeBuffer *buffer =
+        atomic_load_explicit(&deque->buffer, memory_order_acquire);
+    PoolTask *task = atomic_load_explicit(
+        &buffer->slots[t & (buffer->capacity - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top,
+                                                 &t,
+                                                 t + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed))
+        return NULL;
+    return task;
+}
+
+static bool deque_empty(Deque *deque) {
+    int64_t t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    int64_t b = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    return t >= b;
+}
+
+// --- Pool ---
+
+typedef struct {
+    Deque *deques; ///< One per worker
+    pthread_t *threads;
+    size_t workers; ///< Threads actually started, fixed once start_open
+
+    pthread_mutex_t start_lock;
+    pthread_cond_t start_cond;
+    bool start_open; ///< Set once the worker count is published
+
+    pthread_mutex_t inject_lock;
+    PoolTask **inject; ///< Ring buffer of tasks from non-worker threads
+    size_t inject_head;
+    size_t inject_count;
+    size_t inject_capacity;
+    atomic_size_t inject_size; ///< Lock-free emptiness hint
+
+    pthread_mutex_t sleep_lock;
+    pthread_cond_t wake;
+    atomic_size_t sleepers;
+
+    int *placement; ///< CPUs in pinning order, slot 0 is left to the caller
+    size_t placement_count;
+    int *cpu_domain; ///< Domain of each CPU id, for unpinned threads
+    size_t cpu_domain_size;
+    size_t domain_count; ///< 1 unless domain partitioning is enabled
+    size_t domain_weight[POOL_MAX_DOMAINS]; ///< Allowed CPUs per domain
+} Pool;
+
+static Pool pool = {
+    .start_lock = PTHREAD_MUTEX_INITIALIZER,
+    .start_cond = PTHREAD_COND_INITIALIZER,
+    .inject_lock = PTHREAD_MUTEX_INITIALIZER,
+    .sleep_lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+};
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+static _Thread_local size_t pool_self = POOL_NOT_WORKER;
+static _Thread_local int pool_domain = -1; ///< Fixed for pinned workers
+static _Thread_local uint64_t pool_rng;
+
+static pthread_mutex_t config_lock = PTHREAD_MUTEX_INITIALIZER;
+static NumenPoolConfig config;
+static int *config_cpus; ///< Owned copy of config.cpus
+static bool pool_started;
+
+static void pool_start(void);
+
+static int inject_push(PoolTask *task) {
+    pthread_mutex_lock(&pool.inject_lock);
+
+    if (pool.inject_count == pool.inject_capacity) {
+        size_t new_capacity = pool.inject_capacity ? pool.inject_capacity * 2
+                                                   : POOL_QUEUE_MIN_CAPACITY;
+        PoolTask **items = malloc(new_capacity * sizeof(PoolTask *));
+        if (!items) {
+            pthread_mutex_unlock(&pool.inject_lock);
+            return VECTOR_ERROR_MEM;
+        }
+        // Unwrap the ring into the new buffer
+        for (size_t i = 0; i < pool.inject_count; i++) {
+            size_t slot = (pool.inject_head + i) % pool.inject_capacity;
+            items[i] = pool.inject[slot];
+        }
+        free(pool.inject);
+        pool.inject = items;
+        pool.inject_head = 0;
+        pool.inject_capacity = new_capacity;
+    }
+
+    pool.inject[(pool.inject_head + pool.inject_count) % pool.inject_capacity] =
+        task;
+    pool.inject_count++;
+    atomic_fetch_add(&pool.inject_size, 1);
+
+    pthread_mutex_unlock(&pool.inject_lock);
+    return VECTOR_SUCCESS;
+}
+
+static PoolTask *inject_pop(void) {
+    if (atomic_load_explicit(&pool.inject_size, memory_order_relaxed) == 0)
+        return NULL;
+
+    PoolTask *task = NULL;
+    pthread_mutex_lock(&pool.inject_lock);
+    if (pool.inject_count > 0) {
+        task = pool.inject[pool.inject_head];
+        pool.inject_head = (pool.inject_head + 1) % pool.inject_capacity;
+        pool.inject_count--;
+        atomic_fetch_sub(&pool.inject_size, 1);
+    }
+    pthread_mutex_unlock(&pool.inject_lock);
+    return task;
+}
+
+// xorshift64, one stream per thread for victim selection
+static size_t pool_random(void) {
+    if (pool_rng == 0)
+        pool_rng = (uint64_t)(uintptr_t)&pool_rng | 1;
+    pool_rng ^= pool_rng << 13;
+    pool_rng ^= pool_rng >> 7;
+    pool_rng ^= pool_rng << 17;
+    return (size_t)pool_rng;
+}
+
+static PoolTask *pool_find_work(void) {
+    PoolTask *task;
+
+    if (pool_self != POOL_NOT_WORKER &&
+        (task = deque_take(&pool.deques[pool_self])))
+        return task;
+    if ((task = inject_pop()))
+        return task;
+
+    if (pool.workers == 0)
+        return NULL;
+    const size_t start = pool_random() % pool.workers;
+    for (size_t i = 0; i < pool.workers; i++) {
+        size_t victim = (start + i) % pool.workers;
+        if (victim == pool_self)
+            continue;
+        if ((task = deque_steal(&pool.deques[victim])))
+            return task;
+    }
+    return NULL;
+}
+
+static bool pool_has_work(void) {
+    if (atomic_load(&pool.inject_size) > 0)
+        return true;
+    for (size_t i = 0; i < pool.workers; i++) {
+        if (!deque_empty(&pool.deques[i]))
+            return true;
+    }
+    return false;
+}
+
+static void pool_notify(void) {
+    // Pairs with the sleeper count increment in pool_worker: either the
+    // submitter sees a sleeper, or the sleeper sees the new task
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load(&pool.sleepers) > 0) {
+        pthread_mutex_lock(&pool.sleep_lock);
+        pthread_cond_signal(&pool.wake);
+        pthread_mutex_unlock(&pool.sleep_lock);
+    }
+}
+
+static void cpu_relax(void) {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    __builtin_ia32_pause();
+#endif
+}
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static void pin_to_cpu(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+static size_t pool_current_domain(void) {
+    if (pool.domain_count <= 1)
+        return 0;
+    if (pool_domain >= 0)
+        return (size_t)pool_domain;
+#if defined(__linux__)
+    int cpu = sched_getcpu();
+    if (cpu >= 0 && (size_t)cpu < pool.cpu_domain_size)
+        return (size_t)pool.cpu_domain[cpu];
+#endif
+    return 0;
+}
+
+// Spin for config.spin_us (or a few yields) looking for work, false if
+// the worker should park
+static bool pool_idle_wait(size_t *rounds, uint64_t *idle_since) {
+    if (config.spin_us == 0) {
+        if (++*rounds >= POOL_SPIN_ROUNDS)
+            return false;
+        sched_yield();
+        return true;
+    }
+
+    if (*rounds == 0)
+        *idle_since = now_us();
+    if (++*rounds % POOL_SPIN_CLOCK_EVERY == 0 &&
+        now_us() - *idle_since >= config.spin_us)
+        return false;
+    cpu_relax();
+    return true;
+}
+
+static void *pool_worker(void *arg) {
+    pool_self = (size_t)(uintptr_t)arg;
+
+    // Wait until pool_start() knows how many workers exist
+    pthread_mutex_lock(&pool.start_lock);
+    while (!pool.start_open)
+        pthread_cond_wait(&pool.start_cond, &pool.start_lock);
+    pthread_mutex_unlock(&pool.start_lock);
+
+    if (config.affinity != NUMEN_AFFINITY_NONE && pool.placement_count > 0) {
+        // Outside explicit lists, slot 0 stays free for the submitting thread
+        size_t slot = pool_self % pool.placement_count;
+        if (config.affinity != NUMEN_AFFINITY_LIST && pool.placement_count > 1)
+            slot = 1 + pool_self % (pool.placement_count - 1);
+        int cpu = pool.placement[slot];
+        pin_to_cpu(cpu);
+        if ((size_t)cpu < pool.cpu_domain_size)
+            pool_domain = pool.cpu_domain[cpu];
+    }
+
+    size_t idle_rounds = 0;
+    uint64_t idle_since = 0;
+
+    for (;;) {
+        PoolTask *task = pool_find_work();
+        if (task) {
+            task->run(task);
+            idle_rounds = 0;
+            continue;
+        }
+
+        if (pool_idle_wait(&idle_rounds, &idle_since))
+            continue;
+
+        pthread_mutex_lock(&pool.sleep_lock);
+        atomic_fetch_add(&pool.sleepers, 1);
+        if (!pool_has_work())
+            pthread_cond_wait(&pool.wake, &pool.sleep_lock);
+        atomic_fetch_sub(&pool.sleepers, 1);
+        pthread_mutex_unlock(&pool.sleep_lock);
+        idle_rounds = 0;
+    }
+
+    return NULL;
+}
+
+// --- Topology ---
+
+static int read_cpu_attr(const char *format, int cpu, int fallback) {
+    char path[128];
+    snprintf(path, sizeof(path), format, cpu);
+
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return fallback;
+
+    // Lists such as "0-3,8-11" yield their first CPU, which is a fine key
+    int value;
+    if (fscanf(file, "%d", &value) != 1)
+        value = fallback;
+    fclose(file);
+    return value;
+}
+
+static int compare_compact(const void *lhs, const void *rhs) {
+    const PoolCpu *a = lhs;
+    const PoolCpu *b = rhs;
+    if (a->domain != b->domain)
+        return a->domain < b->domain ? -1 : 1;
+    if (a->core != b->core)
+        return a->core < b->core ? -1 : 1;
+    return (a->cpu > b->cpu) - (a->cpu < b->cpu);
+}
+
+// Allowed CPUs with their topology, in compact order
+static size_t pool_topology(PoolCpu **out_cpus) {
+    size_t count = 0;
+    PoolCpu *cpus = NULL;
+
+#if defined(__linux__)
+    // The affinity mask already reflects cgroup cpusets and taskset
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        cpus = malloc((size_t)CPU_COUNT(&set) * sizeof(PoolCpu));
+        for (int cpu = 0; cpus && cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set))
+                cpus[count++].cpu = cpu;
+        }
+    }
+#endif
+    if (count == 0) {
+        free(cpus);
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        count = online > 0 ? (size_t)online : 1;
+        cpus = malloc(count * sizeof(PoolCpu));
+        if (!cpus)
+            return 0;
+        for (size_t i = 0; i < count; i++) {
+            cpus[i].cpu = (int)i;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const int cpu = cpus[i].cpu;
+        int package = read_cpu_attr(
+            "/sys/devices/system/cpu/cpu%d/topology/physical_package_id",
+            cpu,
+            0);
+        int core = read_cpu_attr(
+            "/sys/devices/system/cpu/cpu%d/topology/core_id", cpu, cpu);
+        cpus[i].core = package * 65536 + core;
+        cpus[i].domain = read_cpu_attr(
+            "/sys/devices/system/cpu/cpu%d/cache/index3/shared_cpu_list",
+            cpu,
+            package);
+    }
+
+    qsort(cpus, count, sizeof(PoolCpu), compare_compact);
+    *out_cpus = cpus;
+    return count;
+}
+
+size_t pool_number_domains(PoolCpu *cpus, size_t count, size_t *weights) {
+    memset(weights, 0, POOL_MAX_DOMAINS * sizeof(size_t));
+    if (count == 0)
+        return 0;
+
+    // Compare raw keys: the previous entry has already been renumbered
+    size_t domains = 0;
+    int previous_key = cpus[0].domain;
+    for (size_t i = 0; i < count; i++) {
+        const int key = cpus[i].domain;
+        if (key != previous_key)
+            domains++;
+        previous_key = key;
+        cpus[i].domain = (int)(domains % POOL_MAX_DOMAINS);
+        weights[cpus[i].domain]++;
+    }
+    return domains + 1 < POOL_MAX_DOMAINS ? domains + 1 : POOL_MAX_DOMAINS;
+}
+
+static void pool_place(PoolCpu *cpus, size_t count) {
+    int max_cpu = 0;
+    for (size_t i = 0; i < count; i++) {
+        max_cpu = cpus[i].cpu > max_cpu ? cpus[i].cpu : max_cpu;
+    }
+
+    // Dense domain indices in compact order
+    pool.cpu_domain = malloc(((size_t)max_cpu + 1) * sizeof(int));
+    pool.placement = malloc(count * sizeof(int));
+    if (!pool.cpu_domain || !pool.placement)
+        return;
+    pool.cpu_domain_size = (size_t)max_cpu + 1;
+    memset(pool.cpu_domain, 0, pool.cpu_domain_size * sizeof(int));
+
+    const size_t domains =
+        pool_number_domains(cpus, count, pool.domain_weight);
+    for (size_t i = 0; i < count; i++) {
+        pool.cpu_domain[cpus[i].cpu] = cpus[i].domain;
+    }
+    pool.domain_count = config.domain_partition ? domains : 1;
+
+    if (config.affinity == NUMEN_AFFINITY_LIST) {
+        free(pool.placement);
+        pool.placement = malloc(config.cpu_count * sizeof(int));
+        if (!pool.placement)
+            return;
+        memcpy(pool.placement, config_cpus, config.cpu_count * sizeof(int));
+        pool.placement_count = config.cpu_count;
+        return;
+    }
+
+    // One CPU per physical core if SMT siblings are to be avoided
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (config.avoid_smt && kept > 0 && cpus[i].core == cpus[kept - 1].core)
+            continue;
+        cpus[kept++] = cpus[i];
+    }
+
+    if (config.affinity == NUMEN_AFFINITY_SCATTER) {
+        // Take the next unused CPU of each domain in turn
+        size_t placed = 0;
+        bool *used = calloc(kept, sizeof(bool));
+        if (!used)
+            return;
+        while (placed < kept) {
+            int last_domain = -1;
+            for (size_t i = 0; i < kept; i++) {
+                if (!used[i] && cpus[i].domain != last_domain) {
+                    used[i] = true;
+                    last_domain = cpus[i].domain;
+                    pool.placement[placed++] = cpus[i].cpu;
+                }
+            }
+        }
+        free(used);
+    } else {
+        for (size_t i = 0; i < kept; i++) {
+            pool.placement[i] = cpus[i].cpu;
+        }
+    }
+    pool.placement_count = kept;
+}
+
+static void pool_start(void) {
+    pthread_mutex_lock(&config_lock);
+    pool_started = true;
+    pthread_mutex_unlock(&config_lock);
+
+    PoolCpu *cpus = NULL;
+    size_t cpu_count = pool_topology(&cpus);
+    pool.domain_count = 1;
+    if (cpus)
+        pool_place(cpus, cpu_count);
+    free(cpus);
+
+    size_t workers = config.threads;
+    if (workers == 0) {
+        size_t usable = config.avoid_smt && pool.placement_count > 0
+                            ? pool.placement_count
+                            : cpu_count;
+        workers = usable > 1 ? usable - 1 : 1;
+    }
+
+    pool.threads = malloc(workers * sizeof(pthread_t));
+    pool.deques = malloc(workers * sizeof(Deque));
+    if (!pool.threads || !pool.deques)
+        return;
+
+    // Deques first: a running worker may steal from any of them
+    for (size_t i = 0; i < workers; i++) {
+        if (deque_init(&pool.deques[i]) != VECTOR_SUCCESS) {
+            workers = i;
+            break;
+        }
+    }
+
+    // Workers live for the rest of the process, a failed start just leaves
+    // fewer of them and the calling thread picks up the slack. Started
+    // workers wait at the gate until the count of those that really exist
+    // is published, so none is ever handed a slot nobody serves.
+    size_t started = 0;
+    for (; started < workers; started++) {
+        if (pthread_create(&pool.threads[started],
+                           NULL,
+                           pool_worker,
+                           (void *)(uintptr_t)started) != 0) {
+            break;
+        }
+        pthread_detach(pool.threads[started]);
+    }
+
+    pthread_mutex_lock(&pool.start_lock);
+    pool.workers = started;
+    pool.start_open = true;
+    pthread_cond_broadcast(&pool.start_cond);
+    pthread_mutex_unlock(&pool.start_lock);
+}
+
+// --- Configuration ---
+
+int numen_pool_config_default(NumenPoolConfig *out_config) {
+    if (!out_config)
+        return VECTOR_ERROR_NULL;
+
+    memset(out_config, 0, sizeof(NumenPoolConfig));
+    out_config->affinity = NUMEN_AFFINITY_NONE;
+    return VECTOR_SUCCESS;
+}
+
+int numen_pool_configure(const NumenPoolConfig *new_config) {
+    if (!new_config)
+        return VECTOR_ERROR_NULL;
+    if (new_config->affinity == NUMEN_AFFINITY_LIST &&
+        (!new_config->cpus || new_config->cpu_count == 0))
+        return VECTOR_ERROR_INVALID_ARG;
+
+    int *cpus = NULL;
+    if (new_config->affinity == NUMEN_AFFINITY_LIST) {
+        cpus = malloc(new_config->cpu_count * sizeof(int));
+        if (!cpus)
+            return VECTOR_ERROR_MEM;
+        memcpy(cpus, new_config->cpus, new_config->cpu_count * sizeof(int));
+    }
+
+    pthread_mutex_lock(&config_lock);
+    if (pool_started) {
+        pthread_mutex_unlock(&config_lock);
+        free(cpus);
+        return VECTOR_ERROR_INIT;
+    }
+    free(config_cpus);
+    config = *new_config;
+    config_cpus = cpus;
+    config.cpus = cpus;
+    pthread_mutex_unlock(&config_lock);
+    return VECTOR_SUCCESS;
+}
+
+int numen_pool_threads(size_t *out_threads) {
+    if (!out_threads)
+        return VECTOR_ERROR_NULL;
+
+    *out_threads = pool_thread_count();
+    return VECTOR_SUCCESS;
+}
+
+int numen_pool_domains(size_t *out_domains) {
+    if (!out_domains)
+        return VECTOR_ERROR_NULL;
+
+    pthread_once(&pool_once, pool_start);
+    *out_domains = pool.domain_count;
+    return VECTOR_SUCCESS;
+}
+
+size_t pool_thread_count(void) {
+    pthread_once(&pool_once, pool_start);
+    return pool.workers + 1;
+}
+
+int pool_submit(PoolTask *task) {
+    if (!task || !task->run)
+        return VECTOR_ERROR_NULL;
+    pthread_once(&pool_once, pool_start);
+
+    int err = pool_self != POOL_NOT_WORKER
+                  ? deque_push(&pool.deques[pool_self], task)
+                  : inject_push(task);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    pool_notify();
+    return VECTOR_SUCCESS;
+}
+
+bool pool_try_run_one(void) {
+    pthread_once(&pool_once, pool_start);
+
+    PoolTask *task = pool_find_work();
+    if (!task)
+        return false;
+
+    task->run(task);
+    return true;
+}
+
+// --- Parallel for ---
+
+typedef struct ParallelJob ParallelJob;
+
+typedef struct {
+    PoolTask task;
+    ParallelJob *job;
+} ParallelHelper;
+
+/**
+ * @brief Task indices reserved for one cache domain
+ *
+ * Padded so threads claiming from different domains do not share a line.
+ */
+typedef struct {
+    atomic_size_t next; ///< Next unclaimed task index
+    size_t end;
+    char pad[POOL_CACHE_LINE - sizeof(atomic_size_t) - sizeof(size_t)];
+} DomainRange;
+
+struct ParallelJob {
+    PoolTaskFn fn;
+    void *ctx;
+    size_t tasks;
+    size_t domains; ///< Number of ranges in use
+    DomainRange ranges[POOL_MAX_DOMAINS];
+    atomic_size_t done; ///< Number of finished task indices
+    atomic_size_t refs; ///< Helpers still holding the job, plus the caller
+    pthread_mutex_t lock;
+    pthread_cond_t finished;
+    ParallelHelper helpers[];
+};
+
+static void job_release(ParallelJob *job) {
+    if (atomic_fetch_sub(&job->refs, 1) == 1) {
+        pthread_mutex_destroy(&job->lock);
+        pthread_cond_destroy(&job->finished);
+        free(job);
+    }
+}
+
+// Split task indices across domains in proportion to their CPU counts
+static void job_partition(ParallelJob *job) {
+    job->domains = pool.domain_count < job->tasks ? pool.domain_count : 1;
+
+    size_t total = 0;
+    for (size_t d = 0; d < job->domains; d++) {
+        total += pool.domain_weight[d];
+    }
+
+    size_t begin = 0;
+    size_t weight = 0;
+    for (size_t d = 0; d < job->domains; d++) {
+        weight += pool.domain_weight[d];
+        size_t end = d + 1 == job->domains || total == 0
+                         ? job->tasks
+                         : job->tasks * weight / total;
+        atomic_init(&job->ranges[d].next, begin);
+        job->ranges[d].end = end;
+        begin = end;
+    }
+}
+
+// Drain the local domain first, then help the others
+static void job_run(ParallelJob *job) {
+    const size_t home = pool_current_domain() % job->domains;
+
+    for (size_t offset = 0; offset < job->domains; offset++) {
+        DomainRange *range = &job->ranges[(home + offset) % job->domains];
+
+        size_t task;
+        while ((task = atomic_fetch_add(&range->next, 1)) < range->end) {
+            job->fn(job->ctx, task);
+            if (atomic_fetch_add(&job->done, 1) + 1 == job->tasks) {
+                pthread_mutex_lock(&job->lock);
+                pthread_cond_broadcast(&job->finished);
+                pthread_mutex_unlock(&job->lock);
+            }
+        }
+    }
+}
+
+static void job_helper(PoolTask *task) {
+    ParallelJob *job = ((ParallelHelper *)task)->job;
+    job_run(job);
+    job_release(job);
+}
+
+int pool_parallel_for(size_t tasks, PoolTaskFn fn, void *ctx) {
+    if (!fn)
+        return VECTOR_ERROR_NULL;
+    if (tasks == 0)
+        return VECTOR_SUCCESS;
+
+    size_t helpers = pool_thread_count() - 1;
+    if (helpers > tasks - 1)
+        helpers = tasks - 1;
+
+    if (helpers == 0) {
+        for (size_t i = 0; i < tasks; i++) {
+            fn(ctx, i);
+        }
+        return VECTOR_SUCCESS;
+    }
+
+    // Heap allocated: helpers that are dequeued late may still touch it
+    ParallelJob *job =
+        malloc(sizeof(ParallelJob) + helpers * sizeof(ParallelHelper));
+    if (!job)
+        return VECTOR_ERROR_MEM;
+
+    job->fn = fn;
+    job->ctx = ctx;
+    job->tasks = tasks;
+    job_partition(job);
+    atomic_init(&job->done, 0);
+    atomic_init(&job->refs, 1);
+    pthread_mutex_init(&job->lock, NULL);
+    pthread_cond_init(&job->finished, NULL);
+
+    for (size_t i = 0; i < helpers; i++) {
+        job->helpers[i].task.run = job_helper;
+        job->helpers[i].job = job;
+        atomic_fetch_add(&job->refs, 1);
+        if (pool_submit(&job->helpers[i].task) != VECTOR_SUCCESS) {
+            atomic_fetch_sub(&job->refs, 1);
+            break;
+        }
+    }
+
+    job_run(job);
+
+    pthread_mutex_lock(&job->lock);
+    while (atomic_load(&job->done) < tasks) {
+        pthread_cond_wait(&job->finished, &job->lock);
+    }
+    pthread_mutex_unlock(&job->lock);
+
+    job_release(job);
+    return VECTOR_SUCCESS;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file pool.h
+ * @brief Internal work-stealing worker pool shared by parallel kernels
+ * @date 18/10/26
+ */
+
+#ifndef __POOL_H
+#define __POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define POOL_MAX_DOMAINS 16
+
+/**
+ * @brief Topology of one allowed CPU
+ */
+typedef struct {
+    int cpu;
+    int core; ///< Physical core key, shared by SMT siblings
+    int domain; ///< L3 (or package) key, remapped to a dense index
+} PoolCpu;
+
+/**
+ * @brief Body of a parallel loop, called once per task index
+ */
+typedef void (*PoolTaskFn)(void *ctx, size_t task);
+
+/**
+ * @brief Intrusive unit of work
+ *
+ * Embed as the first member of a larger structure and recover it in run,
+ * so queueing never allocates.
+ */
+typedef struct PoolTask {
+    void (*run)(struct PoolTask *task); ///< Called once on some thread
+} PoolTask;
+
+/**
+ * @brief Number of threads that can run tasks concurrently
+ *
+ * Counts the pool workers plus the calling thread, which always helps.
+ * Starts the pool on first use.
+ */
+size_t pool_thread_count(void);
+
+/**
+ * @brief Queue a task to run on a pool worker
+ * @param task Task to queue, must stay alive until it runs
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note Workers push onto their own deque, other threads onto a shared
+ *       injection queue; idle workers steal from both
+ */
+int pool_submit(PoolTask *task);
+
+/**
+ * @brief Run one queued task on the calling thread, if any
+ * @return true if a task was run, false if no work was found
+ *
+ * @note Lets threads that block on pool work help instead of idling
+ */
+bool pool_try_run_one(void);
+
+/**
+ * @brief Run fn(ctx, i) for every i in [0, tasks) and wait for completion
+ * @param tasks Number of task indices
+ * @param fn Task body
+ * @param ctx Context passed to every call
+ * @return VECTOR_SUCCESS on success, error code otherwise
+ *
+ * @note The caller claims task indices alongside the workers, so progress
+ *       never depends on a free worker and nested calls are safe
+ */
+int pool_parallel_for(size_t tasks, PoolTaskFn fn, void *ctx);
+
+/**
+ * @brief Replace the raw cache keys of CPUs in compact order by dense
+ *        domain indices
+ * @param cpus CPUs sorted so equal keys are adjacent, renumbered in place
+ * @param count Number of CPUs
+ * @param weights Receives the number of CPUs in each domain, has
+ *        POOL_MAX_DOMAINS entries
+ * @return Number of domains, at most POOL_MAX_DOMAINS
+ *
+ * @note Domains past the limit wrap onto the first ones
+ */
+size_t pool_number_domains(PoolCpu *cpus, size_t count, size_t *weights);
+
+#endif // !__POOL_H
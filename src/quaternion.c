@@ -0,0 +1,300 @@
+/**
+ * @file quaternion.c
+ * @brief Quaternion computation
+ * @date 18/10/26
+ */
+
+#include "quaternion.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// --- Construction ---
+
+int quaternion_from_axis_angle(double_t ax,
+                               double_t ay,
+                               double_t az,
+                               double_t angle,
+                               Quaternion *out_quat) {
+    if (!out_quat)
+        return VECTOR_ERROR_NULL;
+
+    double_t len = sqrt(ax * ax + ay * ay + az * az);
+    if (len == 0.0)
+        return VECTOR_ERROR_MATH;
+
+    const double_t s = sin(0.5 * angle) / len;
+    out_quat->w = cos(0.5 * angle);
+    out_quat->x = ax * s;
+    out_quat->y = ay * s;
+    out_quat->z = az * s;
+    return VECTOR_SUCCESS;
+}
+
+int quat_batch_create(size_t count, QuatBatch **out_batch) {
+    if (!out_batch)
+        return VECTOR_ERROR_NULL;
+    if (count > SIZE_MAX / 4 / sizeof(double_t))
+        return VECTOR_ERROR_MEM;
+
+    QuatBatch *batch = malloc(sizeof(QuatBatch));
+    if (!batch)
+        return VECTOR_ERROR_MEM;
+
+    // One block for all components, w | x | y | z
+    double_t *data = calloc(count > 0 ? 4 * count : 1, sizeof(double_t));
+    if (!data) {
+        free(batch);
+        return VECTOR_ERROR_MEM;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        data[i] = 1.0;
+    }
+
+    batch->w = data;
+    batch->x = data + count;
+    batch->y = data + 2 * count;
+    batch->z = data + 3 * count;
+    batch->count = count;
+    *out_batch = batch;
+    return VECTOR_SUCCESS;
+}
+
+int quat_batch_free(QuatBatch *batch) {
+    if (!batch)
+        return VECTOR_ERROR_NULL;
+
+    free(batch->w);
+    free(batch);
+    return VECTOR_SUCCESS;
+}
+
+// --- Quaternion operations ---
+
+int quaternion_multiply(const Quaternion *a,
+                        const Quaternion *b,
+                        Quaternion *result) {
+    if (!a || !b || !result)
+        return VECTOR_ERROR_NULL;
+
+    // Compute into temporaries so result may alias an operand
+    const double_t w = a->w * b->w - a->x * b->x - a->y * b->y - a->z * b->z;
+    const double_t x = a->w * b->x + a->x * b->w + a->y * b->z - a->z * b->y;
+    const double_t y = a->w * b->y - a->x * b->z + a->y * b->w + a->z * b->x;
+    const double_t z = a->w * b->z + a->x * b->y - a->y * b->x + a->z * b->w;
+
+    result->w = w;
+    result->x = x;
+    result->y = y;
+    result->z = z;
+    return VECTOR_SUCCESS;
+}
+
+int quaternion_conjugate(const Quaternion *q, Quaternion *result) {
+    if (!q || !result)
+        return VECTOR_ERROR_NULL;
+
+    result->w = q->w;
+    result->x = -q->x;
+    result->y = -q->y;
+    result->z = -q->z;
+    return VECTOR_SUCCESS;
+}
+
+int quaternion_normalize(Quaternion *q) {
+    if (!q)
+        return VECTOR_ERROR_NULL;
+
+    double_t len = sqrt(q->w * q->w + q->x * q->x + q->y * q->y + q->z * q->z);
+    if (len == 0.0)
+        return VECTOR_ERROR_MATH;
+
+    const double_t scale = 1.0 / len;
+    q->w *= scale;
+    q->x *= scale;
+    q->y *= scale;
+    q->z *= scale;
+    return VECTOR_SUCCESS;
+}
+
+int quaternion_slerp(const Quaternion *a,
+                     const Quaternion *b,
+                     double_t t,
+                     Quaternion *result) {
+    if (!a || !b || !result)
+        return VECTOR_ERROR_NULL;
+
+    double_t dot = a->w * b->w + a->x * b->x + a->y * b->y + a->z * b->z;
+
+    // q and -q are the same rotation, flip b to take the shorter arc
+    double_t sign = 1.0;
+    if (dot < 0.0) {
+        dot = -dot;
+        sign = -1.0;
+    }
+
+    double_t a_scale, b_scale;
+    if (dot > 1.0 - 1e-10) {
+        // Nearly parallel - use lerp and renormalize below
+        a_scale = 1.0 - t;
+        b_scale = t;
+    } else {
+        const double_t omega = acos(dot);
+        const double_t sin_omega = sin(omega);
+        a_scale = sin((1.0 - t) * omega) / sin_omega;
+        b_scale = sin(t * omega) / sin_omega;
+    }
+    b_scale *= sign;
+
+    Quaternion r;
+    r.w = a_scale * a->w + b_scale * b->w;
+    r.x = a_scale * a->x + b_scale * b->x;
+    r.y = a_scale * a->y + b_scale * b->y;
+    r.z = a_scale * a->z + b_scale * b->z;
+
+    int err = quaternion_normalize(&r);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    *result = r;
+    return VECTOR_SUCCESS;
+}
+
+int quaternion_to_mat3(const Quaternion *q, double_t out_mat[9]) {
+    if (!q || !out_mat)
+        return VECTOR_ERROR_NULL;
+
+    const double_t n = q->w * q->w + q->x * q->x + q->y * q->y + q->z * q->z;
+    if (n == 0.0)
+        return VECTOR_ERROR_MATH;
+
+    // s = 2 / |q|^2 folds the normalization into the matrix
+    const double_t s = 2.0 / n;
+    const double_t xx = s * q->x * q->x, yy = s * q->y * q->y;
+    const double_t zz = s * q->z * q->z, xy = s * q->x * q->y;
+    const double_t xz = s * q->x * q->z, yz = s * q->y * q->z;
+    const double_t wx = s * q->w * q->x, wy = s * q->w * q->y;
+    const double_t wz = s * q->w * q->z;
+
+    out_mat[0] = 1.0 - (yy + zz);
+    out_mat[1] = xy - wz;
+    out_mat[2] = xz + wy;
+    out_mat[3] = xy + wz;
+    out_mat[4] = 1.0 - (xx + zz);
+    out_mat[5] = yz - wx;
+    out_mat[6] = xz - wy;
+    out_mat[7] = yz + wx;
+    out_mat[8] = 1.0 - (xx + yy);
+    return VECTOR_SUCCESS;
+}
+
+int quaternion_to_mat4(const Quaternion *q, double_t out_mat[16]) {
+    if (!q || !out_mat)
+        return VECTOR_ERROR_NULL;
+
+    double_t m[9];
+    int err = quaternion_to_mat3(q, m);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    for (size_t r = 0; r < 3; r++) {
+        out_mat[r * 4] = m[r * 3];
+        out_mat[r * 4 + 1] = m[r * 3 + 1];
+        out_mat[r * 4 + 2] = m[r * 3 + 2];
+        out_mat[r * 4 + 3] = 0.0;
+    }
+    out_mat[12] = 0.0;
+    out_mat[13] = 0.0;
+    out_mat[14] = 0.0;
+    out_mat[15] = 1.0;
+    return VECTOR_SUCCESS;
+}
+
+// --- Rotation ---
+
+int quaternion_rotate_vector(const Quaternion *q,
+                             const Vector *v,
+                             Vector *result) {
+    if (!q || !v || !result)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(v) || !vector_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (v->size != 3 || result->size != 3)
+        return VECTOR_ERROR_SIZE;
+
+    double_t m[9];
+    int err = quaternion_to_mat3(q, m);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    const double_t x = v->elements[0];
+    const double_t y = v->elements[1];
+    const double_t z = v->elements[2];
+    result->elements[0] = m[0] * x + m[1] * y + m[2] * z;
+    result->elements[1] = m[3] * x + m[4] * y + m[5] * z;
+    result->elements[2] = m[6] * x + m[7] * y + m[8] * z;
+    return VECTOR_SUCCESS;
+}
+
+// One matrix for all points: 9 multiply-adds per point, vectorized over i
+int quaternion_rotate_points(const Quaternion *q,
+                             const Vec3Batch *points,
+                             Vec3Batch *result) {
+    if (!q || !points || !result)
+        return VECTOR_ERROR_NULL;
+    if (!points->x || !result->x)
+        return VECTOR_ERROR_INIT;
+    if (points->count != result->count)
+        return VECTOR_ERROR_SIZE;
+
+    double_t m[9];
+    int err = quaternion_to_mat3(q, m);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    const double_t m0 = m[0], m1 = m[1], m2 = m[2];
+    const double_t m3 = m[3], m4 = m[4], m5 = m[5];
+    const double_t m6 = m[6], m7 = m[7], m8 = m[8];
+    const double_t *px = points->x, *py = points->y, *pz = points->z;
+    double_t *rx = result->x, *ry = result->y, *rz = result->z;
+
+    for (size_t i = 0; i < points->count; i++) {
+        const double_t x = px[i], y = py[i], z = pz[i];
+        rx[i] = m0 * x + m1 * y + m2 * z;
+        ry[i] = m3 * x + m4 * y + m5 * z;
+        rz[i] = m6 * x + m7 * y + m8 * z;
+    }
+
+    return VECTOR_SUCCESS;
+}
+
+// v' = v + w * t + q x t, with t = 2 * (q x v); branch-free, vectorized over i
+int quaternion_rotate_points_each(const QuatBatch *q,
+                                  const Vec3Batch *points,
+                                  Vec3Batch *result) {
+    if (!q || !points || !result)
+        return VECTOR_ERROR_NULL;
+    if (!q->w || !points->x || !result->x)
+        return VECTOR_ERROR_INIT;
+    if (q->count != points->count || points->count != result->count)
+        return VECTOR_ERROR_SIZE;
+
+    const double_t *qw = q->w, *qx = q->x, *qy = q->y, *qz = q->z;
+    const double_t *px = points->x, *py = points->y, *pz = points->z;
+    double_t *rx = result->x, *ry = result->y, *rz = result->z;
+
+    for (size_t i = 0; i < points->count; i++) {
+        const double_t w = qw[i], x = qx[i], y = qy[i], z = qz[i];
+        const double_t vx = px[i], vy = py[i], vz = pz[i];
+
+        const double_t tx = 2.0 * (y * vz - z * vy);
+        const double_t ty = 2.0 * (z * vx - x * vz);
+        const double_t tz = 2.0 * (x * vy - y * vx);
+
+        rx[i] = vx + w * tx + (y * tz - z * ty);
+        ry[i] = vy + w * ty + (z * tx - x * tz);
+        rz[i] = vz + w * tz + (x * ty - y * tx);
+    }
+
+    return VECTOR_SUCCESS;
+}
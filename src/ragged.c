@@ -0,0 +1,626 @@
+/**
+ * @file ragged.c
+ * @brief Collections of variable-length vectors packed into one buffer
+ * @date 18/10/26
+ */
+
+#include "ragged.h"
+#include "pool.h"
+#include "simd.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RAGGED_TASK_WORK 32768 ///< Elements plus segments per parallel task
+#define RAGGED_CHUNK 32768 ///< Longer segments are reduced in chunks
+#define RAGGED_MIN_CAPACITY 16 ///< Smallest capacity a buffer grows to
+
+typedef enum {
+    SEGMENT_PACK,
+    SEGMENT_SUM,
+    SEGMENT_MEAN,
+    SEGMENT_NORM,
+    SEGMENT_DOT
+} SegmentKind;
+
+typedef struct {
+    SegmentKind kind;
+    const RaggedVectors *ragged;
+    const Vector *const *vectors; ///< Sources when packing
+    const double_t *query;
+    double_t *out;
+    size_t work;
+    size_t tasks;
+    bool split; ///< Segments longer than RAGGED_CHUNK are spread over tasks
+    const size_t *split_ids; ///< Those segments, ascending
+    const size_t *split_base; ///< First partial of each, split_count + 1
+    size_t split_count;
+    double_t *partials; ///< Chunk sums of split segments, in segment order
+} SegmentJob;
+
+bool ragged_valid(const RaggedVectors *ragged) {
+    return ragged != NULL && ragged->values != NULL &&
+           ragged->offsets != NULL;
+}
+
+// --- Storage ---
+
+static int alloc_ragged(size_t values_capacity,
+                        size_t count_capacity,
+                        bool zero,
+                        RaggedVectors **out_ragged) {
+    values_capacity = values_capacity ? values_capacity : 1;
+    if (values_capacity > SIZE_MAX / sizeof(double_t) ||
+        count_capacity >= SIZE_MAX / sizeof(size_t))
+        return VECTOR_ERROR_MEM;
+
+    RaggedVectors *ragged = malloc(sizeof(RaggedVectors));
+    if (!ragged)
+        return VECTOR_ERROR_MEM;
+
+    ragged->values = zero ? calloc(values_capacity, sizeof(double_t))
+                          : malloc(values_capacity * sizeof(double_t));
+    ragged->offsets = malloc((count_capacity + 1) * sizeof(size_t));
+    if (!ragged->values || !ragged->offsets) {
+        free(ragged->values);
+        free(ragged->offsets);
+        free(ragged);
+        return VECTOR_ERROR_MEM;
+    }
+
+    ragged->offsets[0] = 0;
+    ragged->count = 0;
+    ragged->values_capacity = values_capacity;
+    ragged->count_capacity = count_capacity;
+    *out_ragged = ragged;
+    return VECTOR_SUCCESS;
+}
+
+// Grow buffers geometrically to hold values elements and count segments
+static int reserve(RaggedVectors *ragged, size_t values, size_t count) {
+    if (values > ragged->values_capacity) {
+        size_t capacity = ragged->values_capacity * 2;
+        capacity = capacity < RAGGED_MIN_CAPACITY ? RAGGED_MIN_CAPACITY
+                                                  : capacity;
+        capacity = capacity < values ? values : capacity;
+        if (capacity > SIZE_MAX / sizeof(double_t))
+            return VECTOR_ERROR_MEM;
+
+        double_t *grown =
+            realloc(ragged->values, capacity * sizeof(double_t));
+        if (!grown)
+            return VECTOR_ERROR_MEM;
+        ragged->values = grown;
+        ragged->values_capacity = capacity;
+    }
+
+    if (count > ragged->count_capacity) {
+        size_t capacity = ragged->count_capacity * 2;
+        capacity = capacity < RAGGED_MIN_CAPACITY ? RAGGED_MIN_CAPACITY
+                                                  : capacity;
+        capacity = capacity < count ? count : capacity;
+        if (capacity >= SIZE_MAX / sizeof(size_t))
+            return VECTOR_ERROR_MEM;
+
+        size_t *grown =
+            realloc(ragged->offsets, (capacity + 1) * sizeof(size_t));
+        if (!grown)
+            return VECTOR_ERROR_MEM;
+        ragged->offsets = grown;
+        ragged->count_capacity = capacity;
+    }
+    return VECTOR_SUCCESS;
+}
+
+// Sum of lengths, or false on overflow
+static bool total_length(const size_t *lengths, size_t count, size_t *out) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (lengths[i] > SIZE_MAX - total)
+            return false;
+        total += lengths[i];
+    }
+    *out = total;
+    return true;
+}
+
+// --- Segment kernels ---
+
+/*
+ * Sum of x[i] * q[i] (or of x[i] when q is NULL) over eight lanes, lane
+ * i % 8 taking element i, combined in a fixed order
+ */
+static double_t segment_lanes(const double_t *x, const double_t *q, size_t n) {
+    double_t acc[8] = {0.0};
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    __m256d lo = _mm256_setzero_pd();
+    __m256d hi = _mm256_setzero_pd();
+    if (q) {
+        for (; i + 8 <= n; i += 8) {
+            lo = _mm256_add_pd(lo,
+                               _mm256_mul_pd(_mm256_loadu_pd(x + i),
+                                             _mm256_loadu_pd(q + i)));
+            hi = _mm256_add_pd(hi,
+                               _mm256_mul_pd(_mm256_loadu_pd(x + i + 4),
+                                             _mm256_loadu_pd(q + i + 4)));
+        }
+    } else {
+        for (; i + 8 <= n; i += 8) {
+            lo = _mm256_add_pd(lo, _mm256_loadu_pd(x + i));
+            hi = _mm256_add_pd(hi, _mm256_loadu_pd(x + i + 4));
+        }
+    }
+    _mm256_storeu_pd(acc, lo);
+    _mm256_storeu_pd(acc + 4, hi);
+#else
+    if (q) {
+        for (; i + 8 <= n; i += 8) {
+            for (size_t j = 0; j < 8; j++) {
+                acc[j] += x[i + j] * q[i + j];
+            }
+        }
+    } else {
+        for (; i + 8 <= n; i += 8) {
+            for (size_t j = 0; j < 8; j++) {
+                acc[j] += x[i + j];
+            }
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        acc[i & 7] += q ? x[i] * q[i] : x[i];
+    }
+    return ((acc[0] + acc[4]) + (acc[1] + acc[5])) +
+           ((acc[2] + acc[6]) + (acc[3] + acc[7]));
+}
+
+// First segment i whose work offsets[i] + i reaches target
+static size_t segment_at(const size_t *offsets, size_t count, size_t target) {
+    size_t lo = 0;
+    size_t hi = count;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (offsets[mid] + mid < target)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Second operand of the lane sums, offset to element first of segment x
+static const double_t *segment_operand(const SegmentJob *job,
+                                       const double_t *x,
+                                       size_t first) {
+    if (job->kind == SEGMENT_NORM)
+        return x;
+    return job->kind == SEGMENT_DOT ? job->query + first : NULL;
+}
+
+// Chunk sums added in order, whether or not the chunks ran on one thread
+static double_t segment_value(const SegmentJob *job,
+                              const double_t *x,
+                              size_t n) {
+    double_t value = 0.0;
+    for (size_t first = 0; first < n; first += RAGGED_CHUNK) {
+        const size_t length =
+            n - first < RAGGED_CHUNK ? n - first : RAGGED_CHUNK;
+        value += segment_lanes(x + first,
+                               segment_operand(job, x + first, first),
+                               length);
+    }
+    return value;
+}
+
+static double_t segment_finish(SegmentKind kind, double_t value, size_t n) {
+    switch (kind) {
+    case SEGMENT_MEAN:
+        return n ? value / (double_t)n : 0.0;
+    case SEGMENT_NORM:
+        return sqrt(value);
+    default:
+        return value;
+    }
+}
+
+/*
+ * Chunks of split segment i whose work position lies in [work_begin,
+ * work_end); chunk boundaries are fixed relative to the segment start
+ */
+static void segment_chunks(const SegmentJob *job,
+                           size_t i,
+                           size_t work_begin,
+                           size_t work_end) {
+    const RaggedVectors *ragged = job->ragged;
+    const size_t start = ragged->offsets[i] + i;
+    const size_t n = ragged->offsets[i + 1] - ragged->offsets[i];
+    double_t *x = ragged->values + ragged->offsets[i];
+
+    size_t chunk = work_begin > start
+                       ? (work_begin - start + RAGGED_CHUNK - 1) / RAGGED_CHUNK
+                       : 0;
+    double_t *partials = NULL;
+    if (job->kind != SEGMENT_PACK) {
+        size_t lo = 0;
+        size_t hi = job->split_count;
+        while (lo < hi) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (job->split_ids[mid] < i)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        partials = job->partials + job->split_base[lo];
+    }
+
+    for (; chunk * RAGGED_CHUNK < n &&
+           start + chunk * RAGGED_CHUNK < work_end;
+         chunk++) {
+        const size_t first = chunk * RAGGED_CHUNK;
+        const size_t length =
+            n - first < RAGGED_CHUNK ? n - first : RAGGED_CHUNK;
+        if (job->kind == SEGMENT_PACK) {
+            memcpy(x + first,
+                   job->vectors[i]->elements + first,
+                   length * sizeof(double_t));
+        } else {
+            partials[chunk] = segment_lanes(
+                x + first, segment_operand(job, x + first, first), length);
+        }
+    }
+}
+
+static void segment_range(const SegmentJob *job,
+                          size_t begin,
+                          size_t end,
+                          size_t work_end) {
+    const RaggedVectors *ragged = job->ragged;
+    const size_t *offsets = ragged->offsets;
+
+    for (size_t i = begin; i < end; i++) {
+        double_t *x = ragged->values + offsets[i];
+        const size_t n = offsets[i + 1] - offsets[i];
+
+        if (job->split && n > RAGGED_CHUNK) {
+            segment_chunks(job, i, 0, work_end);
+        } else if (job->kind == SEGMENT_PACK) {
+            if (n > 0)
+                memcpy(x, job->vectors[i]->elements, n * sizeof(double_t));
+        } else {
+            job->out[i] =
+                segment_finish(job->kind, segment_value(job, x, n), n);
+        }
+    }
+}
+
+/*
+ * Task boundaries split elements plus segments evenly. A task runs the
+ * segments starting in its share and the chunks of split segments that
+ * fall in it, including those of a segment started by an earlier task.
+ */
+static void segment_task(void *ctx, size_t task) {
+    const SegmentJob *job = ctx;
+    const RaggedVectors *ragged = job->ragged;
+    const size_t work_begin = task * job->work / job->tasks;
+    const size_t work_end = task + 1 == job->tasks
+                                ? job->work
+                                : (task + 1) * job->work / job->tasks;
+    const size_t begin =
+        task == 0 ? 0
+                  : segment_at(ragged->offsets, ragged->count, work_begin);
+    const size_t end =
+        task + 1 == job->tasks
+            ? ragged->count
+            : segment_at(ragged->offsets, ragged->count, work_end);
+
+    if (job->split && begin > 0 &&
+        ragged->offsets[begin] - ragged->offsets[begin - 1] > RAGGED_CHUNK)
+        segment_chunks(job, begin - 1, work_begin, work_end);
+    segment_range(job, begin, end, work_end);
+}
+
+// Spread split segments over the tasks, then add their chunks in order
+static int run_split_segments(SegmentJob *job,
+                              size_t split_count,
+                              size_t chunks) {
+    const RaggedVectors *ragged = job->ragged;
+    const size_t *offsets = ragged->offsets;
+    size_t *split_ids = malloc(split_count * sizeof(size_t));
+    size_t *split_base = malloc((split_count + 1) * sizeof(size_t));
+    double_t *partials = job->kind == SEGMENT_PACK
+                             ? NULL
+                             : malloc(chunks * sizeof(double_t));
+    if (!split_ids || !split_base ||
+        (!partials && job->kind != SEGMENT_PACK)) {
+        free(split_ids);
+        free(split_base);
+        free(partials);
+        return VECTOR_ERROR_MEM;
+    }
+
+    size_t k = 0;
+    split_base[0] = 0;
+    for (size_t i = 0; i < ragged->count; i++) {
+        const size_t n = offsets[i + 1] - offsets[i];
+        if (n > RAGGED_CHUNK) {
+            split_ids[k] = i;
+            split_base[k + 1] =
+                split_base[k] + (n + RAGGED_CHUNK - 1) / RAGGED_CHUNK;
+            k++;
+        }
+    }
+
+    job->split = true;
+    job->split_ids = split_ids;
+    job->split_base = split_base;
+    job->split_count = split_count;
+    job->partials = partials;
+    int err = pool_parallel_for(job->tasks, segment_task, job);
+
+    for (k = 0; partials && err == VECTOR_SUCCESS && k < split_count; k++) {
+        const size_t i = split_ids[k];
+        double_t value = 0.0;
+        for (size_t p = split_base[k]; p < split_base[k + 1]; p++) {
+            value += partials[p];
+        }
+        job->out[i] =
+            segment_finish(job->kind, value, offsets[i + 1] - offsets[i]);
+    }
+
+    free(split_ids);
+    free(split_base);
+    free(partials);
+    return err;
+}
+
+static int run_segments(SegmentJob *job) {
+    const RaggedVectors *ragged = job->ragged;
+    const size_t *offsets = ragged->offsets;
+    job->work = offsets[ragged->count] + ragged->count;
+    job->tasks = job->work / RAGGED_TASK_WORK;
+    if (job->tasks < 2) {
+        segment_range(job, 0, ragged->count, job->work);
+        return VECTOR_SUCCESS;
+    }
+
+    size_t split_count = 0;
+    size_t chunks = 0;
+    for (size_t i = 0; i < ragged->count; i++) {
+        const size_t n = offsets[i + 1] - offsets[i];
+        if (n > RAGGED_CHUNK) {
+            split_count++;
+            chunks += (n + RAGGED_CHUNK - 1) / RAGGED_CHUNK;
+        }
+    }
+    if (split_count > 0)
+        return run_split_segments(job, split_count, chunks);
+    return pool_parallel_for(job->tasks, segment_task, job);
+}
+
+// --- Initialization ---
+
+int ragged_create(size_t values_capacity,
+                  size_t count_capacity,
+                  RaggedVectors **out_ragged) {
+    if (!out_ragged)
+        return VECTOR_ERROR_NULL;
+
+    return alloc_ragged(values_capacity, count_capacity, false, out_ragged);
+}
+
+int ragged_from_lengths(const size_t *lengths,
+                        size_t count,
+                        RaggedVectors **out_ragged) {
+    if ((!lengths && count > 0) || !out_ragged)
+        return VECTOR_ERROR_NULL;
+
+    size_t total = 0;
+    if (!total_length(lengths, count, &total))
+        return VECTOR_ERROR_MEM;
+
+    RaggedVectors *ragged = NULL;
+    int err = alloc_ragged(total, count, true, &ragged);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    for (size_t i = 0; i < count; i++) {
+        ragged->offsets[i + 1] = ragged->offsets[i] + lengths[i];
+    }
+    ragged->count = count;
+    *out_ragged = ragged;
+    return VECTOR_SUCCESS;
+}
+
+int ragged_from_vectors(const Vector *const *vectors,
+                        size_t count,
+                        RaggedVectors **out_ragged) {
+    if ((!vectors && count > 0) || !out_ragged)
+        return VECTOR_ERROR_NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (!vectors[i])
+            return VECTOR_ERROR_NULL;
+    }
+    // Empty vectors have no elements buffer, they become empty segments
+    for (size_t i = 0; i < count; i++) {
+        if (vectors[i]->size > 0 && !vector_valid(vectors[i]))
+            return VECTOR_ERROR_INIT;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (vectors[i]->size > SIZE_MAX - total)
+            return VECTOR_ERROR_MEM;
+        total += vectors[i]->size;
+    }
+
+    RaggedVectors *ragged = NULL;
+    int err = alloc_ragged(total, count, false, &ragged);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    for (size_t i = 0; i < count; i++) {
+        ragged->offsets[i + 1] = ragged->offsets[i] + vectors[i]->size;
+    }
+    ragged->count = count;
+
+    SegmentJob job = {
+        .kind = SEGMENT_PACK,
+        .ragged = ragged,
+        .vectors = vectors,
+    };
+    err = run_segments(&job);
+    if (err != VECTOR_SUCCESS) {
+        ragged_free(ragged);
+        return err;
+    }
+
+    *out_ragged = ragged;
+    return VECTOR_SUCCESS;
+}
+
+int ragged_free(RaggedVectors *ragged) {
+    if (!ragged)
+        return VECTOR_ERROR_NULL;
+
+    free(ragged->values);
+    free(ragged->offsets);
+    free(ragged);
+    return VECTOR_SUCCESS;
+}
+
+// --- Building ---
+
+int ragged_append(RaggedVectors *ragged,
+                  const double_t *values,
+                  size_t length) {
+    return ragged_append_segments(ragged, values, &length, 1);
+}
+
+int ragged_append_segments(RaggedVectors *ragged,
+                           const double_t *values,
+                           const size_t *lengths,
+                           size_t count) {
+    if (!ragged || (!lengths && count > 0))
+        return VECTOR_ERROR_NULL;
+    if (!ragged_valid(ragged))
+        return VECTOR_ERROR_INIT;
+
+    size_t total = 0;
+    if (!total_length(lengths, count, &total))
+        return VECTOR_ERROR_MEM;
+    if (!values && total > 0)
+        return VECTOR_ERROR_NULL;
+
+    const size_t used = ragged->offsets[ragged->count];
+    if (total > SIZE_MAX - used || count > SIZE_MAX - ragged->count)
+        return VECTOR_ERROR_MEM;
+
+    // values may point into the collection itself, which reserve() can
+    // move, so it is tracked as an offset across the growth
+    const uintptr_t base = (uintptr_t)ragged->values;
+    const uintptr_t source = (uintptr_t)values;
+    const bool aliased =
+        source >= base &&
+        source < base + ragged->values_capacity * sizeof(double_t);
+    const size_t source_offset = aliased ? (size_t)(values - ragged->values)
+                                         : 0;
+
+    int err = reserve(ragged, used + total, ragged->count + count);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    if (aliased)
+        values = ragged->values + source_offset;
+    if (total > 0)
+        memmove(ragged->values + used, values, total * sizeof(double_t));
+    size_t *offsets = ragged->offsets + ragged->count;
+    for (size_t i = 0; i < count; i++) {
+        offsets[i + 1] = offsets[i] + lengths[i];
+    }
+    ragged->count += count;
+    return VECTOR_SUCCESS;
+}
+
+// --- Access ---
+
+int ragged_segment(const RaggedVectors *ragged,
+                   size_t index,
+                   VectorView *out_view) {
+    if (!ragged || !out_view)
+        return VECTOR_ERROR_NULL;
+    if (!ragged_valid(ragged))
+        return VECTOR_ERROR_INIT;
+    if (index >= ragged->count)
+        return VECTOR_ERROR_INDEX;
+
+    out_view->elements = ragged->values + ragged->offsets[index];
+    out_view->size = ragged->offsets[index + 1] - ragged->offsets[index];
+    return VECTOR_SUCCESS;
+}
+
+int ragged_segment_data(RaggedVectors *ragged,
+                        size_t index,
+                        double_t **out_data,
+                        size_t *out_length) {
+    if (!ragged || !out_data || !out_length)
+        return VECTOR_ERROR_NULL;
+    if (!ragged_valid(ragged))
+        return VECTOR_ERROR_INIT;
+    if (index >= ragged->count)
+        return VECTOR_ERROR_INDEX;
+
+    *out_data = ragged->values + ragged->offsets[index];
+    *out_length = ragged->offsets[index + 1] - ragged->offsets[index];
+    return VECTOR_SUCCESS;
+}
+
+// --- Segment reductions ---
+
+static int reduce_segments(const RaggedVectors *ragged,
+                           const Vector *query,
+                           Vector *result,
+                           SegmentKind kind) {
+    if (!ragged || !result || (kind == SEGMENT_DOT && !query))
+        return VECTOR_ERROR_NULL;
+    if (!ragged_valid(ragged) || !vector_valid(result) ||
+        (query && !vector_valid(query)))
+        return VECTOR_ERROR_INIT;
+    if (result->size != ragged->count)
+        return VECTOR_ERROR_SIZE;
+
+    if (query) {
+        for (size_t i = 0; i < ragged->count; i++) {
+            if (ragged->offsets[i + 1] - ragged->offsets[i] > query->size)
+                return VECTOR_ERROR_SIZE;
+        }
+    }
+
+    SegmentJob job = {
+        .kind = kind,
+        .ragged = ragged,
+        .query = query ? query->elements : NULL,
+        .out = result->elements,
+    };
+    return run_segments(&job);
+}
+
+int ragged_sum(const RaggedVectors *ragged, Vector *result) {
+    return reduce_segments(ragged, NULL, result, SEGMENT_SUM);
+}
+
+int ragged_mean(const RaggedVectors *ragged, Vector *result) {
+    return reduce_segments(ragged, NULL, result, SEGMENT_MEAN);
+}
+
+int ragged_norm(const RaggedVectors *ragged, Vector *result) {
+    return reduce_segments(ragged, NULL, result, SEGMENT_NORM);
+}
+
+int ragged_dot(const RaggedVectors *ragged,
+               const Vector *query,
+               Vector *result) {
+    return reduce_segments(ragged, query, result, SEGMENT_DOT);
+}
@@ -0,0 +1,656 @@
+/**
+ * @file reduce.c
+ * @brief Reductions along one axis of matrices, arrays and vector batches
+ * @date 18/10/26
+ */
+
+#include "reduce.h"
+#include "pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define REDUCE_TASK_ELEMENTS 32768 ///< Target elements read per task
+#define REDUCE_BLOCK 1024 ///< Columns accumulated together when streaming
+#define REDUCE_TARGET_TASKS 64 ///< Split the axis until this many tasks
+#define REDUCE_PARALLEL_MIN 65536 ///< Elements below which threads do not pay
+
+/*
+ * Reduction of n rows spaced stride apart. In streaming layout each row
+ * holds inner contiguous outputs, repeated over the outer dimensions, and
+ * rows are accumulated whole. Otherwise every output is reduced
+ * separately, its start found from the remaining dimensions.
+ */
+typedef struct {
+    NumenReduceOp op;
+    const double_t *data;
+    const double_t *const *rows; ///< Row starts for batches, else NULL
+    size_t n;
+    ptrdiff_t stride;
+    bool streaming;
+    size_t ndim; ///< Outer dimensions when streaming, all others if not
+    size_t shape[NDARRAY_MAX_DIMS];
+    ptrdiff_t strides[NDARRAY_MAX_DIMS];
+    size_t inner; ///< Contiguous outputs per row, 1 unless streaming
+    size_t outputs;
+
+    // Task decomposition: units of columns or outputs, times row chunks
+    size_t width;
+    size_t blocks;
+    size_t units;
+    size_t chunk_rows;
+    size_t chunks;
+
+    double_t *values; ///< chunks x outputs partial results
+    size_t *indices; ///< chunks x outputs argmax rows, NULL if not wanted
+} ReduceJob;
+
+// Drop extent-1 dimensions and merge contiguous neighbours, in place
+static size_t coalesce(size_t ndim, size_t *shape, ptrdiff_t *strides) {
+    size_t out = 0;
+    for (size_t d = 0; d < ndim; d++) {
+        if (shape[d] == 1)
+            continue;
+        if (out > 0 &&
+            strides[out - 1] == strides[d] * (ptrdiff_t)shape[d]) {
+            shape[out - 1] *= shape[d];
+            strides[out - 1] = strides[d];
+            continue;
+        }
+        shape[out] = shape[d];
+        strides[out] = strides[d];
+        out++;
+    }
+    return out;
+}
+
+static ptrdiff_t offset_of(const ReduceJob *job, size_t index) {
+    ptrdiff_t offset = 0;
+    for (size_t d = job->ndim; d-- > 0;) {
+        offset += (ptrdiff_t)(index % job->shape[d]) * job->strides[d];
+        index /= job->shape[d];
+    }
+    return offset;
+}
+
+static inline double_t min_skip_nan(double_t acc, double_t x) {
+    return (x < acc || acc != acc) ? x : acc;
+}
+
+static inline double_t max_skip_nan(double_t acc, double_t x) {
+    return (x > acc || acc != acc) ? x : acc;
+}
+
+static inline bool beats_max(double_t acc, double_t x) {
+    return x > acc || (acc != acc && x == x);
+}
+
+// --- Kernels ---
+
+// Accumulate rows [r0, r1) of columns [q0, q0 + w) of outer position p
+static void reduce_streaming(const ReduceJob *job,
+                             size_t p,
+                             size_t q0,
+                             size_t w,
+                             size_t r0,
+                             size_t r1,
+                             double_t *acc,
+                             size_t *index) {
+    const double_t *base = job->rows ? NULL : job->data + offset_of(job, p);
+#define ROW(r) \
+    ((job->rows ? job->rows[r] : base + (ptrdiff_t)(r) * job->stride) + q0)
+
+    const double_t *row = ROW(r0);
+    if (job->op == NUMEN_REDUCE_NORM) {
+        for (size_t j = 0; j < w; j++) {
+            acc[j] = row[j] * row[j];
+        }
+    } else {
+        memcpy(acc, row, w * sizeof(double_t));
+    }
+    if (index) {
+        for (size_t j = 0; j < w; j++) {
+            index[j] = r0;
+        }
+    }
+
+    for (size_t r = r0 + 1; r < r1; r++) {
+        row = ROW(r);
+        if (index) {
+            for (size_t j = 0; j < w; j++) {
+                if (beats_max(acc[j], row[j])) {
+                    acc[j] = row[j];
+                    index[j] = r;
+                }
+            }
+            continue;
+        }
+
+        switch (job->op) {
+        case NUMEN_REDUCE_SUM:
+        case NUMEN_REDUCE_MEAN:
+            for (size_t j = 0; j < w; j++) {
+                acc[j] += row[j];
+            }
+            break;
+        case NUMEN_REDUCE_NORM:
+            for (size_t j = 0; j < w; j++) {
+                acc[j] += row[j] * row[j];
+            }
+            break;
+        case NUMEN_REDUCE_MIN:
+            for (size_t j = 0; j < w; j++) {
+                acc[j] = min_skip_nan(acc[j], row[j]);
+            }
+            break;
+        case NUMEN_REDUCE_MAX:
+            for (size_t j = 0; j < w; j++) {
+                acc[j] = max_skip_nan(acc[j], row[j]);
+            }
+            break;
+        }
+    }
+#undef ROW
+}
+
+// Reduce x[r * stride] for r in [r0, r1)
+static void reduce_run(const ReduceJob *job,
+                       const double_t *x,
+                       size_t r0,
+                       size_t r1,
+                       double_t *out_val,
+                       size_t *out_index) {
+    const ptrdiff_t s = job->stride;
+
+    if (out_index) {
+        double_t best = x[(ptrdiff_t)r0 * s];
+        size_t at = r0;
+        for (size_t r = r0 + 1; r < r1; r++) {
+            if (beats_max(best, x[(ptrdiff_t)r * s])) {
+                best = x[(ptrdiff_t)r * s];
+                at = r;
+            }
+        }
+        *out_val = best;
+        *out_index = at;
+        return;
+    }
+
+    switch (job->op) {
+    case NUMEN_REDUCE_SUM:
+    case NUMEN_REDUCE_MEAN:
+    case NUMEN_REDUCE_NORM: {
+        const bool square = job->op == NUMEN_REDUCE_NORM;
+        double_t s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        size_t r = r0;
+        for (; r + 3 < r1; r += 4) {
+            const double_t x0 = x[(ptrdiff_t)r * s];
+            const double_t x1 = x[(ptrdiff_t)(r + 1) * s];
+            const double_t x2 = x[(ptrdiff_t)(r + 2) * s];
+            const double_t x3 = x[(ptrdiff_t)(r + 3) * s];
+            s0 += square ? x0 * x0 : x0;
+            s1 += square ? x1 * x1 : x1;
+            s2 += square ? x2 * x2 : x2;
+            s3 += square ? x3 * x3 : x3;
+        }
+        for (; r < r1; r++) {
+            const double_t xr = x[(ptrdiff_t)r * s];
+            s0 += square ? xr * xr : xr;
+        }
+        *out_val = (s0 + s1) + (s2 + s3);
+        break;
+    }
+    case NUMEN_REDUCE_MIN: {
+        double_t acc = x[(ptrdiff_t)r0 * s];
+        for (size_t r = r0 + 1; r < r1; r++) {
+            acc = min_skip_nan(acc, x[(ptrdiff_t)r * s]);
+        }
+        *out_val = acc;
+        break;
+    }
+    case NUMEN_REDUCE_MAX: {
+        double_t acc = x[(ptrdiff_t)r0 * s];
+        for (size_t r = r0 + 1; r < r1; r++) {
+            acc = max_skip_nan(acc, x[(ptrdiff_t)r * s]);
+        }
+        *out_val = acc;
+        break;
+    }
+    }
+}
+
+static void reduce_task(void *ctx, size_t task) {
+    const ReduceJob *job = ctx;
+    const size_t chunk = task / job->units;
+    const size_t unit = task % job->units;
+    const size_t r0 = chunk * job->chunk_rows;
+    const size_t r1 =
+        r0 + job->chunk_rows < job->n ? r0 + job->chunk_rows : job->n;
+    double_t *values = job->values + chunk * job->outputs;
+    size_t *indices = job->indices ? job->indices + chunk * job->outputs
+                                   : NULL;
+
+    if (job->streaming) {
+        const size_t p = unit / job->blocks;
+        const size_t q0 = (unit % job->blocks) * job->width;
+        const size_t w =
+            q0 + job->width < job->inner ? job->width : job->inner - q0;
+        const size_t o = p * job->inner + q0;
+        reduce_streaming(job,
+                         p,
+                         q0,
+                         w,
+                         r0,
+                         r1,
+                         values + o,
+                         indices ? indices + o : NULL);
+        return;
+    }
+
+    const size_t o0 = unit * job->width;
+    const size_t o1 =
+        o0 + job->width < job->outputs ? o0 + job->width : job->outputs;
+    for (size_t o = o0; o < o1; o++) {
+        reduce_run(job,
+                   job->data + offset_of(job, o),
+                   r0,
+                   r1,
+                   values + o,
+                   indices ? indices + o : NULL);
+    }
+}
+
+// --- Driver ---
+
+static void plan_tasks(ReduceJob *job) {
+    size_t min_rows;
+    if (job->streaming) {
+        job->width = job->inner < REDUCE_BLOCK ? job->inner : REDUCE_BLOCK;
+        job->blocks = (job->inner + job->width - 1) / job->width;
+        job->units = (job->outputs / job->inner) * job->blocks;
+        min_rows = REDUCE_TASK_ELEMENTS / job->width;
+    } else {
+        job->width = REDUCE_TASK_ELEMENTS / job->n;
+        job->width = job->width == 0 ? 1 : job->width;
+        job->blocks = (job->outputs + job->width - 1) / job->width;
+        job->units = job->blocks;
+        min_rows = REDUCE_TASK_ELEMENTS;
+    }
+    min_rows = min_rows == 0 ? 1 : min_rows;
+
+    // Split the reduced axis only when there are too few units to share
+    size_t wanted = 1;
+    if (job->units < REDUCE_TARGET_TASKS)
+        wanted = (REDUCE_TARGET_TASKS + job->units - 1) / job->units;
+    size_t rows = (job->n + wanted - 1) / wanted;
+    job->chunk_rows = rows > min_rows ? rows : min_rows;
+    job->chunks = (job->n + job->chunk_rows - 1) / job->chunk_rows;
+}
+
+/*
+ * Run a prepared job into values (and indices for argmax), one per output
+ * in row-major order. Chunks are combined in order and the result
+ * finalized in the first chunk's slot.
+ */
+static int reduce_execute(ReduceJob *job, double_t *values, size_t *indices) {
+    plan_tasks(job);
+
+    job->values = values;
+    job->indices = indices;
+    double_t *scratch = NULL;
+    size_t *scratch_indices = NULL;
+    if (job->chunks > 1) {
+        scratch = malloc(job->chunks * job->outputs * sizeof(double_t));
+        if (indices)
+            scratch_indices = malloc(job->chunks * job->outputs *
+                                     sizeof(size_t));
+        if (!scratch || (indices && !scratch_indices)) {
+            free(scratch);
+            free(scratch_indices);
+            return VECTOR_ERROR_MEM;
+        }
+        job->values = scratch;
+        job->indices = scratch_indices;
+    }
+
+    const size_t tasks = job->chunks * job->units;
+    if (job->outputs * job->n < REDUCE_PARALLEL_MIN || tasks < 2) {
+        for (size_t t = 0; t < tasks; t++) {
+            reduce_task(job, t);
+        }
+    } else {
+        int err = pool_parallel_for(tasks, reduce_task, job);
+        if (err != VECTOR_SUCCESS) {
+            free(scratch);
+            free(scratch_indices);
+            return err;
+        }
+    }
+
+    if (job->chunks > 1) {
+        memcpy(values, scratch, job->outputs * sizeof(double_t));
+        if (indices)
+            memcpy(indices, scratch_indices, job->outputs * sizeof(size_t));
+
+        for (size_t c = 1; c < job->chunks; c++) {
+            const double_t *part = scratch + c * job->outputs;
+            const size_t *part_indices =
+                indices ? scratch_indices + c * job->outputs : NULL;
+            for (size_t o = 0; o < job->outputs; o++) {
+                if (indices) {
+                    if (beats_max(values[o], part[o])) {
+                        values[o] = part[o];
+                        indices[o] = part_indices[o];
+                    }
+                    continue;
+                }
+                switch (job->op) {
+                case NUMEN_REDUCE_SUM:
+                case NUMEN_REDUCE_MEAN:
+                case NUMEN_REDUCE_NORM:
+                    values[o] += part[o];
+                    break;
+                case NUMEN_REDUCE_MIN:
+                    values[o] = min_skip_nan(values[o], part[o]);
+                    break;
+                case NUMEN_REDUCE_MAX:
+                    values[o] = max_skip_nan(values[o], part[o]);
+                    break;
+                }
+            }
+        }
+        free(scratch);
+        free(scratch_indices);
+    }
+
+    if (!indices && job->op == NUMEN_REDUCE_MEAN) {
+        const double_t scale = 1.0 / (double_t)job->n;
+        for (size_t o = 0; o < job->outputs; o++) {
+            values[o] *= scale;
+        }
+    } else if (!indices && job->op == NUMEN_REDUCE_NORM) {
+        for (size_t o = 0; o < job->outputs; o++) {
+            values[o] = sqrt(values[o]);
+        }
+    }
+    return VECTOR_SUCCESS;
+}
+
+static bool valid_op(NumenReduceOp op) {
+    return op == NUMEN_REDUCE_SUM || op == NUMEN_REDUCE_MEAN ||
+           op == NUMEN_REDUCE_MIN || op == NUMEN_REDUCE_MAX ||
+           op == NUMEN_REDUCE_NORM;
+}
+
+// Lay out a reduction of array along axis
+static void setup_array(ReduceJob *job,
+                        const NdArray *array,
+                        size_t axis,
+                        NumenReduceOp op) {
+    memset(job, 0, sizeof(ReduceJob));
+    job->op = op;
+    job->data = array->data;
+    job->n = array->shape[axis];
+    job->stride = array->strides[axis];
+    job->outputs = ndarray_size(array) / job->n;
+    job->inner = 1;
+
+    // Streaming pays when what follows axis is one contiguous run
+    size_t inner_shape[NDARRAY_MAX_DIMS];
+    ptrdiff_t inner_strides[NDARRAY_MAX_DIMS];
+    const size_t inner_ndim = array->ndim - axis - 1;
+    memcpy(inner_shape,
+           array->shape + axis + 1,
+           inner_ndim * sizeof(size_t));
+    memcpy(inner_strides,
+           array->strides + axis + 1,
+           inner_ndim * sizeof(ptrdiff_t));
+    if (coalesce(inner_ndim, inner_shape, inner_strides) == 1 &&
+        inner_strides[0] == 1) {
+        job->streaming = true;
+        job->inner = inner_shape[0];
+    }
+
+    for (size_t d = 0; d < array->ndim; d++) {
+        if (d == axis || (job->streaming && d > axis))
+            continue;
+        job->shape[job->ndim] = array->shape[d];
+        job->strides[job->ndim] = array->strides[d];
+        job->ndim++;
+    }
+    job->ndim = coalesce(job->ndim, job->shape, job->strides);
+}
+
+static int check_array(const NdArray *array, size_t axis) {
+    if (!ndarray_valid(array))
+        return VECTOR_ERROR_INIT;
+    if (axis >= array->ndim)
+        return VECTOR_ERROR_INVALID_ARG;
+    return VECTOR_SUCCESS;
+}
+
+// --- Arrays ---
+
+int ndarray_reduce(const NdArray *array,
+                   size_t axis,
+                   NumenReduceOp op,
+                   NdArray *result) {
+    if (!array || !result)
+        return VECTOR_ERROR_NULL;
+    int err = check_array(array, axis);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    if (!ndarray_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (!valid_op(op))
+        return VECTOR_ERROR_INVALID_ARG;
+
+    // Result shape is array's without axis, or with axis of extent 1
+    NdArray out = {0};
+    out.ndim = array->ndim;
+    memcpy(out.shape, array->shape, array->ndim * sizeof(size_t));
+    out.shape[axis] = 1;
+    if (result->ndim == array->ndim) {
+        if (memcmp(result->shape, out.shape, out.ndim * sizeof(size_t)))
+            return VECTOR_ERROR_SIZE;
+    } else if (result->ndim + 1 == array->ndim) {
+        memmove(out.shape + axis,
+                out.shape + axis + 1,
+                (out.ndim - axis - 1) * sizeof(size_t));
+        out.ndim--;
+        if (memcmp(result->shape, out.shape, out.ndim * sizeof(size_t)))
+            return VECTOR_ERROR_SIZE;
+    } else {
+        return VECTOR_ERROR_SIZE;
+    }
+
+    ReduceJob job;
+    setup_array(&job, array, axis, op);
+
+    // Reduce into a contiguous buffer, then copy out through result's
+    // strides so result may alias array
+    NdArray values = *result;
+    values.owned = NULL;
+    values.data = malloc(job.outputs * sizeof(double_t));
+    if (!values.data)
+        return VECTOR_ERROR_MEM;
+    ptrdiff_t stride = 1;
+    for (size_t d = values.ndim; d-- > 0;) {
+        values.strides[d] = stride;
+        stride *= (ptrdiff_t)values.shape[d];
+    }
+
+    err = reduce_execute(&job, values.data, NULL);
+    if (err == VECTOR_SUCCESS)
+        err = ndarray_copy(&values, result);
+    free(values.data);
+    return err;
+}
+
+int ndarray_argmax(const NdArray *array, size_t axis, size_t *indices) {
+    if (!array || !indices)
+        return VECTOR_ERROR_NULL;
+    int err = check_array(array, axis);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    ReduceJob job;
+    setup_array(&job, array, axis, NUMEN_REDUCE_MAX);
+
+    double_t *values = malloc(job.outputs * sizeof(double_t));
+    if (!values)
+        return VECTOR_ERROR_MEM;
+    err = reduce_execute(&job, values, indices);
+    free(values);
+    return err;
+}
+
+// --- Matrices ---
+
+static int matrix_setup(const Matrix *matrix,
+                        size_t axis,
+                        NumenReduceOp op,
+                        ReduceJob *job) {
+    if (!matrix_valid(matrix))
+        return VECTOR_ERROR_INIT;
+    if (axis > 1)
+        return VECTOR_ERROR_INVALID_ARG;
+
+    NdArray view;
+    int err = ndarray_from_matrix(matrix, &view);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    setup_array(job, &view, axis, op);
+    return VECTOR_SUCCESS;
+}
+
+int matrix_reduce(const Matrix *matrix,
+                  size_t axis,
+                  NumenReduceOp op,
+                  Vector *result) {
+    if (!matrix || !result)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (!valid_op(op))
+        return VECTOR_ERROR_INVALID_ARG;
+
+    ReduceJob job;
+    int err = matrix_setup(matrix, axis, op, &job);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    if (result->size != job.outputs)
+        return VECTOR_ERROR_SIZE;
+
+    // Chunk partials live in scratch, result is written once at the end
+    return reduce_execute(&job, result->elements, NULL);
+}
+
+int matrix_argmax(const Matrix *matrix, size_t axis, size_t *indices) {
+    if (!matrix || !indices)
+        return VECTOR_ERROR_NULL;
+
+    ReduceJob job;
+    int err = matrix_setup(matrix, axis, NUMEN_REDUCE_MAX, &job);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    double_t *values = malloc(job.outputs * sizeof(double_t));
+    if (!values)
+        return VECTOR_ERROR_MEM;
+    err = reduce_execute(&job, values, indices);
+    free(values);
+    return err;
+}
+
+// --- Vector batches ---
+
+static int check_batch(const Vector *const *vectors, size_t count) {
+    if (!vectors)
+        return VECTOR_ERROR_NULL;
+    for (size_t i = 0; i < count; i++) {
+        if (!vectors[i])
+            return VECTOR_ERROR_NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!vector_valid(vectors[i]))
+            return VECTOR_ERROR_INIT;
+    }
+    if (count == 0 || vectors[0]->size == 0)
+        return VECTOR_ERROR_SIZE;
+    for (size_t i = 1; i < count; i++) {
+        if (vectors[i]->size != vectors[0]->size)
+            return VECTOR_ERROR_SIZE;
+    }
+    return VECTOR_SUCCESS;
+}
+
+// Each vector is one row of a streaming reduction
+static int batch_execute(const Vector *const *vectors,
+                         size_t count,
+                         NumenReduceOp op,
+                         double_t *values,
+                         size_t *indices) {
+    const double_t **rows = malloc(count * sizeof(double_t *));
+    if (!rows)
+        return VECTOR_ERROR_MEM;
+    for (size_t i = 0; i < count; i++) {
+        rows[i] = vectors[i]->elements;
+    }
+
+    ReduceJob job;
+    memset(&job, 0, sizeof(ReduceJob));
+    job.op = op;
+    job.rows = rows;
+    job.n = count;
+    job.streaming = true;
+    job.inner = vectors[0]->size;
+    job.outputs = vectors[0]->size;
+
+    int err = reduce_execute(&job, values, indices);
+    free(rows);
+    return err;
+}
+
+int vector_batch_reduce(const Vector *const *vectors,
+                        size_t count,
+                        NumenReduceOp op,
+                        Vector *result) {
+    if (!result)
+        return VECTOR_ERROR_NULL;
+    int err = check_batch(vectors, count);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    if (!vector_valid(result))
+        return VECTOR_ERROR_INIT;
+    if (result->size != vectors[0]->size)
+        return VECTOR_ERROR_SIZE;
+    if (!valid_op(op))
+        return VECTOR_ERROR_INVALID_ARG;
+
+    // result may be one of the vectors, so partials never go through it
+    double_t *values = malloc(result->size * sizeof(double_t));
+    if (!values)
+        return VECTOR_ERROR_MEM;
+    err = batch_execute(vectors, count, op, values, NULL);
+    if (err == VECTOR_SUCCESS)
+        memcpy(result->elements, values, result->size * sizeof(double_t));
+    free(values);
+    return err;
+}
+
+int vector_batch_argmax(const Vector *const *vectors,
+                        size_t count,
+                        size_t *indices) {
+    if (!indices)
+        return VECTOR_ERROR_NULL;
+    int err = check_batch(vectors, count);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    double_t *values = malloc(vectors[0]->size * sizeof(double_t));
+    if (!values)
+        return VECTOR_ERROR_MEM;
+    err = batch_execute(vectors, count, NUMEN_REDUCE_MAX, values, indices);
+    free(values);
+    return err;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file simd.h
+ * @brief Internal SIMD helpers shared by kernels
+ * @date 18/10/26
+ *
+ * Intrinsic paths are only compiled in when the compiler targets the
+ * instruction set (e.g. with NUMEN_NATIVE=ON), every kernel keeps a
+ * portable fallback.
+ */
+
+#ifndef __SIMD_H
+#define __SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Count set bits of a 64-bit word
+ */
+static inline unsigned simd_popcount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_popcountll(word);
+#else
+    unsigned count = 0;
+    while (word) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Index of lowest set bit of a non-zero 64-bit word
+ */
+static inline unsigned simd_ctz64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(word);
+#else
+    unsigned index = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+/**
+ * @brief Index of highest set bit of a non-zero 64-bit word
+ */
+static inline unsigned simd_log2_64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - (unsigned)__builtin_clzll(word);
+#else
+    unsigned index = 0;
+    while (word >>= 1) {
+        index++;
+    }
+    return index;
+#endif
+}
+
+/**
+ * @brief Mask with the low n bits set (n <= 64)
+ */
+static inline uint64_t simd_low_bits(size_t n) {
+    return n >= 64 ? ~(uint64_t)0 : (((uint64_t)1 << n) - 1);
+}
+
+#if defined(__AVX2__)
+/**
+ * @brief Transpose a 4x4 block of doubles held in four rows
+ */
+static inline void simd_transpose4x4_pd(__m256d *r0,
+                                        __m256d *r1,
+                                        __m256d *r2,
+                                        __m256d *r3) {
+    __m256d t0 = _mm256_unpacklo_pd(*r0, *r1); // a0 b0 a2 b2
+    __m256d t1 = _mm256_unpackhi_pd(*r0, *r1); // a1 b1 a3 b3
+    __m256d t2 = _mm256_unpacklo_pd(*r2, *r3); // c0 d0 c2 d2
+    __m256d t3 = _mm256_unpackhi_pd(*r2, *r3); // c1 d1 c3 d3
+    *r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+    *r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+    *r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+    *r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+#endif
+
+#endif // !__SIMD_H
@@ -0,0 +1,285 @@
+/**
+ * @file snapshot.c
+ * @brief Read-mostly vectors with lock-free snapshot reads
+ * @date 18/10/26
+ */
+
+#include "snapshot.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define SNAPSHOT_IDLE UINT64_MAX ///< Reader epoch when no snapshot is held
+
+typedef struct SnapshotVersion {
+    Vector *vector;
+    uint64_t version;
+    uint64_t retired_at; ///< Global epoch when it was replaced
+    struct SnapshotVersion *next; ///< Next retired version
+} SnapshotVersion;
+
+struct NumenSnapshotReader {
+    NumenSnapshot *snapshot;
+    _Atomic uint64_t epoch; ///< Epoch observed on acquire, or SNAPSHOT_IDLE
+    atomic_bool in_use; ///< Registered to a thread, records are recycled
+    struct NumenSnapshotReader *next;
+};
+
+struct NumenSnapshot {
+    _Atomic(SnapshotVersion *) current;
+    _Atomic uint64_t epoch;
+    _Atomic(NumenSnapshotReader *) readers; ///< Push-only list
+
+    pthread_mutex_t write_lock; ///< Serializes writers, never taken by readers
+    SnapshotVersion *retired;
+    uint64_t next_version;
+};
+
+// --- Versions ---
+
+static int version_create(Vector *vector,
+                          uint64_t version,
+                          SnapshotVersion **out_version) {
+    SnapshotVersion *entry = malloc(sizeof(SnapshotVersion));
+    if (!entry)
+        return VECTOR_ERROR_MEM;
+
+    entry->vector = vector;
+    entry->version = version;
+    entry->retired_at = 0;
+    entry->next = NULL;
+
+    *out_version = entry;
+    return VECTOR_SUCCESS;
+}
+
+static void version_free(SnapshotVersion *entry) {
+    vector_free(entry->vector);
+    free(entry);
+}
+
+// Oldest epoch a reader may still be running in, SNAPSHOT_IDLE if none
+static uint64_t min_reader_epoch(NumenSnapshot *snapshot) {
+    uint64_t min_epoch = SNAPSHOT_IDLE;
+
+    for (NumenSnapshotReader *reader = atomic_load(&snapshot->readers); reader;
+         reader = reader->next) {
+        uint64_t epoch = atomic_load(&reader->epoch);
+        if (epoch < min_epoch)
+            min_epoch = epoch;
+    }
+    return min_epoch;
+}
+
+/*
+ * A reader announces its epoch before loading the current version, and the
+ * writer replaces the version before advancing the epoch. A reader that
+ * could have loaded a version retired at epoch e therefore announced an
+ * epoch <= e, so versions retired before every announced epoch are free.
+ */
+static size_t reclaim_locked(NumenSnapshot *snapshot) {
+    const uint64_t min_epoch = min_reader_epoch(snapshot);
+
+    size_t pending = 0;
+    SnapshotVersion **link = &snapshot->retired;
+    while (*link) {
+        SnapshotVersion *entry = *link;
+        if (entry->retired_at < min_epoch) {
+            *link = entry->next;
+            version_free(entry);
+        } else {
+            link = &entry->next;
+            pending++;
+        }
+    }
+    return pending;
+}
+
+// --- Handle ---
+
+int numen_snapshot_create(const Vector *initial, NumenSnapshot **out_snapshot) {
+    if (!initial || !out_snapshot)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(initial))
+        return VECTOR_ERROR_INIT;
+
+    NumenSnapshot *snapshot = malloc(sizeof(NumenSnapshot));
+    if (!snapshot)
+        return VECTOR_ERROR_MEM;
+
+    Vector *copy = NULL;
+    int err = vector_from_array(initial->elements, initial->size, &copy);
+    if (err != VECTOR_SUCCESS) {
+        free(snapshot);
+        return err;
+    }
+
+    SnapshotVersion *entry = NULL;
+    err = version_create(copy, 0, &entry);
+    if (err != VECTOR_SUCCESS) {
+        vector_free(copy);
+        free(snapshot);
+        return err;
+    }
+
+    atomic_init(&snapshot->current, entry);
+    atomic_init(&snapshot->epoch, 0);
+    atomic_init(&snapshot->readers, NULL);
+    pthread_mutex_init(&snapshot->write_lock, NULL);
+    snapshot->retired = NULL;
+    snapshot->next_version = 1;
+
+    *out_snapshot = snapshot;
+    return VECTOR_SUCCESS;
+}
+
+int numen_snapshot_free(NumenSnapshot *snapshot) {
+    if (!snapshot)
+        return VECTOR_ERROR_NULL;
+
+    version_free(atomic_load(&snapshot->current));
+    while (snapshot->retired) {
+        SnapshotVersion *next = snapshot->retired->next;
+        version_free(snapshot->retired);
+        snapshot->retired = next;
+    }
+
+    NumenSnapshotReader *reader = atomic_load(&snapshot->readers);
+    while (reader) {
+        NumenSnapshotReader *next = reader->next;
+        free(reader);
+        reader = next;
+    }
+
+    pthread_mutex_destroy(&snapshot->write_lock);
+    free(snapshot);
+    return VECTOR_SUCCESS;
+}
+
+// --- Writers ---
+
+int numen_snapshot_swap(NumenSnapshot *snapshot, Vector *vector) {
+    if (!snapshot || !vector)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(vector))
+        return VECTOR_ERROR_INIT;
+
+    pthread_mutex_lock(&snapshot->write_lock);
+
+    SnapshotVersion *entry = NULL;
+    int err = version_create(vector, snapshot->next_version, &entry);
+    if (err != VECTOR_SUCCESS) {
+        pthread_mutex_unlock(&snapshot->write_lock);
+        return err;
+    }
+    snapshot->next_version++;
+
+    SnapshotVersion *old = atomic_exchange(&snapshot->current, entry);
+    old->retired_at = atomic_fetch_add(&snapshot->epoch, 1);
+    old->next = snapshot->retired;
+    snapshot->retired = old;
+
+    reclaim_locked(snapshot);
+    pthread_mutex_unlock(&snapshot->write_lock);
+    return VECTOR_SUCCESS;
+}
+
+int numen_snapshot_publish(NumenSnapshot *snapshot, const Vector *source) {
+    if (!snapshot || !source)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(source))
+        return VECTOR_ERROR_INIT;
+
+    Vector *copy = NULL;
+    int err = vector_from_array(source->elements, source->size, &copy);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    err = numen_snapshot_swap(snapshot, copy);
+    if (err != VECTOR_SUCCESS)
+        vector_free(copy);
+    return err;
+}
+
+int numen_snapshot_reclaim(NumenSnapshot *snapshot, size_t *out_pending) {
+    if (!snapshot)
+        return VECTOR_ERROR_NULL;
+
+    pthread_mutex_lock(&snapshot->write_lock);
+    size_t pending = reclaim_locked(snapshot);
+    pthread_mutex_unlock(&snapshot->write_lock);
+
+    if (out_pending)
+        *out_pending = pending;
+    return VECTOR_SUCCESS;
+}
+
+// --- Readers ---
+
+int numen_snapshot_reader_create(NumenSnapshot *snapshot,
+                                 NumenSnapshotReader **out_reader) {
+    if (!snapshot || !out_reader)
+        return VECTOR_ERROR_NULL;
+
+    // Recycle a released record before growing the list
+    for (NumenSnapshotReader *reader = atomic_load(&snapshot->readers); reader;
+         reader = reader->next) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&reader->in_use, &expected, true)) {
+            *out_reader = reader;
+            return VECTOR_SUCCESS;
+        }
+    }
+
+    NumenSnapshotReader *reader = malloc(sizeof(NumenSnapshotReader));
+    if (!reader)
+        return VECTOR_ERROR_MEM;
+
+    reader->snapshot = snapshot;
+    atomic_init(&reader->epoch, SNAPSHOT_IDLE);
+    atomic_init(&reader->in_use, true);
+
+    NumenSnapshotReader *head = atomic_load(&snapshot->readers);
+    do {
+        reader->next = head;
+    } while (!atomic_compare_exchange_weak(&snapshot->readers, &head, reader));
+
+    *out_reader = reader;
+    return VECTOR_SUCCESS;
+}
+
+int numen_snapshot_reader_free(NumenSnapshotReader *reader) {
+    if (!reader)
+        return VECTOR_ERROR_NULL;
+
+    atomic_store(&reader->epoch, SNAPSHOT_IDLE);
+    atomic_store(&reader->in_use, false);
+    return VECTOR_SUCCESS;
+}
+
+int numen_snapshot_acquire(NumenSnapshotReader *reader,
+                           const Vector **out_vector,
+                           uint64_t *out_version) {
+    if (!reader || !out_vector)
+        return VECTOR_ERROR_NULL;
+    if (atomic_load_explicit(&reader->epoch, memory_order_relaxed) !=
+        SNAPSHOT_IDLE)
+        return VECTOR_ERROR_INIT;
+
+    // Sequentially consistent: the announcement must precede the load
+    atomic_store(&reader->epoch, atomic_load(&reader->snapshot->epoch));
+    SnapshotVersion *entry = atomic_load(&reader->snapshot->current);
+
+    *out_vector = entry->vector;
+    if (out_version)
+        *out_version = entry->version;
+    return VECTOR_SUCCESS;
+}
+
+int numen_snapshot_release(NumenSnapshotReader *reader) {
+    if (!reader)
+        return VECTOR_ERROR_NULL;
+
+    atomic_store_explicit(&reader->epoch, SNAPSHOT_IDLE, memory_order_release);
+    return VECTOR_SUCCESS;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file sparse.c
+ * @brief Compressed sparse row matrices
+ * @date 18/10/26
+ */
+
+#include "sparse.h"
+#include "blas.h"
+
+int sparse_check(const SparseMatrix *matrix) {
+    if (!matrix)
+        return VECTOR_ERROR_NULL;
+    if (!matrix->offsets || matrix->offsets[0] != 0)
+        return VECTOR_ERROR_INIT;
+
+    const size_t *offsets = matrix->offsets;
+    for (size_t i = 0; i < matrix->rows; i++) {
+        if (offsets[i + 1] < offsets[i])
+            return VECTOR_ERROR_INIT;
+    }
+
+    const size_t nnz = offsets[matrix->rows];
+    if (nnz == 0)
+        return VECTOR_SUCCESS;
+    if (!matrix->values || !matrix->columns)
+        return VECTOR_ERROR_INIT;
+
+    // Branch-free maximum so the scan vectorizes
+    size_t max_column = 0;
+    for (size_t p = 0; p < nnz; p++) {
+        const size_t column = matrix->columns[p];
+        max_column = column > max_column ? column : max_column;
+    }
+    return max_column < matrix->cols ? VECTOR_SUCCESS : VECTOR_ERROR_INDEX;
+}
+
+int sparse_mult_vector(const SparseMatrix *a, const Vector *x, Vector *y) {
+    if (!a || !x || !y)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(x) || !vector_valid(y))
+        return VECTOR_ERROR_INIT;
+
+    int err = sparse_check(a);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    if (x->size != a->cols || y->size != a->rows)
+        return VECTOR_ERROR_SIZE;
+    if (x->elements == y->elements)
+        return VECTOR_ERROR_INVALID_ARG;
+
+    return blas_csrmv(a, x->elements, y->elements);
+}
+
+int sparse_diagonal(const SparseMatrix *a, Vector *diagonal) {
+    if (!a || !diagonal)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(diagonal))
+        return VECTOR_ERROR_INIT;
+
+    int err = sparse_check(a);
+    if (err != VECTOR_SUCCESS)
+        return err;
+    if (a->rows != a->cols || diagonal->size != a->rows)
+        return VECTOR_ERROR_SIZE;
+
+    for (size_t i = 0; i < a->rows; i++) {
+        double_t d = 0.0;
+        for (size_t p = a->offsets[i]; p < a->offsets[i + 1]; p++) {
+            if (a->columns[p] == i)
+                d += a->values[p];
+        }
+        diagonal->elements[i] = d;
+    }
+    return VECTOR_SUCCESS;
+}
@@ -5,10 +5,20 @@
  */
 
 #include "vector.h"
+#include "pool.h"
+#include <float.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+// Elements per early-exit block in comparison scans. Each block is checked
+// without branches so the compiler can vectorize it.
+#define VECTOR_COMPARE_BLOCK 16
+
+// Elements per partial sum in vector_dot_parallel. Fixed so the result does
+// not depend on the number of threads.
+#define VECTOR_DOT_CHUNK 16384
+
 bool vector_valid(const Vector *vector) {
     return (vector != NULL && vector->elements != NULL);
 }
@@ -377,10 +387,27 @@ int vector_div(const Vector *a, const Vector *b, Vector *result) {
     if (a->size != b->size || a->size != result->size)
         return VECTOR_ERROR_SIZE;
 
-    for (size_t i = 0; i < a->size; i++) {
-        if (b->elements[i] == 0.0)
+    const double_t *b_data = b->elements;
+    const size_t size = a->size;
+
+    // Scan divisors up front so the result is never left half written
+    // and the division loop below has no branch to block vectorization
+    size_t i = 0;
+    for (; i + VECTOR_COMPARE_BLOCK <= size; i += VECTOR_COMPARE_BLOCK) {
+        int zero = 0;
+        for (size_t j = i; j < i + VECTOR_COMPARE_BLOCK; j++) {
+            zero |= b_data[j] == 0.0;
+        }
+        if (zero)
             return VECTOR_ERROR_MATH;
-        result->elements[i] = a->elements[i] / b->elements[i];
+    }
+    for (; i < size; i++) {
+        if (b_data[i] == 0.0)
+            return VECTOR_ERROR_MATH;
+    }
+
+    for (i = 0; i < size; i++) {
+        result->elements[i] = a->elements[i] / b_data[i];
     }
     return VECTOR_SUCCESS;
 }
@@ -452,6 +479,72 @@ int vector_dot(const Vector *a, const Vector *b, double_t *result) {
     return VECTOR_SUCCESS;
 }
 
+typedef struct {
+    const double_t *a;
+    const double_t *b;
+    size_t size;
+    double_t *partials;
+} DotJob;
+
+static void dot_chunk(void *ctx, size_t task) {
+    DotJob *job = ctx;
+    const size_t begin = task * VECTOR_DOT_CHUNK;
+    const size_t end = begin + VECTOR_DOT_CHUNK < job->size
+                           ? begin + VECTOR_DOT_CHUNK
+                           : job->size;
+
+    double_t sum = 0.0;
+    double_t c = 0.0;
+    for (size_t i = begin; i < end; i++) {
+        double_t y = job->a[i] * job->b[i] - c;
+        double_t t = sum + y;
+        c = (t - sum) - y;
+        sum = t;
+    }
+    job->partials[task] = sum;
+}
+
+int vector_dot_parallel(const Vector *a, const Vector *b, double_t *result) {
+    if (!a || !b || !result)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(a) || !vector_valid(b))
+        return VECTOR_ERROR_INIT;
+    if (a->size != b->size)
+        return VECTOR_ERROR_SIZE;
+
+    const size_t tasks = (a->size + VECTOR_DOT_CHUNK - 1) / VECTOR_DOT_CHUNK;
+    if (tasks < 2)
+        return vector_dot(a, b, result);
+
+    double_t *partials = malloc(tasks * sizeof(double_t));
+    if (!partials)
+        return VECTOR_ERROR_MEM;
+
+    DotJob job = {
+        .a = a->elements,
+        .b = b->elements,
+        .size = a->size,
+        .partials = partials,
+    };
+
+    int err = pool_parallel_for(tasks, dot_chunk, &job);
+    if (err == VECTOR_SUCCESS) {
+        // Combine in chunk order so every run gives the same answer
+        double_t sum = 0.0;
+        double_t c = 0.0;
+        for (size_t i = 0; i < tasks; i++) {
+            double_t y = partials[i] - c;
+            double_t t = sum + y;
+            c = (t - sum) - y;
+            sum = t;
+        }
+        *result = sum;
+    }
+
+    free(partials);
+    return err;
+}
+
 // Optimized 3D cross product (special case)
 int vector_cross(const Vector *a, const Vector *b, Vector *result) {
     if (!a || !b || !result)
@@ -939,7 +1032,64 @@ int vector_round(Vector *vector) {
 }
 
 int vector_equals(const Vector *a, const Vector *b, double_t tolerance) {
-    if (!a || !b)
+    bool equal;
+    int err = vector_approx_equal(a, b, tolerance, &equal);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    return equal ? VECTOR_SUCCESS : VECTOR_ERROR_MATH;
+}
+
+int vector_is_zero(const Vector *vector, double_t tolerance) {
+    bool zero;
+    int err = vector_approx_zero(vector, tolerance, &zero);
+    if (err != VECTOR_SUCCESS)
+        return err;
+
+    return zero ? VECTOR_SUCCESS : VECTOR_ERROR_MATH;
+}
+
+int vector_is_unit(const Vector *vector, double_t tolerance) {
+    if (!vector)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(vector))
+        return VECTOR_ERROR_INIT;
+
+    double_t sum_of_squares = 0.0;
+    const double_t *data = vector->elements;
+
+    for (size_t i = 0; i < vector->size; i++) {
+        sum_of_squares += data[i] * data[i];
+    }
+
+    return (fabs(sum_of_squares - 1.0) <= tolerance) ? VECTOR_SUCCESS
+                                                     : VECTOR_ERROR_MATH;
+}
+
+int vector_print(const Vector *vector) {
+    if (!vector)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(vector))
+        return VECTOR_ERROR_INIT;
+
+    printf("[");
+    for (size_t i = 0; i < vector->size; i++) {
+        printf("%.6f", vector->elements[i]);
+        if (i < vector->size - 1) {
+            printf(", ");
+        }
+    }
+    printf("]\n");
+    return VECTOR_SUCCESS;
+}
+
+// --- Comparisons ---
+
+int vector_approx_equal(const Vector *a,
+                        const Vector *b,
+                        double_t tolerance,
+                        bool *result) {
+    if (!a || !b || !result)
         return VECTOR_ERROR_NULL;
     if (!vector_valid(a) || !vector_valid(b))
         return VECTOR_ERROR_INIT;
@@ -948,63 +1098,191 @@ int vector_equals(const Vector *a, const Vector *b, double_t tolerance) {
 
     const double_t *a_data = a->elements;
     const double_t *b_data = b->elements;
+    const size_t size = a->size;
 
-    for (size_t i = 0; i < a->size; i++) {
-        if (fabs(a_data[i] - b_data[i]) > tolerance) {
-            return VECTOR_SUCCESS; // Return success but result is false
+    // Negated test so NaN counts as a mismatch
+    size_t i = 0;
+    for (; i + VECTOR_COMPARE_BLOCK <= size; i += VECTOR_COMPARE_BLOCK) {
+        int mismatch = 0;
+        for (size_t j = i; j < i + VECTOR_COMPARE_BLOCK; j++) {
+            mismatch |= !(fabs(a_data[j] - b_data[j]) <= tolerance);
+        }
+        if (mismatch) {
+            *result = false;
+            return VECTOR_SUCCESS;
         }
     }
 
+    for (; i < size; i++) {
+        if (!(fabs(a_data[i] - b_data[i]) <= tolerance)) {
+            *result = false;
+            return VECTOR_SUCCESS;
+        }
+    }
+
+    *result = true;
     return VECTOR_SUCCESS;
 }
 
-int vector_is_zero(const Vector *vector, double_t tolerance) {
-    if (!vector)
+// Map a double onto a monotonically ordered integer line
+static int64_t ordered_bits(double x) {
+    int64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return bits < 0 ? INT64_MIN - bits : bits;
+}
+
+static int ulp_mismatch(double_t a, double_t b, uint64_t max_ulps) {
+    const int64_t ia = ordered_bits(a);
+    const int64_t ib = ordered_bits(b);
+    // Unsigned difference cannot overflow
+    const uint64_t dist =
+        ia > ib ? (uint64_t)ia - (uint64_t)ib : (uint64_t)ib - (uint64_t)ia;
+    return (dist > max_ulps) | (a != a) | (b != b);
+}
+
+int vector_ulp_equal(const Vector *a,
+                     const Vector *b,
+                     uint64_t max_ulps,
+                     bool *result) {
+    if (!a || !b || !result)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(a) || !vector_valid(b))
+        return VECTOR_ERROR_INIT;
+    if (a->size != b->size)
+        return VECTOR_ERROR_SIZE;
+
+    const double_t *a_data = a->elements;
+    const double_t *b_data = b->elements;
+    const size_t size = a->size;
+
+    size_t i = 0;
+    for (; i + VECTOR_COMPARE_BLOCK <= size; i += VECTOR_COMPARE_BLOCK) {
+        int mismatch = 0;
+        for (size_t j = i; j < i + VECTOR_COMPARE_BLOCK; j++) {
+            mismatch |= ulp_mismatch(a_data[j], b_data[j], max_ulps);
+        }
+        if (mismatch) {
+            *result = false;
+            return VECTOR_SUCCESS;
+        }
+    }
+
+    for (; i < size; i++) {
+        if (ulp_mismatch(a_data[i], b_data[i], max_ulps)) {
+            *result = false;
+            return VECTOR_SUCCESS;
+        }
+    }
+
+    *result = true;
+    return VECTOR_SUCCESS;
+}
+
+int vector_bitwise_equal(const Vector *a, const Vector *b, bool *result) {
+    if (!a || !b || !result)
+        return VECTOR_ERROR_NULL;
+    if (!vector_valid(a) || !vector_valid(b))
+        return VECTOR_ERROR_INIT;
+
+    // memcmp is already a vectorized, early-exit scan
+    *result = a->size == b->size &&
+              memcmp(a->elements, b->elements, a->size * sizeof(double_t)) == 0;
+    return VECTOR_SUCCESS;
+}
+
+int vector_approx_zero(const Vector *vector, double_t tolerance, bool *result) {
+    if (!vector || !result)
         return VECTOR_ERROR_NULL;
     if (!vector_valid(vector))
         return VECTOR_ERROR_INIT;
 
     const double_t *data = vector->elements;
+    const size_t size = vector->size;
 
-    for (size_t i = 0; i < vector->size; i++) {
-        if (fabs(data[i]) > tolerance) {
-            return VECTOR_SUCCESS; // Return success but result is false
+    size_t i = 0;
+    for (; i + VECTOR_COMPARE_BLOCK <= size; i += VECTOR_COMPARE_BLOCK) {
+        int nonzero = 0;
+        for (size_t j = i; j < i + VECTOR_COMPARE_BLOCK; j++) {
+            nonzero |= !(fabs(data[j]) <= tolerance);
+        }
+        if (nonzero) {
+            *result = false;
+            return VECTOR_SUCCESS;
+        }
+    }
+
+    for (; i < size; i++) {
+        if (!(fabs(data[i]) <= tolerance)) {
+            *result = false;
+            return VECTOR_SUCCESS;
         }
     }
 
+    *result = true;
     return VECTOR_SUCCESS;
 }
 
-int vector_is_unit(const Vector *vector, double_t tolerance) {
-    if (!vector)
+int vector_has_nan(const Vector *vector, bool *result) {
+    if (!vector || !result)
         return VECTOR_ERROR_NULL;
     if (!vector_valid(vector))
         return VECTOR_ERROR_INIT;
 
-    double_t sum_of_squares = 0.0;
     const double_t *data = vector->elements;
+    const size_t size = vector->size;
 
-    for (size_t i = 0; i < vector->size; i++) {
-        sum_of_squares += data[i] * data[i];
+    size_t i = 0;
+    for (; i + VECTOR_COMPARE_BLOCK <= size; i += VECTOR_COMPARE_BLOCK) {
+        int nan = 0;
+        for (size_t j = i; j < i + VECTOR_COMPARE_BLOCK; j++) {
+            nan |= data[j] != data[j];
+        }
+        if (nan) {
+            *result = true;
+            return VECTOR_SUCCESS;
+        }
     }
 
-    return (fabs(sum_of_squares - 1.0) <= tolerance) ? VECTOR_SUCCESS
-                                                     : VECTOR_ERROR_MATH;
+    for (; i < size; i++) {
+        if (data[i] != data[i]) {
+            *result = true;
+            return VECTOR_SUCCESS;
+        }
+    }
+
+    *result = false;
+    return VECTOR_SUCCESS;
 }
 
-int vector_print(const Vector *vector) {
-    if (!vector)
+int vector_all_finite(const Vector *vector, bool *result) {
+    if (!vector || !result)
         return VECTOR_ERROR_NULL;
     if (!vector_valid(vector))
         return VECTOR_ERROR_INIT;
 
-    printf("[");
-    for (size_t i = 0; i < vector->size; i++) {
-        printf("%.6f", vector->elements[i]);
-        if (i < vector->size - 1) {
-            printf(", ");
+    const double_t *data = vector->elements;
+    const size_t size = vector->size;
+
+    // fabs(x) <= DBL_MAX is false for both infinities and NaN
+    size_t i = 0;
+    for (; i + VECTOR_COMPARE_BLOCK <= size; i += VECTOR_COMPARE_BLOCK) {
+        int bad = 0;
+        for (size_t j = i; j < i + VECTOR_COMPARE_BLOCK; j++) {
+            bad |= !(fabs(data[j]) <= DBL_MAX);
+        }
+        if (bad) {
+            *result = false;
+            return VECTOR_SUCCESS;
         }
     }
-    printf("]\n");
+
+    for (; i < size; i++) {
+        if (!(fabs(data[i]) <= DBL_MAX)) {
+            *result = false;
+            return VECTOR_SUCCESS;
+        }
+    }
+
+    *result = true;
     return VECTOR_SUCCESS;
 }
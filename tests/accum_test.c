@@ -0,0 +1,142 @@
+/**
+ * @file accum_test.c
+ * @brief Tests for atomic and sharded accumulators
+ * @date 18/10/26
+ */
+
+#include "accum.h"
+#include "unity.h"
+#include <pthread.h>
+
+#define SIZE 1000
+#define THREADS 4
+#define ROUNDS 200
+
+static NumenAccumulator *accum;
+static Vector *ones;
+
+void setUp(void) {
+    numen_accum_create(SIZE, THREADS, &accum);
+    vector_create(SIZE, &ones);
+    for (size_t i = 0; i < SIZE; i++) {
+        ones->elements[i] = 1.0;
+    }
+}
+
+void tearDown(void) {
+    numen_accum_free(accum);
+    vector_free(ones);
+}
+
+// Each thread adds ones ROUNDS times, plus i at element i
+static void *add_sharded(void *arg) {
+    (void)arg;
+    NumenAccumShard *shard;
+    if (numen_accum_shard_acquire(accum, &shard) != VECTOR_SUCCESS)
+        return NULL;
+
+    for (size_t r = 0; r < ROUNDS; r++) {
+        numen_accum_shard_add(shard, ones);
+    }
+    for (size_t i = 0; i < SIZE; i++) {
+        numen_accum_shard_add_at(shard, i, (double_t)i);
+    }
+    numen_accum_shard_release(shard);
+    return NULL;
+}
+
+static void *add_atomic(void *arg) {
+    (void)arg;
+    for (size_t r = 0; r < ROUNDS; r++) {
+        for (size_t i = 0; i < SIZE; i += 10) {
+            numen_accum_atomic_add(accum, i, 0.5);
+        }
+    }
+    return NULL;
+}
+
+static void test_concurrent_shards_and_atomics(void) {
+    pthread_t sharded[THREADS], atomic[THREADS];
+    for (size_t t = 0; t < THREADS; t++) {
+        pthread_create(&sharded[t], NULL, add_sharded, NULL);
+        pthread_create(&atomic[t], NULL, add_atomic, NULL);
+    }
+    for (size_t t = 0; t < THREADS; t++) {
+        pthread_join(sharded[t], NULL);
+        pthread_join(atomic[t], NULL);
+    }
+
+    Vector *result;
+    vector_create(SIZE, &result);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_accum_merge(accum, result));
+    for (size_t i = 0; i < SIZE; i++) {
+        double_t expected = THREADS * (ROUNDS + (double_t)i);
+        if (i % 10 == 0)
+            expected += THREADS * ROUNDS * 0.5;
+        TEST_ASSERT_EQUAL_DOUBLE(expected, result->elements[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_accum_reset(accum));
+    numen_accum_merge(accum, result);
+    for (size_t i = 0; i < SIZE; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(0.0, result->elements[i]);
+    }
+    vector_free(result);
+}
+
+static void test_shards_run_out(void) {
+    NumenAccumShard *shards[THREADS], *extra = NULL;
+    for (size_t t = 0; t < THREADS; t++) {
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                              numen_accum_shard_acquire(accum, &shards[t]));
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          numen_accum_shard_acquire(accum, &extra));
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_accum_shard_release(shards[0]));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_accum_shard_acquire(accum, &extra));
+    for (size_t t = 1; t < THREADS; t++) {
+        numen_accum_shard_release(shards[t]);
+    }
+    numen_accum_shard_release(extra);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_accum_shard_release(NULL));
+}
+
+static void test_indexed_add_checks_range(void) {
+    NumenAccumShard *shard;
+    numen_accum_shard_acquire(accum, &shard);
+
+    Vector *values;
+    vector_3d(1.0, 2.0, 3.0, &values);
+    size_t indices[3] = {5, 5, 7};
+    int status = numen_accum_shard_add_indexed(shard, indices, values);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, status);
+
+    // The out-of-range index is caught before anything is written
+    indices[2] = SIZE;
+    status = numen_accum_shard_add_indexed(shard, indices, values);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INDEX, status);
+    numen_accum_shard_release(shard);
+
+    Vector *result;
+    vector_create(SIZE, &result);
+    numen_accum_merge(accum, result);
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, result->elements[5]);
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, result->elements[7]);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INDEX,
+                          numen_accum_atomic_add(accum, SIZE, 1.0));
+
+    vector_free(values);
+    vector_free(result);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_accum_free(NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_concurrent_shards_and_atomics);
+    RUN_TEST(test_shards_run_out);
+    RUN_TEST(test_indexed_add_checks_range);
+    return UNITY_END();
+}
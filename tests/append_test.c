@@ -0,0 +1,141 @@
+/**
+ * @file append_test.c
+ * @brief Tests for the multi-producer append buffer
+ * @date 18/10/26
+ */
+
+#include "append.h"
+#include "unity.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+#define PRODUCERS 4
+#define PER_PRODUCER 50000
+
+static NumenAppendBuffer *buffer;
+
+void setUp(void) {
+    numen_append_buffer_create(&buffer);
+}
+
+void tearDown(void) {
+    numen_append_buffer_free(buffer);
+}
+
+// Producer p appends p * PER_PRODUCER + i for i in order, singly and in runs
+static void *produce(void *arg) {
+    const size_t p = (size_t)(uintptr_t)arg;
+    NumenAppender *appender;
+    if (numen_appender_create(buffer, &appender) != VECTOR_SUCCESS)
+        return NULL;
+
+    double_t run[100];
+    size_t i = 0;
+    while (i < PER_PRODUCER) {
+        if (i % 1000 == 0 && i + 100 <= PER_PRODUCER) {
+            for (size_t k = 0; k < 100; k++) {
+                run[k] = (double_t)(p * PER_PRODUCER + i + k);
+            }
+            numen_append_many(appender, run, 100);
+            i += 100;
+        } else {
+            numen_append(appender, (double_t)(p * PER_PRODUCER + i));
+            i++;
+        }
+    }
+    numen_appender_free(appender);
+    return NULL;
+}
+
+static void test_concurrent_producers(void) {
+    pthread_t threads[PRODUCERS];
+    for (size_t p = 0; p < PRODUCERS; p++) {
+        pthread_create(&threads[p], NULL, produce, (void *)(uintptr_t)p);
+    }
+    for (size_t p = 0; p < PRODUCERS; p++) {
+        pthread_join(threads[p], NULL);
+    }
+
+    size_t size = 0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_append_size(buffer, &size));
+    TEST_ASSERT_EQUAL_size_t(PRODUCERS * PER_PRODUCER, size);
+
+    Vector *all;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_append_finalize(buffer, &all));
+    TEST_ASSERT_EQUAL_size_t(size, all->size);
+
+    // Every value once, each producer's values in increasing order
+    bool *seen = calloc(size, sizeof(bool));
+    double_t last[PRODUCERS];
+    for (size_t p = 0; p < PRODUCERS; p++) {
+        last[p] = -1.0;
+    }
+    for (size_t i = 0; i < size; i++) {
+        const size_t value = (size_t)all->elements[i];
+        const size_t p = value / PER_PRODUCER;
+        TEST_ASSERT_TRUE(value < size);
+        TEST_ASSERT_FALSE(seen[value]);
+        TEST_ASSERT_TRUE(all->elements[i] > last[p]);
+        seen[value] = true;
+        last[p] = all->elements[i];
+    }
+
+    free(seen);
+    vector_free(all);
+}
+
+static void test_views_cover_published_elements(void) {
+    NumenAppender *appender;
+    numen_appender_create(buffer, &appender);
+    for (size_t i = 0; i < 5000; i++) {
+        numen_append(appender, (double_t)i);
+    }
+
+    // Only chunks already filled are visible before the flush
+    size_t size = 0;
+    numen_append_size(buffer, &size);
+    TEST_ASSERT_TRUE(size < 5000);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_appender_flush(appender));
+    numen_append_size(buffer, &size);
+    TEST_ASSERT_EQUAL_size_t(5000, size);
+
+    size_t count = 0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_append_views(buffer, NULL, 0, &count));
+    TEST_ASSERT_TRUE(count >= 1);
+    if (count > 1) {
+        VectorView one;
+        TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                              numen_append_views(buffer, &one, 1, &count));
+    }
+
+    VectorView *views = malloc(count * sizeof(VectorView));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_append_views(buffer, views, count, &count));
+    size_t next = 0;
+    for (size_t v = 0; v < count; v++) {
+        for (size_t i = 0; i < views[v].size; i++) {
+            TEST_ASSERT_EQUAL_DOUBLE((double_t)next, views[v].elements[i]);
+            next++;
+        }
+    }
+    TEST_ASSERT_EQUAL_size_t(5000, next);
+
+    free(views);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_appender_free(appender));
+}
+
+static void test_null_handles(void) {
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_append(NULL, 1.0));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_appender_free(NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_append_buffer_free(NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_concurrent_producers);
+    RUN_TEST(test_views_cover_published_elements);
+    RUN_TEST(test_null_handles);
+    return UNITY_END();
+}
@@ -0,0 +1,139 @@
+/**
+ * @file async_test.c
+ * @brief Tests for asynchronous operations and completion futures
+ * @date 18/10/26
+ */
+
+#include "async.h"
+#include "unity.h"
+#include <stdatomic.h>
+
+#define SIZE 100000
+
+static Vector *a;
+static Vector *b;
+static Vector *c;
+
+void setUp(void) {
+    vector_create(SIZE, &a);
+    vector_create(SIZE, &b);
+    vector_create(SIZE, &c);
+    for (size_t i = 0; i < SIZE; i++) {
+        a->elements[i] = (double_t)(i % 10);
+        b->elements[i] = 1.0;
+    }
+}
+
+void tearDown(void) {
+    vector_free(a);
+    vector_free(b);
+    vector_free(c);
+}
+
+static int increment(void *arg) {
+    atomic_fetch_add((atomic_int *)arg, 1);
+    return VECTOR_SUCCESS;
+}
+
+static int fail_math(void *arg) {
+    (void)arg;
+    return VECTOR_ERROR_MATH;
+}
+
+static void record_status(int status, void *user_data) {
+    *(int *)user_data = status;
+}
+
+static void test_submit_and_wait(void) {
+    atomic_int counter = 0;
+    NumenFuture *futures[16];
+    for (size_t i = 0; i < 16; i++) {
+        TEST_ASSERT_EQUAL_INT(
+            VECTOR_SUCCESS,
+            numen_submit(increment, &counter, NULL, 0, &futures[i]));
+    }
+    for (size_t i = 0; i < 16; i++) {
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_wait(futures[i]));
+        numen_future_free(futures[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(16, atomic_load(&counter));
+}
+
+static void test_dependency_chain(void) {
+    // c = a + b, then c *= 2 in place, then dot with b
+    NumenFuture *add, *scale, *dot;
+    double_t result = 0.0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_add_async(a, b, c, NULL, 0, &add));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_scale_async(c, 2.0, c, &add, 1, &scale));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_dot_async(c, b, &result, &scale, 1, &dot));
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_wait(dot));
+    bool done = false;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_poll(add, &done));
+    TEST_ASSERT_TRUE(done);
+
+    // Sum of 2 * (i % 10 + 1)
+    TEST_ASSERT_EQUAL_DOUBLE(2.0 * (SIZE / 10) * 55.0, result);
+
+    numen_future_free(add);
+    numen_future_free(scale);
+    numen_future_free(dot);
+}
+
+static void test_failed_dependency_skips_dependents(void) {
+    atomic_int counter = 0;
+    NumenFuture *failing, *dependent;
+    numen_submit(fail_math, NULL, NULL, 0, &failing);
+    numen_submit(increment, &counter, &failing, 1, &dependent);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH, numen_wait(dependent));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH, numen_wait(failing));
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&counter));
+
+    numen_future_free(failing);
+    numen_future_free(dependent);
+}
+
+static void test_argument_errors_reported_through_future(void) {
+    Vector *small;
+    vector_create(3, &small);
+
+    NumenFuture *future;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_add_async(a, small, c, NULL, 0, &future));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, numen_wait(future));
+
+    int status = -1;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_on_complete(future, record_status, &status));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, status);
+
+    numen_future_free(future);
+    vector_free(small);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_wait(NULL));
+}
+
+static void test_fire_and_forget_then_wait_on_dependent(void) {
+    double_t sum = 0.0;
+    NumenFuture *copy, *total;
+    vector_copy_async(a, c, NULL, 0, &copy);
+    vector_sum_async(c, &sum, &copy, 1, &total);
+    numen_future_free(copy);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_wait(total));
+    TEST_ASSERT_EQUAL_DOUBLE((SIZE / 10) * 45.0, sum);
+    numen_future_free(total);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_submit_and_wait);
+    RUN_TEST(test_dependency_chain);
+    RUN_TEST(test_failed_dependency_skips_dependents);
+    RUN_TEST(test_argument_errors_reported_through_future);
+    RUN_TEST(test_fire_and_forget_then_wait_on_dependent);
+    return UNITY_END();
+}
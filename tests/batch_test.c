@@ -0,0 +1,140 @@
+/**
+ * @file batch_test.c
+ * @brief Tests for structure-of-arrays vector batches
+ * @date 18/10/26
+ */
+
+#include "batch.h"
+#include "unity.h"
+#include <stdint.h>
+
+#define COUNT 37
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static void test_vec3_interleaved_round_trip(void) {
+    Vec3Batch *batch;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vec3_batch_create(COUNT, &batch));
+    TEST_ASSERT_EQUAL_size_t(COUNT, batch->count);
+    for (size_t i = 0; i < COUNT; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(0.0, batch->z[i]);
+    }
+
+    double_t xyz[3 * COUNT], back[3 * COUNT];
+    for (size_t i = 0; i < 3 * COUNT; i++) {
+        xyz[i] = (double_t)i;
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vec3_batch_from_interleaved(xyz, batch));
+    for (size_t i = 0; i < COUNT; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(3.0 * i, batch->x[i]);
+        TEST_ASSERT_EQUAL_DOUBLE(3.0 * i + 1, batch->y[i]);
+        TEST_ASSERT_EQUAL_DOUBLE(3.0 * i + 2, batch->z[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vec3_batch_to_interleaved(batch, back));
+    for (size_t i = 0; i < 3 * COUNT; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(xyz[i], back[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vec3_batch_free(batch));
+}
+
+static void test_vec4_interleaved_round_trip(void) {
+    Vec4Batch *batch;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vec4_batch_create(COUNT, &batch));
+
+    double_t xyzw[4 * COUNT], back[4 * COUNT];
+    for (size_t i = 0; i < 4 * COUNT; i++) {
+        xyzw[i] = (double_t)i;
+    }
+    vec4_batch_from_interleaved(xyzw, batch);
+    for (size_t i = 0; i < COUNT; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(4.0 * i, batch->x[i]);
+        TEST_ASSERT_EQUAL_DOUBLE(4.0 * i + 3, batch->w[i]);
+    }
+
+    vec4_batch_to_interleaved(batch, back);
+    for (size_t i = 0; i < 4 * COUNT; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(xyzw[i], back[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vec4_batch_free(batch));
+}
+
+static void test_vec3_vectors_round_trip(void) {
+    Vec3Batch *batch;
+    vec3_batch_create(3, &batch);
+
+    Vector *in[3], *out[3];
+    for (size_t i = 0; i < 3; i++) {
+        vector_3d(i, 10.0 + i, 20.0 + i, &in[i]);
+        vector_create(3, &out[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vec3_batch_from_vectors((const Vector *const *)in,
+                                                  batch));
+    TEST_ASSERT_EQUAL_DOUBLE(12.0, batch->y[2]);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vec3_batch_to_vectors(batch, out));
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t k = 0; k < 3; k++) {
+            TEST_ASSERT_EQUAL_DOUBLE(in[i]->elements[k], out[i]->elements[k]);
+        }
+    }
+
+    for (size_t i = 0; i < 3; i++) {
+        vector_free(in[i]);
+        vector_free(out[i]);
+    }
+    vec3_batch_free(batch);
+}
+
+// A wrong-sized vector late in the array must leave the batch untouched
+static void test_vectors_validated_before_writing(void) {
+    Vec3Batch *batch;
+    vec3_batch_create(2, &batch);
+
+    Vector *in[2];
+    vector_3d(1, 2, 3, &in[0]);
+    vector_2d(4, 5, &in[1]);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          vec3_batch_from_vectors((const Vector *const *)in,
+                                                  batch));
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, batch->x[0]);
+
+    vector_free(in[0]);
+    vector_free(in[1]);
+    vec3_batch_free(batch);
+}
+
+static void test_create_edge_cases(void) {
+    Vec3Batch *empty;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vec3_batch_create(0, &empty));
+    TEST_ASSERT_EQUAL_size_t(0, empty->count);
+    vec3_batch_free(empty);
+
+    // 3 * count * sizeof(double_t) would wrap around
+    Vec3Batch *huge3 = NULL;
+    Vec4Batch *huge4 = NULL;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MEM,
+                          vec3_batch_create(SIZE_MAX / 3, &huge3));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MEM,
+                          vec4_batch_create(SIZE_MAX / 4, &huge4));
+    TEST_ASSERT_NULL(huge3);
+    TEST_ASSERT_NULL(huge4);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, vec3_batch_create(1, NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, vec3_batch_free(NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, vec4_batch_free(NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_vec3_interleaved_round_trip);
+    RUN_TEST(test_vec4_interleaved_round_trip);
+    RUN_TEST(test_vec3_vectors_round_trip);
+    RUN_TEST(test_vectors_validated_before_writing);
+    RUN_TEST(test_create_edge_cases);
+    return UNITY_END();
+}
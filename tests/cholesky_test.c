@@ -0,0 +1,199 @@
+/**
+ * @file cholesky_test.c
+ * @brief Tests for Cholesky factorization and batched SPD solves
+ * @date 18/10/26
+ */
+
+#include "linalg.h"
+#include "unity.h"
+#include <string.h>
+
+// Trailing matrix spans several tiles, so off-diagonal tiles are updated
+#define SIZE 300
+#define BATCH 600
+
+static uint64_t seed;
+
+void setUp(void) {
+    seed = 7;
+}
+
+void tearDown(void) {}
+
+// Uniform in [-1, 1), reproducible across platforms
+static double_t next_random(void) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (double_t)(seed >> 11) / (double_t)(1ULL << 52) - 1.0;
+}
+
+// m * m^T + n * I into a, row-major n x n
+static void fill_spd(double_t *a, size_t n) {
+    static double_t m[SIZE * SIZE];
+    for (size_t i = 0; i < n * n; i++) {
+        m[i] = next_random();
+    }
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            double_t sum = i == j ? (double_t)n : 0.0;
+            for (size_t p = 0; p < n; p++) {
+                sum += m[i * n + p] * m[j * n + p];
+            }
+            a[i * n + j] = sum;
+        }
+    }
+}
+
+// Larger than CHOLESKY_BLOCK so the trailing updates run
+static void test_factor_reproduces_matrix(void) {
+    Matrix *a, *l, *lt, *product;
+    matrix_create(SIZE, SIZE, &a);
+    matrix_create(SIZE, SIZE, &l);
+    matrix_create(SIZE, SIZE, &lt);
+    matrix_create(SIZE, SIZE, &product);
+    fill_spd(a->elements, SIZE);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, matrix_cholesky(a, l));
+    for (size_t i = 0; i < SIZE; i++) {
+        TEST_ASSERT_TRUE(l->elements[i * SIZE + i] > 0.0);
+        for (size_t j = i + 1; j < SIZE; j++) {
+            TEST_ASSERT_EQUAL_DOUBLE(0.0, l->elements[i * SIZE + j]);
+        }
+    }
+
+    matrix_transpose(l, lt);
+    matrix_mult(l, lt, product);
+    for (size_t i = 0; i < SIZE * SIZE; i++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-10, a->elements[i], product->elements[i]);
+    }
+
+    matrix_free(a);
+    matrix_free(l);
+    matrix_free(lt);
+    matrix_free(product);
+}
+
+static void test_solve_spd(void) {
+    Matrix *a;
+    Vector *b, *x, *ax;
+    matrix_create(SIZE, SIZE, &a);
+    vector_create(SIZE, &b);
+    vector_create(SIZE, &x);
+    vector_create(SIZE, &ax);
+    fill_spd(a->elements, SIZE);
+    for (size_t i = 0; i < SIZE; i++) {
+        b->elements[i] = next_random();
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, matrix_solve_spd(a, b, x));
+    matrix_mult_vector(a, x, ax);
+    for (size_t i = 0; i < SIZE; i++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-10, b->elements[i], ax->elements[i]);
+    }
+
+    matrix_free(a);
+    vector_free(b);
+    vector_free(x);
+    vector_free(ax);
+}
+
+static void test_not_positive_definite(void) {
+    const double_t values[] = {1, 2, 2, 1};
+    Matrix *a, *l;
+    matrix_from_array(values, 2, 2, &a);
+    matrix_create(2, 2, &l);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH, matrix_cholesky(a, l));
+
+    matrix_free(a);
+    matrix_free(l);
+}
+
+// Batch of n x n matrices, lane bad is made indefinite
+static void check_batch(size_t n, size_t bad) {
+    MatrixBatch *batch, *rhs;
+    VectorMask *failed;
+    matrix_batch_create(n, n, BATCH, &batch);
+    matrix_batch_create(n, 1, BATCH, &rhs);
+    vector_mask_create(BATCH, &failed);
+
+    double_t a[BATCH][CHOLESKY_BATCH_MAX * CHOLESKY_BATCH_MAX];
+    for (size_t k = 0; k < BATCH; k++) {
+        fill_spd(a[k], n);
+        if (k == bad)
+            a[k][0] = -1.0;
+        for (size_t e = 0; e < n * n; e++) {
+            batch->elements[e * BATCH + k] = a[k][e];
+        }
+        for (size_t i = 0; i < n; i++) {
+            rhs->elements[i * BATCH + k] = next_random();
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                          matrix_cholesky_batched(batch, failed));
+    size_t failures = 0;
+    vector_count_where(failed, &failures);
+    TEST_ASSERT_EQUAL_size_t(1, failures);
+    bool flagged = false;
+    vector_mask_get(failed, bad, &flagged);
+    TEST_ASSERT_TRUE(flagged);
+
+    MatrixBatch *x;
+    matrix_batch_create(n, 1, BATCH, &x);
+    memcpy(x->elements, rhs->elements, n * BATCH * sizeof(double_t));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          matrix_cholesky_solve_batched(batch, x));
+
+    // Residual of a * x = b for every good lane
+    for (size_t k = 0; k < BATCH; k++) {
+        if (k == bad)
+            continue;
+        for (size_t i = 0; i < n; i++) {
+            double_t sum = 0.0;
+            for (size_t j = 0; j < n; j++) {
+                sum += a[k][i * n + j] * x->elements[j * BATCH + k];
+            }
+            TEST_ASSERT_DOUBLE_WITHIN(1e-10,
+                                      rhs->elements[i * BATCH + k],
+                                      sum);
+        }
+    }
+
+    matrix_batch_free(batch);
+    matrix_batch_free(rhs);
+    matrix_batch_free(x);
+    vector_mask_free(failed);
+}
+
+// BATCH spans several chunks and ends in a partial one
+static void test_batched_3x3(void) {
+    check_batch(3, 0);
+}
+
+static void test_batched_8x8(void) {
+    check_batch(CHOLESKY_BATCH_MAX, BATCH - 1);
+}
+
+static void test_batched_rejects_large_matrices(void) {
+    MatrixBatch *batch;
+    matrix_batch_create(CHOLESKY_BATCH_MAX + 1,
+                        CHOLESKY_BATCH_MAX + 1,
+                        4,
+                        &batch);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          matrix_cholesky_batched(batch, NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL,
+                          matrix_cholesky_batched(NULL, NULL));
+    matrix_batch_free(batch);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_factor_reproduces_matrix);
+    RUN_TEST(test_solve_spd);
+    RUN_TEST(test_not_positive_definite);
+    RUN_TEST(test_batched_3x3);
+    RUN_TEST(test_batched_8x8);
+    RUN_TEST(test_batched_rejects_large_matrices);
+    return UNITY_END();
+}
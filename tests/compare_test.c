@@ -0,0 +1,135 @@
+/**
+ * @file compare_test.c
+ * @brief Tests for boolean early-exit comparisons and NaN/finite scans
+ * @date 18/10/26
+ */
+
+#include "unity.h"
+#include "vector.h"
+
+#define SIZE 1003
+
+static Vector *a;
+static Vector *b;
+
+void setUp(void) {
+    vector_create(SIZE, &a);
+    vector_create(SIZE, &b);
+    for (size_t i = 0; i < SIZE; i++) {
+        a->elements[i] = 0.25 * (double_t)i;
+        b->elements[i] = 0.25 * (double_t)i;
+    }
+}
+
+void tearDown(void) {
+    vector_free(a);
+    vector_free(b);
+}
+
+static void test_approx_equal(void) {
+    bool equal = false;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_approx_equal(a, b, 0.0, &equal));
+    TEST_ASSERT_TRUE(equal);
+
+    // Mismatch in the scalar tail and in the first block
+    b->elements[SIZE - 1] += 1e-3;
+    vector_approx_equal(a, b, 1e-4, &equal);
+    TEST_ASSERT_FALSE(equal);
+    vector_approx_equal(a, b, 1e-2, &equal);
+    TEST_ASSERT_TRUE(equal);
+
+    b->elements[0] = NAN;
+    vector_approx_equal(a, b, INFINITY, &equal);
+    TEST_ASSERT_FALSE(equal);
+}
+
+static void test_ulp_equal(void) {
+    bool equal = false;
+    b->elements[500] = nextafter(b->elements[500], INFINITY);
+    b->elements[501] = nextafter(b->elements[501], -INFINITY);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_ulp_equal(a, b, 1, &equal));
+    TEST_ASSERT_TRUE(equal);
+    vector_ulp_equal(a, b, 0, &equal);
+    TEST_ASSERT_FALSE(equal);
+
+    // Signed zeros are equal
+    a->elements[0] = 0.0;
+    b->elements[0] = -0.0;
+    vector_ulp_equal(a, b, 1, &equal);
+    TEST_ASSERT_TRUE(equal);
+}
+
+static void test_bitwise_equal(void) {
+    bool equal = false;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_bitwise_equal(a, b, &equal));
+    TEST_ASSERT_TRUE(equal);
+
+    b->elements[0] = -0.0;
+    vector_bitwise_equal(a, b, &equal);
+    TEST_ASSERT_FALSE(equal);
+
+    // Different sizes compare unequal rather than failing
+    Vector *c;
+    vector_create(3, &c);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_bitwise_equal(a, c, &equal));
+    TEST_ASSERT_FALSE(equal);
+    vector_free(c);
+}
+
+static void test_approx_zero(void) {
+    bool zero = false;
+    vector_zero(a);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_approx_zero(a, 0.0, &zero));
+    TEST_ASSERT_TRUE(zero);
+
+    a->elements[SIZE / 2] = -1e-9;
+    vector_approx_zero(a, 1e-10, &zero);
+    TEST_ASSERT_FALSE(zero);
+    vector_approx_zero(a, 1e-8, &zero);
+    TEST_ASSERT_TRUE(zero);
+}
+
+static void test_nan_and_finite_scans(void) {
+    bool flag = true;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_has_nan(a, &flag));
+    TEST_ASSERT_FALSE(flag);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_all_finite(a, &flag));
+    TEST_ASSERT_TRUE(flag);
+
+    a->elements[SIZE - 2] = -INFINITY;
+    vector_has_nan(a, &flag);
+    TEST_ASSERT_FALSE(flag);
+    vector_all_finite(a, &flag);
+    TEST_ASSERT_FALSE(flag);
+
+    a->elements[7] = NAN;
+    vector_has_nan(a, &flag);
+    TEST_ASSERT_TRUE(flag);
+}
+
+static void test_errors(void) {
+    bool flag;
+    Vector *c;
+    vector_create(3, &c);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          vector_approx_equal(a, c, 0.0, &flag));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL,
+                          vector_approx_equal(a, b, 0.0, NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, vector_has_nan(NULL, &flag));
+    vector_free(c);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_approx_equal);
+    RUN_TEST(test_ulp_equal);
+    RUN_TEST(test_bitwise_equal);
+    RUN_TEST(test_approx_zero);
+    RUN_TEST(test_nan_and_finite_scans);
+    RUN_TEST(test_errors);
+    return UNITY_END();
+}
@@ -0,0 +1,143 @@
+/**
+ * @file covariance_test.c
+ * @brief Tests for Gram, covariance and correlation matrices
+ * @date 18/10/26
+ */
+
+#include "covariance.h"
+#include "unity.h"
+
+#define COUNT 70
+#define LENGTH 1300
+
+static Vector *vectors[COUNT];
+static Matrix *out;
+
+void setUp(void) {
+    for (size_t v = 0; v < COUNT; v++) {
+        vector_create(LENGTH, &vectors[v]);
+        for (size_t i = 0; i < LENGTH; i++) {
+            vectors[v]->elements[i] = 3.0 + sin(0.37 * (v + 1) * (i + 1));
+        }
+    }
+    matrix_create(COUNT, COUNT, &out);
+}
+
+void tearDown(void) {
+    for (size_t v = 0; v < COUNT; v++) {
+        vector_free(vectors[v]);
+    }
+    matrix_free(out);
+}
+
+static double_t mean(const Vector *a) {
+    double_t sum = 0.0;
+    for (size_t i = 0; i < a->size; i++) {
+        sum += a->elements[i];
+    }
+    return sum / (double_t)a->size;
+}
+
+// Two-pass covariance, the textbook definition
+static double_t naive_covariance(const Vector *a, const Vector *b) {
+    const double_t ma = mean(a), mb = mean(b);
+    double_t sum = 0.0;
+    for (size_t i = 0; i < a->size; i++) {
+        sum += (a->elements[i] - ma) * (b->elements[i] - mb);
+    }
+    return sum / (double_t)(a->size - 1);
+}
+
+// Spans several KC panels, the last one partial
+static void test_gram_matches_dot_products(void) {
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_gram((const Vector *const *)vectors,
+                                      COUNT,
+                                      out));
+    for (size_t i = 0; i < COUNT; i++) {
+        for (size_t j = 0; j < COUNT; j++) {
+            double_t dot = 0.0;
+            for (size_t k = 0; k < LENGTH; k++) {
+                dot += vectors[i]->elements[k] * vectors[j]->elements[k];
+            }
+            TEST_ASSERT_DOUBLE_WITHIN(1e-12 * dot,
+                                      dot,
+                                      out->elements[i * COUNT + j]);
+        }
+    }
+}
+
+static void test_covariance_and_correlation(void) {
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_covariance((const Vector *const *)vectors,
+                                            COUNT,
+                                            out));
+    for (size_t i = 0; i < COUNT; i++) {
+        for (size_t j = 0; j < COUNT; j++) {
+            TEST_ASSERT_DOUBLE_WITHIN(1e-13,
+                                      naive_covariance(vectors[i],
+                                                       vectors[j]),
+                                      out->elements[i * COUNT + j]);
+        }
+    }
+
+    // A constant variable gets a zero row and column
+    for (size_t k = 0; k < LENGTH; k++) {
+        vectors[3]->elements[k] = 7.0;
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_correlation((const Vector *const *)vectors,
+                                             COUNT,
+                                             out));
+    for (size_t i = 0; i < COUNT; i++) {
+        for (size_t j = 0; j < COUNT; j++) {
+            double_t expected = 0.0;
+            if (i != 3 && j != 3) {
+                expected = naive_covariance(vectors[i], vectors[j]) /
+                           sqrt(naive_covariance(vectors[i], vectors[i]) *
+                                naive_covariance(vectors[j], vectors[j]));
+            }
+            TEST_ASSERT_DOUBLE_WITHIN(1e-12,
+                                      expected,
+                                      out->elements[i * COUNT + j]);
+        }
+    }
+}
+
+static void test_short_vectors(void) {
+    // Zero-length vectors with storage: the Gram matrix is all zeros
+    double_t storage[2] = {1.0, 2.0};
+    Vector empty[2] = {{&storage[0], 0, 0}, {&storage[1], 0, 0}};
+    const Vector *pair[2] = {&empty[0], &empty[1]};
+    Matrix *small;
+    matrix_create(2, 2, &small);
+    small->elements[0] = 5.0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_gram(pair, 2, small));
+    for (size_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(0.0, small->elements[i]);
+    }
+
+    // One sample has no variance
+    Vector single[2] = {{&storage[0], 1, 1}, {&storage[1], 1, 1}};
+    pair[0] = &single[0];
+    pair[1] = &single[1];
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          vector_covariance(pair, 2, small));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          vector_correlation(pair, 2, small));
+
+    // Mismatched lengths and output shape
+    pair[1] = vectors[0];
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, vector_gram(pair, 2, small));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          vector_gram((const Vector *const *)vectors, 2, out));
+    matrix_free(small);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_gram_matches_dot_products);
+    RUN_TEST(test_covariance_and_correlation);
+    RUN_TEST(test_short_vectors);
+    return UNITY_END();
+}
@@ -0,0 +1,310 @@
+/**
+ * @file eigen_test.c
+ * @brief Tests for eigensolvers, randomized SVD and PCA
+ * @date 18/10/26
+ */
+
+#include "eigen.h"
+#include "linalg.h"
+#include "unity.h"
+
+#define SIZE 60
+#define SAMPLES 200
+#define DIM 6
+
+static uint64_t seed;
+static Matrix *spectral;
+
+// Uniform in [-1, 1), reproducible across platforms
+static double_t next_random(void) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (double_t)(seed >> 11) / (double_t)(1ULL << 52) - 1.0;
+}
+
+// Eigenvalue i of spectral, a clear gap below the first
+static double_t expected_eigenvalue(size_t i) {
+    return i == 0 ? 2.0 * SIZE : (double_t)(SIZE - i);
+}
+
+// spectral = Q * diag(expected) * Q^T for a random orthogonal Q
+void setUp(void) {
+    seed = 11;
+    Matrix *a, *qr, *q;
+    Vector *tau;
+    matrix_create(SIZE, SIZE, &a);
+    matrix_create(SIZE, SIZE, &qr);
+    matrix_create(SIZE, SIZE, &q);
+    vector_create(SIZE, &tau);
+    for (size_t i = 0; i < SIZE * SIZE; i++) {
+        a->elements[i] = next_random();
+    }
+    matrix_qr(a, qr, tau);
+    matrix_qr_unpack(qr, tau, q, NULL);
+
+    matrix_create(SIZE, SIZE, &spectral);
+    for (size_t i = 0; i < SIZE; i++) {
+        for (size_t j = 0; j < SIZE; j++) {
+            double_t sum = 0.0;
+            for (size_t p = 0; p < SIZE; p++) {
+                sum += q->elements[i * SIZE + p] * expected_eigenvalue(p) *
+                       q->elements[j * SIZE + p];
+            }
+            spectral->elements[i * SIZE + j] = sum;
+        }
+    }
+
+    matrix_free(a);
+    matrix_free(qr);
+    matrix_free(q);
+    vector_free(tau);
+}
+
+void tearDown(void) {
+    matrix_free(spectral);
+}
+
+// Largest |a * v - lambda * v| over the columns of vectors
+static double_t eigen_residual(const Matrix *a,
+                               const Vector *values,
+                               const Matrix *vectors) {
+    const size_t n = a->rows, k = values->size;
+    double_t worst = 0.0;
+    for (size_t c = 0; c < k; c++) {
+        for (size_t i = 0; i < n; i++) {
+            double_t av = 0.0;
+            for (size_t p = 0; p < n; p++) {
+                av += a->elements[i * n + p] * vectors->elements[p * k + c];
+            }
+            const double_t v = vectors->elements[i * k + c];
+            worst = fmax(worst, fabs(av - values->elements[c] * v));
+        }
+    }
+    return worst;
+}
+
+static void test_symmetric_all_pairs(void) {
+    Vector *values;
+    Matrix *vectors;
+    vector_create(SIZE, &values);
+    matrix_create(SIZE, SIZE, &vectors);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          matrix_eigen_symmetric(spectral, values, vectors));
+    for (size_t i = 0; i < SIZE; i++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-10,
+                                  expected_eigenvalue(i),
+                                  values->elements[i]);
+    }
+    TEST_ASSERT_TRUE(eigen_residual(spectral, values, vectors) < 1e-9);
+
+    // Values only
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          matrix_eigen_symmetric(spectral, values, NULL));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-10, 2.0 * SIZE, values->elements[0]);
+
+    vector_free(values);
+    matrix_free(vectors);
+}
+
+static void test_power_iteration(void) {
+    Vector *v;
+    vector_create(SIZE, &v);
+    double_t lambda = 0.0;
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          matrix_power_iteration(spectral,
+                                                 v,
+                                                 1e-14,
+                                                 1000,
+                                                 &lambda));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-8, 2.0 * SIZE, lambda);
+
+    // Too few iterations to converge
+    for (size_t i = 0; i < SIZE; i++) {
+        v->elements[i] = 0.0;
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                          matrix_power_iteration(spectral,
+                                                 v,
+                                                 1e-14,
+                                                 1,
+                                                 &lambda));
+    vector_free(v);
+}
+
+static void test_topk_matches_full_solve(void) {
+    const size_t k = 5;
+    Vector *values;
+    Matrix *vectors;
+    vector_create(k, &values);
+    matrix_create(SIZE, k, &vectors);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          matrix_eigen_topk(spectral, k, values, vectors));
+    for (size_t i = 0; i < k; i++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-8,
+                                  expected_eigenvalue(i),
+                                  values->elements[i]);
+    }
+    TEST_ASSERT_TRUE(eigen_residual(spectral, values, vectors) < 1e-6);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          matrix_eigen_topk(spectral, 0, values, NULL));
+    vector_free(values);
+    matrix_free(vectors);
+}
+
+// A rank-3 matrix is captured exactly by a rank-3 randomized SVD
+static void test_svd_randomized_low_rank(void) {
+    const size_t m = 100, n = 40, rank = 3;
+    Matrix *b, *c, *a, *ata, *u, *vt;
+    matrix_create(m, rank, &b);
+    matrix_create(rank, n, &c);
+    matrix_create(m, n, &a);
+    matrix_create(n, n, &ata);
+    matrix_create(m, rank, &u);
+    matrix_create(rank, n, &vt);
+    for (size_t i = 0; i < m * rank; i++) {
+        b->elements[i] = next_random();
+    }
+    for (size_t i = 0; i < rank * n; i++) {
+        c->elements[i] = next_random();
+    }
+    matrix_mult(b, c, a);
+
+    Vector *singular, *eigen;
+    vector_create(rank, &singular);
+    vector_create(n, &eigen);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          matrix_svd_randomized(a,
+                                                rank,
+                                                5,
+                                                1,
+                                                singular,
+                                                u,
+                                                vt));
+
+    // Singular values are the square roots of the eigenvalues of a^T * a
+    Matrix *at;
+    matrix_create(n, m, &at);
+    matrix_transpose(a, at);
+    matrix_mult(at, a, ata);
+    matrix_eigen_symmetric(ata, eigen, NULL);
+    for (size_t i = 0; i < rank; i++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9 * singular->elements[0],
+                                  sqrt(eigen->elements[i]),
+                                  singular->elements[i]);
+    }
+
+    // u * diag(s) * vt reproduces a
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
+            double_t sum = 0.0;
+            for (size_t p = 0; p < rank; p++) {
+                sum += u->elements[i * rank + p] * singular->elements[p] *
+                       vt->elements[p * n + j];
+            }
+            TEST_ASSERT_DOUBLE_WITHIN(1e-10, a->elements[i * n + j], sum);
+        }
+    }
+
+    matrix_free(b);
+    matrix_free(c);
+    matrix_free(a);
+    matrix_free(at);
+    matrix_free(ata);
+    matrix_free(u);
+    matrix_free(vt);
+    vector_free(singular);
+    vector_free(eigen);
+}
+
+// Samples on a plane spanned by two orthonormal directions around an offset
+static void test_pca_recovers_plane(void) {
+    const double_t r = sqrt(0.5);
+    const double_t u1[DIM] = {r, r, 0, 0, 0, 0};
+    const double_t u2[DIM] = {0, 0, 0, 1, 0, 0};
+    Vector *samples[SAMPLES];
+    double_t mean[DIM] = {0};
+    for (size_t s = 0; s < SAMPLES; s++) {
+        const double_t a = 10.0 * next_random(), b = next_random();
+        vector_create(DIM, &samples[s]);
+        for (size_t c = 0; c < DIM; c++) {
+            samples[s]->elements[c] = 5.0 + a * u1[c] + b * u2[c];
+            mean[c] += samples[s]->elements[c] / SAMPLES;
+        }
+    }
+
+    // Reference: top eigenvalues of the sample covariance
+    Matrix *cov;
+    Vector *eigen;
+    matrix_create(DIM, DIM, &cov);
+    vector_create(DIM, &eigen);
+    for (size_t i = 0; i < DIM; i++) {
+        for (size_t j = 0; j < DIM; j++) {
+            double_t sum = 0.0;
+            for (size_t s = 0; s < SAMPLES; s++) {
+                sum += (samples[s]->elements[i] - mean[i]) *
+                       (samples[s]->elements[j] - mean[j]);
+            }
+            cov->elements[i * DIM + j] = sum / (SAMPLES - 1);
+        }
+    }
+    matrix_eigen_symmetric(cov, eigen, NULL);
+
+    NumenPCA *pca;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_pca_fit((const Vector *const *)samples,
+                                        SAMPLES,
+                                        2,
+                                        &pca));
+    Vector *variance, *coords;
+    vector_create(2, &variance);
+    vector_create(2, &coords);
+    numen_pca_explained_variance(pca, variance);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, eigen->elements[0], variance->elements[0]);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, eigen->elements[1], variance->elements[1]);
+
+    // The plane is captured whole, so projection keeps centered lengths
+    Matrix *batch;
+    matrix_create(SAMPLES, 2, &batch);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_pca_project_batch(pca,
+                                                  (const Vector *const *)
+                                                      samples,
+                                                  SAMPLES,
+                                                  batch));
+    for (size_t s = 0; s < SAMPLES; s++) {
+        double_t length = 0.0;
+        for (size_t c = 0; c < DIM; c++) {
+            const double_t d = samples[s]->elements[c] - mean[c];
+            length += d * d;
+        }
+        numen_pca_project(pca, samples[s], coords);
+        const double_t x = coords->elements[0], y = coords->elements[1];
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, length, x * x + y * y);
+        TEST_ASSERT_DOUBLE_WITHIN(1e-12, x, batch->elements[s * 2]);
+        TEST_ASSERT_DOUBLE_WITHIN(1e-12, y, batch->elements[s * 2 + 1]);
+    }
+
+    for (size_t s = 0; s < SAMPLES; s++) {
+        vector_free(samples[s]);
+    }
+    matrix_free(cov);
+    vector_free(eigen);
+    vector_free(variance);
+    vector_free(coords);
+    matrix_free(batch);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_pca_free(pca));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_pca_free(NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_symmetric_all_pairs);
+    RUN_TEST(test_power_iteration);
+    RUN_TEST(test_topk_matches_full_solve);
+    RUN_TEST(test_svd_randomized_low_rank);
+    RUN_TEST(test_pca_recovers_plane);
+    return UNITY_END();
+}
@@ -0,0 +1,159 @@
+/**
+ * @file gather_test.c
+ * @brief Tests for indexed gather, scatter and scatter-add
+ * @date 18/10/26
+ */
+
+#include "gather.h"
+#include "unity.h"
+#include <stdlib.h>
+
+#define SRC_SIZE 97
+#define COUNT 1000
+
+static Vector *src;
+static Vector *values;
+static size_t indices[COUNT];
+
+void setUp(void) {
+    vector_create(SRC_SIZE, &src);
+    vector_create(COUNT, &values);
+    for (size_t i = 0; i < SRC_SIZE; i++) {
+        src->elements[i] = (double_t)i * 1.5;
+    }
+    // Many duplicates, in no particular order
+    for (size_t i = 0; i < COUNT; i++) {
+        indices[i] = (i * 31 + 7) % SRC_SIZE;
+        values->elements[i] = (double_t)(i % 5);
+    }
+}
+
+void tearDown(void) {
+    vector_free(src);
+    vector_free(values);
+}
+
+static void test_gather(void) {
+    Vector *out;
+    vector_create(COUNT, &out);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_gather(src, indices, out));
+    for (size_t i = 0; i < COUNT; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(src->elements[indices[i]], out->elements[i]);
+    }
+    vector_free(out);
+}
+
+static void test_scatter_last_value_wins(void) {
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_scatter(values, indices, src));
+
+    double_t expected[SRC_SIZE];
+    for (size_t i = 0; i < SRC_SIZE; i++) {
+        expected[i] = (double_t)i * 1.5;
+    }
+    for (size_t i = 0; i < COUNT; i++) {
+        expected[indices[i]] = values->elements[i];
+    }
+    for (size_t i = 0; i < SRC_SIZE; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(expected[i], src->elements[i]);
+    }
+}
+
+static void test_scatter_add_accumulates_duplicates(void) {
+    vector_zero(src);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_scatter_add(values, indices, src));
+
+    double_t expected[SRC_SIZE] = {0};
+    for (size_t i = 0; i < COUNT; i++) {
+        expected[indices[i]] += values->elements[i];
+    }
+    for (size_t i = 0; i < SRC_SIZE; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(expected[i], src->elements[i]);
+    }
+}
+
+static void test_scatter_add_parallel_matches_serial(void) {
+    // Large enough to be split over the pool
+    const size_t count = 1 << 20;
+    Vector *many, *serial, *parallel;
+    size_t *many_indices = malloc(count * sizeof(size_t));
+    TEST_ASSERT_NOT_NULL(many_indices);
+    vector_create(count, &many);
+    vector_create(SRC_SIZE, &serial);
+    vector_create(SRC_SIZE, &parallel);
+    for (size_t i = 0; i < count; i++) {
+        many_indices[i] = (i * 2654435761u) % SRC_SIZE;
+        many->elements[i] = (double_t)(i % 3);
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_scatter_add(many, many_indices, serial));
+    TEST_ASSERT_EQUAL_INT(
+        VECTOR_SUCCESS,
+        vector_scatter_add_parallel(many, many_indices, parallel));
+    // Small integers sum exactly in any order
+    for (size_t i = 0; i < SRC_SIZE; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(serial->elements[i], parallel->elements[i]);
+    }
+
+    free(many_indices);
+    vector_free(many);
+    vector_free(serial);
+    vector_free(parallel);
+}
+
+// Few updates into a large dest: no private copies, same result
+static void test_scatter_add_parallel_sparse(void) {
+    const size_t count = 1 << 16, dest_size = 1 << 22;
+    Vector *updates, *serial, *parallel;
+    size_t *sparse_indices = malloc(count * sizeof(size_t));
+    TEST_ASSERT_NOT_NULL(sparse_indices);
+    vector_create(count, &updates);
+    vector_create(dest_size, &serial);
+    vector_create(dest_size, &parallel);
+    for (size_t i = 0; i < count; i++) {
+        sparse_indices[i] = (i * 2654435761u) % dest_size;
+        updates->elements[i] = 0.25 * (double_t)(i % 7);
+    }
+
+    vector_scatter_add(updates, sparse_indices, serial);
+    TEST_ASSERT_EQUAL_INT(
+        VECTOR_SUCCESS,
+        vector_scatter_add_parallel(updates, sparse_indices, parallel));
+    for (size_t i = 0; i < count; i++) {
+        const size_t index = sparse_indices[i];
+        TEST_ASSERT_EQUAL_DOUBLE(serial->elements[index],
+                                 parallel->elements[index]);
+    }
+
+    free(sparse_indices);
+    vector_free(updates);
+    vector_free(serial);
+    vector_free(parallel);
+}
+
+static void test_out_of_range_index_writes_nothing(void) {
+    indices[COUNT - 1] = SRC_SIZE;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INDEX,
+                          vector_scatter(values, indices, src));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INDEX,
+                          vector_scatter_add(values, indices, src));
+    for (size_t i = 0; i < SRC_SIZE; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE((double_t)i * 1.5, src->elements[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL,
+                          vector_gather(src, NULL, values));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_gather);
+    RUN_TEST(test_scatter_last_value_wins);
+    RUN_TEST(test_scatter_add_accumulates_duplicates);
+    RUN_TEST(test_scatter_add_parallel_matches_serial);
+    RUN_TEST(test_scatter_add_parallel_sparse);
+    RUN_TEST(test_out_of_range_index_writes_nothing);
+    return UNITY_END();
+}
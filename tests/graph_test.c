@@ -0,0 +1,150 @@
+/**
+ * @file graph_test.c
+ * @brief Tests for task graphs of dependent vector operations
+ * @date 18/10/26
+ */
+
+#include "graph.h"
+#include "unity.h"
+#include <stdatomic.h>
+
+#define SIZE 200000
+
+static NumenGraph *graph;
+static Vector *a;
+static Vector *b;
+static Vector *c;
+
+void setUp(void) {
+    numen_graph_create(&graph);
+    vector_create(SIZE, &a);
+    vector_create(SIZE, &b);
+    vector_create(SIZE, &c);
+    for (size_t i = 0; i < SIZE; i++) {
+        a->elements[i] = (double_t)(i % 7);
+        b->elements[i] = 2.0;
+    }
+}
+
+void tearDown(void) {
+    numen_graph_free(graph);
+    vector_free(a);
+    vector_free(b);
+    vector_free(c);
+}
+
+// Appends its tag to a shared log, to check execution order
+typedef struct {
+    atomic_size_t *position;
+    int *log;
+    int tag;
+} OrderArg;
+
+static int record_order(void *arg) {
+    OrderArg *order = arg;
+    order->log[atomic_fetch_add(order->position, 1)] = order->tag;
+    return VECTOR_SUCCESS;
+}
+
+static int fail_math(void *arg) {
+    (void)arg;
+    return VECTOR_ERROR_MATH;
+}
+
+static void test_inferred_dependencies(void) {
+    // c = a + b; c = c * b; a = a - a (write after read of a); dot(c, b)
+    double_t dot = 0.0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_graph_add(graph, a, b, c, NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_graph_mult(graph, c, b, c, NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_graph_sub(graph, a, a, a, NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_graph_dot(graph, c, b, &dot, NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_graph_run(graph));
+
+    // Sum over i of 4 * (i % 7 + 2)
+    double_t expected = 0.0;
+    for (size_t i = 0; i < SIZE; i++) {
+        expected += 4.0 * ((double_t)(i % 7) + 2.0);
+        TEST_ASSERT_EQUAL_DOUBLE(0.0, a->elements[i]);
+    }
+    TEST_ASSERT_EQUAL_DOUBLE(expected, dot);
+}
+
+static void test_rerun_is_deterministic(void) {
+    double_t dot = 0.0;
+    numen_graph_scale(graph, a, 0.1, c, NULL);
+    numen_graph_dot(graph, c, c, &dot, NULL);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_graph_run(graph));
+
+    const double_t first = dot;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_graph_run(graph));
+    TEST_ASSERT_TRUE(first == dot);
+
+    // Matches the serial dot product to rounding
+    double_t serial;
+    vector_dot(c, c, &serial);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9 * serial, serial, dot);
+}
+
+static void test_explicit_dependencies_order_custom_nodes(void) {
+    atomic_size_t position = 0;
+    int log[3] = {0};
+    OrderArg first = {&position, log, 1};
+    OrderArg second = {&position, log, 2};
+    OrderArg third = {&position, log, 3};
+
+    NumenNode n1, n2, n3;
+    numen_graph_custom(graph, record_order, &first, &n1);
+    numen_graph_custom(graph, record_order, &second, &n2);
+    numen_graph_custom(graph, record_order, &third, &n3);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_graph_depend(graph, n2, n1));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_graph_depend(graph, n3, n2));
+
+    for (int run = 0; run < 20; run++) {
+        atomic_store(&position, 0);
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_graph_run(graph));
+        TEST_ASSERT_EQUAL_INT(1, log[0]);
+        TEST_ASSERT_EQUAL_INT(2, log[1]);
+        TEST_ASSERT_EQUAL_INT(3, log[2]);
+    }
+}
+
+static void test_failure_skips_dependents(void) {
+    atomic_size_t position = 0;
+    int log[1] = {0};
+    OrderArg after = {&position, log, 1};
+
+    NumenNode failing, dependent;
+    numen_graph_custom(graph, fail_math, NULL, &failing);
+    numen_graph_custom(graph, record_order, &after, &dependent);
+    numen_graph_depend(graph, dependent, failing);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH, numen_graph_run(graph));
+    TEST_ASSERT_EQUAL_size_t(0, atomic_load(&position));
+}
+
+static void test_errors(void) {
+    Vector *small;
+    vector_create(3, &small);
+    numen_graph_add(graph, a, small, c, NULL);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, numen_graph_run(graph));
+    vector_free(small);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL,
+                          numen_graph_add(NULL, a, b, c, NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_graph_run(NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_graph_free(NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_inferred_dependencies);
+    RUN_TEST(test_rerun_is_deterministic);
+    RUN_TEST(test_explicit_dependencies_order_custom_nodes);
+    RUN_TEST(test_failure_skips_dependents);
+    RUN_TEST(test_errors);
+    return UNITY_END();
+}
@@ -0,0 +1,231 @@
+/**
+ * @file intvec_test.c
+ * @brief Tests for int32, int64 and saturating uint8 vectors
+ * @date 18/10/26
+ */
+
+#include "intvec.h"
+#include "unity.h"
+
+// Not a multiple of any SIMD width, so the scalar tails run
+#define SIZE 1003
+
+static VectorI32 *a32, *b32, *r32;
+static VectorI64 *a64, *b64, *r64;
+static VectorU8 *a8, *b8, *r8;
+
+void setUp(void) {
+    vector_i32_create(SIZE, &a32);
+    vector_i32_create(SIZE, &b32);
+    vector_i32_create(SIZE, &r32);
+    vector_i64_create(SIZE, &a64);
+    vector_i64_create(SIZE, &b64);
+    vector_i64_create(SIZE, &r64);
+    vector_u8_create(SIZE, &a8);
+    vector_u8_create(SIZE, &b8);
+    vector_u8_create(SIZE, &r8);
+    for (size_t i = 0; i < SIZE; i++) {
+        a32->elements[i] = (int32_t)(i * 7919 % 2001) - 1000;
+        b32->elements[i] = (int32_t)(i * 104729 % 501) - 250;
+        a64->elements[i] = (int64_t)a32->elements[i] * 3000000;
+        b64->elements[i] = b32->elements[i];
+        a8->elements[i] = (uint8_t)(i * 37 % 256);
+        b8->elements[i] = (uint8_t)(i * 91 % 256);
+    }
+}
+
+void tearDown(void) {
+    vector_i32_free(a32);
+    vector_i32_free(b32);
+    vector_i32_free(r32);
+    vector_i64_free(a64);
+    vector_i64_free(b64);
+    vector_i64_free(r64);
+    vector_u8_free(a8);
+    vector_u8_free(b8);
+    vector_u8_free(r8);
+}
+
+static uint8_t saturate(int value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : (uint8_t)value);
+}
+
+static void test_elementwise_match_scalar(void) {
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_i32_mult(a32, b32, r32));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_i64_sub(a64, b64, r64));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_u8_add(a8, b8, r8));
+    for (size_t i = 0; i < SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT32(a32->elements[i] * b32->elements[i],
+                                r32->elements[i]);
+        TEST_ASSERT_EQUAL_INT64(a64->elements[i] - b64->elements[i],
+                                r64->elements[i]);
+        TEST_ASSERT_EQUAL_UINT8(saturate(a8->elements[i] + b8->elements[i]),
+                                r8->elements[i]);
+    }
+
+    vector_u8_sub(a8, b8, r8);
+    for (size_t i = 0; i < SIZE; i++) {
+        TEST_ASSERT_EQUAL_UINT8(saturate(a8->elements[i] - b8->elements[i]),
+                                r8->elements[i]);
+    }
+    vector_u8_mult(a8, b8, r8);
+    for (size_t i = 0; i < SIZE; i++) {
+        TEST_ASSERT_EQUAL_UINT8(saturate(a8->elements[i] * b8->elements[i]),
+                                r8->elements[i]);
+    }
+
+    // The result may alias an operand
+    const int32_t before = a32->elements[SIZE - 1];
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_i32_add(a32, b32, a32));
+    TEST_ASSERT_EQUAL_INT32(before + b32->elements[SIZE - 1],
+                            a32->elements[SIZE - 1]);
+
+    VectorI32 *short32;
+    vector_i32_create(SIZE - 1, &short32);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          vector_i32_add(a32, short32, r32));
+    vector_i32_free(short32);
+}
+
+static void test_signed_wraps_unsigned_saturates(void) {
+    const int32_t big[2] = {INT32_MAX, INT32_MIN};
+    const int32_t one[2] = {1, 1};
+    VectorI32 *x, *y;
+    vector_i32_from_array(big, 2, &x);
+    vector_i32_from_array(one, 2, &y);
+    vector_i32_add(x, y, x);
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, x->elements[0]);
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN + 1, x->elements[1]);
+    vector_i32_sub(x, y, x);
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, x->elements[0]);
+    vector_i32_free(x);
+    vector_i32_free(y);
+
+    const uint8_t high[2] = {200, 5};
+    const uint8_t step[2] = {100, 10};
+    VectorU8 *u, *v;
+    vector_u8_from_array(high, 2, &u);
+    vector_u8_from_array(step, 2, &v);
+    vector_u8_add(u, v, u);
+    TEST_ASSERT_EQUAL_UINT8(255, u->elements[0]);
+    vector_u8_sub(v, u, v);
+    TEST_ASSERT_EQUAL_UINT8(0, v->elements[0]);
+    TEST_ASSERT_EQUAL_UINT8(0, v->elements[1]);
+    vector_u8_free(u);
+    vector_u8_free(v);
+}
+
+static void test_reductions(void) {
+    int64_t sum32 = 0, sum64 = 0, dot32 = 0;
+    uint64_t sum8 = 0, dot8 = 0;
+    int64_t reference32 = 0, reference64 = 0, reference_dot32 = 0;
+    uint64_t reference8 = 0, reference_dot8 = 0;
+    for (size_t i = 0; i < SIZE; i++) {
+        reference32 += a32->elements[i];
+        reference64 += a64->elements[i];
+        reference_dot32 += (int64_t)a32->elements[i] * b32->elements[i];
+        reference8 += a8->elements[i];
+        reference_dot8 += (uint64_t)a8->elements[i] * b8->elements[i];
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_i32_sum(a32, &sum32));
+    TEST_ASSERT_EQUAL_INT64(reference32, sum32);
+    vector_i64_sum(a64, &sum64);
+    TEST_ASSERT_EQUAL_INT64(reference64, sum64);
+    vector_u8_sum(a8, &sum8);
+    TEST_ASSERT_EQUAL_UINT64(reference8, sum8);
+    vector_i32_dot(a32, b32, &dot32);
+    TEST_ASSERT_EQUAL_INT64(reference_dot32, dot32);
+    vector_u8_dot(a8, b8, &dot8);
+    TEST_ASSERT_EQUAL_UINT64(reference_dot8, dot8);
+
+    // int32 sums do not overflow at 32 bits
+    for (size_t i = 0; i < SIZE; i++) {
+        a32->elements[i] = INT32_MAX;
+    }
+    vector_i32_sum(a32, &sum32);
+    TEST_ASSERT_EQUAL_INT64((int64_t)INT32_MAX * SIZE, sum32);
+
+    int32_t min32, max32;
+    uint8_t min8, max8;
+    b32->elements[SIZE - 1] = -5000;
+    b32->elements[SIZE - 2] = 5000;
+    vector_i32_min(b32, &min32);
+    vector_i32_max(b32, &max32);
+    TEST_ASSERT_EQUAL_INT32(-5000, min32);
+    TEST_ASSERT_EQUAL_INT32(5000, max32);
+    vector_u8_min(a8, &min8);
+    vector_u8_max(a8, &max8);
+    TEST_ASSERT_EQUAL_UINT8(0, min8);
+    TEST_ASSERT_EQUAL_UINT8(255, max8);
+}
+
+static void test_counting(void) {
+    const size_t indices[6] = {2, 0, 2, 2, 1, 2};
+    VectorI64 *counts;
+    VectorU8 *saturating;
+    vector_i64_create(3, &counts);
+    vector_u8_create(3, &saturating);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_i64_increment(counts, indices, 6));
+    TEST_ASSERT_EQUAL_INT64(1, counts->elements[0]);
+    TEST_ASSERT_EQUAL_INT64(4, counts->elements[2]);
+
+    // Counters stop at 255
+    for (int round = 0; round < 100; round++) {
+        vector_u8_increment(saturating, indices, 6);
+    }
+    TEST_ASSERT_EQUAL_UINT8(100, saturating->elements[0]);
+    TEST_ASSERT_EQUAL_UINT8(255, saturating->elements[2]);
+
+    // A bad index late in the array leaves every counter untouched
+    const size_t bad[3] = {0, 1, 3};
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INDEX,
+                          vector_i64_increment(counts, bad, 3));
+    TEST_ASSERT_EQUAL_INT64(1, counts->elements[0]);
+
+    const int64_t values[6] = {10, 20, 30, 40, 50, 60};
+    VectorI64 *added;
+    vector_i64_from_array(values, 6, &added);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_i64_scatter_add(added, indices, counts));
+    TEST_ASSERT_EQUAL_INT64(21, counts->elements[0]);
+    TEST_ASSERT_EQUAL_INT64(51, counts->elements[1]);
+    TEST_ASSERT_EQUAL_INT64(4 + 10 + 30 + 40 + 60, counts->elements[2]);
+
+    vector_i64_free(counts);
+    vector_i64_free(added);
+    vector_u8_free(saturating);
+}
+
+static void test_access_and_conversion(void) {
+    int32_t value = 0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_i32_set(a32, 3, -42));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_i32_get(a32, 3, &value));
+    TEST_ASSERT_EQUAL_INT32(-42, value);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INDEX,
+                          vector_i32_get(a32, SIZE, &value));
+
+    Vector *doubles;
+    vector_create(SIZE, &doubles);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_u8_to_vector(a8, doubles));
+    TEST_ASSERT_EQUAL_DOUBLE((double_t)a8->elements[10],
+                             doubles->elements[10]);
+    vector_i32_to_vector(a32, doubles);
+    TEST_ASSERT_EQUAL_DOUBLE(-42.0, doubles->elements[3]);
+    vector_free(doubles);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, vector_i32_free(NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, vector_u8_free(NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_elementwise_match_scalar);
+    RUN_TEST(test_signed_wraps_unsigned_saturates);
+    RUN_TEST(test_reductions);
+    RUN_TEST(test_counting);
+    RUN_TEST(test_access_and_conversion);
+    return UNITY_END();
+}
@@ -0,0 +1,126 @@
+/**
+ * @file jobs_test.c
+ * @brief Tests for batches of small heterogeneous jobs
+ * @date 18/10/26
+ */
+
+#include "jobs.h"
+#include "unity.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define JOBS 10000
+
+static atomic_int calls;
+
+void setUp(void) {
+    atomic_store(&calls, 0);
+}
+
+void tearDown(void) {}
+
+static int count_call(void *arg) {
+    (void)arg;
+    atomic_fetch_add(&calls, 1);
+    return VECTOR_SUCCESS;
+}
+
+static void test_mixed_batch(void) {
+    Vector *a, *b, *sum, *scaled;
+    vector_3d(1, 2, 3, &a);
+    vector_3d(4, 5, 6, &b);
+    vector_create(3, &sum);
+    vector_create(3, &scaled);
+    double_t dot = 0.0, magnitude = 0.0, fact = 0.0;
+
+    NumenJob jobs[] = {
+        {.type = NUMEN_JOB_VECTOR_ADD, .a = a, .b = b, .result = sum},
+        {.type = NUMEN_JOB_VECTOR_SCALE, .a = a, .scalar = 2, .result = scaled},
+        {.type = NUMEN_JOB_VECTOR_DOT, .a = a, .b = b, .out = &dot},
+        {.type = NUMEN_JOB_VECTOR_MAGNITUDE, .a = b, .out = &magnitude},
+        {.type = NUMEN_JOB_FACTORIAL, .scalar = 5, .out = &fact},
+        {.type = NUMEN_JOB_CUSTOM, .fn = count_call},
+    };
+    const size_t count = sizeof(jobs) / sizeof(jobs[0]);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_batch_run(jobs, count));
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, jobs[i].status);
+    }
+    TEST_ASSERT_EQUAL_DOUBLE(9.0, sum->elements[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(6.0, scaled->elements[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(32.0, dot);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, sqrt(77.0), magnitude);
+    TEST_ASSERT_EQUAL_DOUBLE(120.0, fact);
+    TEST_ASSERT_EQUAL_INT(1, atomic_load(&calls));
+
+    vector_free(a);
+    vector_free(b);
+    vector_free(sum);
+    vector_free(scaled);
+}
+
+static void test_many_jobs_all_run(void) {
+    NumenJob *jobs = calloc(JOBS, sizeof(NumenJob));
+    TEST_ASSERT_NOT_NULL(jobs);
+    for (size_t i = 0; i < JOBS; i++) {
+        jobs[i].type = NUMEN_JOB_CUSTOM;
+        jobs[i].fn = count_call;
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_batch_run(jobs, JOBS));
+    TEST_ASSERT_EQUAL_INT(JOBS, atomic_load(&calls));
+    free(jobs);
+}
+
+static void test_first_failure_in_array_order(void) {
+    Vector *a, *small;
+    vector_3d(1, 2, 3, &a);
+    vector_2d(1, 2, &small);
+    double_t out = 0.0;
+
+    NumenJob jobs[] = {
+        {.type = NUMEN_JOB_CUSTOM, .fn = count_call},
+        {.type = NUMEN_JOB_VECTOR_DOT, .a = a, .b = small, .out = &out},
+        {.type = NUMEN_JOB_FACTORIAL, .scalar = -1, .out = &out},
+        {.type = NUMEN_JOB_CUSTOM, .fn = count_call},
+    };
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, numen_batch_run(jobs, 4));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, jobs[0].status);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, jobs[1].status);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH, jobs[2].status);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, jobs[3].status);
+    TEST_ASSERT_EQUAL_INT(2, atomic_load(&calls));
+
+    vector_free(a);
+    vector_free(small);
+}
+
+static void test_batch_submit_after_dependency(void) {
+    NumenJob first[64], second[64];
+    for (size_t i = 0; i < 64; i++) {
+        first[i] = (NumenJob){.type = NUMEN_JOB_CUSTOM, .fn = count_call};
+        second[i] = first[i];
+    }
+
+    NumenFuture *a, *b;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_batch_submit(first, 64, NULL, 0, &a));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_batch_submit(second, 64, &a, 1, &b));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_wait(b));
+    TEST_ASSERT_EQUAL_INT(128, atomic_load(&calls));
+
+    numen_future_free(a);
+    numen_future_free(b);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mixed_batch);
+    RUN_TEST(test_many_jobs_all_run);
+    RUN_TEST(test_first_failure_in_array_order);
+    RUN_TEST(test_batch_submit_after_dependency);
+    return UNITY_END();
+}
@@ -0,0 +1,166 @@
+/**
+ * @file krylov_test.c
+ * @brief Tests for CG, BiCGSTAB and GMRES
+ * @date 18/10/26
+ */
+
+#include "krylov.h"
+#include "unity.h"
+
+#define SIZE 500
+#define NONZEROS (3 * SIZE - 2)
+
+static double_t values[NONZEROS];
+static size_t columns[NONZEROS];
+static size_t offsets[SIZE + 1];
+static SparseMatrix matrix;
+static Vector *diagonal, *b, *x;
+static NumenOperator op;
+
+// Tridiagonal with growing diagonal, symmetric when lower == upper
+static void build_tridiagonal(double_t lower, double_t upper) {
+    size_t k = 0;
+    for (size_t i = 0; i < SIZE; i++) {
+        offsets[i] = k;
+        if (i > 0) {
+            values[k] = lower;
+            columns[k++] = i - 1;
+        }
+        values[k] = 2.5 + (double_t)i / 10.0;
+        columns[k++] = i;
+        if (i + 1 < SIZE) {
+            values[k] = upper;
+            columns[k++] = i + 1;
+        }
+    }
+    offsets[SIZE] = k;
+    matrix = (SparseMatrix){values, columns, offsets, SIZE, SIZE};
+    numen_operator_sparse(&matrix, diagonal, &op);
+}
+
+void setUp(void) {
+    vector_create(SIZE, &diagonal);
+    vector_create(SIZE, &b);
+    vector_create(SIZE, &x);
+    for (size_t i = 0; i < SIZE; i++) {
+        b->elements[i] = sin((double_t)i);
+    }
+}
+
+void tearDown(void) {
+    vector_free(diagonal);
+    vector_free(b);
+    vector_free(x);
+}
+
+// ||b - A x|| / ||b|| computed independently of the solver
+static double_t relative_residual(void) {
+    Vector *ax;
+    vector_create(SIZE, &ax);
+    sparse_mult_vector(&matrix, x, ax);
+    double_t r = 0.0, nb = 0.0;
+    for (size_t i = 0; i < SIZE; i++) {
+        const double_t d = b->elements[i] - ax->elements[i];
+        r += d * d;
+        nb += b->elements[i] * b->elements[i];
+    }
+    vector_free(ax);
+    return sqrt(r / nb);
+}
+
+static void test_cg_spd(void) {
+    build_tridiagonal(-1.0, -1.0);
+    NumenSolverStats plain, jacobi;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_cg(&op, b, x, NULL, &plain));
+    TEST_ASSERT_TRUE(relative_residual() < 1e-9);
+    TEST_ASSERT_TRUE(plain.residual <= 1e-10);
+
+    NumenSolverConfig config;
+    numen_solver_config_default(&config);
+    config.preconditioner = NUMEN_PRECONDITIONER_JACOBI;
+    for (size_t i = 0; i < SIZE; i++) {
+        x->elements[i] = 0.0;
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_cg(&op, b, x, &config, &jacobi));
+    TEST_ASSERT_TRUE(relative_residual() < 1e-9);
+    TEST_ASSERT_TRUE(jacobi.iterations <= plain.iterations);
+}
+
+static void test_nonsymmetric_solvers(void) {
+    build_tridiagonal(-1.4, -0.6);
+    NumenSolverStats stats;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_bicgstab(&op, b, x, NULL, &stats));
+    TEST_ASSERT_TRUE(relative_residual() < 1e-9);
+
+    // Restarts more often than the solve needs iterations
+    NumenSolverConfig config;
+    numen_solver_config_default(&config);
+    config.restart = 10;
+    config.preconditioner = NUMEN_PRECONDITIONER_JACOBI;
+    for (size_t i = 0; i < SIZE; i++) {
+        x->elements[i] = 0.0;
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_gmres(&op, b, x, &config, &stats));
+    TEST_ASSERT_TRUE(relative_residual() < 1e-9);
+    TEST_ASSERT_TRUE(stats.iterations > config.restart);
+}
+
+static int apply_scaled(void *ctx, const Vector *in, Vector *out) {
+    const double_t *scale = ctx;
+    for (size_t i = 0; i < in->size; i++) {
+        out->elements[i] = (*scale + (double_t)i) * in->elements[i];
+    }
+    return VECTOR_SUCCESS;
+}
+
+static void test_matrix_free_operator(void) {
+    double_t scale = 1.0;
+    NumenOperator diag_op = {.size = SIZE,
+                             .apply = apply_scaled,
+                             .ctx = &scale};
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_cg(&diag_op, b, x, NULL, NULL));
+    for (size_t i = 0; i < SIZE; i++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9,
+                                  b->elements[i] / (1.0 + (double_t)i),
+                                  x->elements[i]);
+    }
+
+    // Jacobi needs a diagonal
+    NumenSolverConfig config;
+    numen_solver_config_default(&config);
+    config.preconditioner = NUMEN_PRECONDITIONER_JACOBI;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INVALID_ARG,
+                          numen_cg(&diag_op, b, x, &config, NULL));
+}
+
+static void test_failures_reported(void) {
+    build_tridiagonal(-1.0, -1.0);
+    NumenSolverConfig config;
+    numen_solver_config_default(&config);
+    config.max_iterations = 2;
+    NumenSolverStats stats;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                          numen_cg(&op, b, x, &config, &stats));
+    TEST_ASSERT_TRUE(stats.residual > config.tolerance);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INVALID_ARG,
+                          numen_gmres(&op, b, b, NULL, NULL));
+    Vector *small;
+    vector_create(SIZE - 1, &small);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          numen_bicgstab(&op, b, small, NULL, NULL));
+    vector_free(small);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_cg_spd);
+    RUN_TEST(test_nonsymmetric_solvers);
+    RUN_TEST(test_matrix_free_operator);
+    RUN_TEST(test_failures_reported);
+    return UNITY_END();
+}
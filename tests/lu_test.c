@@ -0,0 +1,213 @@
+/**
+ * @file lu_test.c
+ * @brief Tests for LU factorization and dense linear solves
+ * @date 18/10/26
+ */
+
+#include "linalg.h"
+#include "unity.h"
+#include <stdlib.h>
+
+#define SIZE 150
+#define BATCH 20
+
+static uint64_t seed;
+
+void setUp(void) {
+    seed = 42;
+}
+
+void tearDown(void) {}
+
+// Uniform in [-1, 1), reproducible across platforms
+static double_t next_random(void) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (double_t)(seed >> 11) / (double_t)(1ULL << 52) - 1.0;
+}
+
+static void fill_random(Matrix *m) {
+    for (size_t i = 0; i < m->rows * m->cols; i++) {
+        m->elements[i] = next_random();
+    }
+}
+
+// Largest |a * x - b| relative to |b|
+static double_t residual(const Matrix *a, const Vector *x, const Vector *b) {
+    Vector *ax;
+    vector_create(b->size, &ax);
+    matrix_mult_vector(a, x, ax);
+    double_t worst = 0.0, scale = 0.0;
+    for (size_t i = 0; i < b->size; i++) {
+        worst = fmax(worst, fabs(ax->elements[i] - b->elements[i]));
+        scale = fmax(scale, fabs(b->elements[i]));
+    }
+    vector_free(ax);
+    return worst / scale;
+}
+
+// Larger than LU_BLOCK so the trailing updates run
+static void test_solve_large_system(void) {
+    Matrix *a;
+    Vector *b, *x;
+    matrix_create(SIZE, SIZE, &a);
+    vector_create(SIZE, &b);
+    vector_create(SIZE, &x);
+    fill_random(a);
+    for (size_t i = 0; i < SIZE; i++) {
+        b->elements[i] = next_random();
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, matrix_solve(a, b, x));
+    TEST_ASSERT_TRUE(residual(a, x, b) < 1e-10);
+
+    // In place: x may be b itself
+    Vector *copy;
+    vector_create(SIZE, &copy);
+    vector_copy(b, copy);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, matrix_solve(a, copy, copy));
+    for (size_t i = 0; i < SIZE; i++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-12, x->elements[i], copy->elements[i]);
+    }
+
+    matrix_free(a);
+    vector_free(b);
+    vector_free(x);
+    vector_free(copy);
+}
+
+static void test_factors_reproduce_matrix(void) {
+    const size_t n = 70;
+    Matrix *a, *lu, *l, *u, *product;
+    matrix_create(n, n, &a);
+    matrix_create(n, n, &lu);
+    matrix_create(n, n, &l);
+    matrix_create(n, n, &u);
+    matrix_create(n, n, &product);
+    fill_random(a);
+    size_t pivots[70];
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, matrix_lu(a, lu, pivots));
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            const double_t f = lu->elements[i * n + j];
+            l->elements[i * n + j] = j < i ? f : (i == j ? 1.0 : 0.0);
+            u->elements[i * n + j] = j >= i ? f : 0.0;
+        }
+    }
+    matrix_mult(l, u, product);
+
+    // Apply the row swaps to a copy of a
+    Matrix *pa;
+    matrix_create(n, n, &pa);
+    matrix_copy(a, pa);
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_TRUE(pivots[i] >= i && pivots[i] < n);
+        for (size_t j = 0; j < n; j++) {
+            const double_t t = pa->elements[i * n + j];
+            pa->elements[i * n + j] = pa->elements[pivots[i] * n + j];
+            pa->elements[pivots[i] * n + j] = t;
+        }
+    }
+    for (size_t i = 0; i < n * n; i++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-12, pa->elements[i], product->elements[i]);
+    }
+
+    matrix_free(a);
+    matrix_free(lu);
+    matrix_free(l);
+    matrix_free(u);
+    matrix_free(product);
+    matrix_free(pa);
+}
+
+static void test_singular_matrix(void) {
+    const double_t values[] = {1, 2, 3, 2, 4, 6, 1, 0, 1};
+    Matrix *a;
+    Vector *b, *x;
+    matrix_from_array(values, 3, 3, &a);
+    vector_3d(1, 2, 3, &b);
+    vector_create(3, &x);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH, matrix_solve(a, b, x));
+
+    Matrix *wide;
+    matrix_create(2, 3, &wide);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, matrix_solve(wide, b, x));
+
+    matrix_free(a);
+    matrix_free(wide);
+    vector_free(b);
+    vector_free(x);
+}
+
+static void test_triangular_solves(void) {
+    const double_t values[] = {2, 0, 0, 1, 4, 0, 3, 5, 8};
+    Matrix *t;
+    Vector *b, *x;
+    matrix_from_array(values, 3, 3, &t);
+    vector_3d(2, 9, 24, &b);
+    vector_create(3, &x);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          matrix_solve_triangular(t, true, false, b, x));
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, x->elements[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, x->elements[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(1.375, x->elements[2]);
+
+    // The upper triangle is the diagonal only, so x = b / diag
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          matrix_solve_triangular(t, false, false, b, x));
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, x->elements[2]);
+
+    t->elements[4] = 0.0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                          matrix_solve_triangular(t, true, false, b, x));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          matrix_solve_triangular(t, true, true, b, x));
+
+    matrix_free(t);
+    vector_free(b);
+    vector_free(x);
+}
+
+static void test_batched_mixed_sizes(void) {
+    Matrix *a[BATCH];
+    Vector *b[BATCH], *x[BATCH];
+    for (size_t k = 0; k < BATCH; k++) {
+        const size_t n = 1 + k % 9;
+        matrix_create(n, n, &a[k]);
+        fill_random(a[k]);
+        vector_create(n, &b[k]);
+        vector_create(n, &x[k]);
+        for (size_t i = 0; i < n; i++) {
+            b[k]->elements[i] = next_random();
+        }
+    }
+    // One singular system must not stop the others
+    for (size_t i = 0; i < a[5]->cols; i++) {
+        a[5]->elements[i] = 0.0;
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                          matrix_solve_batched((const Matrix *const *)a,
+                                               (const Vector *const *)b,
+                                               x,
+                                               BATCH));
+    for (size_t k = 0; k < BATCH; k++) {
+        if (k != 5)
+            TEST_ASSERT_TRUE(residual(a[k], x[k], b[k]) < 1e-10);
+        matrix_free(a[k]);
+        vector_free(b[k]);
+        vector_free(x[k]);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_solve_large_system);
+    RUN_TEST(test_factors_reproduce_matrix);
+    RUN_TEST(test_singular_matrix);
+    RUN_TEST(test_triangular_solves);
+    RUN_TEST(test_batched_mixed_sizes);
+    return UNITY_END();
+}
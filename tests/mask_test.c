@@ -0,0 +1,215 @@
+/**
+ * @file mask_test.c
+ * @brief Tests for comparison bitmasks, masked operations and checked
+ *        division
+ * @date 18/10/26
+ */
+
+#include "mask.h"
+#include "unity.h"
+
+// Not a multiple of 64 or of any SIMD width, so tail words are covered
+#define SIZE 131
+
+static Vector *a;
+static Vector *b;
+static VectorMask *mask;
+
+void setUp(void) {
+    vector_create(SIZE, &a);
+    vector_create(SIZE, &b);
+    vector_mask_create(SIZE, &mask);
+    for (size_t i = 0; i < SIZE; i++) {
+        a->elements[i] = (double_t)i;
+        b->elements[i] = (double_t)(SIZE - i);
+    }
+}
+
+void tearDown(void) {
+    vector_free(a);
+    vector_free(b);
+    vector_mask_free(mask);
+}
+
+static void test_cmp_lt_sets_expected_bits(void) {
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_cmp_lt(a, b, mask));
+    for (size_t i = 0; i < SIZE; i++) {
+        bool bit;
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_mask_get(mask, i, &bit));
+        TEST_ASSERT_EQUAL_INT(a->elements[i] < b->elements[i], bit);
+    }
+
+    // Bits past size stay clear
+    TEST_ASSERT_EQUAL_UINT64(0, mask->bits[SIZE / 64] >> (SIZE % 64));
+}
+
+static void test_scalar_compares(void) {
+    size_t count;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_cmp_gt_scalar(a, 99.5, mask));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_count_where(mask, &count));
+    TEST_ASSERT_EQUAL_size_t(SIZE - 100, count);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_cmp_eq_scalar(a, 7.0, mask));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_count_where(mask, &count));
+    TEST_ASSERT_EQUAL_size_t(1, count);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_cmp_lt_scalar(a, 0.0, mask));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_count_where(mask, &count));
+    TEST_ASSERT_EQUAL_size_t(0, count);
+}
+
+static void test_nan_compares_false(void) {
+    a->elements[3] = NAN;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_cmp_eq(a, a, mask));
+
+    size_t count;
+    vector_count_where(mask, &count);
+    TEST_ASSERT_EQUAL_size_t(SIZE - 1, count);
+}
+
+static void test_select_and_masked_ops(void) {
+    Vector *result;
+    vector_create(SIZE, &result);
+    vector_cmp_lt_scalar(a, 50.0, mask);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_select(mask, a, b, result));
+    for (size_t i = 0; i < SIZE; i++) {
+        const double_t expected = i < 50 ? a->elements[i] : b->elements[i];
+        TEST_ASSERT_EQUAL_DOUBLE(expected, result->elements[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_masked_add(a, b, mask, result));
+    for (size_t i = 0; i < SIZE; i++) {
+        const double_t expected = i < 50 ? (double_t)SIZE : a->elements[i];
+        TEST_ASSERT_EQUAL_DOUBLE(expected, result->elements[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_masked_scale(a, -2.0, mask, result));
+    for (size_t i = 0; i < SIZE; i++) {
+        const double_t expected =
+            i < 50 ? -2.0 * a->elements[i] : a->elements[i];
+        TEST_ASSERT_EQUAL_DOUBLE(expected, result->elements[i]);
+    }
+
+    vector_free(result);
+}
+
+static void test_compress_in_place(void) {
+    vector_cmp_gt_scalar(a, 120.0, mask);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_compress(a, mask, a));
+    TEST_ASSERT_EQUAL_size_t(SIZE - 121, a->size);
+    for (size_t i = 0; i < a->size; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(121.0 + (double_t)i, a->elements[i]);
+    }
+}
+
+static void test_errors(void) {
+    VectorMask *small;
+    vector_mask_create(SIZE - 1, &small);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, vector_cmp_lt(a, b, small));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, vector_cmp_lt(NULL, b, mask));
+
+    bool bit;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INDEX,
+                          vector_mask_get(mask, SIZE, &bit));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, vector_mask_free(NULL));
+    vector_mask_free(small);
+}
+
+// b has zeros at every tenth element in these tests
+static void zero_every_tenth(void) {
+    for (size_t i = 0; i < SIZE; i += 10) {
+        b->elements[i] = 0.0;
+    }
+}
+
+static void test_div_checked_ieee(void) {
+    Vector *result;
+    vector_create(SIZE, &result);
+    zero_every_tenth();
+    a->elements[0] = 0.0;
+
+    size_t zeros = 0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_div_checked(a,
+                                             b,
+                                             VECTOR_DIV_IEEE,
+                                             0.0,
+                                             result,
+                                             mask,
+                                             &zeros));
+    TEST_ASSERT_EQUAL_size_t((SIZE + 9) / 10, zeros);
+    TEST_ASSERT_DOUBLE_IS_NAN(result->elements[0]);
+    TEST_ASSERT_DOUBLE_IS_INF(result->elements[10]);
+    TEST_ASSERT_EQUAL_DOUBLE(1.0 / (double_t)(SIZE - 1), result->elements[1]);
+    for (size_t i = 0; i < SIZE; i++) {
+        bool bit;
+        vector_mask_get(mask, i, &bit);
+        TEST_ASSERT_EQUAL_INT(i % 10 == 0, bit);
+    }
+
+    vector_free(result);
+}
+
+static void test_div_checked_substitute_in_place(void) {
+    zero_every_tenth();
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_div_checked(a,
+                                             b,
+                                             VECTOR_DIV_SUBSTITUTE,
+                                             -1.0,
+                                             a,
+                                             NULL,
+                                             NULL));
+    for (size_t i = 0; i < SIZE; i++) {
+        const double_t expected =
+            i % 10 == 0 ? -1.0 : (double_t)i / (double_t)(SIZE - i);
+        TEST_ASSERT_EQUAL_DOUBLE(expected, a->elements[i]);
+    }
+}
+
+static void test_div_checked_strict_leaves_result(void) {
+    Vector *result;
+    vector_create(SIZE, &result);
+    vector_copy(a, result);
+    b->elements[SIZE - 1] = 0.0;
+
+    size_t zeros = 0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                          vector_div_checked(a,
+                                             b,
+                                             VECTOR_DIV_STRICT,
+                                             0.0,
+                                             result,
+                                             NULL,
+                                             &zeros));
+    TEST_ASSERT_EQUAL_size_t(1, zeros);
+    for (size_t i = 0; i < SIZE; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(a->elements[i], result->elements[i]);
+    }
+
+    // vector_div is strict too
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH, vector_div(a, b, result));
+    b->elements[SIZE - 1] = 1.0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_div(a, b, result));
+    TEST_ASSERT_EQUAL_DOUBLE(SIZE - 1, result->elements[SIZE - 1]);
+
+    vector_free(result);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_cmp_lt_sets_expected_bits);
+    RUN_TEST(test_scalar_compares);
+    RUN_TEST(test_nan_compares_false);
+    RUN_TEST(test_select_and_masked_ops);
+    RUN_TEST(test_compress_in_place);
+    RUN_TEST(test_errors);
+    RUN_TEST(test_div_checked_ieee);
+    RUN_TEST(test_div_checked_substitute_in_place);
+    RUN_TEST(test_div_checked_strict_leaves_result);
+    return UNITY_END();
+}
@@ -0,0 +1,218 @@
+/**
+ * @file ndarray_test.c
+ * @brief Tests for strided N-dimensional arrays, views and broadcasting
+ * @date 18/10/26
+ */
+
+#include "ndarray.h"
+#include "unity.h"
+
+#define LONG_ROW 300000
+#define SIDE 600
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// Fill with a value that identifies the flat row-major position
+static void fill_positions(NdArray *array) {
+    const size_t size = ndarray_size(array);
+    for (size_t i = 0; i < size; i++) {
+        array->data[i] = (double_t)i;
+    }
+}
+
+static void test_create_and_access(void) {
+    const size_t shape[3] = {2, 3, 4};
+    NdArray *array;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ndarray_create(3, shape, &array));
+    TEST_ASSERT_EQUAL_size_t(24, ndarray_size(array));
+    TEST_ASSERT_TRUE(ndarray_contiguous(array));
+
+    const size_t index[3] = {1, 2, 3};
+    double_t value = 0.0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ndarray_set(array, index, 5.0));
+    TEST_ASSERT_EQUAL_DOUBLE(5.0, array->data[23]);
+    ndarray_get(array, index, &value);
+    TEST_ASSERT_EQUAL_DOUBLE(5.0, value);
+
+    const size_t outside[3] = {2, 0, 0};
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INDEX,
+                          ndarray_get(array, outside, &value));
+
+    const size_t empty[2] = {2, 0};
+    NdArray *bad = NULL;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, ndarray_create(2, empty, &bad));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ndarray_free(array));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, ndarray_free(NULL));
+}
+
+static void test_views_share_elements(void) {
+    const size_t shape[2] = {3, 4};
+    NdArray *array;
+    ndarray_create(2, shape, &array);
+    fill_positions(array);
+
+    // Reshape of a contiguous array is a view
+    const size_t flat_shape[1] = {12};
+    NdArray flat, transposed, reversed;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ndarray_reshape(array, 1, flat_shape, &flat));
+    TEST_ASSERT_EQUAL_PTR(array->data, flat.data);
+
+    // The transpose cannot be flattened without a copy
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ndarray_transpose(array, NULL, &transposed));
+    TEST_ASSERT_FALSE(ndarray_contiguous(&transposed));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INVALID_ARG,
+                          ndarray_reshape(&transposed, 1, flat_shape, &flat));
+    const size_t index[2] = {3, 1};
+    double_t value;
+    ndarray_get(&transposed, index, &value);
+    TEST_ASSERT_EQUAL_DOUBLE(7.0, value);
+
+    // Columns 3, 1 of every row
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ndarray_slice(array, 1, 3, 0, -2, &reversed));
+    TEST_ASSERT_EQUAL_size_t(2, reversed.shape[1]);
+    const size_t first[2] = {2, 0}, second[2] = {2, 1};
+    ndarray_get(&reversed, first, &value);
+    TEST_ASSERT_EQUAL_DOUBLE(11.0, value);
+    ndarray_get(&reversed, second, &value);
+    TEST_ASSERT_EQUAL_DOUBLE(9.0, value);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          ndarray_slice(array, 1, 2, 2, 1, &reversed));
+
+    ndarray_free(array);
+}
+
+static void test_broadcast_arithmetic(void) {
+    const size_t column_shape[2] = {3, 1}, row_shape[1] = {4};
+    const size_t shape[2] = {3, 4};
+    NdArray *column, *row, *result;
+    ndarray_create(2, column_shape, &column);
+    ndarray_create(1, row_shape, &row);
+    ndarray_create(2, shape, &result);
+    for (size_t i = 0; i < 3; i++) {
+        column->data[i] = 10.0 * (double_t)i;
+    }
+    for (size_t j = 0; j < 4; j++) {
+        row->data[j] = (double_t)j;
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ndarray_add(column, row, result));
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            TEST_ASSERT_EQUAL_DOUBLE(10.0 * i + j, result->data[i * 4 + j]);
+        }
+    }
+
+    // Division by zero follows IEEE 754
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ndarray_div(row, column, result));
+    TEST_ASSERT_DOUBLE_IS_NAN(result->data[0]);
+    TEST_ASSERT_DOUBLE_IS_INF(result->data[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.15, result->data[11]);
+
+    // 3 x 1 does not broadcast to 2 x 4
+    const size_t wrong_shape[2] = {2, 4};
+    NdArray *wrong;
+    ndarray_create(2, wrong_shape, &wrong);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, ndarray_add(column, row, wrong));
+
+    ndarray_free(column);
+    ndarray_free(row);
+    ndarray_free(result);
+    ndarray_free(wrong);
+}
+
+// One long contiguous row is split into several pool tasks
+static void test_long_row_split(void) {
+    const size_t shape[1] = {LONG_ROW};
+    NdArray *a, *b;
+    ndarray_create(1, shape, &a);
+    ndarray_create(1, shape, &b);
+    fill_positions(a);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ndarray_fill(b, 0.5));
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ndarray_mult(a, b, a));
+    for (size_t i = 0; i < LONG_ROW; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(0.5 * (double_t)i, a->data[i]);
+    }
+
+    // Reversed view of the same row
+    NdArray reversed;
+    ndarray_slice(b, 0, LONG_ROW - 1, -1, -1, &reversed);
+    fill_positions(b);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ndarray_sub(&reversed, a, a));
+    for (size_t i = 0; i < LONG_ROW; i++) {
+        const double_t expected = (double_t)(LONG_ROW - 1 - i) - 0.5 * i;
+        TEST_ASSERT_EQUAL_DOUBLE(expected, a->data[i]);
+    }
+
+    ndarray_free(a);
+    ndarray_free(b);
+}
+
+// Many short rows with a transposed operand are grouped into tasks
+static void test_transposed_rows_grouped(void) {
+    const size_t shape[2] = {SIDE, SIDE};
+    NdArray *a, *result;
+    NdArray transposed;
+    ndarray_create(2, shape, &a);
+    ndarray_create(2, shape, &result);
+    fill_positions(a);
+    ndarray_transpose(a, NULL, &transposed);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ndarray_add(a, &transposed, result));
+    for (size_t i = 0; i < SIDE; i++) {
+        for (size_t j = 0; j < SIDE; j++) {
+            const double_t expected = (double_t)(i * SIDE + j + j * SIDE + i);
+            TEST_ASSERT_EQUAL_DOUBLE(expected, result->data[i * SIDE + j]);
+        }
+    }
+
+    // Copy into a non-contiguous destination
+    NdArray dest;
+    ndarray_transpose(result, NULL, &dest);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ndarray_copy(a, &dest));
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, result->data[SIDE]);
+    TEST_ASSERT_EQUAL_DOUBLE((double_t)SIDE, result->data[1]);
+
+    ndarray_free(a);
+    ndarray_free(result);
+}
+
+static void test_vector_and_matrix_views(void) {
+    Vector *v;
+    Matrix *m;
+    vector_3d(1, 2, 3, &v);
+    matrix_create(2, 3, &m);
+    NdArray vector_view, matrix_view;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ndarray_from_vector(v, &vector_view));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ndarray_from_matrix(m, &matrix_view));
+
+    // The vector broadcasts over the rows of the matrix
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ndarray_add(&matrix_view,
+                                      &vector_view,
+                                      &matrix_view));
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, m->elements[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, m->elements[5]);
+
+    vector_free(v);
+    matrix_free(m);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_create_and_access);
+    RUN_TEST(test_views_share_elements);
+    RUN_TEST(test_broadcast_arithmetic);
+    RUN_TEST(test_long_row_split);
+    RUN_TEST(test_transposed_rows_grouped);
+    RUN_TEST(test_vector_and_matrix_views);
+    return UNITY_END();
+}
@@ -0,0 +1,212 @@
+/**
+ * @file ortho_test.c
+ * @brief Tests for Gram-Schmidt and CholQR orthonormalization
+ * @date 18/10/26
+ */
+
+#include "ortho.h"
+#include "unity.h"
+
+#define COUNT 50
+#define LENGTH 200
+
+static const NumenOrthoMethod methods[] = {
+    NUMEN_ORTHO_GRAM_SCHMIDT,
+    NUMEN_ORTHO_CHOLQR,
+};
+
+static uint64_t seed;
+
+void setUp(void) {
+    seed = 5;
+}
+
+void tearDown(void) {}
+
+// Uniform in [-1, 1), reproducible across platforms
+static double_t next_random(void) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (double_t)(seed >> 11) / (double_t)(1ULL << 52) - 1.0;
+}
+
+static double_t dot(const Vector *a, const Vector *b) {
+    double_t sum = 0.0;
+    for (size_t i = 0; i < a->size; i++) {
+        sum += a->elements[i] * b->elements[i];
+    }
+    return sum;
+}
+
+// Nonzero vectors are unit length and orthogonal, the rest are zero
+static void check_orthonormal(Vector *const *vectors,
+                              size_t count,
+                              size_t rank) {
+    size_t nonzero = 0;
+    for (size_t i = 0; i < count; i++) {
+        const double_t norm2 = dot(vectors[i], vectors[i]);
+        if (norm2 == 0.0)
+            continue;
+        nonzero++;
+        TEST_ASSERT_DOUBLE_WITHIN(1e-12, 1.0, norm2);
+        for (size_t j = 0; j < i; j++) {
+            TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.0, dot(vectors[i], vectors[j]));
+        }
+    }
+    TEST_ASSERT_EQUAL_size_t(rank, nonzero);
+}
+
+// Crosses the Gram-Schmidt block size
+static void test_full_rank_set(void) {
+    for (size_t m = 0; m < 2; m++) {
+        Vector *vectors[COUNT], *original[COUNT];
+        for (size_t v = 0; v < COUNT; v++) {
+            vector_create(LENGTH, &vectors[v]);
+            vector_create(LENGTH, &original[v]);
+            for (size_t i = 0; i < LENGTH; i++) {
+                vectors[v]->elements[i] = next_random();
+            }
+            vector_copy(vectors[v], original[v]);
+        }
+
+        size_t rank = 0;
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                              vector_orthonormalize(vectors,
+                                                    COUNT,
+                                                    methods[m],
+                                                    &rank));
+        TEST_ASSERT_EQUAL_size_t(COUNT, rank);
+        check_orthonormal(vectors, COUNT, COUNT);
+
+        // Original vector i lies in the span of results 0..i
+        for (size_t v = 0; v < COUNT; v++) {
+            double_t residual = 1.0;
+            vector_orthogonalize((const Vector *const *)vectors,
+                                 v + 1,
+                                 original[v],
+                                 NULL,
+                                 &residual);
+            TEST_ASSERT_DOUBLE_WITHIN(1e-10, 0.0, residual);
+        }
+
+        for (size_t v = 0; v < COUNT; v++) {
+            vector_free(vectors[v]);
+            vector_free(original[v]);
+        }
+    }
+}
+
+// More vectors than dimensions can never be full rank
+static void test_three_vectors_in_plane(void) {
+    for (size_t m = 0; m < 2; m++) {
+        Vector *vectors[3];
+        vector_2d(3.0, 1.0, &vectors[0]);
+        vector_2d(1.0, 2.0, &vectors[1]);
+        vector_2d(-1.0, 4.0, &vectors[2]);
+
+        size_t rank = 0;
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                              vector_orthonormalize(vectors,
+                                                    3,
+                                                    methods[m],
+                                                    &rank));
+        TEST_ASSERT_EQUAL_size_t(2, rank);
+        check_orthonormal(vectors, 3, 2);
+        TEST_ASSERT_EQUAL_DOUBLE(0.0, dot(vectors[2], vectors[2]));
+
+        for (size_t v = 0; v < 3; v++) {
+            vector_free(vectors[v]);
+        }
+    }
+}
+
+static void test_exact_dependency(void) {
+    for (size_t m = 0; m < 2; m++) {
+        Vector *vectors[4];
+        for (size_t v = 0; v < 4; v++) {
+            vector_create(5, &vectors[v]);
+        }
+        for (size_t i = 0; i < 5; i++) {
+            vectors[0]->elements[i] = (double_t)(i + 1);
+            vectors[1]->elements[i] = (double_t)(i * i) - 3.0;
+            vectors[2]->elements[i] =
+                vectors[0]->elements[i] + 2.0 * vectors[1]->elements[i];
+            vectors[3]->elements[i] = i == 2 ? 1.0 : 0.0;
+        }
+
+        size_t rank = 0;
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                              vector_orthonormalize(vectors,
+                                                    4,
+                                                    methods[m],
+                                                    &rank));
+        TEST_ASSERT_EQUAL_size_t(3, rank);
+        check_orthonormal(vectors, 4, 3);
+        TEST_ASSERT_EQUAL_DOUBLE(0.0, dot(vectors[2], vectors[2]));
+
+        for (size_t v = 0; v < 4; v++) {
+            vector_free(vectors[v]);
+        }
+    }
+}
+
+static void test_orthogonalize_against_basis(void) {
+    Vector *basis[2], *v, *coefficients;
+    vector_3d(1, 0, 0, &basis[0]);
+    vector_3d(0, 1, 0, &basis[1]);
+    vector_3d(2, -3, 4, &v);
+    vector_create(2, &coefficients);
+
+    double_t norm = 0.0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_orthogonalize((const Vector *const *)basis,
+                                               2,
+                                               v,
+                                               coefficients,
+                                               &norm));
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, coefficients->elements[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(-3.0, coefficients->elements[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, v->elements[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(4.0, v->elements[2]);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-15, 4.0, norm);
+
+    vector_free(basis[0]);
+    vector_free(basis[1]);
+    vector_free(v);
+    vector_free(coefficients);
+}
+
+static void test_matrix_columns(void) {
+    const double_t values[] = {1, 1, 2, 0, 1, 1, 1, 0, 1, 1, 1, 2};
+    for (size_t m = 0; m < 2; m++) {
+        Matrix *a;
+        matrix_from_array(values, 4, 3, &a);
+
+        size_t rank = 0;
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                              matrix_orthonormalize(a, methods[m], &rank));
+        TEST_ASSERT_EQUAL_size_t(2, rank);
+
+        // Column 2 = column 0 + column 1, so it is zeroed
+        for (size_t i = 0; i < 3; i++) {
+            for (size_t j = 0; j < 3; j++) {
+                double_t sum = 0.0;
+                for (size_t r = 0; r < 4; r++) {
+                    sum += a->elements[r * 3 + i] * a->elements[r * 3 + j];
+                }
+                const double_t expected = i == j && i < 2 ? 1.0 : 0.0;
+                TEST_ASSERT_DOUBLE_WITHIN(1e-12, expected, sum);
+            }
+        }
+        matrix_free(a);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_full_rank_set);
+    RUN_TEST(test_three_vectors_in_plane);
+    RUN_TEST(test_exact_dependency);
+    RUN_TEST(test_orthogonalize_against_basis);
+    RUN_TEST(test_matrix_columns);
+    return UNITY_END();
+}
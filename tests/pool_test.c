@@ -0,0 +1,158 @@
+/**
+ * @file pool_test.c
+ * @brief Tests for worker pool configuration and parallel loops
+ * @date 18/10/26
+ */
+
+#include "../src/pool.h"
+#include "runtime.h"
+#include "unity.h"
+#include "vector.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define WORKERS 3
+#define TASKS 10000
+#define INNER_TASKS 16
+
+static atomic_uchar visits[TASKS];
+
+void setUp(void) {
+    for (size_t i = 0; i < TASKS; i++) {
+        atomic_store(&visits[i], 0);
+    }
+}
+
+void tearDown(void) {}
+
+static void visit(void *ctx, size_t task) {
+    (void)ctx;
+    atomic_fetch_add(&visits[task], 1);
+}
+
+static void visit_nested(void *ctx, size_t task) {
+    atomic_size_t *inner = ctx;
+    atomic_fetch_add(&visits[task], 1);
+    pool_parallel_for(INNER_TASKS, visit, NULL);
+    atomic_fetch_add(inner, 1);
+}
+
+// Runs before the pool starts, so the configuration is applied
+static void test_configure_before_start(void) {
+    NumenPoolConfig config;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_pool_config_default(&config));
+    TEST_ASSERT_EQUAL_INT(NUMEN_AFFINITY_NONE, config.affinity);
+
+    config.affinity = NUMEN_AFFINITY_LIST;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INVALID_ARG,
+                          numen_pool_configure(&config));
+
+    config.affinity = NUMEN_AFFINITY_NONE;
+    config.threads = WORKERS;
+    config.spin_us = 50;
+    config.domain_partition = true;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_pool_configure(&config));
+
+    size_t threads = 0, domains = 0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_pool_threads(&threads));
+    TEST_ASSERT_EQUAL_size_t(WORKERS + 1, threads);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_pool_domains(&domains));
+    TEST_ASSERT_TRUE(domains >= 1);
+
+    // Too late once started
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INIT, numen_pool_configure(&config));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_pool_configure(NULL));
+}
+
+static void test_parallel_for_runs_each_task_once(void) {
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          pool_parallel_for(TASKS, visit, NULL));
+    for (size_t i = 0; i < TASKS; i++) {
+        TEST_ASSERT_EQUAL_UINT8(1, atomic_load(&visits[i]));
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, pool_parallel_for(0, visit, NULL));
+}
+
+static void test_nested_parallel_for(void) {
+    atomic_size_t inner = 0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          pool_parallel_for(64, visit_nested, &inner));
+    TEST_ASSERT_EQUAL_size_t(64, atomic_load(&inner));
+
+    // Outer tasks 0..63 once, plus every inner task 0..15 once per outer
+    for (size_t i = 0; i < INNER_TASKS; i++) {
+        TEST_ASSERT_EQUAL_UINT8(1 + 64, atomic_load(&visits[i]));
+    }
+    for (size_t i = INNER_TASKS; i < 64; i++) {
+        TEST_ASSERT_EQUAL_UINT8(1, atomic_load(&visits[i]));
+    }
+}
+
+static void test_dot_parallel_reproducible(void) {
+    const size_t size = 1 << 20;
+    Vector *a, *b;
+    vector_create(size, &a);
+    vector_create(size, &b);
+    for (size_t i = 0; i < size; i++) {
+        a->elements[i] = 1.0 / (double_t)(i + 1);
+        b->elements[i] = (i % 2) ? -1.0 : 1.0;
+    }
+
+    double_t first, again, serial;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_dot_parallel(a, b, &first));
+    for (int run = 0; run < 5; run++) {
+        vector_dot_parallel(a, b, &again);
+        TEST_ASSERT_TRUE(first == again);
+    }
+
+    // Alternating harmonic series
+    vector_dot(a, b, &serial);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, serial, first);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, log(2.0), first);
+
+    vector_free(a);
+    vector_free(b);
+}
+
+// Two L3 caches keyed by their first CPU, as sysfs reports them
+static void test_number_domains_two_caches(void) {
+    PoolCpu cpus[6] = {
+        {.cpu = 0, .core = 0, .domain = 0},
+        {.cpu = 1, .core = 1, .domain = 0},
+        {.cpu = 2, .core = 2, .domain = 0},
+        {.cpu = 8, .core = 8, .domain = 8},
+        {.cpu = 9, .core = 9, .domain = 8},
+        {.cpu = 10, .core = 10, .domain = 8},
+    };
+    size_t weights[POOL_MAX_DOMAINS];
+    TEST_ASSERT_EQUAL_size_t(2, pool_number_domains(cpus, 6, weights));
+    TEST_ASSERT_EQUAL_size_t(3, weights[0]);
+    TEST_ASSERT_EQUAL_size_t(3, weights[1]);
+    TEST_ASSERT_EQUAL_size_t(0, weights[2]);
+    for (size_t i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_INT(i < 3 ? 0 : 1, cpus[i].domain);
+    }
+
+    // One cache whose key is not 0, as under taskset 4-7
+    PoolCpu shifted[4] = {
+        {.cpu = 4, .core = 4, .domain = 4},
+        {.cpu = 5, .core = 5, .domain = 4},
+        {.cpu = 6, .core = 6, .domain = 4},
+        {.cpu = 7, .core = 7, .domain = 4},
+    };
+    TEST_ASSERT_EQUAL_size_t(1, pool_number_domains(shifted, 4, weights));
+    TEST_ASSERT_EQUAL_size_t(4, weights[0]);
+    TEST_ASSERT_EQUAL_size_t(0, weights[1]);
+    TEST_ASSERT_EQUAL_size_t(0, pool_number_domains(shifted, 0, weights));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_configure_before_start);
+    RUN_TEST(test_parallel_for_runs_each_task_once);
+    RUN_TEST(test_nested_parallel_for);
+    RUN_TEST(test_dot_parallel_reproducible);
+    RUN_TEST(test_number_domains_two_caches);
+    return UNITY_END();
+}
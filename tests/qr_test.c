@@ -0,0 +1,329 @@
+/**
+ * @file qr_test.c
+ * @brief Tests for QR factorization and least-squares fits
+ * @date 18/10/26
+ */
+
+#include "linalg.h"
+#include "unity.h"
+
+#define ROWS 200
+#define COLS 80
+#define COEFFS 4
+
+static uint64_t seed;
+
+void setUp(void) {
+    seed = 3;
+}
+
+void tearDown(void) {}
+
+// Uniform in [-1, 1), reproducible across platforms
+static double_t next_random(void) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (double_t)(seed >> 11) / (double_t)(1ULL << 52) - 1.0;
+}
+
+static void fill_random(Matrix *m) {
+    for (size_t i = 0; i < m->rows * m->cols; i++) {
+        m->elements[i] = next_random();
+    }
+}
+
+// Wider than QR_BLOCK so the compact WY updates run
+static void test_factors_are_orthonormal_and_triangular(void) {
+    Matrix *a, *qr, *q, *r, *qt, *product;
+    Vector *tau;
+    matrix_create(ROWS, COLS, &a);
+    matrix_create(ROWS, COLS, &qr);
+    matrix_create(ROWS, COLS, &q);
+    matrix_create(COLS, COLS, &r);
+    matrix_create(COLS, ROWS, &qt);
+    vector_create(COLS, &tau);
+    fill_random(a);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, matrix_qr(a, qr, tau));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, matrix_qr_unpack(qr, tau, q, r));
+    for (size_t i = 0; i < COLS; i++) {
+        for (size_t j = 0; j < i; j++) {
+            TEST_ASSERT_EQUAL_DOUBLE(0.0, r->elements[i * COLS + j]);
+        }
+    }
+
+    // Q^T * Q = I
+    matrix_create(COLS, COLS, &product);
+    matrix_transpose(q, qt);
+    matrix_mult(qt, q, product);
+    for (size_t i = 0; i < COLS; i++) {
+        for (size_t j = 0; j < COLS; j++) {
+            TEST_ASSERT_DOUBLE_WITHIN(1e-12,
+                                      i == j ? 1.0 : 0.0,
+                                      product->elements[i * COLS + j]);
+        }
+    }
+    matrix_free(product);
+
+    // Q * R = A
+    matrix_create(ROWS, COLS, &product);
+    matrix_mult(q, r, product);
+    for (size_t i = 0; i < ROWS * COLS; i++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-12, a->elements[i], product->elements[i]);
+    }
+
+    matrix_free(a);
+    matrix_free(qr);
+    matrix_free(q);
+    matrix_free(r);
+    matrix_free(qt);
+    matrix_free(product);
+    vector_free(tau);
+}
+
+static void test_least_squares(void) {
+    Matrix *a;
+    Vector *b, *x, *ax;
+    matrix_create(ROWS, COLS, &a);
+    vector_create(ROWS, &b);
+    vector_create(COLS, &x);
+    vector_create(ROWS, &ax);
+    fill_random(a);
+    for (size_t i = 0; i < ROWS; i++) {
+        b->elements[i] = next_random();
+    }
+
+    // The residual is orthogonal to every column of a
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, matrix_least_squares(a, b, x));
+    matrix_mult_vector(a, x, ax);
+    for (size_t j = 0; j < COLS; j++) {
+        double_t dot = 0.0;
+        for (size_t i = 0; i < ROWS; i++) {
+            dot += a->elements[i * COLS + j] *
+                   (ax->elements[i] - b->elements[i]);
+        }
+        TEST_ASSERT_DOUBLE_WITHIN(1e-10, 0.0, dot);
+    }
+
+    // Rank deficient: column 1 repeats column 0
+    for (size_t i = 0; i < ROWS; i++) {
+        a->elements[i * COLS + 1] = a->elements[i * COLS];
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH, matrix_least_squares(a, b, x));
+
+    matrix_free(a);
+    vector_free(b);
+    vector_free(x);
+    vector_free(ax);
+}
+
+static void test_stream_matches_batch_fit(void) {
+    const size_t rows = 50;
+    NumenQRStream *stream;
+    Matrix *a;
+    Vector *b, *row, *batch_x, *stream_x;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_qr_stream_create(COEFFS, 1.0, &stream));
+    matrix_create(rows, COEFFS, &a);
+    vector_create(rows, &b);
+    vector_create(COEFFS, &row);
+    vector_create(COEFFS, &batch_x);
+    vector_create(COEFFS, &stream_x);
+    fill_random(a);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                          numen_qr_stream_solve(stream, stream_x, NULL));
+    for (size_t i = 0; i < rows; i++) {
+        b->elements[i] = next_random();
+        for (size_t j = 0; j < COEFFS; j++) {
+            row->elements[j] = a->elements[i * COEFFS + j];
+        }
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                              numen_qr_stream_add(stream, row, b->elements[i]));
+    }
+
+    double_t rss = 0.0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_qr_stream_solve(stream, stream_x, &rss));
+    matrix_least_squares(a, b, batch_x);
+    for (size_t j = 0; j < COEFFS; j++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-12,
+                                  batch_x->elements[j],
+                                  stream_x->elements[j]);
+    }
+
+    double_t expected = 0.0;
+    for (size_t i = 0; i < rows; i++) {
+        double_t fit = 0.0;
+        for (size_t j = 0; j < COEFFS; j++) {
+            fit += a->elements[i * COEFFS + j] * batch_x->elements[j];
+        }
+        expected += (fit - b->elements[i]) * (fit - b->elements[i]);
+    }
+    TEST_ASSERT_DOUBLE_WITHIN(1e-10, expected, rss);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_qr_stream_reset(stream));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                          numen_qr_stream_solve(stream, stream_x, NULL));
+
+    matrix_free(a);
+    vector_free(b);
+    vector_free(row);
+    vector_free(batch_x);
+    vector_free(stream_x);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_qr_stream_free(stream));
+}
+
+// With forgetting, the fit follows a change of model
+static void test_stream_forgets_old_rows(void) {
+    const double_t before[COEFFS] = {1, 2, 3, 4};
+    const double_t after[COEFFS] = {-4, 0.5, 2, -1};
+    NumenQRStream *stream;
+    Vector *row, *x;
+    numen_qr_stream_create(COEFFS, 0.9, &stream);
+    vector_create(COEFFS, &row);
+    vector_create(COEFFS, &x);
+
+    for (size_t i = 0; i < 400; i++) {
+        const double_t *model = i < 200 ? before : after;
+        double_t y = 0.0;
+        for (size_t j = 0; j < COEFFS; j++) {
+            row->elements[j] = next_random();
+            y += model[j] * row->elements[j];
+        }
+        numen_qr_stream_add(stream, row, y);
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_qr_stream_solve(stream, x, NULL));
+    for (size_t j = 0; j < COEFFS; j++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-6, after[j], x->elements[j]);
+    }
+
+    Vector *short_x;
+    vector_create(COEFFS - 1, &short_x);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          numen_qr_stream_solve(stream, short_x, NULL));
+    vector_free(short_x);
+
+    vector_free(row);
+    vector_free(x);
+    numen_qr_stream_free(stream);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_qr_stream_free(NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INVALID_ARG,
+                          numen_qr_stream_create(COEFFS, 0.0, &stream));
+}
+
+// Removing the row that leaves the window refits on exactly the window
+static void test_stream_sliding_window(void) {
+    const size_t rows = 120, window = 20;
+    NumenQRStream *stream;
+    Matrix *a, *last;
+    Vector *b, *last_b, *row, *batch_x, *stream_x;
+    numen_qr_stream_create(COEFFS, 1.0, &stream);
+    matrix_create(rows, COEFFS, &a);
+    matrix_create(window, COEFFS, &last);
+    vector_create(rows, &b);
+    vector_create(window, &last_b);
+    vector_create(COEFFS, &row);
+    vector_create(COEFFS, &batch_x);
+    vector_create(COEFFS, &stream_x);
+    fill_random(a);
+
+    for (size_t i = 0; i < rows; i++) {
+        b->elements[i] = next_random();
+        for (size_t j = 0; j < COEFFS; j++) {
+            row->elements[j] = a->elements[i * COEFFS + j];
+        }
+        numen_qr_stream_add(stream, row, b->elements[i]);
+        if (i < window)
+            continue;
+
+        const size_t old = i - window;
+        for (size_t j = 0; j < COEFFS; j++) {
+            row->elements[j] = a->elements[old * COEFFS + j];
+        }
+        TEST_ASSERT_EQUAL_INT(
+            VECTOR_SUCCESS,
+            numen_qr_stream_remove(stream, row, b->elements[old]));
+    }
+
+    // Batch fit of the last window rows
+    for (size_t i = 0; i < window; i++) {
+        const size_t source = rows - window + i;
+        last_b->elements[i] = b->elements[source];
+        for (size_t j = 0; j < COEFFS; j++) {
+            last->elements[i * COEFFS + j] = a->elements[source * COEFFS + j];
+        }
+    }
+    matrix_least_squares(last, last_b, batch_x);
+
+    double_t rss = 0.0, expected = 0.0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_qr_stream_solve(stream, stream_x, &rss));
+    for (size_t j = 0; j < COEFFS; j++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-10,
+                                  batch_x->elements[j],
+                                  stream_x->elements[j]);
+    }
+    for (size_t i = 0; i < window; i++) {
+        double_t fit = 0.0;
+        for (size_t j = 0; j < COEFFS; j++) {
+            fit += last->elements[i * COEFFS + j] * batch_x->elements[j];
+        }
+        expected += (fit - last_b->elements[i]) * (fit - last_b->elements[i]);
+    }
+    TEST_ASSERT_DOUBLE_WITHIN(1e-10, expected, rss);
+
+    matrix_free(a);
+    matrix_free(last);
+    vector_free(b);
+    vector_free(last_b);
+    vector_free(row);
+    vector_free(batch_x);
+    vector_free(stream_x);
+    numen_qr_stream_free(stream);
+}
+
+// With only n rows left, removing one would leave coefficients undetermined
+static void test_stream_remove_breakdown(void) {
+    NumenQRStream *stream;
+    Vector *row, *x, *again;
+    numen_qr_stream_create(COEFFS, 1.0, &stream);
+    vector_create(COEFFS, &row);
+    vector_create(COEFFS, &x);
+    vector_create(COEFFS, &again);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                          numen_qr_stream_remove(stream, row, 0.0));
+    for (size_t i = 0; i < COEFFS; i++) {
+        for (size_t j = 0; j < COEFFS; j++) {
+            row->elements[j] = next_random();
+        }
+        numen_qr_stream_add(stream, row, (double_t)i);
+    }
+    numen_qr_stream_solve(stream, x, NULL);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                          numen_qr_stream_remove(stream, row, 3.0));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_qr_stream_solve(stream, again, NULL));
+    for (size_t j = 0; j < COEFFS; j++) {
+        TEST_ASSERT_EQUAL_DOUBLE(x->elements[j], again->elements[j]);
+    }
+
+    vector_free(row);
+    vector_free(x);
+    vector_free(again);
+    numen_qr_stream_free(stream);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_factors_are_orthonormal_and_triangular);
+    RUN_TEST(test_least_squares);
+    RUN_TEST(test_stream_matches_batch_fit);
+    RUN_TEST(test_stream_forgets_old_rows);
+    RUN_TEST(test_stream_sliding_window);
+    RUN_TEST(test_stream_remove_breakdown);
+    return UNITY_END();
+}
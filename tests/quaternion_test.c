@@ -0,0 +1,176 @@
+/**
+ * @file quaternion_test.c
+ * @brief Tests for quaternion rotations and batched point rotation
+ * @date 18/10/26
+ */
+
+#include "quaternion.h"
+#include "unity.h"
+#include <stdint.h>
+
+#define EPS 1e-12
+#define PI 3.14159265358979323846
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static void test_axis_angle_rotates_x_to_y(void) {
+    Quaternion q;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          quaternion_from_axis_angle(0, 0, 1, PI / 2, &q));
+
+    Vector *v, *r;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_create(3, &v));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vector_create(3, &r));
+    v->elements[0] = 1.0;
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, quaternion_rotate_vector(&q, v, r));
+    TEST_ASSERT_DOUBLE_WITHIN(EPS, 0.0, r->elements[0]);
+    TEST_ASSERT_DOUBLE_WITHIN(EPS, 1.0, r->elements[1]);
+    TEST_ASSERT_DOUBLE_WITHIN(EPS, 0.0, r->elements[2]);
+
+    vector_free(v);
+    vector_free(r);
+}
+
+static void test_zero_axis_is_math_error(void) {
+    Quaternion q;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                          quaternion_from_axis_angle(0, 0, 0, 1.0, &q));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL,
+                          quaternion_from_axis_angle(1, 0, 0, 1.0, NULL));
+}
+
+static void test_multiply_composes_rotations(void) {
+    Quaternion a, b, ab;
+    quaternion_from_axis_angle(0, 0, 1, PI / 2, &a);
+    quaternion_from_axis_angle(1, 0, 0, PI / 2, &b);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, quaternion_multiply(&a, &b, &ab));
+
+    // b first takes y to z, a then leaves z alone
+    double_t m[9];
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, quaternion_to_mat3(&ab, m));
+    TEST_ASSERT_DOUBLE_WITHIN(EPS, 0.0, m[1]);
+    TEST_ASSERT_DOUBLE_WITHIN(EPS, 0.0, m[4]);
+    TEST_ASSERT_DOUBLE_WITHIN(EPS, 1.0, m[7]);
+}
+
+static void test_slerp_halfway(void) {
+    Quaternion a = {1, 0, 0, 0}, b, half, expected;
+    quaternion_from_axis_angle(0, 1, 0, PI / 2, &b);
+    quaternion_from_axis_angle(0, 1, 0, PI / 4, &expected);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          quaternion_slerp(&a, &b, 0.5, &half));
+    TEST_ASSERT_DOUBLE_WITHIN(EPS, expected.w, half.w);
+    TEST_ASSERT_DOUBLE_WITHIN(EPS, expected.x, half.x);
+    TEST_ASSERT_DOUBLE_WITHIN(EPS, expected.y, half.y);
+    TEST_ASSERT_DOUBLE_WITHIN(EPS, expected.z, half.z);
+}
+
+static void test_normalize_zero_is_math_error(void) {
+    Quaternion q = {0, 0, 0, 0};
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH, quaternion_normalize(&q));
+
+    q = (Quaternion){2, 0, 0, 0};
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, quaternion_normalize(&q));
+    TEST_ASSERT_DOUBLE_WITHIN(EPS, 1.0, q.w);
+}
+
+static void test_rotate_points_matches_single(void) {
+    const size_t count = 37;
+    Vec3Batch *points;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vec3_batch_create(count, &points));
+    for (size_t i = 0; i < count; i++) {
+        points->x[i] = (double_t)i;
+        points->y[i] = 1.0 - (double_t)i;
+        points->z[i] = 0.5 * (double_t)i;
+    }
+
+    Quaternion q;
+    quaternion_from_axis_angle(1, 2, 3, 0.7, &q);
+
+    Vector *v, *r;
+    vector_create(3, &v);
+    vector_create(3, &r);
+    double_t expected[3 * 37];
+    for (size_t i = 0; i < count; i++) {
+        v->elements[0] = points->x[i];
+        v->elements[1] = points->y[i];
+        v->elements[2] = points->z[i];
+        quaternion_rotate_vector(&q, v, r);
+        expected[3 * i] = r->elements[0];
+        expected[3 * i + 1] = r->elements[1];
+        expected[3 * i + 2] = r->elements[2];
+    }
+
+    // In place
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          quaternion_rotate_points(&q, points, points));
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-10, expected[3 * i], points->x[i]);
+        TEST_ASSERT_DOUBLE_WITHIN(1e-10, expected[3 * i + 1], points->y[i]);
+        TEST_ASSERT_DOUBLE_WITHIN(1e-10, expected[3 * i + 2], points->z[i]);
+    }
+
+    vector_free(v);
+    vector_free(r);
+    vec3_batch_free(points);
+}
+
+static void test_rotate_points_each(void) {
+    const size_t count = 5;
+    QuatBatch *q;
+    Vec3Batch *points;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, quat_batch_create(count, &q));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, vec3_batch_create(count, &points));
+
+    // New batches hold identity rotations
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(1.0, q->w[i]);
+        points->x[i] = 1.0;
+    }
+
+    // Quaternion i turns by i quarter turns about z
+    for (size_t i = 0; i < count; i++) {
+        Quaternion qi;
+        quaternion_from_axis_angle(0, 0, 1, (double_t)i * PI / 2, &qi);
+        q->w[i] = qi.w;
+        q->x[i] = qi.x;
+        q->y[i] = qi.y;
+        q->z[i] = qi.z;
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          quaternion_rotate_points_each(q, points, points));
+
+    const double_t cos_i[] = {1, 0, -1, 0, 1};
+    const double_t sin_i[] = {0, 1, 0, -1, 0};
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_DOUBLE_WITHIN(EPS, cos_i[i], points->x[i]);
+        TEST_ASSERT_DOUBLE_WITHIN(EPS, sin_i[i], points->y[i]);
+    }
+
+    quat_batch_free(q);
+    vec3_batch_free(points);
+}
+
+static void test_batch_create_rejects_overflowing_count(void) {
+    QuatBatch *q = NULL;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MEM,
+                          quat_batch_create(SIZE_MAX / 2, &q));
+    TEST_ASSERT_NULL(q);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_axis_angle_rotates_x_to_y);
+    RUN_TEST(test_zero_axis_is_math_error);
+    RUN_TEST(test_multiply_composes_rotations);
+    RUN_TEST(test_slerp_halfway);
+    RUN_TEST(test_normalize_zero_is_math_error);
+    RUN_TEST(test_rotate_points_matches_single);
+    RUN_TEST(test_rotate_points_each);
+    RUN_TEST(test_batch_create_rejects_overflowing_count);
+    return UNITY_END();
+}
@@ -0,0 +1,271 @@
+/**
+ * @file ragged_test.c
+ * @brief Tests for variable-length vector collections
+ * @date 18/10/26
+ */
+
+#include "ragged.h"
+#include "unity.h"
+#include <stdlib.h>
+
+#define SEGMENTS 100000
+#define LONG_SEGMENT 500000
+#define HUGE_SEGMENT 3000001
+
+static RaggedVectors *ragged;
+
+void setUp(void) {
+    ragged = NULL;
+}
+
+void tearDown(void) {
+    ragged_free(ragged);
+}
+
+static void test_from_lengths_and_reductions(void) {
+    const size_t lengths[4] = {3, 0, 1, 2};
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ragged_from_lengths(lengths, 4, &ragged));
+    TEST_ASSERT_EQUAL_size_t(4, ragged->count);
+    TEST_ASSERT_EQUAL_size_t(6, ragged->offsets[4]);
+
+    // Segments 3 4 0 | - | -2 | 1 1
+    const double_t values[6] = {3, 4, 0, -2, 1, 1};
+    for (size_t s = 0; s < 4; s++) {
+        double_t *data;
+        size_t length;
+        ragged_segment_data(ragged, s, &data, &length);
+        TEST_ASSERT_EQUAL_size_t(lengths[s], length);
+        for (size_t i = 0; i < length; i++) {
+            data[i] = values[ragged->offsets[s] + i];
+        }
+    }
+
+    Vector *result, *query;
+    vector_create(4, &result);
+    vector_3d(1, 2, 3, &query);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ragged_sum(ragged, result));
+    TEST_ASSERT_EQUAL_DOUBLE(7.0, result->elements[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, result->elements[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(-2.0, result->elements[2]);
+
+    ragged_mean(ragged, result);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-15, 7.0 / 3.0, result->elements[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, result->elements[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, result->elements[3]);
+
+    ragged_norm(ragged, result);
+    TEST_ASSERT_EQUAL_DOUBLE(5.0, result->elements[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, result->elements[2]);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ragged_dot(ragged, query, result));
+    TEST_ASSERT_EQUAL_DOUBLE(11.0, result->elements[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, result->elements[3]);
+
+    // The query must cover the longest segment
+    Vector *short_query;
+    vector_2d(1, 1, &short_query);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          ragged_dot(ragged, short_query, result));
+
+    VectorView view;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INDEX,
+                          ragged_segment(ragged, 4, &view));
+
+    vector_free(result);
+    vector_free(query);
+    vector_free(short_query);
+}
+
+static void test_from_vectors(void) {
+    Vector *vectors[3];
+    vector_3d(1, 2, 3, &vectors[0]);
+    vector_2d(4, 5, &vectors[1]);
+    vector_4d(6, 7, 8, 9, &vectors[2]);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ragged_from_vectors((const Vector *const *)vectors,
+                                              3,
+                                              &ragged));
+
+    VectorView view;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ragged_segment(ragged, 2, &view));
+    TEST_ASSERT_EQUAL_size_t(4, view.size);
+    TEST_ASSERT_EQUAL_DOUBLE(6.0, view.elements[0]);
+    for (size_t i = 0; i < 9; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE((double_t)(i + 1), ragged->values[i]);
+    }
+
+    for (size_t v = 0; v < 3; v++) {
+        vector_free(vectors[v]);
+    }
+}
+
+// Each append copies the whole collection onto its own end
+static void test_append_own_elements(void) {
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ragged_create(1, 1, &ragged));
+    const double_t first[2] = {1.0, 2.0};
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ragged_append(ragged, first, 2));
+
+    for (size_t round = 0; round < 10; round++) {
+        const size_t used = ragged->offsets[ragged->count];
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                              ragged_append(ragged, ragged->values, used));
+    }
+    TEST_ASSERT_EQUAL_size_t(11, ragged->count);
+    TEST_ASSERT_EQUAL_size_t(2048, ragged->offsets[11]);
+    for (size_t i = 0; i < 2048; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(i % 2 ? 2.0 : 1.0, ragged->values[i]);
+    }
+
+    // Segments 1 and 2 again, as two new segments
+    const size_t lengths[2] = {2, 4};
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ragged_append_segments(ragged,
+                                                 ragged->values + 2,
+                                                 lengths,
+                                                 2));
+    TEST_ASSERT_EQUAL_size_t(13, ragged->count);
+    TEST_ASSERT_EQUAL_size_t(2054, ragged->offsets[13]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, ragged->values[2053]);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ragged_append(ragged, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, ragged_append(ragged, NULL, 1));
+}
+
+// Many short segments and one long one spread over the pool
+static void test_uneven_segments(void) {
+    size_t *lengths = malloc((SEGMENTS + 1) * sizeof(size_t));
+    for (size_t s = 0; s < SEGMENTS; s++) {
+        lengths[s] = s % 5;
+    }
+    lengths[SEGMENTS] = LONG_SEGMENT;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ragged_from_lengths(lengths, SEGMENTS + 1, &ragged));
+    const size_t total = ragged->offsets[SEGMENTS + 1];
+    for (size_t i = 0; i < total; i++) {
+        ragged->values[i] = 1.0;
+    }
+
+    Vector *result, *again;
+    vector_create(SEGMENTS + 1, &result);
+    vector_create(SEGMENTS + 1, &again);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ragged_sum(ragged, result));
+    for (size_t s = 0; s < SEGMENTS; s++) {
+        TEST_ASSERT_EQUAL_DOUBLE((double_t)(s % 5), result->elements[s]);
+    }
+    TEST_ASSERT_EQUAL_DOUBLE((double_t)LONG_SEGMENT,
+                             result->elements[SEGMENTS]);
+
+    // Fractional values: identical bits on every run
+    for (size_t i = 0; i < total; i++) {
+        ragged->values[i] = 1.0 / (double_t)(i + 1);
+    }
+    ragged_norm(ragged, result);
+    for (int run = 0; run < 3; run++) {
+        ragged_norm(ragged, again);
+        for (size_t s = 0; s <= SEGMENTS; s++) {
+            TEST_ASSERT_TRUE(result->elements[s] == again->elements[s]);
+        }
+    }
+
+    free(lengths);
+    vector_free(result);
+    vector_free(again);
+}
+
+// One segment much longer than a task is split into chunks over the pool
+static void test_single_huge_segment(void) {
+    Vector *parts[3];
+    vector_2d(1, 2, &parts[0]);
+    vector_create(HUGE_SEGMENT, &parts[1]);
+    vector_3d(3, 4, 5, &parts[2]);
+    for (size_t i = 0; i < HUGE_SEGMENT; i++) {
+        parts[1]->elements[i] = (double_t)(i % 7);
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ragged_from_vectors((const Vector *const *)parts,
+                                              3,
+                                              &ragged));
+    for (size_t i = 0; i < HUGE_SEGMENT; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE(parts[1]->elements[i], ragged->values[i + 2]);
+    }
+
+    // Small integers sum exactly however the chunks are added
+    double_t expected = 0.0;
+    for (size_t i = 0; i < HUGE_SEGMENT; i++) {
+        expected += (double_t)(i % 7);
+    }
+    Vector *result, *again, *query;
+    vector_create(3, &result);
+    vector_create(3, &again);
+    vector_create(HUGE_SEGMENT, &query);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ragged_sum(ragged, result));
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, result->elements[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(expected, result->elements[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(12.0, result->elements[2]);
+    ragged_mean(ragged, result);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12,
+                              expected / HUGE_SEGMENT,
+                              result->elements[1]);
+
+    // Fractional values: close to a plain loop, identical bits every run
+    double_t reference = 0.0;
+    for (size_t i = 0; i < HUGE_SEGMENT; i++) {
+        query->elements[i] = 1.0 / (double_t)(i + 1);
+        reference += parts[1]->elements[i] * query->elements[i];
+    }
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ragged_dot(ragged, query, result));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9 * reference,
+                              reference,
+                              result->elements[1]);
+    for (int run = 0; run < 3; run++) {
+        ragged_dot(ragged, query, again);
+        TEST_ASSERT_TRUE(result->elements[1] == again->elements[1]);
+    }
+
+    // The same segment alone is too small to split over tasks, yet its
+    // chunks are added the same way
+    RaggedVectors *alone;
+    const size_t alone_length = 60000;
+    Vector *alone_result, *split_result;
+    ragged_create(alone_length, 1, &alone);
+    ragged_append(alone, query->elements, alone_length);
+    vector_create(1, &alone_result);
+    vector_create(2, &split_result);
+    ragged_free(ragged);
+    ragged = NULL;
+    const size_t lengths[2] = {alone_length, HUGE_SEGMENT};
+    ragged_create(1, 2, &ragged);
+    ragged_append_segments(ragged, query->elements, lengths, 1);
+    ragged_append_segments(ragged, query->elements, lengths + 1, 1);
+    ragged_sum(alone, alone_result);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ragged_sum(ragged, split_result));
+    TEST_ASSERT_TRUE(alone_result->elements[0] == split_result->elements[0]);
+
+    for (size_t v = 0; v < 3; v++) {
+        vector_free(parts[v]);
+    }
+    ragged_free(alone);
+    vector_free(alone_result);
+    vector_free(split_result);
+    vector_free(result);
+    vector_free(again);
+    vector_free(query);
+}
+
+static void test_null_handles(void) {
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, ragged_free(NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, ragged_create(1, 1, NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_from_lengths_and_reductions);
+    RUN_TEST(test_from_vectors);
+    RUN_TEST(test_append_own_elements);
+    RUN_TEST(test_uneven_segments);
+    RUN_TEST(test_single_huge_segment);
+    RUN_TEST(test_null_handles);
+    return UNITY_END();
+}
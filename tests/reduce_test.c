@@ -0,0 +1,215 @@
+/**
+ * @file reduce_test.c
+ * @brief Tests for axis reductions of arrays, matrices and vector batches
+ * @date 18/10/26
+ */
+
+#include "reduce.h"
+#include "unity.h"
+
+#define LONG_AXIS (1 << 20)
+#define ROWS 2000
+#define COLS 300
+
+static Matrix *small;
+
+// 3 x 4 matrix with (i, j) = 4 * i + j - 5
+void setUp(void) {
+    matrix_create(3, 4, &small);
+    for (size_t i = 0; i < 12; i++) {
+        small->elements[i] = (double_t)i - 5.0;
+    }
+}
+
+void tearDown(void) {
+    matrix_free(small);
+}
+
+static void test_matrix_reduce_both_axes(void) {
+    Vector *columns, *rows;
+    vector_create(4, &columns);
+    vector_create(3, &rows);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          matrix_reduce(small, 0, NUMEN_REDUCE_SUM, columns));
+    TEST_ASSERT_EQUAL_DOUBLE(-3.0, columns->elements[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(6.0, columns->elements[3]);
+
+    matrix_reduce(small, 1, NUMEN_REDUCE_MEAN, rows);
+    TEST_ASSERT_EQUAL_DOUBLE(-3.5, rows->elements[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(4.5, rows->elements[2]);
+
+    matrix_reduce(small, 0, NUMEN_REDUCE_MIN, columns);
+    TEST_ASSERT_EQUAL_DOUBLE(-5.0, columns->elements[0]);
+    matrix_reduce(small, 1, NUMEN_REDUCE_MAX, rows);
+    TEST_ASSERT_EQUAL_DOUBLE(-2.0, rows->elements[0]);
+
+    // Row 0 is -5, -4, -3, -2
+    matrix_reduce(small, 1, NUMEN_REDUCE_NORM, rows);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-15, sqrt(54.0), rows->elements[0]);
+
+    size_t indices[4];
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, matrix_argmax(small, 0, indices));
+    TEST_ASSERT_EQUAL_size_t(2, indices[0]);
+    TEST_ASSERT_EQUAL_size_t(2, indices[3]);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          matrix_reduce(small, 0, NUMEN_REDUCE_SUM, rows));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INVALID_ARG,
+                          matrix_reduce(small, 2, NUMEN_REDUCE_SUM, rows));
+
+    vector_free(columns);
+    vector_free(rows);
+}
+
+static void test_nan_and_ties(void) {
+    Vector *rows;
+    vector_create(3, &rows);
+    small->elements[0] = NAN;
+    small->elements[4] = NAN;
+    small->elements[5] = NAN;
+    small->elements[6] = NAN;
+    small->elements[7] = NAN;
+    small->elements[9] = 6.0;
+
+    // NaN is skipped unless the whole row is NaN
+    matrix_reduce(small, 1, NUMEN_REDUCE_MAX, rows);
+    TEST_ASSERT_EQUAL_DOUBLE(-2.0, rows->elements[0]);
+    TEST_ASSERT_DOUBLE_IS_NAN(rows->elements[1]);
+    matrix_reduce(small, 1, NUMEN_REDUCE_MIN, rows);
+    TEST_ASSERT_EQUAL_DOUBLE(-4.0, rows->elements[0]);
+
+    // Row 2 is 3, 6, 5, 6: the first 6 wins
+    size_t indices[3];
+    matrix_argmax(small, 1, indices);
+    TEST_ASSERT_EQUAL_size_t(3, indices[0]);
+    TEST_ASSERT_EQUAL_size_t(1, indices[2]);
+
+    vector_free(rows);
+}
+
+// Long enough to be split into chunks on the pool
+static void test_long_axis_reproducible(void) {
+    const size_t shape[1] = {LONG_AXIS}, scalar_shape[1] = {1};
+    NdArray *array, *result;
+    ndarray_create(1, shape, &array);
+    ndarray_create(1, scalar_shape, &result);
+    for (size_t i = 0; i < LONG_AXIS; i++) {
+        array->data[i] = (double_t)i;
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ndarray_reduce(array, 0, NUMEN_REDUCE_SUM, result));
+    const double_t expected = (double_t)LONG_AXIS * (LONG_AXIS - 1) / 2.0;
+    TEST_ASSERT_EQUAL_DOUBLE(expected, result->data[0]);
+
+    // Fractional values: identical bits on every run
+    for (size_t i = 0; i < LONG_AXIS; i++) {
+        array->data[i] = 1.0 / (double_t)(i + 1);
+    }
+    ndarray_reduce(array, 0, NUMEN_REDUCE_SUM, result);
+    const double_t first = result->data[0];
+    for (int run = 0; run < 5; run++) {
+        ndarray_reduce(array, 0, NUMEN_REDUCE_SUM, result);
+        TEST_ASSERT_TRUE(first == result->data[0]);
+    }
+
+    size_t index = 0;
+    array->data[LONG_AXIS - 7] = 10.0;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, ndarray_argmax(array, 0, &index));
+    TEST_ASSERT_EQUAL_size_t(LONG_AXIS - 7, index);
+
+    ndarray_free(array);
+    ndarray_free(result);
+}
+
+// Axis 0 accumulates whole rows, axis 1 walks each row
+static void test_array_axes_and_kept_dims(void) {
+    const size_t shape[2] = {ROWS, COLS};
+    const size_t kept_shape[2] = {1, COLS}, row_shape[1] = {ROWS};
+    NdArray *array, *kept, *per_row;
+    ndarray_create(2, shape, &array);
+    ndarray_create(2, kept_shape, &kept);
+    ndarray_create(1, row_shape, &per_row);
+    for (size_t i = 0; i < ROWS; i++) {
+        for (size_t j = 0; j < COLS; j++) {
+            array->data[i * COLS + j] = (double_t)(i + j);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ndarray_reduce(array, 0, NUMEN_REDUCE_MEAN, kept));
+    for (size_t j = 0; j < COLS; j++) {
+        TEST_ASSERT_EQUAL_DOUBLE((ROWS - 1) / 2.0 + j, kept->data[j]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ndarray_reduce(array, 1, NUMEN_REDUCE_MAX, per_row));
+    for (size_t i = 0; i < ROWS; i++) {
+        TEST_ASSERT_EQUAL_DOUBLE((double_t)(i + COLS - 1), per_row->data[i]);
+    }
+
+    // A transposed view reduces the same way through strides
+    NdArray transposed;
+    ndarray_transpose(array, NULL, &transposed);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          ndarray_reduce(&transposed,
+                                         0,
+                                         NUMEN_REDUCE_MAX,
+                                         per_row));
+    TEST_ASSERT_EQUAL_DOUBLE((double_t)(COLS - 1), per_row->data[0]);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          ndarray_reduce(array, 0, NUMEN_REDUCE_SUM, per_row));
+
+    ndarray_free(array);
+    ndarray_free(kept);
+    ndarray_free(per_row);
+}
+
+static void test_vector_batches(void) {
+    Vector *vectors[3], *result;
+    vector_3d(1, -2, 3, &vectors[0]);
+    vector_3d(4, -6, 0, &vectors[1]);
+    vector_3d(4, 5, -3, &vectors[2]);
+    vector_create(3, &result);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_batch_reduce((const Vector *const *)vectors,
+                                              3,
+                                              NUMEN_REDUCE_MEAN,
+                                              result));
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, result->elements[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(-1.0, result->elements[1]);
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, result->elements[2]);
+
+    vector_batch_reduce((const Vector *const *)vectors,
+                        3,
+                        NUMEN_REDUCE_NORM,
+                        result);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-15, sqrt(33.0), result->elements[0]);
+
+    size_t indices[3];
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          vector_batch_argmax((const Vector *const *)vectors,
+                                              3,
+                                              indices));
+    TEST_ASSERT_EQUAL_size_t(1, indices[0]);
+    TEST_ASSERT_EQUAL_size_t(2, indices[1]);
+    TEST_ASSERT_EQUAL_size_t(0, indices[2]);
+
+    for (size_t v = 0; v < 3; v++) {
+        vector_free(vectors[v]);
+    }
+    vector_free(result);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_matrix_reduce_both_axes);
+    RUN_TEST(test_nan_and_ties);
+    RUN_TEST(test_long_axis_reproducible);
+    RUN_TEST(test_array_axes_and_kept_dims);
+    RUN_TEST(test_vector_batches);
+    return UNITY_END();
+}
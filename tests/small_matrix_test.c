@@ -0,0 +1,203 @@
+/**
+ * @file small_matrix_test.c
+ * @brief Tests for batched determinants, inverses and products of small
+ *        matrices
+ * @date 18/10/26
+ */
+
+#include "mask.h"
+#include "matrix.h"
+#include "unity.h"
+#include <string.h>
+
+#define COUNT 1000
+
+static uint64_t seed;
+
+void setUp(void) {
+    seed = 19;
+}
+
+void tearDown(void) {}
+
+// Uniform in [-1, 1), reproducible across platforms
+static double_t next_random(void) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (double_t)(seed >> 11) / (double_t)(1ULL << 52) - 1.0;
+}
+
+// Element (i, j) of matrix k
+static double_t *at(const MatrixBatch *batch, size_t i, size_t j, size_t k) {
+    return &batch->elements[(i * batch->cols + j) * batch->count + k];
+}
+
+// Diagonally weighted so the batch is well conditioned
+static void fill_batch(MatrixBatch *batch) {
+    for (size_t k = 0; k < batch->count; k++) {
+        for (size_t i = 0; i < batch->rows; i++) {
+            for (size_t j = 0; j < batch->cols; j++) {
+                *at(batch, i, j, k) = next_random() + (i == j ? 3.0 : 0.0);
+            }
+        }
+    }
+}
+
+// Laplace expansion along the first row
+static double_t naive_det(const double_t *m, size_t n) {
+    if (n == 1)
+        return m[0];
+    double_t minor[9], det = 0.0, sign = 1.0;
+    for (size_t c = 0; c < n; c++) {
+        size_t p = 0;
+        for (size_t i = 1; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                if (j != c)
+                    minor[p++] = m[i * n + j];
+            }
+        }
+        det += sign * m[c] * naive_det(minor, n - 1);
+        sign = -sign;
+    }
+    return det;
+}
+
+static void test_det_all_sizes(void) {
+    for (size_t n = 1; n <= MATRIX_BATCH_SMALL_MAX; n++) {
+        MatrixBatch *a;
+        Vector *det;
+        matrix_batch_create(n, n, COUNT, &a);
+        vector_create(COUNT, &det);
+        fill_batch(a);
+
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, matrix_batch_det(a, det));
+        for (size_t k = 0; k < COUNT; k++) {
+            double_t m[16];
+            for (size_t e = 0; e < n * n; e++) {
+                m[e] = a->elements[e * COUNT + k];
+            }
+            const double_t expected = naive_det(m, n);
+            TEST_ASSERT_DOUBLE_WITHIN(1e-12 * fabs(expected),
+                                      expected,
+                                      det->elements[k]);
+        }
+
+        matrix_batch_free(a);
+        vector_free(det);
+    }
+}
+
+static void test_inverse_all_sizes(void) {
+    for (size_t n = 1; n <= MATRIX_BATCH_SMALL_MAX; n++) {
+        MatrixBatch *a, *inverse, *product;
+        VectorMask *singular;
+        matrix_batch_create(n, n, COUNT, &a);
+        matrix_batch_create(n, n, COUNT, &inverse);
+        matrix_batch_create(n, n, COUNT, &product);
+        vector_mask_create(COUNT, &singular);
+        fill_batch(a);
+
+        // Matrix 17 is all zeros
+        for (size_t e = 0; e < n * n; e++) {
+            a->elements[e * COUNT + 17] = 0.0;
+        }
+
+        TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                              matrix_batch_inverse(a, inverse, singular));
+        size_t flagged = 0;
+        vector_count_where(singular, &flagged);
+        TEST_ASSERT_EQUAL_size_t(1, flagged);
+
+        TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                              matrix_batch_mult(a, inverse, product));
+        for (size_t k = 0; k < COUNT; k++) {
+            for (size_t i = 0; i < n; i++) {
+                for (size_t j = 0; j < n; j++) {
+                    const double_t expected =
+                        k == 17 ? 0.0 : (i == j ? 1.0 : 0.0);
+                    TEST_ASSERT_DOUBLE_WITHIN(1e-12,
+                                              expected,
+                                              *at(product, i, j, k));
+                }
+            }
+        }
+
+        // In place gives the same result
+        TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_MATH,
+                              matrix_batch_inverse(a, a, NULL));
+        TEST_ASSERT_EQUAL_INT(0,
+                              memcmp(a->elements,
+                                     inverse->elements,
+                                     n * n * COUNT * sizeof(double_t)));
+
+        matrix_batch_free(a);
+        matrix_batch_free(inverse);
+        matrix_batch_free(product);
+        vector_mask_free(singular);
+    }
+}
+
+static void test_rectangular_products(void) {
+    MatrixBatch *a, *b, *result, *x, *y;
+    matrix_batch_create(2, 4, COUNT, &a);
+    matrix_batch_create(4, 3, COUNT, &b);
+    matrix_batch_create(2, 3, COUNT, &result);
+    matrix_batch_create(4, 1, COUNT, &x);
+    matrix_batch_create(2, 1, COUNT, &y);
+    fill_batch(a);
+    fill_batch(b);
+    fill_batch(x);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, matrix_batch_mult(a, b, result));
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          matrix_batch_mult_vector(a, x, y));
+    for (size_t k = 0; k < COUNT; k++) {
+        for (size_t i = 0; i < 2; i++) {
+            for (size_t j = 0; j < 3; j++) {
+                double_t sum = 0.0;
+                for (size_t p = 0; p < 4; p++) {
+                    sum += *at(a, i, p, k) * *at(b, p, j, k);
+                }
+                TEST_ASSERT_DOUBLE_WITHIN(1e-14, sum, *at(result, i, j, k));
+            }
+            double_t sum = 0.0;
+            for (size_t p = 0; p < 4; p++) {
+                sum += *at(a, i, p, k) * *at(x, p, 0, k);
+            }
+            TEST_ASSERT_DOUBLE_WITHIN(1e-14, sum, *at(y, i, 0, k));
+        }
+    }
+
+    // Inner dimensions must agree
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, matrix_batch_mult(b, a, result));
+
+    matrix_batch_free(a);
+    matrix_batch_free(b);
+    matrix_batch_free(result);
+    matrix_batch_free(x);
+    matrix_batch_free(y);
+}
+
+static void test_rejects_large_matrices(void) {
+    MatrixBatch *a;
+    Vector *det;
+    matrix_batch_create(MATRIX_BATCH_SMALL_MAX + 1,
+                        MATRIX_BATCH_SMALL_MAX + 1,
+                        2,
+                        &a);
+    vector_create(2, &det);
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE, matrix_batch_det(a, det));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_SIZE,
+                          matrix_batch_inverse(a, a, NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, matrix_batch_det(NULL, det));
+    matrix_batch_free(a);
+    vector_free(det);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_det_all_sizes);
+    RUN_TEST(test_inverse_all_sizes);
+    RUN_TEST(test_rectangular_products);
+    RUN_TEST(test_rejects_large_matrices);
+    return UNITY_END();
+}
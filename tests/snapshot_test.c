@@ -0,0 +1,139 @@
+/**
+ * @file snapshot_test.c
+ * @brief Tests for RCU-style snapshot publication
+ * @date 18/10/26
+ */
+
+#include "snapshot.h"
+#include "unity.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define SIZE 256
+#define READERS 3
+#define VERSIONS 2000
+
+static NumenSnapshot *snapshot;
+static Vector *source;
+static atomic_bool writing;
+static atomic_int torn_reads;
+
+void setUp(void) {
+    vector_create(SIZE, &source);
+    numen_snapshot_create(source, &snapshot);
+    atomic_store(&torn_reads, 0);
+}
+
+void tearDown(void) {
+    numen_snapshot_free(snapshot);
+    vector_free(source);
+}
+
+// Version v holds v in every element, so a mixed read is detectable
+static void *read_versions(void *arg) {
+    (void)arg;
+    NumenSnapshotReader *reader;
+    if (numen_snapshot_reader_create(snapshot, &reader) != VECTOR_SUCCESS)
+        return NULL;
+
+    uint64_t last = 0;
+    while (atomic_load(&writing)) {
+        const Vector *v;
+        uint64_t version;
+        numen_snapshot_acquire(reader, &v, &version);
+        for (size_t i = 0; i < v->size; i++) {
+            if (v->elements[i] != (double_t)version)
+                atomic_fetch_add(&torn_reads, 1);
+        }
+        if (version < last)
+            atomic_fetch_add(&torn_reads, 1);
+        last = version;
+        numen_snapshot_release(reader);
+    }
+    numen_snapshot_reader_free(reader);
+    return NULL;
+}
+
+static void test_readers_see_whole_versions(void) {
+    pthread_t threads[READERS];
+    atomic_store(&writing, true);
+    for (size_t r = 0; r < READERS; r++) {
+        pthread_create(&threads[r], NULL, read_versions, NULL);
+    }
+
+    for (size_t v = 1; v <= VERSIONS; v++) {
+        for (size_t i = 0; i < SIZE; i++) {
+            source->elements[i] = (double_t)v;
+        }
+        if (v % 2) {
+            TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                                  numen_snapshot_publish(snapshot, source));
+        } else {
+            Vector *owned;
+            vector_create(SIZE, &owned);
+            vector_copy(source, owned);
+            TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                                  numen_snapshot_swap(snapshot, owned));
+        }
+    }
+
+    atomic_store(&writing, false);
+    for (size_t r = 0; r < READERS; r++) {
+        pthread_join(threads[r], NULL);
+    }
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&torn_reads));
+
+    size_t pending = 1;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_snapshot_reclaim(snapshot, &pending));
+    TEST_ASSERT_EQUAL_size_t(0, pending);
+}
+
+static void test_pinned_version_survives_publish(void) {
+    NumenSnapshotReader *reader;
+    numen_snapshot_reader_create(snapshot, &reader);
+
+    const Vector *pinned;
+    uint64_t version;
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS,
+                          numen_snapshot_acquire(reader, &pinned, &version));
+    TEST_ASSERT_EQUAL_UINT64(0, version);
+
+    // A second acquire without release is refused
+    const Vector *again;
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_INIT,
+                          numen_snapshot_acquire(reader, &again, NULL));
+
+    source->elements[0] = 42.0;
+    numen_snapshot_publish(snapshot, source);
+    numen_snapshot_publish(snapshot, source);
+
+    size_t pending = 0;
+    numen_snapshot_reclaim(snapshot, &pending);
+    TEST_ASSERT_TRUE(pending >= 1);
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, pinned->elements[0]);
+
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_snapshot_release(reader));
+    numen_snapshot_reclaim(snapshot, &pending);
+    TEST_ASSERT_EQUAL_size_t(0, pending);
+
+    numen_snapshot_acquire(reader, &pinned, &version);
+    TEST_ASSERT_EQUAL_UINT64(2, version);
+    TEST_ASSERT_EQUAL_DOUBLE(42.0, pinned->elements[0]);
+    TEST_ASSERT_EQUAL_INT(VECTOR_SUCCESS, numen_snapshot_reader_free(reader));
+}
+
+static void test_null_handles(void) {
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL,
+                          numen_snapshot_publish(NULL, source));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_snapshot_reader_free(NULL));
+    TEST_ASSERT_EQUAL_INT(VECTOR_ERROR_NULL, numen_snapshot_free(NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_readers_see_whole_versions);
+    RUN_TEST(test_pinned_version_survives_publish);
+    RUN_TEST(test_null_handles);
+    return UNITY_END();
+}